@@ -0,0 +1,158 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  allocation_counter.hpp
+/// \brief Counts of the heap allocations made by a piece of code, for the tests and the benchmarks.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_ALLOCATION_COUNTER_HPP
+#define BOOST_ALGORITHM_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>      // for std::size_t
+#include <new>          // for std::bad_alloc, std::nothrow_t
+
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
+
+#if defined ( BOOST_ALGORITHM_COUNT_ALLOCATIONS )
+#include <cstdlib>      // for std::malloc, std::free
+#endif
+
+/*
+    Allocation counts.
+
+    An allocation_scope takes a snapshot of the program's allocation counts
+    when it is made, and reports what was allocated (and freed) since:
+
+        allocation_scope s;
+        searcher ( first, last );
+        std::cout << s.allocations () << " allocations, " << s.bytes () << " bytes";
+
+    The counts come from replacing the global operator new and operator
+    delete. A program can only do that once, so exactly one of its translation
+    units must define BOOST_ALGORITHM_COUNT_ALLOCATIONS before including this
+    header; the others just include it. Without that, nothing is counted, and
+    allocation_scope::counting () is false.
+
+    The counts are atomic, so allocations on other threads (a thread pool's,
+    say) are counted too; but they are the whole program's, so a scope on
+    one thread sees what the others allocate while it is open.
+*/
+
+namespace boost { namespace algorithm {
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    struct allocation_totals {
+        boost::atomic<std::size_t> allocations;
+        boost::atomic<std::size_t> bytes;
+        boost::atomic<std::size_t> frees;
+        };
+
+//  Zero-initialized before anything runs, so operator new can use it at any time
+    inline allocation_totals &allocation_counts () {
+        static allocation_totals totals;
+        return totals;
+        }
+
+//  Defined only with BOOST_ALGORITHM_COUNT_ALLOCATIONS, below
+    void *counted_new ( std::size_t n );
+    void counted_delete ( void *p );
+}
+/// \endcond
+
+/*!
+    \class allocation_scope
+    \brief What the program allocated between the scope's construction and now.
+*/
+    class allocation_scope {
+    public:
+        allocation_scope () { reset (); }
+
+        /// \brief Start counting again from now
+        void reset () {
+            const detail::allocation_totals &t = detail::allocation_counts ();
+            allocations_ = t.allocations;
+            bytes_       = t.bytes;
+            frees_       = t.frees;
+            }
+
+        std::size_t allocations () const { return detail::allocation_counts ().allocations - allocations_; }
+        std::size_t bytes       () const { return detail::allocation_counts ().bytes - bytes_; }
+        std::size_t frees       () const { return detail::allocation_counts ().frees - frees_; }
+
+        /// \brief Whether this program counts its allocations (see BOOST_ALGORITHM_COUNT_ALLOCATIONS)
+        static bool counting () {
+            const std::size_t before = detail::allocation_counts ().allocations;
+        //  Calls of the functions themselves, unlike new-expressions, can't be left out
+            ::operator delete ( ::operator new ( 1 ));
+            return detail::allocation_counts ().allocations != before;
+            }
+
+    private:
+        std::size_t allocations_, bytes_, frees_;
+        };
+
+}}
+
+#if defined ( BOOST_ALGORITHM_COUNT_ALLOCATIONS )
+//  The replacements can't be inline, which is why only one translation unit may have them.
+//  The malloc and free are kept out of line as well: inlined into the replacements, and
+//  those into new-expressions, they look to the compiler like a new paired with a free.
+namespace boost { namespace algorithm { namespace detail {
+    BOOST_NOINLINE void *counted_new ( std::size_t n ) {
+        allocation_totals &t = allocation_counts ();
+        ++t.allocations;
+        t.bytes += n;
+        return std::malloc ( n == 0 ? 1 : n );
+        }
+
+    BOOST_NOINLINE void counted_delete ( void *p ) {
+        if ( p != NULL ) {
+            ++allocation_counts ().frees;
+            std::free ( p );
+            }
+        }
+}}}
+
+#if defined ( BOOST_NO_CXX11_NOEXCEPT )
+void *operator new   ( std::size_t n ) throw ( std::bad_alloc ) {
+    void *p = boost::algorithm::detail::counted_new ( n );
+    if ( p == NULL ) throw std::bad_alloc ();
+    return p;
+    }
+void *operator new[] ( std::size_t n ) throw ( std::bad_alloc ) { return ::operator new ( n ); }
+void *operator new   ( std::size_t n, const std::nothrow_t & ) throw () { return boost::algorithm::detail::counted_new ( n ); }
+void *operator new[] ( std::size_t n, const std::nothrow_t & ) throw () { return boost::algorithm::detail::counted_new ( n ); }
+void operator delete   ( void *p ) throw () { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete[] ( void *p ) throw () { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete   ( void *p, const std::nothrow_t & ) throw () { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete[] ( void *p, const std::nothrow_t & ) throw () { boost::algorithm::detail::counted_delete ( p ); }
+#else
+void *operator new   ( std::size_t n ) {
+    void *p = boost::algorithm::detail::counted_new ( n );
+    if ( p == NULL ) throw std::bad_alloc ();
+    return p;
+    }
+void *operator new[] ( std::size_t n ) { return ::operator new ( n ); }
+void *operator new   ( std::size_t n, const std::nothrow_t & ) noexcept { return boost::algorithm::detail::counted_new ( n ); }
+void *operator new[] ( std::size_t n, const std::nothrow_t & ) noexcept { return boost::algorithm::detail::counted_new ( n ); }
+void operator delete   ( void *p ) noexcept { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete[] ( void *p ) noexcept { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete   ( void *p, const std::nothrow_t & ) noexcept { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete[] ( void *p, const std::nothrow_t & ) noexcept { boost::algorithm::detail::counted_delete ( p ); }
+#if defined ( __cpp_sized_deallocation )
+//  C++14 sized deallocation; without these, a compiler that uses them would go around the counts
+void operator delete   ( void *p, std::size_t ) noexcept { boost::algorithm::detail::counted_delete ( p ); }
+void operator delete[] ( void *p, std::size_t ) noexcept { boost::algorithm::detail::counted_delete ( p ); }
+#endif
+#endif
+#endif
+
+#endif  //  BOOST_ALGORITHM_ALLOCATION_COUNTER_HPP
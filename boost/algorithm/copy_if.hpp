@@ -39,7 +39,7 @@ OutputIterator copy_if ( InputIterator first, InputIterator last, OutputIterator
 {
     for ( ; first != last; ++first )
         if (p(*first))
-            *result++ = first;
+            *result++ = *first;
     return result;
 }
 #endif
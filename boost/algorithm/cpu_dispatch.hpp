@@ -0,0 +1,184 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_CPU_DISPATCH_HPP
+#define BOOST_ALGORITHM_CPU_DISPATCH_HPP
+
+#include <cstdlib>      // for std::getenv
+#include <cstring>      // for std::strcmp
+
+#include <boost/config.hpp>
+
+/*
+    Choosing vector code at run time.
+
+    The vector kernels in the library are compiled for several instruction
+    sets at once, and the one to use is picked when the kernel is called,
+    from the processor the program is running on. A binary built for plain
+    x86-64 still uses SSSE3 or AVX2 where the processor has them.
+
+    The levels are ordered; each one includes the ones below it:
+
+        simd_scalar     no vector code at all
+        simd_sse2       SSE2 (every x86-64)
+        simd_sse42      SSE4.2, and so SSSE3
+        simd_avx2       AVX2 (and the operating system saves the ymm registers)
+        simd_avx512     AVX-512 F and BW (and the operating system saves the zmm registers)
+
+    detected_simd_level () asks the processor once, with cpuid, and caches
+    the answer. A kernel asks active_simd_level (), which is the detected
+    level, lowered by:
+
+        * force_simd_level ( level ), which is meant for tests: the kernel for
+          each level up to the detected one can be run on one machine.
+        * the environment variable BOOST_ALGORITHM_SIMD, set to the name of a
+          level ("scalar", "sse2", "sse42", "avx2" or "avx512"), read once,
+          so that a whole test suite can be run at each level.
+
+    A kernel that has no version for the active level uses its best one below it.
+
+    Kernels for levels above what the compiler was told to target are
+    marked with BOOST_ALGORITHM_TARGET ( "avx2" ) and the like, and only
+    exist if BOOST_ALGORITHM_MULTIVERSION is defined (GCC, Clang, and MSVC on
+    x86); the SSE2 kernels are still controlled by BOOST_ALGORITHM_BYTE_SET_SSE2.
+    Define BOOST_ALGORITHM_NO_SIMD to use only the portable code.
+
+    force_simd_level is not guarded; call it before starting threads that
+    search.
+*/
+
+#if !defined ( BOOST_ALGORITHM_NO_SIMD ) && \
+    ( defined ( __x86_64__ ) || defined ( __i386__ ) || defined ( _M_X64 ) || defined ( _M_IX86 ))
+#if defined ( __GNUC__ ) && ( defined ( __clang__ ) || __GNUC__ >= 5 )
+#define BOOST_ALGORITHM_MULTIVERSION
+#define BOOST_ALGORITHM_TARGET(isa) __attribute__ (( target ( isa )))
+#include <immintrin.h>
+#elif defined ( BOOST_MSVC ) && BOOST_MSVC >= 1700
+#define BOOST_ALGORITHM_MULTIVERSION
+#define BOOST_ALGORITHM_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>     // for __cpuid, __cpuidex
+#endif
+#endif
+
+#ifndef BOOST_ALGORITHM_TARGET
+#define BOOST_ALGORITHM_TARGET(isa)
+#endif
+
+namespace boost { namespace algorithm {
+
+    enum simd_level { simd_scalar, simd_sse2, simd_sse42, simd_avx2, simd_avx512 };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline const char *simd_level_names ( int i ) {
+        static const char *names [] = { "scalar", "sse2", "sse42", "avx2", "avx512" };
+        return names [ i ];
+        }
+
+//  The level named by 's', or 'otherwise' if it isn't the name of one
+    inline simd_level parse_simd_level ( const char *s, simd_level otherwise ) {
+        if ( s != NULL )
+            for ( int i = simd_scalar; i <= simd_avx512; ++i )
+                if ( std::strcmp ( s, simd_level_names ( i )) == 0 )
+                    return static_cast<simd_level> ( i );
+        return otherwise;
+        }
+
+//  Without BOOST_ALGORITHM_MULTIVERSION, only what the compiler was told to target
+    inline simd_level cpuid_simd_level () {
+#if defined ( BOOST_ALGORITHM_NO_SIMD )
+        return simd_scalar;
+#elif !defined ( BOOST_ALGORITHM_MULTIVERSION )
+#if defined ( __AVX512F__ ) && defined ( __AVX512BW__ )
+        return simd_avx512;
+#elif defined ( __AVX2__ )
+        return simd_avx2;
+#elif defined ( __SSE4_2__ ) && defined ( __SSSE3__ )
+        return simd_sse42;
+#elif defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+        return simd_sse2;
+#else
+        return simd_scalar;
+#endif
+#elif defined ( __GNUC__ )
+    //  These check that the operating system saves the wide registers, too
+        __builtin_cpu_init ();
+        if ( __builtin_cpu_supports ( "avx512f" ) && __builtin_cpu_supports ( "avx512bw" ))
+            return simd_avx512;
+        if ( __builtin_cpu_supports ( "avx2" ))
+            return simd_avx2;
+        if ( __builtin_cpu_supports ( "sse4.2" ) && __builtin_cpu_supports ( "ssse3" ))
+            return simd_sse42;
+        if ( __builtin_cpu_supports ( "sse2" ))
+            return simd_sse2;
+        return simd_scalar;
+#else
+        int r [ 4 ];
+        __cpuid ( r, 0 );
+        const int max_leaf = r [ 0 ];
+        __cpuid ( r, 1 );
+        const bool sse2  = ( r [ 3 ] & ( 1 << 26 )) != 0;
+        const bool ssse3 = ( r [ 2 ] & ( 1 <<  9 )) != 0;
+        const bool sse42 = ( r [ 2 ] & ( 1 << 20 )) != 0;
+        const bool osxsave = ( r [ 2 ] & ( 1 << 27 )) != 0;
+        const unsigned long long xcr0 = osxsave ? _xgetbv ( 0 ) : 0;
+        bool avx2 = false, avx512 = false;
+        if ( max_leaf >= 7 ) {
+            __cpuidex ( r, 7, 0 );
+            avx2   = ( r [ 1 ] & ( 1 << 5 )) != 0 && ( xcr0 & 0x06 ) == 0x06;
+            avx512 = ( r [ 1 ] & ( 1 << 16 )) != 0 && ( r [ 1 ] & ( 1 << 30 )) != 0 && ( xcr0 & 0xe6 ) == 0xe6;
+            }
+        return avx512 ? simd_avx512 : avx2 ? simd_avx2 : sse42 && ssse3 ? simd_sse42 : sse2 ? simd_sse2 : simd_scalar;
+#endif
+        }
+
+    inline simd_level &forced_simd_level () {
+        static simd_level level = simd_avx512;
+        return level;
+        }
+
+    inline simd_level lower ( simd_level a, simd_level b ) { return a < b ? a : b; }
+}
+/// \endcond
+
+/// \fn simd_level_name ( simd_level level )
+/// \brief The name of the level, as used by BOOST_ALGORITHM_SIMD
+    inline const char *simd_level_name ( simd_level level ) {
+        return detail::simd_level_names ( level );
+        }
+
+/// \fn detected_simd_level ()
+/// \brief The best level that this processor (and this build) can run,
+///     lowered by the environment variable BOOST_ALGORITHM_SIMD, if it is set
+    inline simd_level detected_simd_level () {
+        static const simd_level level = detail::lower ( detail::cpuid_simd_level (),
+                detail::parse_simd_level ( std::getenv ( "BOOST_ALGORITHM_SIMD" ), simd_avx512 ));
+        return level;
+        }
+
+/// \fn active_simd_level ()
+/// \brief The level that kernels should use now
+    inline simd_level active_simd_level () {
+        return detail::lower ( detected_simd_level (), detail::forced_simd_level ());
+        }
+
+/// \fn force_simd_level ( simd_level level )
+/// \brief Keeps the kernels at or below 'level' (for testing); returns the previous setting.
+///     force_simd_level ( simd_avx512 ) removes the limit.
+    inline simd_level force_simd_level ( simd_level level ) {
+        const simd_level retVal = detail::forced_simd_level ();
+        detail::forced_simd_level () = level;
+        return retVal;
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_CPU_DISPATCH_HPP
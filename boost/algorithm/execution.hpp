@@ -0,0 +1,138 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  execution.hpp
+/// \brief Execution policies, and the interface to a pool of threads that runs parallel algorithms.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_EXECUTION_HPP
+#define BOOST_ALGORITHM_EXECUTION_HPP
+
+#include <cstddef>      // for std::size_t
+
+#include <boost/function.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Execution policies.
+
+    The algorithms in parallel.hpp take a policy as their first argument,
+    like the ones in the C++17 standard library:
+
+        execution::seq          run on the calling thread; no threads are
+                                created or used, and the plain algorithm is called
+        execution::par          split the input into pieces, and run the pieces
+                                on an executor (and on the calling thread)
+        execution::par_unseq    the same as par; the pieces may also be
+                                vectorized (which the kernels here do anyway)
+
+    The parallel policies can be adjusted:
+
+        execution::par.with_grain ( 10000 )     at least 10000 elements a piece
+        execution::par.on ( my_executor )       run the pieces on my_executor
+
+    An input no bigger than one grain is done on the calling thread, without
+    touching the executor. The default grain is chosen from the size of the
+    input and the executor's concurrency, but is never less than
+    current_search_tuning ().parallel_min_grain (in searching/tuning.hpp),
+    which starts out as execution::parallel_min_grain and can be measured
+    with calibrate_parallel_min_grain ().
+
+    An executor is anything derived from boost::algorithm::executor, which
+    says how to run a task, and how many tasks can usefully run at once; an
+    adapter for an existing thread pool is a few lines. Without .on (), the
+    library's own work-stealing pool (default_executor (), in parallel.hpp)
+    is used; it is created the first time it is needed.
+
+    This header doesn't need Boost.Thread; parallel.hpp does.
+*/
+
+/*!
+    \class executor
+    \brief Something that runs tasks, on some thread, at some time.
+*/
+    class executor {
+    public:
+        typedef boost::function<void ()> task;
+
+        virtual ~executor () {}
+
+        /// \brief Arrange for 'task' to be run. The parallel algorithms do some of the
+        ///     work on the calling thread, and only wait for tasks that have started,
+        ///     so they make progress even if the executor runs tasks late (or inline).
+        virtual void execute ( const task &t ) = 0;
+
+        /// \brief How many tasks can usefully run at once
+        virtual std::size_t concurrency () const = 0;
+        };
+
+namespace execution {
+
+    //  The least default grain, until current_search_tuning () says otherwise
+    static const std::size_t parallel_min_grain = 1024;
+
+    class sequenced_policy {};
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Derived>
+    class parallel_policy_base {
+    public:
+        parallel_policy_base () : grain_ ( 0 ), executor_ ( NULL ) {}
+
+        /// \brief A copy that gives each task at least 'g' elements (0 for the default)
+        Derived with_grain ( std::size_t g ) const {
+            Derived retVal ( static_cast<const Derived &> ( *this ));
+            retVal.grain_ = g;
+            return retVal;
+            }
+
+        /// \brief A copy that runs the tasks on 'e', which must outlive the call
+        Derived on ( executor &e ) const {
+            Derived retVal ( static_cast<const Derived &> ( *this ));
+            retVal.executor_ = &e;
+            return retVal;
+            }
+
+        std::size_t grain () const { return grain_; }
+        executor *get_executor () const { return executor_; }
+
+    private:
+        std::size_t grain_;
+        executor *executor_;
+        };
+}
+/// \endcond
+
+    class parallel_policy : public detail::parallel_policy_base<parallel_policy> {};
+    class parallel_unsequenced_policy : public detail::parallel_policy_base<parallel_unsequenced_policy> {};
+
+    static const sequenced_policy            seq       = sequenced_policy ();
+    static const parallel_policy             par       = parallel_policy ();
+    static const parallel_unsequenced_policy par_unseq = parallel_unsequenced_policy ();
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename T> struct is_execution_policy_impl : public boost::false_type {};
+    template <> struct is_execution_policy_impl<sequenced_policy>            : public boost::true_type {};
+    template <> struct is_execution_policy_impl<parallel_policy>             : public boost::true_type {};
+    template <> struct is_execution_policy_impl<parallel_unsequenced_policy> : public boost::true_type {};
+}
+/// \endcond
+
+    template <typename T>
+    struct is_execution_policy : public detail::is_execution_policy_impl<typename boost::remove_cv<T>::type> {};
+}
+
+}}
+
+#endif  //  BOOST_ALGORITHM_EXECUTION_HPP
@@ -36,6 +36,8 @@ TO DO:
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_integral.hpp>
 
+#include <boost/algorithm/probes.hpp>
+
 
 namespace boost { namespace algorithm {
 
@@ -162,8 +164,11 @@ namespace detail {
 template <typename InputIterator, typename OutputIterator>
 typename boost::enable_if<boost::is_integral<typename detail::hex_iterator_traits<InputIterator>::value_type>, OutputIterator>::type
 hex ( InputIterator first, InputIterator last, OutputIterator out ) {
-    while ( first != last )
+    std::size_t count = 0;
+    BOOST_ALGORITHM_PROBE0 ( hex_encode_begin );
+    for ( ; first != last; ++count )
         out = detail::encode_one ( *first++, out );
+    BOOST_ALGORITHM_PROBE1 ( hex_encode_end, count );
     return out;
     }
     
@@ -178,8 +183,11 @@ hex ( InputIterator first, InputIterator last, OutputIterator out ) {
 template <typename T, typename OutputIterator>
 typename boost::enable_if<boost::is_integral<T>, OutputIterator>::type
 hex ( const T *ptr, OutputIterator out ) {
-    while ( *ptr )
+    std::size_t count = 0;
+    BOOST_ALGORITHM_PROBE0 ( hex_encode_begin );
+    for ( ; *ptr; ++count )
         out = detail::encode_one ( *ptr++, out );
+    BOOST_ALGORITHM_PROBE1 ( hex_encode_end, count );
     return out;
     }
 
@@ -207,8 +215,17 @@ hex ( const Range &r, OutputIterator out ) {
 /// \note           Based on the MySQL function of the same name
 template <typename InputIterator, typename OutputIterator>
 OutputIterator unhex ( InputIterator first, InputIterator last, OutputIterator out ) {
-    while ( first != last )
-        out = detail::decode_one ( first, last, out );
+    std::ptrdiff_t count = 0;
+    BOOST_ALGORITHM_PROBE0 ( hex_decode_begin );
+    try {
+        for ( ; first != last; ++count )
+            out = detail::decode_one ( first, last, out );
+        }
+    catch ( ... ) {     //  so that a tracer sees every begin matched by an end
+        BOOST_ALGORITHM_PROBE1 ( hex_decode_end, static_cast<std::ptrdiff_t> ( -1 ));
+        throw;
+        }
+    BOOST_ALGORITHM_PROBE1 ( hex_decode_end, count );
     return out;
     }
 
@@ -228,8 +245,17 @@ OutputIterator unhex ( const T *ptr, OutputIterator out ) {
 //      exception - but how much extra work would that require?
 //  I just make up an "end iterator" which we will never get to - 
 //      two Ts per byte of the output type.
-    while ( *ptr )
-        out = detail::decode_one ( ptr, ptr + 2 * sizeof(OutputType), out );
+    std::ptrdiff_t count = 0;
+    BOOST_ALGORITHM_PROBE0 ( hex_decode_begin );
+    try {
+        for ( ; *ptr; ++count )
+            out = detail::decode_one ( ptr, ptr + 2 * sizeof(OutputType), out );
+        }
+    catch ( ... ) {
+        BOOST_ALGORITHM_PROBE1 ( hex_decode_end, static_cast<std::ptrdiff_t> ( -1 ));
+        throw;
+        }
+    BOOST_ALGORITHM_PROBE1 ( hex_decode_end, count );
     return out;
     }
 
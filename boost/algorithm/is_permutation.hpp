@@ -23,6 +23,8 @@
 #include <boost/type_traits/is_same.hpp>
 #include <boost/tr1/tr1/tuple>      // for tie
 
+#include <boost/algorithm/execution.hpp>
+
 namespace boost { namespace algorithm {
 
 #if __cplusplus >= 201103L
@@ -128,8 +130,9 @@ bool is_permutation ( const Range &r, ForwardIterator first2 )
 ///
 //  Disable this template when the first two parameters are the same type
 //  That way the non-range version will be chosen.
+//  Also when the first is an execution policy; see parallel.hpp
 template <typename Range, typename ForwardIterator, typename BinaryPredicate>
-typename boost::disable_if_c<boost::is_same<Range, ForwardIterator>::value, bool>::type
+typename boost::disable_if_c<boost::is_same<Range, ForwardIterator>::value || execution::is_execution_policy<Range>::value, bool>::type
 is_permutation ( const Range &r, ForwardIterator first2, BinaryPredicate pred )
 {
     return boost::algorithm::is_permutation (boost::begin (r), boost::end (r), first2, pred );
@@ -22,6 +22,8 @@
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_same.hpp>
 
+#include <boost/algorithm/execution.hpp>
+
 namespace boost { namespace algorithm {
 
 #if __cplusplus >= 201103L
@@ -142,9 +144,11 @@ minmax_element ( Range &r )
 //
 //  Disable this template when the first two parameters are the same type
 //  That way the non-range version will be chosen.
+//  Also when the first is an execution policy; see parallel.hpp
 template<class Range, class Compare>
 typename boost::lazy_disable_if_c<
-        boost::is_same<Range, Compare>::value, typename detail::range_pair<Range> >
+        boost::is_same<Range, Compare>::value || execution::is_execution_policy<Range>::value,
+        typename detail::range_pair<Range> >
     ::type
 minmax_element ( Range &r, Compare comp )
 {
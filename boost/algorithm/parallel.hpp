@@ -0,0 +1,1587 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  parallel.hpp
+/// \brief A work-stealing thread pool, and versions of the algorithms that take an execution policy.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_PARALLEL_HPP
+#define BOOST_ALGORITHM_PARALLEL_HPP
+
+#include <algorithm>    // for std::max, std::min
+#include <cstddef>      // for std::size_t
+#include <deque>
+#include <functional>   // for std::less and friends
+#include <iterator>     // for std::iterator_traits
+#include <string>
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <boost/algorithm/execution.hpp>
+#include <boost/algorithm/all_of.hpp>
+#include <boost/algorithm/any_of.hpp>
+#include <boost/algorithm/none_of.hpp>
+#include <boost/algorithm/one_of.hpp>
+#include <boost/algorithm/clamp.hpp>
+#include <boost/algorithm/copy_if.hpp>
+#include <boost/algorithm/copy_n.hpp>
+#include <boost/algorithm/find_if_not.hpp>
+#include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/iota.hpp>
+#include <boost/algorithm/is_partitioned.hpp>
+#include <boost/algorithm/is_permutation.hpp>
+#include <boost/algorithm/minmax_element.hpp>
+#include <boost/algorithm/ordered.hpp>
+#include <boost/algorithm/partition_copy.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/calibrate.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/search_each.hpp>
+#include <boost/algorithm/searching/tuning.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Running the algorithms on several threads.
+
+    thread_pool is a fixed set of threads, each with its own queue of
+    tasks. New tasks are dealt out to the queues in turn; a thread takes
+    tasks from the front of its own queue, and when that is empty, steals
+    from the back of another thread's queue. default_executor () is a pool
+    with one thread per processor (less one, for the calling thread), made
+    the first time it is needed.
+
+    parallel_for ( policy, n, body ) calls body ( lo, hi ) for pieces
+    [lo, hi) that cover [0, n), on the policy's executor and on the calling
+    thread, and returns when they have all been done. The pieces are handed
+    out in order, as threads ask for them; the calling thread takes pieces
+    too, so it doesn't depend on the executor to make progress, and only
+    waits for pieces that have been started. If a piece throws, no more
+    pieces are started, and the exception is rethrown on the calling thread.
+
+    The algorithms below take an execution policy (see execution.hpp) as
+    their first argument. With execution::seq, or iterators that aren't
+    random access, they call the ordinary algorithm. Otherwise, the input is
+    cut into pieces with parallel_for. The searches (all_of and friends,
+    one_of, find_if_not, is_partitioned, is_ordered, is_permutation) stop
+    handing out pieces once one of them has the answer, and give the same
+    answer as the ordinary algorithm -- the first element that decides it.
+    minmax_element gives the first smallest and the last largest element, as
+    the ordinary one does.
+
+    copy_if and partition_copy write each element to a place that depends
+    on how many before it were copied, so they take two passes over the same
+    pieces. The first marks the elements that satisfy the predicate, and
+    counts them in each piece; the sums of the counts before each piece
+    (an exclusive prefix sum) say where its output starts; and the second
+    pass copies each piece there. unhex decodes each value from a fixed
+    place in the input (two characters for each byte of the value), so its
+    pieces are independent.
+
+    parallel_search looks for a pattern in one long corpus. Each piece is a
+    range of places where a match could start, and is searched with m - 1
+    elements of the next piece after it (m being the length of the pattern),
+    so that a match that crosses the boundary is found in the piece where it
+    starts. boyer_moore_search, boyer_moore_horspool_search and
+    knuth_morris_pratt_search take a policy too, and call it.
+
+    The predicates, comparisons and searchers are called from several
+    threads at once, so they must be safe to call that way.
+
+    partition_point has no parallel version; it is a binary search, and
+    looks at only log n elements.
+
+    Below some size, handing pieces to other threads costs more than it
+    saves. That size is current_search_tuning ().parallel_min_grain (see
+    searching/tuning.hpp); calibrate_parallel_min_grain () measures it on
+    the machine it runs on, and it can be saved and loaded with the other
+    settings.
+
+    This header needs Boost.Thread to be linked in.
+*/
+
+/*!
+    \class thread_pool
+    \brief A work-stealing pool of threads
+*/
+    class thread_pool : public executor, private boost::noncopyable {
+    public:
+        /// \brief Start 'threads' threads (or one per processor, if 'threads' is zero)
+        explicit thread_pool ( std::size_t threads = 0 )
+                : k_threads ( threads != 0 ? threads : (std::max) ( 1U, boost::thread::hardware_concurrency ())),
+                  queues_ ( new queue [ k_threads ] ), pending_ ( 0 ), next_queue_ ( 0 ), stop_ ( false ) {
+            try {
+                for ( std::size_t i = 0; i < k_threads; ++i )
+                    threads_.create_thread ( worker ( this, i ));
+                }
+            catch ( ... ) {
+                shut_down ();
+                throw;
+                }
+            }
+
+        /// \brief Runs the tasks that are still queued, then stops the threads
+        ~thread_pool () { shut_down (); }
+
+        void execute ( const task &t ) {
+            std::size_t q;
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            q = next_queue_++ % k_threads;
+            }
+            {
+            boost::lock_guard<boost::mutex> lock ( queues_ [ q ].mutex );
+            queues_ [ q ].tasks.push_back ( t );
+            }
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            ++pending_;
+            }
+            wake_.notify_one ();
+            }
+
+        std::size_t concurrency () const { return k_threads; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        struct queue {
+            boost::mutex mutex;
+            std::deque<task> tasks;
+            };
+
+        struct worker {
+            worker ( thread_pool *pool, std::size_t self ) : pool_ ( pool ), self_ ( self ) {}
+            void operator () () const { pool_->work ( self_ ); }
+            thread_pool *pool_;
+            std::size_t self_;
+            };
+
+        const std::size_t k_threads;
+        boost::scoped_array<queue> queues_;
+
+    //  Guarded by mutex_. A task is put in a queue before it is counted in
+    //  pending_, so a thread that takes one from the count will find one.
+        boost::mutex mutex_;
+        boost::condition_variable wake_;
+        std::size_t pending_;
+        std::size_t next_queue_;
+        bool stop_;
+
+        boost::thread_group threads_;
+
+        void shut_down () {
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            stop_ = true;
+            }
+            wake_.notify_all ();
+            threads_.join_all ();
+            }
+
+        void work ( std::size_t self ) {
+            for ( ;; ) {
+                {
+                boost::unique_lock<boost::mutex> lock ( mutex_ );
+                while ( pending_ == 0 && !stop_ )
+                    wake_.wait ( lock );
+                if ( pending_ == 0 )
+                    return;
+                --pending_;
+                }
+                task t;
+                while ( !take ( self, t ))
+                    ;
+                try { t (); }
+                catch ( ... ) {}    // tasks report their own errors
+                }
+            }
+
+    //  Take from the front of our own queue, or steal from the back of someone else's
+        bool take ( std::size_t self, task &t ) {
+            for ( std::size_t i = 0; i < k_threads; ++i ) {
+                queue &q = queues_ [ ( self + i ) % k_threads ];
+                boost::lock_guard<boost::mutex> lock ( q.mutex );
+                if ( !q.tasks.empty ()) {
+                    if ( i == 0 ) {
+                        t.swap ( q.tasks.front ());
+                        q.tasks.pop_front ();
+                        }
+                    else {
+                        t.swap ( q.tasks.back ());
+                        q.tasks.pop_back ();
+                        }
+                    return true;
+                    }
+                }
+            return false;
+            }
+/// \endcond
+        };
+
+/// \fn default_executor ()
+/// \brief The pool that the parallel policies use, unless they are given another executor
+    inline executor &default_executor () {
+        static thread_pool pool ( (std::max) ( 2U, boost::thread::hardware_concurrency ()) - 1 );
+        return pool;
+        }
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  How the work will be split; 'exec' is NULL if it will all be done on the calling thread
+    struct parallel_plan {
+        executor *exec;
+        std::size_t grain, chunks;
+        };
+
+    inline parallel_plan make_parallel_plan ( const execution::sequenced_policy &, std::size_t n ) {
+        parallel_plan retVal = { NULL, n, 1 };
+        return retVal;
+        }
+
+    template <typename Policy>
+    parallel_plan make_parallel_plan ( const Policy &policy, std::size_t n ) {
+        parallel_plan retVal = { NULL, n, 1 };
+        const std::size_t min_grain = (std::max) ( std::size_t ( 1 ), current_search_tuning ().parallel_min_grain );
+        if ( n <= ( policy.grain () != 0 ? policy.grain () : min_grain ))
+            return retVal;      // don't even look at the executor
+
+        executor &e = policy.get_executor () != NULL ? *policy.get_executor () : default_executor ();
+        std::size_t grain = policy.grain ();
+        if ( grain == 0 ) {     // about four pieces for each thread, counting this one
+            const std::size_t pieces = 4 * ( e.concurrency () + 1 );
+            grain = (std::max) ( min_grain, ( n + pieces - 1 ) / pieces );
+            }
+        if ( n > grain ) {
+            retVal.exec   = &e;
+            retVal.grain  = grain;
+            retVal.chunks = ( n + grain - 1 ) / grain;
+            }
+        return retVal;
+        }
+
+//  The pieces still to be done, shared by the calling thread and the tasks
+    struct parallel_state : private boost::noncopyable {
+        typedef boost::function<bool ( std::size_t, std::size_t, std::size_t )> body_type;
+
+        parallel_state ( const parallel_plan &plan, std::size_t n, const body_type &body )
+            : n_ ( n ), grain_ ( plan.grain ), chunks_ ( plan.chunks ), body_ ( body ),
+              next_ ( 0 ), running_ ( 0 ), stop_ ( false ) {}
+
+    //  Do one piece; false if there are none left
+        bool run_one () {
+            std::size_t c;
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            if ( stop_ || next_ == chunks_ )
+                return false;
+            c = next_++;
+            ++running_;
+            }
+            bool stop = false;
+            boost::exception_ptr e;
+            try { stop = body_ ( c, c * grain_, (std::min) ( n_, ( c + 1 ) * grain_ )); }
+            catch ( ... ) { e = boost::current_exception (); }
+
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            if ( e && !error_ )
+                error_ = e;
+            if ( stop || e )
+                stop_ = true;
+            if ( --running_ == 0 )
+                done_.notify_all ();
+            return true;
+            }
+
+    //  Wait for the pieces that have started, and pass on any exception
+        void finish () {
+            boost::unique_lock<boost::mutex> lock ( mutex_ );
+            while ( running_ != 0 )
+                done_.wait ( lock );
+            if ( error_ )
+                boost::rethrow_exception ( error_ );
+            }
+
+        const std::size_t n_, grain_, chunks_;
+        const body_type body_;
+
+    //  Guarded by mutex_
+        boost::mutex mutex_;
+        boost::condition_variable done_;
+        std::size_t next_, running_;
+        bool stop_;
+        boost::exception_ptr error_;
+        };
+
+    struct parallel_helper {
+        explicit parallel_helper ( const boost::shared_ptr<parallel_state> &st ) : st_ ( st ) {}
+        void operator () () const { while ( st_->run_one ()) {} }
+        boost::shared_ptr<parallel_state> st_;
+        };
+
+//  Call body ( chunk, lo, hi ) for each piece of the plan; body returns true
+//  if no more pieces need to be started.
+    template <typename Body>
+    void parallel_run ( const parallel_plan &plan, std::size_t n, Body body ) {
+        if ( plan.exec == NULL ) {
+            body ( 0, 0, n );
+            return;
+            }
+        boost::shared_ptr<parallel_state> st ( new parallel_state ( plan, n, body ));
+        const std::size_t helpers = (std::min) ( plan.chunks - 1, plan.exec->concurrency ());
+        try {
+            for ( std::size_t i = 0; i < helpers; ++i )
+                plan.exec->execute ( parallel_helper ( st ));
+            }
+        catch ( ... ) {}    // run the rest here
+        while ( st->run_one ())
+            ;
+        st->finish ();
+        }
+
+    template <typename Body>
+    struct parallel_for_body {
+        explicit parallel_for_body ( const Body &b ) : b_ ( b ) {}
+        bool operator () ( std::size_t, std::size_t lo, std::size_t hi ) const { b_ ( lo, hi ); return false; }
+        Body b_;
+        };
+
+//  Does this policy, with these iterators, run in parallel?
+    template <typename Policy, typename Iter>
+    struct runs_parallel : public boost::integral_constant<bool,
+            !boost::is_same<typename boost::remove_cv<Policy>::type, execution::sequenced_policy>::value &&
+            boost::is_convertible<typename std::iterator_traits<Iter>::iterator_category,
+                                  std::random_access_iterator_tag>::value> {};
+
+//  The first i in [0, n) for which test ( i ), or n
+    template <typename Test>
+    struct parallel_find_body {
+        parallel_find_body ( const Test &t, std::vector<std::size_t> &found ) : t_ ( t ), found_ ( &found ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            for ( std::size_t i = lo; i < hi; ++i )
+                if ( t_ ( i )) {
+                    ( *found_ ) [ c ] = i;
+                    return true;
+                    }
+            return false;
+            }
+        Test t_;
+        std::vector<std::size_t> *found_;
+        };
+
+    template <typename Policy, typename Test>
+    std::size_t parallel_find ( const Policy &policy, std::size_t n, const Test &t ) {
+        const parallel_plan plan = make_parallel_plan ( policy, n );
+        std::vector<std::size_t> found ( plan.chunks, n );
+        parallel_run ( plan, n, parallel_find_body<Test> ( t, found ));
+    //  Pieces are started in order, so every piece before the first hit was done
+        for ( std::size_t c = 0; c < found.size (); ++c )
+            if ( found [ c ] != n )
+                return found [ c ];
+        return n;
+        }
+
+    template <typename Iter, typename Pred>
+    struct parallel_pred_test {
+        parallel_pred_test ( Iter first, Pred p, bool want ) : first_ ( first ), p_ ( p ), want_ ( want ) {}
+        bool operator () ( std::size_t i ) const { return static_cast<bool> ( p_ ( first_ [ i ] )) == want_; }
+        Iter first_;
+        Pred p_;
+        bool want_;
+        };
+
+    template <typename Iter, typename T>
+    struct parallel_equal_test {
+        parallel_equal_test ( Iter first, const T &val, bool want ) : first_ ( first ), val_ ( &val ), want_ ( want ) {}
+        bool operator () ( std::size_t i ) const { return ( *val_ == first_ [ i ] ) == want_; }
+        Iter first_;
+        const T *val_;
+        bool want_;
+        };
+
+    template <typename Iter, typename Pred>
+    struct parallel_unordered_test {
+        parallel_unordered_test ( Iter first, Pred p ) : first_ ( first ), p_ ( p ) {}
+        bool operator () ( std::size_t i ) const { return !p_ ( first_ [ i ], first_ [ i + 1 ] ); }
+        Iter first_;
+        Pred p_;
+        };
+
+//  Is there an element of [first, last) for which p is 'want'?
+    template <typename Policy, typename Iter, typename Pred>
+    bool parallel_exists ( const Policy &policy, Iter first, Iter last, Pred p, bool want ) {
+        const std::size_t n = last - first;
+        return parallel_find ( policy, n, parallel_pred_test<Iter, Pred> ( first, p, want )) != n;
+        }
+
+    template <typename Policy, typename Iter, typename T>
+    bool parallel_exists_equal ( const Policy &policy, Iter first, Iter last, const T &val, bool want ) {
+        const std::size_t n = last - first;
+        return parallel_find ( policy, n, parallel_equal_test<Iter, T> ( first, val, want )) != n;
+        }
+
+    template <typename Iter, typename Compare>
+    struct parallel_minmax_body {
+        typedef std::pair<Iter, Iter> result;
+        parallel_minmax_body ( Iter first, Compare comp, std::vector<result> &r ) : first_ ( first ), comp_ ( comp ), r_ ( &r ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            ( *r_ ) [ c ] = boost::algorithm::minmax_element ( first_ + lo, first_ + hi, comp_ );
+            return false;
+            }
+        Iter first_;
+        Compare comp_;
+        std::vector<result> *r_;
+        };
+
+    template <typename Iter, typename T>
+    struct parallel_iota_body {
+        parallel_iota_body ( Iter first, T value ) : first_ ( first ), value_ ( value ) {}
+        bool operator () ( std::size_t, std::size_t lo, std::size_t hi ) const {
+            boost::algorithm::iota ( first_ + lo, first_ + hi, static_cast<T> ( value_ + static_cast<T> ( lo )));
+            return false;
+            }
+        Iter first_;
+        T value_;
+        };
+
+    template <typename InputIterator, typename OutputIterator>
+    struct parallel_hex_body {
+        parallel_hex_body ( InputIterator first, OutputIterator out ) : first_ ( first ), out_ ( out ) {}
+        bool operator () ( std::size_t, std::size_t lo, std::size_t hi ) const {
+            typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+            boost::algorithm::hex ( first_ + lo, first_ + hi, out_ + lo * 2 * sizeof ( value_type ));
+            return false;
+            }
+        InputIterator first_;
+        OutputIterator out_;
+        };
+
+    template <typename Searcher, typename CorporaIter, typename OutputIterator>
+    struct parallel_search_each_body {
+        parallel_search_each_body ( const Searcher &s, CorporaIter first, OutputIterator out ) : s_ ( &s ), first_ ( first ), out_ ( out ) {}
+        bool operator () ( std::size_t, std::size_t lo, std::size_t hi ) const {
+            boost::algorithm::search_each ( *s_, first_ + lo, first_ + hi, out_ + lo );
+            return false;
+            }
+        const Searcher *s_;
+        CorporaIter first_;
+        OutputIterator out_;
+        };
+
+    template <typename InputIterator, typename OutputIterator, typename Pred>
+    struct parallel_clamp_body {
+        typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+        parallel_clamp_body ( InputIterator first, OutputIterator out, const value_type &lo, const value_type &hi, Pred p )
+            : first_ ( first ), out_ ( out ), lo_ ( &lo ), hi_ ( &hi ), p_ ( p ) {}
+        bool operator () ( std::size_t, std::size_t lo, std::size_t hi ) const {
+            boost::algorithm::clamp_range ( first_ + lo, first_ + hi, out_ + lo, *lo_, *hi_, p_ );
+            return false;
+            }
+        InputIterator first_;
+        OutputIterator out_;
+        const value_type *lo_, *hi_;
+        Pred p_;
+        };
+
+    template <typename InputIterator, typename OutputIterator>
+    struct parallel_copy_body {
+        parallel_copy_body ( InputIterator first, OutputIterator out ) : first_ ( first ), out_ ( out ) {}
+        bool operator () ( std::size_t, std::size_t lo, std::size_t hi ) const {
+            std::copy ( first_ + lo, first_ + hi, out_ + lo );
+            return false;
+            }
+        InputIterator first_;
+        OutputIterator out_;
+        };
+
+//  The first pass of copy_if and partition_copy: mark the elements that
+//  satisfy the predicate, and count them in each piece
+    template <typename Iter, typename Pred>
+    struct parallel_mark_body {
+        parallel_mark_body ( Iter first, Pred p, std::vector<unsigned char> &marks, std::vector<std::size_t> &counts )
+            : first_ ( first ), p_ ( p ), marks_ ( &marks ), counts_ ( &counts ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            std::size_t count = 0;
+            for ( std::size_t i = lo; i < hi; ++i ) {
+                const bool marked = p_ ( first_ [ i ] );
+                ( *marks_ ) [ i ] = marked;
+                count += marked;
+                }
+            ( *counts_ ) [ c ] = count;
+            return false;
+            }
+        Iter first_;
+        Pred p_;
+        std::vector<unsigned char> *marks_;
+        std::vector<std::size_t> *counts_;
+        };
+
+//  Turns the counts for each piece into where each piece's output starts; returns the total
+    inline std::size_t exclusive_scan ( std::vector<std::size_t> &counts ) {
+        std::size_t total = 0;
+        for ( std::size_t c = 0; c < counts.size (); ++c ) {
+            const std::size_t n = counts [ c ];
+            counts [ c ] = total;
+            total += n;
+            }
+        return total;
+        }
+
+//  The second pass of copy_if
+    template <typename InputIterator, typename OutputIterator>
+    struct parallel_copy_marked_body {
+        parallel_copy_marked_body ( InputIterator first, OutputIterator out,
+                                    const std::vector<unsigned char> &marks, const std::vector<std::size_t> &starts )
+            : first_ ( first ), out_ ( out ), marks_ ( &marks ), starts_ ( &starts ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            OutputIterator o = out_ + ( *starts_ ) [ c ];
+            for ( std::size_t i = lo; i < hi; ++i )
+                if (( *marks_ ) [ i ] )
+                    *o++ = first_ [ i ];
+            return false;
+            }
+        InputIterator first_;
+        OutputIterator out_;
+        const std::vector<unsigned char> *marks_;
+        const std::vector<std::size_t> *starts_;
+        };
+
+//  The second pass of partition_copy. The elements before piece c that weren't
+//  marked are the ones that were, taken from lo.
+    template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+    struct parallel_partition_marked_body {
+        parallel_partition_marked_body ( InputIterator first, OutputIterator1 out_true, OutputIterator2 out_false,
+                                         const std::vector<unsigned char> &marks, const std::vector<std::size_t> &starts )
+            : first_ ( first ), out_true_ ( out_true ), out_false_ ( out_false ), marks_ ( &marks ), starts_ ( &starts ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            OutputIterator1 t = out_true_  + ( *starts_ ) [ c ];
+            OutputIterator2 f = out_false_ + ( lo - ( *starts_ ) [ c ] );
+            for ( std::size_t i = lo; i < hi; ++i )
+                if (( *marks_ ) [ i ] )
+                    *t++ = first_ [ i ];
+                else
+                    *f++ = first_ [ i ];
+            return false;
+            }
+        InputIterator first_;
+        OutputIterator1 out_true_;
+        OutputIterator2 out_false_;
+        const std::vector<unsigned char> *marks_;
+        const std::vector<std::size_t> *starts_;
+        };
+
+//  Values [lo, hi) of unhex, from characters [lo * width, hi * width). A piece
+//  that throws keeps its exception, so that the first in the input can be rethrown.
+    template <typename InputIterator, typename OutputIterator>
+    struct parallel_unhex_body {
+        parallel_unhex_body ( InputIterator first, OutputIterator out, std::size_t width, std::vector<boost::exception_ptr> &errors )
+            : first_ ( first ), out_ ( out ), width_ ( width ), errors_ ( &errors ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            try {
+                boost::algorithm::unhex ( first_ + lo * width_, first_ + hi * width_, out_ + lo );
+                }
+            catch ( ... ) {
+                ( *errors_ ) [ c ] = boost::current_exception ();
+                return true;
+                }
+            return false;
+            }
+        InputIterator first_;
+        OutputIterator out_;
+        std::size_t width_;
+        std::vector<boost::exception_ptr> *errors_;
+        };
+
+    template <typename Iter1, typename Iter2, typename Pred>
+    struct parallel_mismatch_test {
+        parallel_mismatch_test ( Iter1 first1, Iter2 first2, Pred p ) : first1_ ( first1 ), first2_ ( first2 ), p_ ( p ) {}
+        bool operator () ( std::size_t i ) const { return !p_ ( first1_ [ i ], first2_ [ i ] ); }
+        Iter1 first1_;
+        Iter2 first2_;
+        Pred p_;
+        };
+
+//  Does element i of the first sequence show that it isn't a permutation of
+//  the second? As in the ordinary is_permutation, only the first of each value
+//  is checked, and it does if the second has none of it, or a different number.
+    template <typename Iter1, typename Iter2, typename Pred>
+    struct parallel_permutation_test {
+        parallel_permutation_test ( Iter1 first1, Iter2 first2, std::size_t n, Pred p )
+            : first1_ ( first1 ), first2_ ( first2 ), n_ ( n ), p_ ( p ) {}
+        bool operator () ( std::size_t i ) const {
+            for ( std::size_t j = 0; j < i; ++j )
+                if ( p_ ( first1_ [ i ], first1_ [ j ] ))
+                    return false;   // checked already, at j
+            std::size_t count1 = 0, count2 = 0;
+            for ( std::size_t j = i; j < n_; ++j )
+                if ( p_ ( first1_ [ i ], first1_ [ j ] ))
+                    ++count1;
+            for ( std::size_t j = 0; j < n_; ++j )
+                if ( p_ ( first1_ [ i ], first2_ [ j ] ))
+                    ++count2;
+            return count2 == 0 || count2 != count1;
+            }
+        Iter1 first1_;
+        Iter2 first2_;
+        std::size_t n_;
+        Pred p_;
+        };
+
+//  Pieces are ranges of places where a match could start; each is searched
+//  with the m - 1 elements after it, so that matches that cross into the next
+//  piece are found in this one.
+    template <typename Searcher, typename corpusIter>
+    struct parallel_search_body {
+        parallel_search_body ( const Searcher &s, std::size_t m, corpusIter first, corpusIter last, std::vector<std::size_t> &found )
+            : s_ ( &s ), m_ ( m ), first_ ( first ), last_ ( last ), found_ ( &found ) {}
+        bool operator () ( std::size_t c, std::size_t lo, std::size_t hi ) const {
+            const corpusIter piece_last = first_ + (std::min) ( hi + m_ - 1, static_cast<std::size_t> ( last_ - first_ ));
+            const corpusIter res = ( *s_ ) ( first_ + lo, piece_last );
+            if ( res == piece_last )
+                return false;
+            ( *found_ ) [ c ] = res - first_;
+            return true;
+            }
+        const Searcher *s_;
+        std::size_t m_;
+        corpusIter first_, last_;
+        std::vector<std::size_t> *found_;
+        };
+}
+/// \endcond
+
+/// \fn parallel_for ( const Policy &policy, std::size_t n, Body body )
+/// \brief Calls body ( lo, hi ) for pieces [lo, hi) that together cover [0, n),
+///     on several threads if the policy allows it.
+///
+/// \param policy   How to run the pieces (see execution.hpp)
+/// \param n        The number of elements
+/// \param body     Called as body ( std::size_t lo, std::size_t hi ); must be safe to call from several threads at once
+///
+    template <typename Policy, typename Body>
+    typename boost::enable_if<execution::is_execution_policy<Policy> >::type
+    parallel_for ( const Policy &policy, std::size_t n, Body body ) {
+        if ( n != 0 )
+            detail::parallel_run ( detail::make_parallel_plan ( policy, n ), n, detail::parallel_for_body<Body> ( body ));
+        }
+
+
+//  all_of, any_of, none_of
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Iter, typename Pred>
+    bool exists ( const Policy &policy, Iter first, Iter last, Pred p, bool want, boost::true_type ) {
+        return parallel_exists ( policy, first, last, p, want );
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    bool exists ( const Policy &, Iter first, Iter last, Pred p, bool want, boost::false_type ) {
+        return want ? boost::algorithm::any_of ( first, last, p ) : !boost::algorithm::all_of ( first, last, p );
+        }
+
+    template <typename Policy, typename Iter, typename T>
+    bool exists_equal ( const Policy &policy, Iter first, Iter last, const T &val, bool want, boost::true_type ) {
+        return parallel_exists_equal ( policy, first, last, val, want );
+        }
+
+    template <typename Policy, typename Iter, typename T>
+    bool exists_equal ( const Policy &, Iter first, Iter last, const T &val, bool want, boost::false_type ) {
+        return want ? boost::algorithm::any_of_equal ( first, last, val ) : !boost::algorithm::all_of_equal ( first, last, val );
+        }
+}
+/// \endcond
+
+/// \fn all_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p )
+/// \return true if all elements in [first, last) satisfy the predicate 'p'
+    template <typename Policy, typename InputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    all_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p ) {
+        return !detail::exists ( policy, first, last, p, false, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    all_of ( const Policy &policy, const Range &r, Predicate p ) {
+        return boost::algorithm::all_of ( policy, boost::begin ( r ), boost::end ( r ), p );
+        }
+
+/// \fn any_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p )
+/// \return true if any of the elements in [first, last) satisfy the predicate 'p'
+    template <typename Policy, typename InputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    any_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p ) {
+        return detail::exists ( policy, first, last, p, true, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    any_of ( const Policy &policy, const Range &r, Predicate p ) {
+        return boost::algorithm::any_of ( policy, boost::begin ( r ), boost::end ( r ), p );
+        }
+
+/// \fn none_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p )
+/// \return true if none of the elements in [first, last) satisfy the predicate 'p'
+    template <typename Policy, typename InputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    none_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p ) {
+        return !detail::exists ( policy, first, last, p, true, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    none_of ( const Policy &policy, const Range &r, Predicate p ) {
+        return boost::algorithm::none_of ( policy, boost::begin ( r ), boost::end ( r ), p );
+        }
+
+/// \fn all_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val )
+/// \return true if all elements in [first, last) are equal to 'val'
+    template <typename Policy, typename InputIterator, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    all_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val ) {
+        return !detail::exists_equal ( policy, first, last, val, false, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    all_of_equal ( const Policy &policy, const Range &r, const T &val ) {
+        return boost::algorithm::all_of_equal ( policy, boost::begin ( r ), boost::end ( r ), val );
+        }
+
+/// \fn any_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val )
+/// \return true if any of the elements in [first, last) are equal to 'val'
+    template <typename Policy, typename InputIterator, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    any_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val ) {
+        return detail::exists_equal ( policy, first, last, val, true, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    any_of_equal ( const Policy &policy, const Range &r, const T &val ) {
+        return boost::algorithm::any_of_equal ( policy, boost::begin ( r ), boost::end ( r ), val );
+        }
+
+/// \fn none_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val )
+/// \return true if none of the elements in [first, last) are equal to 'val'
+    template <typename Policy, typename InputIterator, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    none_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val ) {
+        return !detail::exists_equal ( policy, first, last, val, true, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    none_of_equal ( const Policy &policy, const Range &r, const T &val ) {
+        return boost::algorithm::none_of_equal ( policy, boost::begin ( r ), boost::end ( r ), val );
+        }
+
+
+//  one_of, find_if_not, is_partitioned
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Iter, typename Pred>
+    Iter find_if_not ( const Policy &policy, Iter first, Iter last, Pred p, boost::true_type ) {
+        return first + parallel_find ( policy, last - first, parallel_pred_test<Iter, Pred> ( first, p, false ));
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    Iter find_if_not ( const Policy &, Iter first, Iter last, Pred p, boost::false_type ) {
+        return boost::algorithm::find_if_not ( first, last, p );
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    bool one_of ( const Policy &policy, Iter first, Iter last, Pred p, boost::true_type ) {
+        const std::size_t n = last - first;
+        const std::size_t i = parallel_find ( policy, n, parallel_pred_test<Iter, Pred> ( first, p, true ));
+        return i != n && !parallel_exists ( policy, first + i + 1, last, p, true );
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    bool one_of ( const Policy &, Iter first, Iter last, Pred p, boost::false_type ) {
+        return boost::algorithm::one_of ( first, last, p );
+        }
+
+    template <typename Policy, typename Iter, typename T>
+    bool one_of_equal ( const Policy &policy, Iter first, Iter last, const T &val, boost::true_type ) {
+        const std::size_t n = last - first;
+        const std::size_t i = parallel_find ( policy, n, parallel_equal_test<Iter, T> ( first, val, true ));
+        return i != n && !parallel_exists_equal ( policy, first + i + 1, last, val, true );
+        }
+
+    template <typename Policy, typename Iter, typename T>
+    bool one_of_equal ( const Policy &, Iter first, Iter last, const T &val, boost::false_type ) {
+        return boost::algorithm::one_of_equal ( first, last, val );
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    bool is_partitioned ( const Policy &policy, Iter first, Iter last, Pred p, boost::true_type ) {
+        const Iter mid = detail::find_if_not ( policy, first, last, p, boost::true_type ());
+        return mid == last || !parallel_exists ( policy, mid + 1, last, p, true );
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    bool is_partitioned ( const Policy &, Iter first, Iter last, Pred p, boost::false_type ) {
+        return boost::algorithm::is_partitioned ( first, last, p );
+        }
+}
+/// \endcond
+
+/// \fn one_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p )
+/// \return true if exactly one of the elements in [first, last) satisfies the predicate 'p'
+    template <typename Policy, typename InputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    one_of ( const Policy &policy, InputIterator first, InputIterator last, Predicate p ) {
+        return detail::one_of ( policy, first, last, p, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    one_of ( const Policy &policy, const Range &r, Predicate p ) {
+        return boost::algorithm::one_of ( policy, boost::begin ( r ), boost::end ( r ), p );
+        }
+
+/// \fn one_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val )
+/// \return true if exactly one of the elements in [first, last) is equal to 'val'
+    template <typename Policy, typename InputIterator, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    one_of_equal ( const Policy &policy, InputIterator first, InputIterator last, const T &val ) {
+        return detail::one_of_equal ( policy, first, last, val, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    one_of_equal ( const Policy &policy, const Range &r, const T &val ) {
+        return boost::algorithm::one_of_equal ( policy, boost::begin ( r ), boost::end ( r ), val );
+        }
+
+/// \fn find_if_not ( const Policy &policy, InputIterator first, InputIterator last, Predicate p )
+/// \return the first element in [first, last) that doesn't satisfy the predicate 'p', or 'last'
+    template <typename Policy, typename InputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, InputIterator>::type
+    find_if_not ( const Policy &policy, InputIterator first, InputIterator last, Predicate p ) {
+        return detail::find_if_not ( policy, first, last, p, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename Predicate>
+    typename boost::lazy_enable_if<execution::is_execution_policy<Policy>, boost::range_iterator<const Range> >::type
+    find_if_not ( const Policy &policy, const Range &r, Predicate p ) {
+        return boost::algorithm::find_if_not ( policy, boost::begin ( r ), boost::end ( r ), p );
+        }
+
+/// \fn is_partitioned ( const Policy &policy, InputIterator first, InputIterator last, UnaryPredicate p )
+/// \return true if every element in [first, last) that satisfies 'p' comes before every one that doesn't
+    template <typename Policy, typename InputIterator, typename UnaryPredicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_partitioned ( const Policy &policy, InputIterator first, InputIterator last, UnaryPredicate p ) {
+        return detail::is_partitioned ( policy, first, last, p, detail::runs_parallel<Policy, InputIterator> ());
+        }
+
+    template <typename Policy, typename Range, typename UnaryPredicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_partitioned ( const Policy &policy, const Range &r, UnaryPredicate p ) {
+        return boost::algorithm::is_partitioned ( policy, boost::begin ( r ), boost::end ( r ), p );
+        }
+
+
+//  is_permutation
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Iter1, typename Iter2, typename Pred>
+    bool is_permutation ( const Policy &policy, Iter1 first1, Iter1 last1, Iter2 first2, Pred p, boost::true_type ) {
+    //  Skip the common prefix, then check each element of the rest
+        const std::size_t n = last1 - first1;
+        const std::size_t same = parallel_find ( policy, n, parallel_mismatch_test<Iter1, Iter2, Pred> ( first1, first2, p ));
+        const std::size_t rest = n - same;
+        return parallel_find ( policy, rest,
+                    parallel_permutation_test<Iter1, Iter2, Pred> ( first1 + same, first2 + same, rest, p )) == rest;
+        }
+
+    template <typename Policy, typename Iter1, typename Iter2, typename Pred>
+    bool is_permutation ( const Policy &, Iter1 first1, Iter1 last1, Iter2 first2, Pred p, boost::false_type ) {
+        return boost::algorithm::is_permutation ( first1, last1, first2, p );
+        }
+}
+/// \endcond
+
+/// \fn is_permutation ( const Policy &policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2, BinaryPredicate p )
+/// \return true if [first1, last1) is a permutation of the sequence starting at first2.
+///     Done in parallel when both are random access: after the common prefix, each
+///     element is counted in both sequences, as the ordinary one does, on several threads.
+    template <typename Policy, typename ForwardIterator1, typename ForwardIterator2, typename BinaryPredicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_permutation ( const Policy &policy, ForwardIterator1 first1, ForwardIterator1 last1,
+                     ForwardIterator2 first2, BinaryPredicate p ) {
+        return detail::is_permutation ( policy, first1, last1, first2, p, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, ForwardIterator1>::value && detail::runs_parallel<Policy, ForwardIterator2>::value> ());
+        }
+
+    template <typename Policy, typename ForwardIterator1, typename ForwardIterator2>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_permutation ( const Policy &policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2 ) {
+        return boost::algorithm::is_permutation ( policy, first1, last1, first2,
+                    std::equal_to<typename std::iterator_traits<ForwardIterator1>::value_type> ());
+        }
+
+    template <typename Policy, typename Range, typename ForwardIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_permutation ( const Policy &policy, const Range &r, ForwardIterator first2 ) {
+        return boost::algorithm::is_permutation ( policy, boost::begin ( r ), boost::end ( r ), first2 );
+        }
+
+//  Not when the last two are the same type; that's the iterator version
+    template <typename Policy, typename Range, typename ForwardIterator, typename BinaryPredicate>
+    typename boost::enable_if_c<execution::is_execution_policy<Policy>::value && !boost::is_same<Range, ForwardIterator>::value, bool>::type
+    is_permutation ( const Policy &policy, const Range &r, ForwardIterator first2, BinaryPredicate p ) {
+        return boost::algorithm::is_permutation ( policy, boost::begin ( r ), boost::end ( r ), first2, p );
+        }
+
+
+//  is_ordered, and is_increasing and friends
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Iter, typename Pred>
+    Iter is_ordered ( const Policy &policy, Iter first, Iter last, Pred p, boost::true_type ) {
+        if ( first == last )
+            return last;
+        const std::size_t n = last - first - 1;     // the number of adjacent pairs
+        const std::size_t i = parallel_find ( policy, n, parallel_unordered_test<Iter, Pred> ( first, p ));
+        return i == n ? last : first + i + 1;
+        }
+
+    template <typename Policy, typename Iter, typename Pred>
+    Iter is_ordered ( const Policy &, Iter first, Iter last, Pred p, boost::false_type ) {
+        return boost::algorithm::is_ordered ( first, last, p );
+        }
+}
+/// \endcond
+
+/// \fn is_ordered ( const Policy &policy, ForwardIterator first, ForwardIterator last, Pred p )
+/// \return the point in the sequence [first, last) where the elements are unordered
+///     (according to the comparison predicate 'p').
+    template <typename Policy, typename ForwardIterator, typename Pred>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, ForwardIterator>::type
+    is_ordered ( const Policy &policy, ForwardIterator first, ForwardIterator last, Pred p ) {
+        return detail::is_ordered ( policy, first, last, p, detail::runs_parallel<Policy, ForwardIterator> ());
+        }
+
+    template <typename Policy, typename R, typename Pred>
+    typename boost::lazy_enable_if<execution::is_execution_policy<Policy>, boost::range_iterator<const R> >::type
+    is_ordered ( const Policy &policy, const R &range, Pred p ) {
+        return boost::algorithm::is_ordered ( policy, boost::begin ( range ), boost::end ( range ), p );
+        }
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Iter, template <typename> class Compare>
+    struct ordered_by {
+        typedef Compare<typename std::iterator_traits<Iter>::value_type> type;
+        };
+}
+/// \endcond
+
+    template <typename Policy, typename ForwardIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_increasing ( const Policy &policy, ForwardIterator first, ForwardIterator last ) {
+        typedef typename detail::ordered_by<ForwardIterator, std::less_equal>::type pred;
+        return boost::algorithm::is_ordered ( policy, first, last, pred ()) == last;
+        }
+
+    template <typename Policy, typename R>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_increasing ( const Policy &policy, const R &range ) {
+        return boost::algorithm::is_increasing ( policy, boost::begin ( range ), boost::end ( range ));
+        }
+
+    template <typename Policy, typename ForwardIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_decreasing ( const Policy &policy, ForwardIterator first, ForwardIterator last ) {
+        typedef typename detail::ordered_by<ForwardIterator, std::greater_equal>::type pred;
+        return boost::algorithm::is_ordered ( policy, first, last, pred ()) == last;
+        }
+
+    template <typename Policy, typename R>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_decreasing ( const Policy &policy, const R &range ) {
+        return boost::algorithm::is_decreasing ( policy, boost::begin ( range ), boost::end ( range ));
+        }
+
+    template <typename Policy, typename ForwardIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_strictly_increasing ( const Policy &policy, ForwardIterator first, ForwardIterator last ) {
+        typedef typename detail::ordered_by<ForwardIterator, std::less>::type pred;
+        return boost::algorithm::is_ordered ( policy, first, last, pred ()) == last;
+        }
+
+    template <typename Policy, typename R>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_strictly_increasing ( const Policy &policy, const R &range ) {
+        return boost::algorithm::is_strictly_increasing ( policy, boost::begin ( range ), boost::end ( range ));
+        }
+
+    template <typename Policy, typename ForwardIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_strictly_decreasing ( const Policy &policy, ForwardIterator first, ForwardIterator last ) {
+        typedef typename detail::ordered_by<ForwardIterator, std::greater>::type pred;
+        return boost::algorithm::is_ordered ( policy, first, last, pred ()) == last;
+        }
+
+    template <typename Policy, typename R>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, bool>::type
+    is_strictly_decreasing ( const Policy &policy, const R &range ) {
+        return boost::algorithm::is_strictly_decreasing ( policy, boost::begin ( range ), boost::end ( range ));
+        }
+
+
+//  minmax_element
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Iter, typename Compare>
+    std::pair<Iter, Iter> minmax_element ( const Policy &policy, Iter first, Iter last, Compare comp, boost::true_type ) {
+        const std::size_t n = last - first;
+        const parallel_plan plan = make_parallel_plan ( policy, n );
+        std::vector<std::pair<Iter, Iter> > r ( plan.chunks, std::make_pair ( last, last ));
+        parallel_run ( plan, n, parallel_minmax_body<Iter, Compare> ( first, comp, r ));
+
+    //  The first of the smallest, and the last of the largest, as the sequential version does
+        std::pair<Iter, Iter> retVal = r [ 0 ];
+        for ( std::size_t c = 1; c < r.size (); ++c ) {
+            if (  comp ( *r [ c ].first,  *retVal.first  )) retVal.first  = r [ c ].first;
+            if ( !comp ( *r [ c ].second, *retVal.second )) retVal.second = r [ c ].second;
+            }
+        return retVal;
+        }
+
+    template <typename Policy, typename Iter, typename Compare>
+    std::pair<Iter, Iter> minmax_element ( const Policy &, Iter first, Iter last, Compare comp, boost::false_type ) {
+        return boost::algorithm::minmax_element ( first, last, comp );
+        }
+}
+/// \endcond
+
+/// \fn minmax_element ( const Policy &policy, ForwardIterator first, ForwardIterator last, Compare comp )
+/// \brief Returns a pair of iterators denoting the minimum and maximum values of a sequence.
+    template <typename Policy, typename ForwardIterator, typename Compare>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, std::pair<ForwardIterator, ForwardIterator> >::type
+    minmax_element ( const Policy &policy, ForwardIterator first, ForwardIterator last, Compare comp ) {
+        return detail::minmax_element ( policy, first, last, comp, detail::runs_parallel<Policy, ForwardIterator> ());
+        }
+
+    template <typename Policy, typename ForwardIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, std::pair<ForwardIterator, ForwardIterator> >::type
+    minmax_element ( const Policy &policy, ForwardIterator first, ForwardIterator last ) {
+        return boost::algorithm::minmax_element ( policy, first, last,
+                    std::less<typename std::iterator_traits<ForwardIterator>::value_type> ());
+        }
+
+    template <typename Policy, typename Range>
+    typename boost::lazy_enable_if<execution::is_execution_policy<Policy>, detail::range_pair<Range> >::type
+    minmax_element ( const Policy &policy, Range &r ) {
+        return boost::algorithm::minmax_element ( policy, boost::begin ( r ), boost::end ( r ));
+        }
+
+//  Not when the last two are the same type; that's the iterator version
+    template <typename Policy, typename Range, typename Compare>
+    typename boost::lazy_enable_if_c<execution::is_execution_policy<Policy>::value && !boost::is_same<Range, Compare>::value,
+                                     detail::range_pair<Range> >::type
+    minmax_element ( const Policy &policy, Range &r, Compare comp ) {
+        return boost::algorithm::minmax_element ( policy, boost::begin ( r ), boost::end ( r ), comp );
+        }
+
+
+//  iota
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Iter, typename T>
+    void iota ( const Policy &policy, Iter first, Iter last, T value, boost::true_type ) {
+        const std::size_t n = last - first;
+        parallel_run ( make_parallel_plan ( policy, n ), n, parallel_iota_body<Iter, T> ( first, value ));
+        }
+
+    template <typename Policy, typename Iter, typename T>
+    void iota ( const Policy &, Iter first, Iter last, T value, boost::false_type ) {
+        boost::algorithm::iota ( first, last, value );
+        }
+}
+/// \endcond
+
+/// \fn iota ( const Policy &policy, ForwardIterator first, ForwardIterator last, T value )
+/// \brief Generates an increasing sequence of values, and stores them in [first, last).
+///     Only arithmetic types are done in parallel, since each piece starts at value + lo.
+    template <typename Policy, typename ForwardIterator, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy> >::type
+    iota ( const Policy &policy, ForwardIterator first, ForwardIterator last, T value ) {
+        detail::iota ( policy, first, last, value, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, ForwardIterator>::value && boost::is_arithmetic<T>::value> ());
+        }
+
+    template <typename Policy, typename Range, typename T>
+    typename boost::enable_if<execution::is_execution_policy<Policy> >::type
+    iota ( const Policy &policy, Range &r, T value ) {
+        boost::algorithm::iota ( policy, boost::begin ( r ), boost::end ( r ), value );
+        }
+
+
+//  hex
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    OutputIterator hex ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out, boost::true_type ) {
+        typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+        const std::size_t n = last - first;
+        parallel_run ( make_parallel_plan ( policy, n ), n, parallel_hex_body<InputIterator, OutputIterator> ( first, out ));
+        return out + n * 2 * sizeof ( value_type );
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    OutputIterator hex ( const Policy &, InputIterator first, InputIterator last, OutputIterator out, boost::false_type ) {
+        return boost::algorithm::hex ( first, last, out );
+        }
+}
+/// \endcond
+
+/// \fn hex ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out )
+/// \brief Converts a sequence of integral types into a hexadecimal sequence of characters.
+///     Done in parallel when both the input and the output are random access.
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    typename boost::enable_if_c<execution::is_execution_policy<Policy>::value &&
+            boost::is_integral<typename detail::hex_iterator_traits<InputIterator>::value_type>::value, OutputIterator>::type
+    hex ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out ) {
+        return detail::hex ( policy, first, last, out, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, InputIterator>::value && detail::runs_parallel<Policy, OutputIterator>::value> ());
+        }
+
+    template <typename Policy, typename Range, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    hex ( const Policy &policy, const Range &r, OutputIterator out ) {
+        return boost::algorithm::hex ( policy, boost::begin ( r ), boost::end ( r ), out );
+        }
+
+
+//  unhex
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    OutputIterator unhex ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out, boost::true_type ) {
+        typedef typename iterator_value_type<OutputIterator>::value_type value_type;
+        const std::size_t width = 2 * sizeof ( value_type );
+        const std::size_t n = static_cast<std::size_t> ( last - first ) / width;    // the values that are all there
+        const parallel_plan plan = make_parallel_plan ( policy, n );
+        if ( plan.exec == NULL )
+            return boost::algorithm::unhex ( first, last, out );
+
+        std::vector<boost::exception_ptr> errors ( plan.chunks );
+        parallel_run ( plan, n, parallel_unhex_body<InputIterator, OutputIterator> ( first, out, width, errors ));
+    //  Pieces are started in order, so every piece before the first that threw was
+    //  done; its exception is the one that the ordinary unhex would throw
+        for ( std::size_t c = 0; c < errors.size (); ++c )
+            if ( errors [ c ] )
+                boost::rethrow_exception ( errors [ c ] );
+    //  Then any characters left over, which aren't enough for a value
+        return boost::algorithm::unhex ( first + n * width, last, out + n );
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    OutputIterator unhex ( const Policy &, InputIterator first, InputIterator last, OutputIterator out, boost::false_type ) {
+        return boost::algorithm::unhex ( first, last, out );
+        }
+}
+/// \endcond
+
+/// \fn unhex ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out )
+/// \brief Converts a sequence of hexadecimal characters into a sequence of integers.
+///     Done in parallel when both the input and the output are random access; the grain
+///     is in decoded values. Bad input throws what the ordinary unhex throws, though
+///     more of the output may have been written by then.
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    unhex ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out ) {
+        return detail::unhex ( policy, first, last, out, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, InputIterator>::value && detail::runs_parallel<Policy, OutputIterator>::value> ());
+        }
+
+    template <typename Policy, typename Range, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    unhex ( const Policy &policy, const Range &r, OutputIterator out ) {
+        return boost::algorithm::unhex ( policy, boost::begin ( r ), boost::end ( r ), out );
+        }
+
+
+//  clamp_range, copy_n
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename InputIterator, typename OutputIterator, typename Pred>
+    OutputIterator clamp_range ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out,
+                typename std::iterator_traits<InputIterator>::value_type lo,
+                typename std::iterator_traits<InputIterator>::value_type hi, Pred p, boost::true_type ) {
+        const std::size_t n = last - first;
+        parallel_run ( make_parallel_plan ( policy, n ), n,
+                    parallel_clamp_body<InputIterator, OutputIterator, Pred> ( first, out, lo, hi, p ));
+        return out + n;
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator, typename Pred>
+    OutputIterator clamp_range ( const Policy &, InputIterator first, InputIterator last, OutputIterator out,
+                typename std::iterator_traits<InputIterator>::value_type lo,
+                typename std::iterator_traits<InputIterator>::value_type hi, Pred p, boost::false_type ) {
+        return boost::algorithm::clamp_range ( first, last, out, lo, hi, p );
+        }
+
+    template <typename Policy, typename InputIterator, typename Size, typename OutputIterator>
+    OutputIterator copy_n ( const Policy &policy, InputIterator first, Size count, OutputIterator out, boost::true_type ) {
+        if ( !( count > 0 ))
+            return out;
+        const std::size_t n = static_cast<std::size_t> ( count );
+        parallel_run ( make_parallel_plan ( policy, n ), n, parallel_copy_body<InputIterator, OutputIterator> ( first, out ));
+        return out + n;
+        }
+
+    template <typename Policy, typename InputIterator, typename Size, typename OutputIterator>
+    OutputIterator copy_n ( const Policy &, InputIterator first, Size count, OutputIterator out, boost::false_type ) {
+        return boost::algorithm::copy_n ( first, count, out );
+        }
+}
+/// \endcond
+
+/// \fn clamp_range ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out,
+///       std::iterator_traits<InputIterator>::value_type lo,
+///       std::iterator_traits<InputIterator>::value_type hi, Pred p )
+/// \brief Clamps the values in [first, last) into [ lo, hi ], using 'p' to compare them, and writes them to 'out'.
+///     Done in parallel when both the input and the output are random access.
+    template <typename Policy, typename InputIterator, typename OutputIterator, typename Pred>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    clamp_range ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out,
+                typename std::iterator_traits<InputIterator>::value_type lo,
+                typename std::iterator_traits<InputIterator>::value_type hi, Pred p ) {
+        return detail::clamp_range ( policy, first, last, out, lo, hi, p, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, InputIterator>::value && detail::runs_parallel<Policy, OutputIterator>::value> ());
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    clamp_range ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out,
+                typename std::iterator_traits<InputIterator>::value_type lo,
+                typename std::iterator_traits<InputIterator>::value_type hi ) {
+        return boost::algorithm::clamp_range ( policy, first, last, out, lo, hi,
+                    std::less<typename std::iterator_traits<InputIterator>::value_type> ());
+        }
+
+/// \fn copy_n ( const Policy &policy, InputIterator first, Size n, OutputIterator out )
+/// \brief Copies the n elements starting at 'first' to the range starting at 'out'.
+///     Done in parallel when both the input and the output are random access.
+    template <typename Policy, typename InputIterator, typename Size, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    copy_n ( const Policy &policy, InputIterator first, Size n, OutputIterator out ) {
+        return detail::copy_n ( policy, first, n, out, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, InputIterator>::value && detail::runs_parallel<Policy, OutputIterator>::value> ());
+        }
+
+
+//  copy_if, partition_copy
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename InputIterator, typename OutputIterator, typename Pred>
+    OutputIterator copy_if ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator out, Pred p, boost::true_type ) {
+        const std::size_t n = last - first;
+        const parallel_plan plan = make_parallel_plan ( policy, n );
+        if ( plan.exec == NULL )
+            return boost::algorithm::copy_if ( first, last, out, p );
+
+        std::vector<unsigned char> marks ( n );
+        std::vector<std::size_t> starts ( plan.chunks );
+        parallel_run ( plan, n, parallel_mark_body<InputIterator, Pred> ( first, p, marks, starts ));
+        const std::size_t total = exclusive_scan ( starts );
+        parallel_run ( plan, n, parallel_copy_marked_body<InputIterator, OutputIterator> ( first, out, marks, starts ));
+        return out + total;
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator, typename Pred>
+    OutputIterator copy_if ( const Policy &, InputIterator first, InputIterator last, OutputIterator out, Pred p, boost::false_type ) {
+        return boost::algorithm::copy_if ( first, last, out, p );
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename Pred>
+    std::pair<OutputIterator1, OutputIterator2>
+    partition_copy ( const Policy &policy, InputIterator first, InputIterator last,
+                     OutputIterator1 out_true, OutputIterator2 out_false, Pred p, boost::true_type ) {
+        const std::size_t n = last - first;
+        const parallel_plan plan = make_parallel_plan ( policy, n );
+        if ( plan.exec == NULL )
+            return boost::algorithm::partition_copy ( first, last, out_true, out_false, p );
+
+        std::vector<unsigned char> marks ( n );
+        std::vector<std::size_t> starts ( plan.chunks );
+        parallel_run ( plan, n, parallel_mark_body<InputIterator, Pred> ( first, p, marks, starts ));
+        const std::size_t total = exclusive_scan ( starts );
+        parallel_run ( plan, n, parallel_partition_marked_body<InputIterator, OutputIterator1, OutputIterator2> (
+                    first, out_true, out_false, marks, starts ));
+        return std::pair<OutputIterator1, OutputIterator2> ( out_true + total, out_false + ( n - total ));
+        }
+
+    template <typename Policy, typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename Pred>
+    std::pair<OutputIterator1, OutputIterator2>
+    partition_copy ( const Policy &, InputIterator first, InputIterator last,
+                     OutputIterator1 out_true, OutputIterator2 out_false, Pred p, boost::false_type ) {
+        return boost::algorithm::partition_copy ( first, last, out_true, out_false, p );
+        }
+}
+/// \endcond
+
+/// \fn copy_if ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator result, Predicate p )
+/// \brief Copies the elements of [first, last) that satisfy the predicate 'p' to 'result', in order.
+///     Done in parallel when both the input and the output are random access. 'p' is called
+///     once for each element, and its answers are kept, a byte for each, between the passes.
+    template <typename Policy, typename InputIterator, typename OutputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    copy_if ( const Policy &policy, InputIterator first, InputIterator last, OutputIterator result, Predicate p ) {
+        return detail::copy_if ( policy, first, last, result, p, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, InputIterator>::value && detail::runs_parallel<Policy, OutputIterator>::value> ());
+        }
+
+    template <typename Policy, typename Range, typename OutputIterator, typename Predicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    copy_if ( const Policy &policy, const Range &r, OutputIterator result, Predicate p ) {
+        return boost::algorithm::copy_if ( policy, boost::begin ( r ), boost::end ( r ), result, p );
+        }
+
+/// \fn partition_copy ( const Policy &policy, InputIterator first, InputIterator last,
+///       OutputIterator1 out_true, OutputIterator2 out_false, UnaryPredicate p )
+/// \brief Copies the elements of [first, last) that satisfy 'p' to 'out_true', and the others to 'out_false', in order.
+///     Done in parallel when the input and both outputs are random access, as copy_if is.
+    template <typename Policy, typename InputIterator, typename OutputIterator1, typename OutputIterator2, typename UnaryPredicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, std::pair<OutputIterator1, OutputIterator2> >::type
+    partition_copy ( const Policy &policy, InputIterator first, InputIterator last,
+                     OutputIterator1 out_true, OutputIterator2 out_false, UnaryPredicate p ) {
+        return detail::partition_copy ( policy, first, last, out_true, out_false, p, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, InputIterator>::value && detail::runs_parallel<Policy, OutputIterator1>::value
+                && detail::runs_parallel<Policy, OutputIterator2>::value> ());
+        }
+
+    template <typename Policy, typename Range, typename OutputIterator1, typename OutputIterator2, typename UnaryPredicate>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, std::pair<OutputIterator1, OutputIterator2> >::type
+    partition_copy ( const Policy &policy, const Range &r, OutputIterator1 out_true, OutputIterator2 out_false, UnaryPredicate p ) {
+        return boost::algorithm::partition_copy ( policy, boost::begin ( r ), boost::end ( r ), out_true, out_false, p );
+        }
+
+
+//  search_each
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Searcher, typename CorporaIter, typename OutputIterator>
+    OutputIterator search_each ( const Policy &policy, const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+                                 OutputIterator out, boost::true_type ) {
+        const std::size_t n = corpora_last - corpora_first;
+        parallel_run ( make_parallel_plan ( policy, n ), n,
+                    parallel_search_each_body<Searcher, CorporaIter, OutputIterator> ( s, corpora_first, out ));
+        return out + n;
+        }
+
+    template <typename Policy, typename Searcher, typename CorporaIter, typename OutputIterator>
+    OutputIterator search_each ( const Policy &, const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+                                 OutputIterator out, boost::false_type ) {
+        return boost::algorithm::search_each ( s, corpora_first, corpora_last, out );
+        }
+}
+/// \endcond
+
+/// \fn search_each ( const Policy &policy, const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last, OutputIterator out )
+/// \brief Searches each of the corpora for the searcher's pattern; the grain is in corpora.
+///     Done in parallel when both the corpora and the output are random access.
+    template <typename Policy, typename Searcher, typename CorporaIter, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    search_each ( const Policy &policy, const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last, OutputIterator out ) {
+        return detail::search_each ( policy, s, corpora_first, corpora_last, out, boost::integral_constant<bool,
+                detail::runs_parallel<Policy, CorporaIter>::value && detail::runs_parallel<Policy, OutputIterator>::value> ());
+        }
+
+    template <typename Policy, typename Searcher, typename CorporaRange, typename OutputIterator>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, OutputIterator>::type
+    search_each ( const Policy &policy, const Searcher &s, const CorporaRange &corpora, OutputIterator out ) {
+        return boost::algorithm::search_each ( policy, s, boost::begin ( corpora ), boost::end ( corpora ), out );
+        }
+
+
+//  parallel_search, and the searches that take a policy
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    template <typename Policy, typename Searcher, typename corpusIter>
+    corpusIter parallel_search ( const Policy &policy, const Searcher &s, std::size_t m,
+                                 corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) {
+        const std::size_t n = corpus_last - corpus_first;
+        if ( m == 0 || n < m )      // the searcher knows what to do
+            return s ( corpus_first, corpus_last );
+        const std::size_t starts = n - m + 1;
+        const parallel_plan plan = make_parallel_plan ( policy, starts );
+        std::vector<std::size_t> found ( plan.chunks, n );
+        parallel_run ( plan, starts, parallel_search_body<Searcher, corpusIter> ( s, m, corpus_first, corpus_last, found ));
+    //  As in parallel_find: every piece before the first hit was searched
+        for ( std::size_t c = 0; c < found.size (); ++c )
+            if ( found [ c ] != n )
+                return corpus_first + found [ c ];
+        return corpus_last;
+        }
+
+    template <typename Policy, typename Searcher, typename corpusIter>
+    corpusIter parallel_search ( const Policy &, const Searcher &s, std::size_t,
+                                 corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) {
+        return s ( corpus_first, corpus_last );
+        }
+}
+/// \endcond
+
+/// \fn parallel_search ( const Policy &policy, const Searcher &s, std::size_t pattern_length, corpusIter corpus_first, corpusIter corpus_last )
+/// \brief Searches one corpus for the searcher's pattern, in pieces, on several threads if the policy allows it.
+///     The grain is in places where a match could start.
+///
+/// \param policy          How to run the pieces (see execution.hpp)
+/// \param s               The searcher; its operator () is called from several threads at once
+/// \param pattern_length  The length of the searcher's pattern
+/// \param corpus_first    The start of the data to search (Random Access Iterator)
+/// \param corpus_last     One past the end of the data to search
+/// \return                The first match, as the searcher would find it, or corpus_last
+///
+    template <typename Policy, typename Searcher, typename corpusIter>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, corpusIter>::type
+    parallel_search ( const Policy &policy, const Searcher &s, std::size_t pattern_length,
+                      corpusIter corpus_first, corpusIter corpus_last ) {
+        return detail::parallel_search ( policy, s, pattern_length, corpus_first, corpus_last,
+                                         detail::runs_parallel<Policy, corpusIter> ());
+        }
+
+/// \fn boyer_moore_search ( const Policy &policy, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, with boyer_moore and parallel_search
+    template <typename Policy, typename corpusIter, typename patIter>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, corpusIter>::type
+    boyer_moore_search ( const Policy &policy, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last ) {
+        const boyer_moore<patIter> s ( pat_first, pat_last );
+        return boost::algorithm::parallel_search ( policy, s, std::distance ( pat_first, pat_last ), corpus_first, corpus_last );
+        }
+
+/// \fn boyer_moore_horspool_search ( const Policy &policy, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, with boyer_moore_horspool and parallel_search
+    template <typename Policy, typename corpusIter, typename patIter>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, corpusIter>::type
+    boyer_moore_horspool_search ( const Policy &policy, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last ) {
+        const boyer_moore_horspool<patIter> s ( pat_first, pat_last );
+        return boost::algorithm::parallel_search ( policy, s, std::distance ( pat_first, pat_last ), corpus_first, corpus_last );
+        }
+
+/// \fn knuth_morris_pratt_search ( const Policy &policy, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, with knuth_morris_pratt and parallel_search
+    template <typename Policy, typename corpusIter, typename patIter>
+    typename boost::enable_if<execution::is_execution_policy<Policy>, corpusIter>::type
+    knuth_morris_pratt_search ( const Policy &policy, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last ) {
+        const knuth_morris_pratt<patIter> s ( pat_first, pat_last );
+        return boost::algorithm::parallel_search ( policy, s, std::distance ( pat_first, pat_last ), corpus_first, corpus_last );
+        }
+
+//  calibrate_parallel_min_grain
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+//  The least wall-clock time of a call to f, over three runs of at least 'seconds' each.
+//  (calibration_time counts processor time, which adds up the time of all the threads.)
+    template <typename F>
+    double calibration_wall_time ( F f, double seconds ) {
+        typedef boost::posix_time::microsec_clock clock;
+        double best = 0;
+        for ( int run = 0; run < 3; ++run ) {
+            std::size_t calls = 0;
+            const boost::posix_time::ptime start = clock::universal_time ();
+            double elapsed;
+            do {
+                f ();
+                ++calls;
+                elapsed = ( clock::universal_time () - start ).total_microseconds () / 1e6;
+                } while ( elapsed < seconds );
+            const double t = elapsed / calls;
+            if ( run == 0 || t < best )
+                best = t;
+            }
+        return best;
+        }
+
+    template <typename Policy>
+    struct calibration_scan {
+        calibration_scan ( const Policy &policy, const std::string &text, std::size_t n, volatile std::size_t &sink )
+            : policy_ ( policy ), text_ ( text ), n_ ( n ), sink_ ( sink ) {}
+        void operator () () const {
+            sink_ = sink_ + boost::algorithm::none_of_equal ( policy_, text_.begin (), text_.begin () + n_, '#' );
+            }
+        Policy policy_;
+        const std::string &text_;
+        std::size_t n_;
+        volatile std::size_t &sink_;
+        };
+}
+/// \endcond
+
+/// \fn calibrate_parallel_min_grain ( double seconds, executor *e )
+/// \brief Measures, on this machine, the size of input below which the parallel
+///     algorithms are better done on the calling thread
+///
+/// \param seconds  The least wall-clock time for each run of each timing
+/// \param e        The executor to measure (default_executor () if NULL)
+/// \return         A value for search_tuning::parallel_min_grain; current_search_tuning () is not changed
+///
+    inline std::size_t calibrate_parallel_min_grain ( double seconds = 0.002, executor *e = NULL ) {
+        executor &exec = e != NULL ? *e : default_executor ();
+        volatile std::size_t sink = 0;
+
+    //  none_of_equal, on the calling thread against split four ways for each
+    //  thread, over text that doesn't have the value in it
+        const std::string text = detail::calibration_text ( 1024 * 1024, 4 );
+        std::vector<std::size_t> sizes;
+        std::vector<double> small, large;
+        for ( std::size_t n = 256; n <= text.size (); n *= 4 ) {
+            const std::size_t pieces = 4 * ( exec.concurrency () + 1 );
+            const execution::parallel_policy par = execution::par.on ( exec ).with_grain ( ( n + pieces - 1 ) / pieces );
+            sizes.push_back ( n );
+            small.push_back ( detail::calibration_wall_time (
+                        detail::calibration_scan<execution::sequenced_policy> ( execution::seq, text, n, sink ), seconds ));
+            large.push_back ( detail::calibration_wall_time (
+                        detail::calibration_scan<execution::parallel_policy> ( par, text, n, sink ), seconds ));
+            }
+        return (std::max) ( sizes.front (), detail::calibration_threshold ( sizes, small, large ));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_PARALLEL_HPP
@@ -0,0 +1,218 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  perf_counters.hpp
+/// \brief Hardware event counts (cycles, instructions, misses) around a piece of code, for the benchmarks.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_PERF_COUNTERS_HPP
+#define BOOST_ALGORITHM_PERF_COUNTERS_HPP
+
+#include <ctime>        // for std::clock
+#include <cstring>      // for std::memset
+#include <iostream>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+/*
+    Hardware event counts.
+
+    A benchmark that only measures time says that one algorithm is slower
+    than another, but not why. perf_counters also counts, for the code between
+    start () and stop ():
+
+        cycles          processor cycles
+        instructions    instructions retired (instructions / cycles is the IPC)
+        branch_misses   mispredicted branches
+        l1d_misses      reads that missed the level 1 data cache
+        llc_misses      references that missed the last level cache
+
+    On Linux, the counts come from perf_event_open (2), counting this thread
+    in user space only (so /proc/sys/kernel/perf_event_paranoid may be as high
+    as 2). Each event is opened on its own; an event that the processor or the
+    kernel doesn't offer, or that isn't allowed (in a container, in a virtual
+    machine, or without permission) is marked as not valid, and the others
+    still work. If the kernel had to share the counters between events, the
+    counts are scaled up by the time each was actually counting.
+
+    Elsewhere, or with BOOST_ALGORITHM_NO_PERF_COUNTERS defined, no event is
+    valid, and only the std::clock ticks are measured. Either way, the
+    benchmark runs, and prints "n/a" for what it couldn't count.
+*/
+
+#if defined ( __linux__ ) && !defined ( BOOST_ALGORITHM_NO_PERF_COUNTERS )
+#define BOOST_ALGORITHM_HAS_PERF_COUNTERS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace boost { namespace algorithm {
+
+/*!
+    \struct perf_sample
+    \brief What was measured between a perf_counters' start () and stop ()
+*/
+    struct perf_sample {
+        enum event { cycles, instructions, branch_misses, l1d_misses, llc_misses, num_events };
+
+        perf_sample () : ticks ( 0 ) {
+            for ( int i = 0; i < num_events; ++i ) {
+                counts [ i ] = 0;
+                valid  [ i ] = false;
+                }
+            }
+
+        std::clock_t ticks;                     // always measured
+        boost::uint64_t counts [ num_events ];  // only meaningful where 'valid' is true
+        bool valid [ num_events ];
+
+        /// \brief Instructions per cycle, or 0 if either wasn't counted
+        double ipc () const {
+            return valid [ cycles ] && valid [ instructions ] && counts [ cycles ] != 0
+                ? static_cast<double> ( counts [ instructions ] ) / counts [ cycles ] : 0.0;
+            }
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+    inline const char *perf_event_names ( int i ) {
+        static const char *names [] = { "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses" };
+        return names [ i ];
+        }
+
+#if defined ( BOOST_ALGORITHM_HAS_PERF_COUNTERS )
+//  A disabled counter for 'type'/'config' on this thread, user space only; -1 if it can't be had
+    inline int open_perf_event ( boost::uint32_t type, boost::uint64_t config ) {
+        struct perf_event_attr attr;
+        std::memset ( &attr, 0, sizeof ( attr ));
+        attr.size           = sizeof ( attr );
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int> ( ::syscall ( __NR_perf_event_open, &attr, 0, -1, -1, 0 ));
+        }
+#endif
+}
+/// \endcond
+
+/*!
+    \class perf_counters
+    \brief Counts hardware events for the code between start () and stop ().
+        Not thread-safe; the counts are for the thread that constructed it.
+*/
+    class perf_counters : boost::noncopyable {
+    public:
+        perf_counters () : running_ ( false ), start_ ( 0 ) {
+            for ( int i = 0; i < perf_sample::num_events; ++i )
+                fd_ [ i ] = -1;
+#if defined ( BOOST_ALGORITHM_HAS_PERF_COUNTERS )
+            const boost::uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D
+                | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+            fd_ [ perf_sample::cycles ]        = detail::open_perf_event ( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES );
+            fd_ [ perf_sample::instructions ]  = detail::open_perf_event ( PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS );
+            fd_ [ perf_sample::branch_misses ] = detail::open_perf_event ( PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES );
+            fd_ [ perf_sample::l1d_misses ]    = detail::open_perf_event ( PERF_TYPE_HW_CACHE, l1d_read_miss );
+            fd_ [ perf_sample::llc_misses ]    = detail::open_perf_event ( PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES );
+#endif
+            }
+
+        ~perf_counters () {
+#if defined ( BOOST_ALGORITHM_HAS_PERF_COUNTERS )
+            for ( int i = 0; i < perf_sample::num_events; ++i )
+                if ( fd_ [ i ] >= 0 )
+                    ::close ( fd_ [ i ] );
+#endif
+            }
+
+        /// \brief Whether the event could be opened
+        bool available ( perf_sample::event e ) const { return fd_ [ e ] >= 0; }
+
+        /// \brief Whether any hardware event could be opened
+        bool available () const {
+            for ( int i = 0; i < perf_sample::num_events; ++i )
+                if ( fd_ [ i ] >= 0 )
+                    return true;
+            return false;
+            }
+
+        /// \brief Zero the counts, and start counting
+        void start () {
+#if defined ( BOOST_ALGORITHM_HAS_PERF_COUNTERS )
+            for ( int i = 0; i < perf_sample::num_events; ++i )
+                if ( fd_ [ i ] >= 0 ) {
+                    ::ioctl ( fd_ [ i ], PERF_EVENT_IOC_RESET, 0 );
+                    ::ioctl ( fd_ [ i ], PERF_EVENT_IOC_ENABLE, 0 );
+                    }
+#endif
+            running_ = true;
+            start_ = std::clock ();
+            }
+
+        /// \brief Stop counting, and return what was counted since start ()
+        perf_sample stop () {
+            perf_sample retVal;
+            retVal.ticks = std::clock () - start_;
+#if defined ( BOOST_ALGORITHM_HAS_PERF_COUNTERS )
+            for ( int i = 0; i < perf_sample::num_events; ++i )
+                if ( fd_ [ i ] >= 0 )
+                    ::ioctl ( fd_ [ i ], PERF_EVENT_IOC_DISABLE, 0 );
+
+        //  { value, time enabled, time running }
+            for ( int i = 0; i < perf_sample::num_events; ++i ) {
+                boost::uint64_t buf [ 3 ];
+                if ( !running_ || fd_ [ i ] < 0 || ::read ( fd_ [ i ], buf, sizeof ( buf )) != sizeof ( buf ) || buf [ 2 ] == 0 )
+                    continue;
+                retVal.counts [ i ] = buf [ 2 ] == buf [ 1 ] ? buf [ 0 ]
+                    : static_cast<boost::uint64_t> ( static_cast<double> ( buf [ 0 ] ) * buf [ 1 ] / buf [ 2 ] );
+                retVal.valid  [ i ] = true;
+                }
+#endif
+            running_ = false;
+            return retVal;
+            }
+
+    private:
+        int fd_ [ perf_sample::num_events ];
+        bool running_;
+        std::clock_t start_;
+        };
+
+/// \fn print_perf_sample ( std::ostream &out, const perf_sample &s )
+/// \brief Writes the event counts on one line, with "n/a" for the ones that weren't counted
+///     (the ticks are left to the caller, which usually compares them with something)
+    inline std::ostream &print_perf_sample ( std::ostream &out, const perf_sample &s ) {
+        bool any = false;
+        for ( int i = 0; i < perf_sample::num_events; ++i )
+            any = any || s.valid [ i ];
+        if ( !any )
+            return out << "(hardware counters n/a)";
+
+        for ( int i = 0; i < perf_sample::num_events; ++i ) {
+            out << detail::perf_event_names ( i ) << ' ';
+            if ( s.valid [ i ] )
+                out << s.counts [ i ];
+            else
+                out << "n/a";
+            out << ( i + 1 < perf_sample::num_events ? "  " : "" );
+            if ( i == perf_sample::instructions && s.ipc () != 0.0 )
+                out << "(IPC " << s.ipc () << ")  ";
+            }
+        return out;
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_PERF_COUNTERS_HPP
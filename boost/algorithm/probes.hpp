@@ -0,0 +1,130 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  probes.hpp
+/// \brief Static trace points (USDT) in the searchers and the hex codecs.
+/// \author Marshall Clow
+
+#ifndef BOOST_ALGORITHM_PROBES_HPP
+#define BOOST_ALGORITHM_PROBES_HPP
+
+#include <cstddef>      // for std::ptrdiff_t
+#include <iterator>     // for std::distance
+
+/*
+    Static trace points.
+
+    The searchers and hex/unhex have trace points, so that slow searches can
+    be looked at in a running program, with no debug build. With
+    BOOST_ALGORITHM_USDT defined, each one is a systemtap-style (USDT) probe,
+    from <sys/sdt.h>, in the provider "boost_algorithm". A probe is a single
+    NOP until a tracer (bpftrace, perf, systemtap) attaches to it; its
+    arguments are evaluated, but they are cheap. Without BOOST_ALGORITHM_USDT,
+    the trace points are nothing at all.
+
+    The probes, and their arguments:
+
+        searcher_create     kind, pattern length
+        search_begin        kind, corpus length, pattern length
+        search_end          kind, corpus length, pattern length, offset of the match (-1 if none)
+        hex_encode_begin
+        hex_encode_end      elements encoded
+        hex_decode_begin
+        hex_decode_end      elements decoded (-1 if the input was malformed,
+                            and an exception is on its way out)
+
+    'kind' is the name of the searcher ("boyer_moore", "knuth_morris_pratt", ...),
+    as a C string. For example, a histogram of search times by searcher:
+
+        bpftrace -e '
+            usdt:./prog:boost_algorithm:search_begin { @start [ tid, str ( arg0 ) ] = nsecs; }
+            usdt:./prog:boost_algorithm:search_end /@start [ tid, str ( arg0 ) ]/ {
+                @ns [ str ( arg0 ) ] = hist ( nsecs - @start [ tid, str ( arg0 ) ] );
+                delete ( @start [ tid, str ( arg0 ) ] ); }'
+
+    Every searcher, and the two indexes, have the three searcher probes. Where
+    a searcher isn't one pattern found once, the arguments mean:
+
+        multi_literal_searcher, rabin_karp_set
+                            'pattern length' is the number of patterns
+        baker_bird_searcher 'pattern length' and 'corpus length' are the
+                            number of elements (width times height)
+        suffix_array, fm_index
+                            searcher_create gives the length of the corpus;
+                            a query (operator (), count, locate) is a search
+                            of the whole corpus; equal_range, which they
+                            call, has no probes of its own
+        calls that report every match (the ones that take an output iterator,
+        count and locate)
+                            search_end's last argument is the number of matches
+
+    utf8_searcher and utf8_icase_searcher call another searcher, whose probes
+    fire inside theirs; so begins and ends nest, and a tracer should pair them
+    by kind as well as by thread, as above. baker_bird_searcher builds a
+    knuth_morris_pratt over the pattern's rows, whose searcher_create comes
+    just before its own.
+
+    A program can send the trace points somewhere else instead, by defining
+    all of BOOST_ALGORITHM_PROBE0 ... BOOST_ALGORITHM_PROBE4 ( name, args... )
+    before including any of the library's headers.
+*/
+
+#if !defined ( BOOST_ALGORITHM_PROBE0 )
+#if defined ( BOOST_ALGORITHM_USDT )
+#include <sys/sdt.h>
+#define BOOST_ALGORITHM_PROBE0(name)                 DTRACE_PROBE  ( boost_algorithm, name )
+#define BOOST_ALGORITHM_PROBE1(name, a1)             DTRACE_PROBE1 ( boost_algorithm, name, a1 )
+#define BOOST_ALGORITHM_PROBE2(name, a1, a2)         DTRACE_PROBE2 ( boost_algorithm, name, a1, a2 )
+#define BOOST_ALGORITHM_PROBE3(name, a1, a2, a3)     DTRACE_PROBE3 ( boost_algorithm, name, a1, a2, a3 )
+#define BOOST_ALGORITHM_PROBE4(name, a1, a2, a3, a4) DTRACE_PROBE4 ( boost_algorithm, name, a1, a2, a3, a4 )
+#else
+//  sizeof doesn't evaluate its operand; it only keeps 'unused variable' warnings away
+#define BOOST_ALGORITHM_PROBE0(name)                 ((void) 0)
+#define BOOST_ALGORITHM_PROBE1(name, a1)             ((void) sizeof ( a1 ))
+#define BOOST_ALGORITHM_PROBE2(name, a1, a2)         ((void) sizeof ( a1 ), (void) sizeof ( a2 ))
+#define BOOST_ALGORITHM_PROBE3(name, a1, a2, a3)     ((void) sizeof ( a1 ), (void) sizeof ( a2 ), (void) sizeof ( a3 ))
+#define BOOST_ALGORITHM_PROBE4(name, a1, a2, a3, a4) ((void) sizeof ( a1 ), (void) sizeof ( a2 ), (void) sizeof ( a3 ), (void) sizeof ( a4 ))
+#endif
+#endif
+
+namespace boost { namespace algorithm {
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+//  Where 'result' is in [first, last), or -1 if it is 'last'
+    template <typename Iter>
+    std::ptrdiff_t probe_offset ( Iter first, Iter last, Iter result ) {
+        return result == last ? -1 : static_cast<std::ptrdiff_t> ( std::distance ( first, result ));
+        }
+}
+/// \endcond
+
+}}
+
+//  The three trace points that every searcher has
+#define BOOST_ALGORITHM_PROBE_SEARCHER_CREATE(kind, pattern_length) \
+    BOOST_ALGORITHM_PROBE2 ( searcher_create, kind, static_cast<std::ptrdiff_t> ( pattern_length ))
+#define BOOST_ALGORITHM_PROBE_SEARCH_BEGIN(kind, first, last, pattern_length) \
+    BOOST_ALGORITHM_PROBE3 ( search_begin, kind, static_cast<std::ptrdiff_t> ( std::distance ( first, last )), \
+                             static_cast<std::ptrdiff_t> ( pattern_length ))
+#define BOOST_ALGORITHM_PROBE_SEARCH_END(kind, first, last, pattern_length, result) \
+    BOOST_ALGORITHM_PROBE4 ( search_end, kind, static_cast<std::ptrdiff_t> ( std::distance ( first, last )), \
+                             static_cast<std::ptrdiff_t> ( pattern_length ), \
+                             boost::algorithm::detail::probe_offset ( first, last, result ))
+
+//  The same, given lengths rather than iterators; 'result' is the offset of the
+//  match (-1 if none), or the number of matches
+#define BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N(kind, corpus_length, pattern_length) \
+    BOOST_ALGORITHM_PROBE3 ( search_begin, kind, static_cast<std::ptrdiff_t> ( corpus_length ), \
+                             static_cast<std::ptrdiff_t> ( pattern_length ))
+#define BOOST_ALGORITHM_PROBE_SEARCH_END_N(kind, corpus_length, pattern_length, result) \
+    BOOST_ALGORITHM_PROBE4 ( search_end, kind, static_cast<std::ptrdiff_t> ( corpus_length ), \
+                             static_cast<std::ptrdiff_t> ( pattern_length ), static_cast<std::ptrdiff_t> ( result ))
+
+#endif  //  BOOST_ALGORITHM_PROBES_HPP
@@ -0,0 +1,236 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BAKER_BIRD_HPP
+#define BOOST_ALGORITHM_BAKER_BIRD_HPP
+
+#include <algorithm>    // for std::lower_bound
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <deque>
+#include <stdexcept>    // for std::invalid_argument
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Two-dimensional searching: the Baker-Bird algorithm.
+
+    Finds every place where a rectangular pattern occurs in a rectangular
+    text, both given as strided views: a pointer to the first element, a
+    width and a height, and a stride (the distance from the start of one row
+    to the start of the next, in elements). Nothing is copied, so a view can
+    be a block of a larger array, or a frame in a video buffer.
+
+    Each distinct row of the pattern gets a number, and an Aho-Corasick
+    automaton is built over the distinct rows. Each row of the text is run
+    through the automaton, which says, for every column, which pattern row
+    (if any) ends there. Every column of the text then has a search under
+    way with knuth_morris_pratt, looking for the pattern's sequence of row
+    numbers, fed one text row at a time. When one of those finds a match,
+    the whole pattern is there.
+
+    The time is linear in the size of the text (times a log of the number of
+    different elements in the pattern, to follow the automaton's edges), and
+    the extra space is one counter per column.
+
+    Matches are reported as ( row, column ) of the top left corner, ordered by
+    row and then by column.
+
+    Requirements:
+        * T must be copyable, and have operator == and operator <
+*/
+
+    template <typename T>
+    struct strided_view {
+        strided_view ( const T *d, std::size_t w, std::size_t h )
+            : data ( d ), width ( w ), height ( h ), stride ( w ) {}
+        strided_view ( const T *d, std::size_t w, std::size_t h, std::size_t s )
+            : data ( d ), width ( w ), height ( h ), stride ( s ) {}
+
+        const T *row ( std::size_t r ) const { return data + r * stride; }
+        const T &operator () ( std::size_t r, std::size_t c ) const { return data [ r * stride + c ]; }
+
+        const T *data;
+        std::size_t width, height;
+        std::size_t stride;     // in elements
+        };
+
+    template <typename T>
+    class baker_bird_searcher {
+        typedef std::vector<int>::const_iterator id_iterator;
+    public:
+        typedef std::pair<std::size_t, std::size_t> position;    // row, column
+
+        /// \brief Build a searcher for 'pattern', which must not be empty.
+        ///     The pattern's elements are copied; the view need not outlive the searcher.
+        explicit baker_bird_searcher ( const strided_view<T> &pattern )
+                : k_width ( pattern.width ), k_height ( pattern.height ),
+                  ids_ ( add_rows ( pattern )), columns_ ( ids_->begin (), ids_->end ()) {
+            build_failure_links ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "baker_bird_searcher", k_width * k_height );
+            }
+
+        ~baker_bird_searcher () {}
+
+        std::size_t pattern_width  () const { return k_width; }
+        std::size_t pattern_height () const { return k_height; }
+
+        /// \fn operator () ( const strided_view<T> &text, OutputIterator out )
+        /// \brief Finds every occurrence of the pattern in 'text'
+        ///
+        /// \param text     The array to search
+        /// \param out      Where to write the position of each match
+        /// \return         The output iterator, after the last match
+        ///
+        template <typename OutputIterator>
+        OutputIterator operator () ( const strided_view<T> &text, OutputIterator out ) const {
+            std::size_t matches = 0;
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "baker_bird_searcher", text.width * text.height, k_width * k_height );
+            out = this->find ( text, out, matches );
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "baker_bird_searcher", text.width * text.height, k_width * k_height, matches );
+            return out;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+    //  The search itself; operator () adds the trace points
+        template <typename OutputIterator>
+        OutputIterator find ( const strided_view<T> &text, OutputIterator out, std::size_t &matches ) const {
+            if ( text.width < k_width || text.height < k_height )
+                return out;
+
+            std::vector<std::ptrdiff_t> matched ( text.width, 0 );
+            const std::ptrdiff_t h = static_cast<std::ptrdiff_t> ( k_height );
+            for ( std::size_t r = 0; r < text.height; ++r ) {
+                const T *row = text.row ( r );
+                std::size_t node = 0;
+                for ( std::size_t c = 0; c < text.width; ++c ) {
+                    node = next ( node, row [ c ] );
+                    const int id = nodes_ [ node ].id;
+                    if ( id < 0 )
+                        matched [ c ] = 0;
+                    else if (( matched [ c ] = columns_.step ( matched [ c ], id )) == h ) {
+                        *out++ = position ( r + 1 - k_height, c + 1 - k_width );
+                        ++matches;
+                        }
+                    }
+                }
+            return out;
+            }
+
+        struct node {
+            node () : failure ( 0 ), id ( -1 ) {}
+            std::vector<std::pair<T, std::size_t> > edges;    // sorted by element
+            std::size_t failure;
+            int id;     // the row that ends here, or -1
+            };
+
+        struct edge_less {
+            bool operator () ( const std::pair<T, std::size_t> &e, const T &t ) const { return e.first < t; }
+            };
+
+        const std::size_t k_width, k_height;
+        std::vector<node> nodes_;   // built before ids_, so add_rows can use it
+        boost::shared_ptr<const std::vector<int> > ids_;    // shared, so that copies can share columns_
+        knuth_morris_pratt<id_iterator> columns_;
+
+        //  The child of 'n' for 't', or 0 if there isn't one
+        std::size_t child ( std::size_t n, const T &t ) const {
+            const std::vector<std::pair<T, std::size_t> > &e = nodes_ [ n ].edges;
+            typename std::vector<std::pair<T, std::size_t> >::const_iterator it =
+                    std::lower_bound ( e.begin (), e.end (), t, edge_less ());
+            return ( it != e.end () && it->first == t ) ? it->second : 0;
+            }
+
+        std::size_t next ( std::size_t n, const T &t ) const {
+            for ( ;; ) {
+                const std::size_t c = child ( n, t );
+                if ( c != 0 || n == 0 )
+                    return c;
+                n = nodes_ [ n ].failure;
+                }
+            }
+
+        //  Put the rows into the trie, and number them; identical rows share a number
+        boost::shared_ptr<const std::vector<int> > add_rows ( const strided_view<T> &pattern ) {
+            if ( pattern.width == 0 || pattern.height == 0 )
+                BOOST_THROW_EXCEPTION ( std::invalid_argument ( "baker_bird_searcher: the pattern is empty" ));
+
+            boost::shared_ptr<std::vector<int> > ids ( new std::vector<int> );
+            int next_id = 0;
+            nodes_.push_back ( node ());
+            for ( std::size_t r = 0; r < pattern.height; ++r ) {
+                const T *row = pattern.row ( r );
+                std::size_t n = 0;
+                for ( std::size_t c = 0; c < pattern.width; ++c ) {
+                    std::size_t ch = child ( n, row [ c ] );
+                    if ( ch == 0 ) {
+                        ch = nodes_.size ();
+                        nodes_.push_back ( node ());
+                        std::vector<std::pair<T, std::size_t> > &e = nodes_ [ n ].edges;
+                        e.insert ( std::lower_bound ( e.begin (), e.end (), row [ c ], edge_less ()),
+                                    std::make_pair ( row [ c ], ch ));
+                        }
+                    n = ch;
+                    }
+                if ( nodes_ [ n ].id < 0 )
+                    nodes_ [ n ].id = next_id++;
+                ids->push_back ( nodes_ [ n ].id );
+                }
+            return ids;
+            }
+
+        //  Breadth first, so that a node's failure link is set before its children's.
+        //  All the rows are the same length, so a row can only end at its own node,
+        //  and no output links are needed.
+        void build_failure_links () {
+            std::deque<std::size_t> queue;
+            for ( std::size_t i = 0; i < nodes_ [ 0 ].edges.size (); ++i )
+                queue.push_back ( nodes_ [ 0 ].edges [ i ].second );
+            while ( !queue.empty ()) {
+                const std::size_t n = queue.front ();
+                queue.pop_front ();
+                for ( std::size_t i = 0; i < nodes_ [ n ].edges.size (); ++i ) {
+                    const T &t = nodes_ [ n ].edges [ i ].first;
+                    const std::size_t ch = nodes_ [ n ].edges [ i ].second;
+                    std::size_t f = nodes_ [ n ].failure;
+                    while ( f != 0 && child ( f, t ) == 0 )
+                        f = nodes_ [ f ].failure;
+                    nodes_ [ ch ].failure = child ( f, t );
+                    queue.push_back ( ch );
+                    }
+                }
+            }
+/// \endcond
+        };
+
+/// \fn baker_bird_search ( const strided_view<T> &text, const strided_view<T> &pattern, OutputIterator out )
+/// \brief Finds every occurrence of a two-dimensional pattern in a two-dimensional text.
+///
+/// \param text     The array to search
+/// \param pattern  The array to search for
+/// \param out      Where to write the ( row, column ) of the top left corner of each match
+///
+    template <typename T, typename OutputIterator>
+    OutputIterator baker_bird_search (
+            const strided_view<T> &text, const strided_view<T> &pattern, OutputIterator out ) {
+        baker_bird_searcher<T> bb ( pattern );
+        return bb ( text, out );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BAKER_BIRD_HPP
@@ -23,9 +23,12 @@
 
 #include <boost/algorithm/searching/detail/bm_traits.hpp>
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/probes.hpp>
 
 namespace boost { namespace algorithm {
 
+namespace detail { struct compiled_searcher_access; }   // see searcher_table.hpp
+
 /*
     A templated version of the boyer-moore searching algorithm.
     
@@ -64,9 +67,18 @@ Requirements:
             {
             this->build_skip_table   ( first, last );
             this->build_suffix_table ( first, last );
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "boyer_moore", k_pattern_length );
             }
             
         ~boyer_moore () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \brief The pattern that was passed into the constructor
+        typedef patIter pattern_iterator;
+        patIter pattern_begin () const { return pat_first; }
+        patIter pattern_end   () const { return pat_last; }
         
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -76,6 +88,28 @@ Requirements:
         ///
         template <typename corpusIter>
         corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "boyer_moore", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "boyer_moore", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+            
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        friend struct detail::compiled_searcher_access;
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        typename traits::skip_table_t skip_;
+        std::vector <difference_type> suffix_;
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
             BOOST_STATIC_ASSERT (( boost::is_same<
                                     typename std::iterator_traits<patIter>::value_type, 
                                     typename std::iterator_traits<corpusIter>::value_type>::value ));
@@ -91,18 +125,6 @@ Requirements:
         //  Do the search 
             return this->do_search   ( corpus_first, corpus_last );
             }
-            
-        template <typename Range>
-        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
-            return (*this) (boost::begin(r), boost::end(r));
-            }
-
-    private:
-/// \cond DOXYGEN_HIDE
-        patIter pat_first, pat_last;
-        const difference_type k_pattern_length;
-        typename traits::skip_table_t skip_;
-        std::vector <difference_type> suffix_;
 
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
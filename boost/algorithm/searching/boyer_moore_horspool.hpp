@@ -18,11 +18,14 @@
 
 #include <boost/algorithm/searching/detail/bm_traits.hpp>
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/probes.hpp>
 
 // #define  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_DEBUG_HPP
 
 namespace boost { namespace algorithm {
 
+namespace detail { struct compiled_searcher_access; }   // see searcher_table.hpp
+
 /*
     A templated version of the boyer-moore-horspool searching algorithm.
     
@@ -55,9 +58,18 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
 #ifdef BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_DEBUG_HPP
             skip_.PrintSkipTable ();
 #endif
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "boyer_moore_horspool", k_pattern_length );
             }
             
         ~boyer_moore_horspool () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \brief The pattern that was passed into the constructor
+        typedef patIter pattern_iterator;
+        patIter pattern_begin () const { return pat_first; }
+        patIter pattern_end   () const { return pat_last; }
         
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -68,6 +80,22 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
         ///
         template <typename corpusIter>
         corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "boyer_moore_horspool", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "boyer_moore_horspool", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+            
+    private:
+/// \cond DOXYGEN_HIDE
+        friend struct detail::compiled_searcher_access;
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        typename traits::skip_table_t skip_;
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
             BOOST_STATIC_ASSERT (( boost::is_same<
                 typename std::iterator_traits<patIter>::value_type, 
                 typename std::iterator_traits<corpusIter>::value_type>::value ));
@@ -83,12 +111,6 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
         //  Do the search 
             return this->do_search ( corpus_first, corpus_last );
             }
-            
-    private:
-/// \cond DOXYGEN_HIDE
-        patIter pat_first, pat_last;
-        const difference_type k_pattern_length;
-        typename traits::skip_table_t skip_;
 
         /// \fn do_search ( corpusIter corpus_first, corpusIter corpus_last )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
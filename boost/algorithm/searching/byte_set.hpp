@@ -0,0 +1,393 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_BYTE_SET_HPP
+#define BOOST_ALGORITHM_BYTE_SET_HPP
+
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits
+#include <string>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/cpu_dispatch.hpp>
+
+//  Define BOOST_ALGORITHM_NO_SIMD to use only the portable code.
+//  The SSSE3 and AVX2 kernels are built when the compiler targets them, or
+//  can build them alongside the SSE2 ones; which one runs is chosen at run
+//  time (see cpu_dispatch.hpp).
+#if !defined ( BOOST_ALGORITHM_NO_SIMD ) && \
+    ( defined ( __SSE2__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && _M_IX86_FP >= 2 ))
+#define BOOST_ALGORITHM_BYTE_SET_SSE2
+#include <emmintrin.h>
+#if defined ( __SSSE3__ ) || defined ( __AVX__ ) || defined ( BOOST_ALGORITHM_MULTIVERSION )
+#define BOOST_ALGORITHM_BYTE_SET_SSSE3
+#include <tmmintrin.h>
+#endif
+#if defined ( __AVX2__ ) || defined ( BOOST_ALGORITHM_MULTIVERSION )
+#define BOOST_ALGORITHM_BYTE_SET_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined ( BOOST_MSVC ) && defined ( BOOST_ALGORITHM_BYTE_SET_SSE2 )
+#include <intrin.h>     // for _BitScanForward
+#endif
+
+namespace boost { namespace algorithm {
+
+/*
+    A searcher for the first element of the corpus that is in a set of byte
+    values; like strpbrk, or std::find_first_of with a fixed set.
+
+    The set is turned into a 256-bit bitmap, which is used to test one element
+    at a time. When the corpus is contiguous (pointers to bytes, or iterators
+    into a std::string or std::vector of bytes) and the processor has SSE2,
+    sixteen bytes are tested at a time:
+
+        * If the set has at most eight members, each one is compared with all
+          sixteen bytes at once.
+        * Otherwise, if the processor has SSSE3, each byte is split
+          into nibbles, which are looked up in two sixteen entry tables with
+          pshufb; the byte is in the set if the two lookups have a bit in common.
+          (The bits stand for groups of high nibbles that share the same low
+          nibbles; if there are more than eight such groups, a second pair of
+          tables is used.)
+        * Otherwise, the bitmap is used.
+
+    With AVX2, both vector methods test thirty-two bytes at a time. The
+    method is chosen at run time, with active_simd_level ().
+
+    Requirements:
+        * The elements of the set and the corpus must be a one-byte integral type.
+        * Forward iterators (the vector code needs contiguous memory)
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Iterators over memory that the vector code can read directly
+    template <typename Iter>
+    struct is_contiguous_byte_iterator {
+        typedef typename std::iterator_traits<Iter>::value_type value_type;
+        static const bool value = sizeof ( value_type ) == 1 && !boost::is_same<value_type, bool>::value && (
+               boost::is_pointer<Iter>::value
+            || boost::is_same<Iter, std::string::iterator>::value
+            || boost::is_same<Iter, std::string::const_iterator>::value
+            || boost::is_same<Iter, typename std::vector<value_type>::iterator>::value
+            || boost::is_same<Iter, typename std::vector<value_type>::const_iterator>::value );
+        };
+
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+    inline unsigned byte_set_first_bit ( unsigned mask ) {
+#if defined ( __GNUC__ )
+        return __builtin_ctz ( mask );
+#elif defined ( BOOST_MSVC )
+        unsigned long retVal;
+        _BitScanForward ( &retVal, mask );
+        return retVal;
+#else
+        unsigned retVal = 0;
+        while (( mask & 1 ) == 0 ) { mask >>= 1; ++retVal; }
+        return retVal;
+#endif
+        }
+#endif
+}
+/// \endcond
+
+    class byte_set_searcher {
+    public:
+        /// \brief Build the searcher for the byte values in [set_first, set_last)
+        template <typename setIter>
+        byte_set_searcher ( setIter set_first, setIter set_last ) {
+            init ( set_first, set_last );
+            }
+
+        /// \brief Build the searcher for the byte values in a range.
+        ///     Note that a string literal is a range that includes its trailing NUL.
+        template <typename Range>
+        explicit byte_set_searcher ( const Range &r ) {
+            init ( boost::begin ( r ), boost::end ( r ));
+            }
+
+        ~byte_set_searcher () {}
+
+        /// \brief Is the byte 'c' in the set?
+        bool contains ( unsigned char c ) const {
+            return (( bits_ [ c >> 6 ] >> ( c & 63 )) & 1 ) != 0;
+            }
+
+        /// \brief The number of distinct values in the set
+        std::size_t size () const { return count_; }
+
+        /// \brief The length of every match
+        std::size_t pattern_length () const { return 1; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Finds the first element of the corpus that is in the set
+        ///
+        /// \param corpus_first The start of the data to search
+        /// \param corpus_last  One past the end of the data to search
+        /// \return An iterator to the element, or corpus_last if there isn't one
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+            return dispatch ( corpus_first, corpus_last, boost::integral_constant<bool,
+                        detail::is_contiguous_byte_iterator<corpusIter>::value> ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+        /// \brief Finds the first byte in [first, last) that is in the set
+        const unsigned char *find ( const unsigned char *first, const unsigned char *last ) const {
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+            if ( count_ == 0 )
+                return last;
+            const simd_level level = active_simd_level ();
+            if ( count_ <= k_max_compare ) {
+#ifdef BOOST_ALGORITHM_BYTE_SET_AVX2
+                if ( level >= simd_avx2 )
+                    first = find_compare_avx2 ( first, last );
+                else
+#endif
+                if ( level >= simd_sse2 )
+                    first = find_compare ( first, last );
+                }
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSSE3
+            else {
+#ifdef BOOST_ALGORITHM_BYTE_SET_AVX2
+                if ( level >= simd_avx2 )
+                    first = find_nibbles_avx2 ( first, last );
+                else
+#endif
+                if ( level >= simd_sse42 )
+                    first = find_nibbles ( first, last );
+                }
+#endif
+#endif
+            return find_scalar ( first, last );
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        enum { k_max_compare = 8 };
+
+        boost::uint64_t bits_ [ 4 ];
+        std::size_t count_;
+        unsigned char members_ [ k_max_compare ];       // when there are only a few
+        unsigned char lo_ [ 2 ][ 16 ], hi_ [ 2 ][ 16 ]; // the nibble tables
+        std::size_t pairs_;                             // how many of them are used
+
+        template <typename setIter>
+        void init ( setIter set_first, setIter set_last ) {
+            typedef typename std::iterator_traits<setIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+
+            bits_ [ 0 ] = bits_ [ 1 ] = bits_ [ 2 ] = bits_ [ 3 ] = 0;
+            for ( ; set_first != set_last; ++set_first ) {
+                const unsigned char c = static_cast<unsigned char> ( *set_first );
+                bits_ [ c >> 6 ] |= boost::uint64_t ( 1 ) << ( c & 63 );
+                }
+
+            count_ = 0;
+            for ( unsigned c = 0; c < 256; ++c )
+                if ( contains ( static_cast<unsigned char> ( c ))) {
+                    if ( count_ < k_max_compare )
+                        members_ [ count_ ] = static_cast<unsigned char> ( c );
+                    ++count_;
+                    }
+
+        //  The nibble tables: high nibbles with the same set of low nibbles
+        //  share a bit; there are at most sixteen distinct sets.
+            for ( int p = 0; p < 2; ++p )
+                for ( int i = 0; i < 16; ++i )
+                    lo_ [ p ][ i ] = hi_ [ p ][ i ] = 0;
+            unsigned short groups [ 16 ];
+            std::size_t group_count = 0;
+            for ( unsigned h = 0; h < 16; ++h ) {
+                unsigned short lows = 0;
+                for ( unsigned l = 0; l < 16; ++l )
+                    if ( contains ( static_cast<unsigned char> ( h << 4 | l )))
+                        lows |= static_cast<unsigned short> ( 1U << l );
+                if ( lows == 0 )
+                    continue;
+                std::size_t g = 0;
+                while ( g < group_count && groups [ g ] != lows )
+                    ++g;
+                if ( g == group_count )
+                    groups [ group_count++ ] = lows;
+                hi_ [ g / 8 ][ h ] |= static_cast<unsigned char> ( 1U << ( g % 8 ));
+                for ( unsigned l = 0; l < 16; ++l )
+                    if ( lows & ( 1U << l ))
+                        lo_ [ g / 8 ][ l ] |= static_cast<unsigned char> ( 1U << ( g % 8 ));
+                }
+            pairs_ = group_count > 8 ? 2 : 1;
+            }
+
+        template <typename corpusIter>
+        corpusIter dispatch ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            for ( ; corpus_first != corpus_last; ++corpus_first )
+                if ( contains ( static_cast<unsigned char> ( *corpus_first )))
+                    break;
+            return corpus_first;
+            }
+
+        template <typename corpusIter>
+        corpusIter dispatch ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            if ( corpus_first == corpus_last )
+                return corpus_last;
+            const unsigned char *first = reinterpret_cast<const unsigned char *> ( &*corpus_first );
+            const unsigned char *last  = first + ( corpus_last - corpus_first );
+            return corpus_first + ( find ( first, last ) - first );
+            }
+
+        const unsigned char *find_scalar ( const unsigned char *first, const unsigned char *last ) const {
+            for ( ; first != last; ++first )
+                if ( contains ( *first ))
+                    break;
+            return first;
+            }
+
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+    //  These return where the scalar code should pick up: either the first
+    //  byte in the set, or somewhere in the last sixteen bytes.
+        const unsigned char *find_compare ( const unsigned char *first, const unsigned char *last ) const {
+            __m128i needles [ k_max_compare ];
+            for ( std::size_t i = 0; i < count_; ++i )
+                needles [ i ] = _mm_set1_epi8 ( static_cast<char> ( members_ [ i ] ));
+
+            for ( ; last - first >= 16; first += 16 ) {
+                const __m128i v = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( first ));
+                __m128i hits = _mm_cmpeq_epi8 ( v, needles [ 0 ] );
+                for ( std::size_t i = 1; i < count_; ++i )
+                    hits = _mm_or_si128 ( hits, _mm_cmpeq_epi8 ( v, needles [ i ] ));
+                const unsigned mask = static_cast<unsigned> ( _mm_movemask_epi8 ( hits ));
+                if ( mask != 0 )
+                    return first + detail::byte_set_first_bit ( mask );
+                }
+            return first;
+            }
+
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSSE3
+        BOOST_ALGORITHM_TARGET ( "ssse3" )
+        const unsigned char *find_nibbles ( const unsigned char *first, const unsigned char *last ) const {
+            const __m128i lo0 = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( lo_ [ 0 ] ));
+            const __m128i hi0 = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( hi_ [ 0 ] ));
+            const __m128i lo1 = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( lo_ [ 1 ] ));
+            const __m128i hi1 = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( hi_ [ 1 ] ));
+            const __m128i nibble = _mm_set1_epi8 ( 0x0f );
+            const __m128i zero   = _mm_setzero_si128 ();
+
+            for ( ; last - first >= 16; first += 16 ) {
+                const __m128i v  = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( first ));
+                const __m128i lo = _mm_and_si128 ( v, nibble );
+                const __m128i hi = _mm_and_si128 ( _mm_srli_epi16 ( v, 4 ), nibble );
+                __m128i hits = _mm_and_si128 ( _mm_shuffle_epi8 ( lo0, lo ), _mm_shuffle_epi8 ( hi0, hi ));
+                if ( pairs_ > 1 )
+                    hits = _mm_or_si128 ( hits,
+                            _mm_and_si128 ( _mm_shuffle_epi8 ( lo1, lo ), _mm_shuffle_epi8 ( hi1, hi )));
+                const unsigned mask = 0xffffU & ~static_cast<unsigned> ( _mm_movemask_epi8 ( _mm_cmpeq_epi8 ( hits, zero )));
+                if ( mask != 0 )
+                    return first + detail::byte_set_first_bit ( mask );
+                }
+            return first;
+            }
+#endif
+
+#ifdef BOOST_ALGORITHM_BYTE_SET_AVX2
+        BOOST_ALGORITHM_TARGET ( "avx2" )
+        const unsigned char *find_compare_avx2 ( const unsigned char *first, const unsigned char *last ) const {
+            __m256i needles [ k_max_compare ];
+            for ( std::size_t i = 0; i < count_; ++i )
+                needles [ i ] = _mm256_set1_epi8 ( static_cast<char> ( members_ [ i ] ));
+
+            for ( ; last - first >= 32; first += 32 ) {
+                const __m256i v = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( first ));
+                __m256i hits = _mm256_cmpeq_epi8 ( v, needles [ 0 ] );
+                for ( std::size_t i = 1; i < count_; ++i )
+                    hits = _mm256_or_si256 ( hits, _mm256_cmpeq_epi8 ( v, needles [ i ] ));
+                const unsigned mask = static_cast<unsigned> ( _mm256_movemask_epi8 ( hits ));
+                if ( mask != 0 )
+                    return first + detail::byte_set_first_bit ( mask );
+                }
+            return first;
+            }
+
+    //  vpshufb looks up within each sixteen byte half, so the tables are in both halves
+        BOOST_ALGORITHM_TARGET ( "avx2" )
+        const unsigned char *find_nibbles_avx2 ( const unsigned char *first, const unsigned char *last ) const {
+            const __m256i lo0 = _mm256_broadcastsi128_si256 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( lo_ [ 0 ] )));
+            const __m256i hi0 = _mm256_broadcastsi128_si256 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( hi_ [ 0 ] )));
+            const __m256i lo1 = _mm256_broadcastsi128_si256 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( lo_ [ 1 ] )));
+            const __m256i hi1 = _mm256_broadcastsi128_si256 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( hi_ [ 1 ] )));
+            const __m256i nibble = _mm256_set1_epi8 ( 0x0f );
+            const __m256i zero   = _mm256_setzero_si256 ();
+
+            for ( ; last - first >= 32; first += 32 ) {
+                const __m256i v  = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( first ));
+                const __m256i lo = _mm256_and_si256 ( v, nibble );
+                const __m256i hi = _mm256_and_si256 ( _mm256_srli_epi16 ( v, 4 ), nibble );
+                __m256i hits = _mm256_and_si256 ( _mm256_shuffle_epi8 ( lo0, lo ), _mm256_shuffle_epi8 ( hi0, hi ));
+                if ( pairs_ > 1 )
+                    hits = _mm256_or_si256 ( hits,
+                            _mm256_and_si256 ( _mm256_shuffle_epi8 ( lo1, lo ), _mm256_shuffle_epi8 ( hi1, hi )));
+                const unsigned mask = ~static_cast<unsigned> ( _mm256_movemask_epi8 ( _mm256_cmpeq_epi8 ( hits, zero )));
+                if ( mask != 0 )
+                    return first + detail::byte_set_first_bit ( mask );
+                }
+            return first;
+            }
+#endif
+#endif
+/// \endcond
+        };
+
+/// \fn byte_set_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       setIter set_first, setIter set_last )
+/// \brief Finds the first element of the corpus that is one of the elements of the set.
+///
+/// \param corpus_first The start of the data to search
+/// \param corpus_last  One past the end of the data to search
+/// \param set_first    The start of the set of values to search for
+/// \param set_last     One past the end of the set
+///
+    template <typename setIter, typename corpusIter>
+    corpusIter byte_set_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            setIter set_first, setIter set_last ) {
+        byte_set_searcher bs ( set_first, set_last );
+        return bs ( corpus_first, corpus_last );
+        }
+
+    template <typename Range>
+    byte_set_searcher make_byte_set_searcher ( const Range &r ) {
+        return byte_set_searcher ( boost::begin ( r ), boost::end ( r ));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_BYTE_SET_HPP
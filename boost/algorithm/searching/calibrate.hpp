@@ -0,0 +1,182 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_CALIBRATE_HPP
+#define BOOST_ALGORITHM_SEARCH_CALIBRATE_HPP
+
+#include <cstddef>      // for std::size_t
+#include <ctime>        // for std::clock
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/search_each.hpp>
+#include <boost/algorithm/searching/tuning.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Measuring the crossovers in search_tuning on this machine.
+
+    Each crossover is found by timing the two algorithms on the same work
+    at a series of sizes, and choosing the threshold (none, or one of the
+    sizes) that makes the total time over all the sizes least. That copes
+    with noise, and with algorithms whose timings cross more than once,
+    better than stopping at the first size where the order changes. Each
+    timing is the best of three runs, and each run repeats the
+    work for at least 'seconds' of processor time; with the default, the
+    whole calibration takes a fraction of a second.
+
+    The text searched is pseudo-random lower case letters and spaces, from a
+    fixed seed, so the results don't depend on any input -- but a machine
+    that mostly searches something very different (DNA, say) may do better
+    with its own measurements.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline std::string calibration_text ( std::size_t n, boost::uint32_t seed ) {
+        std::string retVal ( n, ' ' );
+        for ( std::size_t i = 0; i < n; ++i ) {
+            seed = seed * 1103515245U + 12345U;
+            const unsigned r = ( seed >> 16 ) % 32;
+            retVal [ i ] = r < 26 ? static_cast<char> ( 'a' + r ) : ' ';
+            }
+        return retVal;
+        }
+
+//  Seconds per call of f (), best of three
+    template <typename F>
+    double calibration_time ( F f, double seconds ) {
+        double best = 0;
+        for ( int run = 0; run < 3; ++run ) {
+            std::size_t calls = 0;
+            const std::clock_t start = std::clock ();
+            std::clock_t now;
+            do {
+                f ();
+                ++calls;
+                now = std::clock ();
+                } while ( now - start < seconds * CLOCKS_PER_SEC );
+            const double t = double ( now - start ) / CLOCKS_PER_SEC / calls;
+            if ( run == 0 || t < best )
+                best = t;
+            }
+        return best;
+        }
+
+//  The threshold t, out of { 0, sizes [ i ] }, that makes the sum of
+//  ( sizes [ i ] <= t ? small [ i ] : large [ i ] ) least
+    inline std::size_t calibration_threshold ( const std::vector<std::size_t> &sizes,
+                const std::vector<double> &small, const std::vector<double> &large ) {
+        std::size_t retVal = 0;
+        double total = 0;
+        for ( std::size_t i = 0; i < sizes.size (); ++i )
+            total += large [ i ];
+        double best = total;
+        for ( std::size_t i = 0; i < sizes.size (); ++i ) {
+            total += small [ i ] - large [ i ];
+            if ( total < best ) {
+                best = total;
+                retVal = sizes [ i ];
+                }
+            }
+        return retVal;
+        }
+
+//  The kernels being timed. Each adds its result to a volatile sink on every
+//  call, so the compiler can't drop the work, or move it out of the timed loop.
+    template <typename Searcher>
+    struct calibration_search {
+        calibration_search ( const std::string &text, const std::string &pat, volatile std::size_t &sink )
+            : text_ ( text ), s_ ( pat.begin (), pat.end ()), sink_ ( sink ) {}
+        void operator () () const { sink_ = sink_ + ( s_ ( text_.begin (), text_.end ()) - text_.begin ()); }
+        const std::string &text_;
+        Searcher s_;
+        volatile std::size_t &sink_;
+        };
+
+    struct calibration_short {
+        calibration_short ( const std::vector<std::string> &corpora, const std::string &pat, volatile std::size_t &sink )
+            : corpora_ ( corpora ), pat_ ( pat ), sink_ ( sink ) {}
+        void operator () () const {
+            for ( std::size_t i = 0; i < corpora_.size (); ++i )
+                sink_ = sink_ + search_short ( reinterpret_cast<const unsigned char *> ( corpora_ [ i ].data ()), corpora_ [ i ].size (),
+                                        reinterpret_cast<const unsigned char *> ( pat_.data ()), pat_.size ());
+            }
+        const std::vector<std::string> &corpora_;
+        const std::string &pat_;
+        volatile std::size_t &sink_;
+        };
+
+    template <typename Searcher>
+    struct calibration_each {
+        calibration_each ( const std::vector<std::string> &corpora, const std::string &pat, volatile std::size_t &sink )
+            : corpora_ ( corpora ), s_ ( pat.begin (), pat.end ()), sink_ ( sink ) {}
+        void operator () () const {
+            for ( std::size_t i = 0; i < corpora_.size (); ++i )
+                sink_ = sink_ + ( s_ ( corpora_ [ i ].begin (), corpora_ [ i ].end ()) - corpora_ [ i ].begin ());
+            }
+        const std::vector<std::string> &corpora_;
+        Searcher s_;
+        volatile std::size_t &sink_;
+        };
+}
+/// \endcond
+
+/// \fn calibrate_search_tuning ( double seconds )
+/// \brief Measures the crossovers in search_tuning on this machine
+///
+/// \param seconds  The least processor time for each run of each timing
+/// \return         The measured settings; current_search_tuning () is not changed
+///
+    inline search_tuning calibrate_search_tuning ( double seconds = 0.002 ) {
+        typedef std::string::const_iterator iter;
+        search_tuning retVal;
+        volatile std::size_t sink = 0;
+
+    //  boyer_moore_horspool against boyer_moore, on a pattern that isn't there
+        const std::string text = detail::calibration_text ( 256 * 1024, 1 );
+        std::vector<std::size_t> sizes;
+        std::vector<double> small, large;
+        for ( std::size_t m = 4; m <= 256; m *= 2 ) {
+            const std::string pat = detail::calibration_text ( m - 1, 2 ) + "#";
+            sizes.push_back ( m );
+            small.push_back ( detail::calibration_time (
+                        detail::calibration_search<boyer_moore_horspool<iter> > ( text, pat, sink ), seconds ));
+            large.push_back ( detail::calibration_time (
+                        detail::calibration_search<boyer_moore<iter> > ( text, pat, sink ), seconds ));
+            }
+        retVal.horspool_max_pattern = detail::calibration_threshold ( sizes, small, large );
+
+    //  search_each's short corpus loop against calling the searcher, for the
+    //  same total amount of text cut into corpora of each size
+        const std::string pat = detail::calibration_text ( 7, 3 ) + "#";
+        sizes.clear (); small.clear (); large.clear ();
+        for ( std::size_t n = 16; n <= 4096; n *= 2 ) {
+            std::vector<std::string> corpora;
+            for ( std::size_t off = 0; off + n <= 64 * 1024; off += n )
+                corpora.push_back ( text.substr ( off, n ));
+            sizes.push_back ( n );
+            small.push_back ( detail::calibration_time ( detail::calibration_short ( corpora, pat, sink ), seconds ));
+            large.push_back ( detail::calibration_time (
+                        detail::calibration_each<boyer_moore_horspool<iter> > ( corpora, pat, sink ), seconds ));
+            }
+        retVal.short_corpus = detail::calibration_threshold ( sizes, small, large );
+
+        return retVal;
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_CALIBRATE_HPP
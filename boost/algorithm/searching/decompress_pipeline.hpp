@@ -0,0 +1,396 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_DECOMPRESS_PIPELINE_HPP
+#define BOOST_ALGORITHM_DECOMPRESS_PIPELINE_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcmp, std::memset
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include <zlib.h>
+#ifdef BOOST_ALGORITHM_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/exception/exception.hpp>
+#include <boost/exception/errinfo_file_name.hpp>
+#include <boost/exception_ptr.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <boost/algorithm/searching/stream_matcher.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching compressed data, without decompressing it to disk first.
+
+    A decompress_pipeline decompresses a gzip (or zlib) stream, or a zstd
+    stream, into fixed-size blocks on one thread, and hands the blocks in
+    order to a consumer on the calling thread -- usually a stream_matcher,
+    which finds the matches that span blocks too. The consumer is told the
+    offset of each block in the uncompressed data, so the matches are
+    reported at uncompressed offsets.
+
+    Only 'blocks' blocks of 'block_size' bytes exist; when the consumer falls
+    behind, the decompressor waits for a block to come back. So the memory
+    used is those blocks, one input buffer, and the decompressor's own state
+    (32KB for gzip; the frame's window size, often 8MB or less, for zstd).
+
+    Concatenated gzip members and zstd frames are read one after another, as
+    gzip -d and zstd -d do. The format is chosen by the first bytes of the
+    stream. zlib is always needed; zstd support is compiled in when
+    BOOST_ALGORITHM_HAS_ZSTD is defined (and then libzstd must be linked).
+    This also needs Boost.Thread.
+*/
+
+/*!
+    \struct decompress_error
+    \brief  Thrown when the compressed data is damaged or cut short, or is in a
+            format that isn't supported. Carries a decompress_message.
+*/
+struct decompress_error : virtual boost::exception, virtual std::exception {};
+typedef boost::error_info<struct decompress_message_, std::string> decompress_message;
+
+    struct decompress_stats {
+        decompress_stats () : bytes_in ( 0 ), bytes_out ( 0 ), blocks ( 0 ), total_seconds ( 0 ),
+                              decompress_seconds ( 0 ), wait_seconds ( 0 ), consume_seconds ( 0 ) {}
+
+        boost::uintmax_t bytes_in;      // compressed
+        boost::uintmax_t bytes_out;     // uncompressed
+        boost::uintmax_t blocks;
+        double total_seconds;
+        double decompress_seconds;      // on the decompressing thread
+        double wait_seconds;            // the consumer waiting for a block
+        double consume_seconds;         // in the consumer
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline double decompress_clock () {
+        return ( boost::posix_time::microsec_clock::universal_time ()
+               - boost::posix_time::ptime ( boost::gregorian::date ( 1970, 1, 1 ))).total_microseconds () / 1e6;
+        }
+
+    inline void throw_decompress_error ( const char *message ) {
+        BOOST_THROW_EXCEPTION ( decompress_error () << decompress_message ( message ));
+        }
+
+//  Each decoder turns as much of [in, in + in_len) into [out, out + out_len) as it can,
+//  and moves the pointers and lengths along. They return true at the end of a member/frame.
+
+    class gzip_decoder : private boost::noncopyable {
+    public:
+        gzip_decoder () {
+            std::memset ( &zs_, 0, sizeof ( zs_ ));
+            if ( inflateInit2 ( &zs_, 15 + 32 ) != Z_OK )   // +32: gzip or zlib header
+                throw_decompress_error ( "inflateInit2 failed" );
+            }
+        ~gzip_decoder () { inflateEnd ( &zs_ ); }
+
+        bool decode ( const char *&in, std::size_t &in_len, char *&out, std::size_t &out_len ) {
+            zs_.next_in   = reinterpret_cast<Bytef *> ( const_cast<char *> ( in ));
+            zs_.avail_in  = static_cast<uInt> ( in_len );
+            zs_.next_out  = reinterpret_cast<Bytef *> ( out );
+            zs_.avail_out = static_cast<uInt> ( out_len );
+            const int r = inflate ( &zs_, Z_NO_FLUSH );
+            in      += in_len  - zs_.avail_in;
+            in_len   = zs_.avail_in;
+            out     += out_len - zs_.avail_out;
+            out_len  = zs_.avail_out;
+            if ( r == Z_STREAM_END ) {
+                inflateReset ( &zs_ );
+                return true;
+                }
+            if ( r != Z_OK && r != Z_BUF_ERROR )
+                throw_decompress_error ( zs_.msg != NULL ? zs_.msg : "inflate failed" );
+            return false;
+            }
+
+    private:
+        z_stream zs_;
+        };
+
+#ifdef BOOST_ALGORITHM_HAS_ZSTD
+    class zstd_decoder : private boost::noncopyable {
+    public:
+        zstd_decoder () : ds_ ( ZSTD_createDStream ()) {
+            if ( ds_ == NULL || ZSTD_isError ( ZSTD_initDStream ( ds_ )))
+                throw_decompress_error ( "ZSTD_initDStream failed" );
+            }
+        ~zstd_decoder () { ZSTD_freeDStream ( ds_ ); }
+
+        bool decode ( const char *&in, std::size_t &in_len, char *&out, std::size_t &out_len ) {
+            ZSTD_inBuffer  ib = { in,  in_len,  0 };
+            ZSTD_outBuffer ob = { out, out_len, 0 };
+            const std::size_t r = ZSTD_decompressStream ( ds_, &ob, &ib );
+            if ( ZSTD_isError ( r ))
+                throw_decompress_error ( ZSTD_getErrorName ( r ));
+            in  += ib.pos;  in_len  -= ib.pos;
+            out += ob.pos;  out_len -= ob.pos;
+            return r == 0;      // a frame is finished, and all of it has been written
+            }
+
+    private:
+        ZSTD_DStream *ds_;
+        };
+#endif
+
+//  The blocks, and the queues of them, shared by the two threads
+    struct decompress_state : private boost::noncopyable {
+        decompress_state ( std::size_t block_size, unsigned blocks )
+            : storage ( block_size * blocks ), lengths ( blocks ), finished ( false ), stop ( false ) {
+            for ( unsigned i = 0; i < blocks; ++i )
+                free_blocks.push_back ( i );
+            }
+
+        std::vector<char> storage;
+        std::vector<std::size_t> lengths;
+
+    //  Guarded by 'mutex'
+        boost::mutex mutex;
+        boost::condition_variable changed;
+        std::deque<unsigned> free_blocks, full_blocks;
+        bool finished;                  // no more blocks are coming
+        bool stop;                      // the consumer has given up
+        boost::exception_ptr error;     // from the decompressing thread
+        };
+}
+/// \endcond
+
+    class decompress_pipeline : private boost::noncopyable {
+    public:
+        /// \brief Make a pipeline that decompresses into 'blocks' blocks of 'block_size' bytes
+        explicit decompress_pipeline ( std::size_t block_size = 256 * 1024, unsigned blocks = 4,
+                                       std::size_t input_size = 64 * 1024 )
+            : k_block_size ( block_size ), k_blocks ( blocks < 2 ? 2 : blocks ), k_input_size ( input_size ) {}
+
+        ~decompress_pipeline () {}
+
+        /// \brief The timings of the last run
+        const decompress_stats &stats () const { return stats_; }
+
+        /// \fn operator () ( std::istream &in, Consumer consume )
+        /// \brief Decompress 'in', calling consume ( first, last, offset ) for each block, in order.
+        ///     'offset' is the position of the block in the uncompressed data.
+        ///
+        /// \param in       The compressed data (opened in binary mode)
+        /// \param consume  Called as consume ( const char *first, const char *last, boost::uintmax_t offset )
+        /// \return         The consumer, like std::for_each
+        /// \throws decompress_error if the data is damaged, cut short, or not supported
+        ///
+        template <typename Consumer>
+        Consumer operator () ( std::istream &in, Consumer consume ) {
+            stats_ = decompress_stats ();
+            const double start = detail::decompress_clock ();
+
+            detail::decompress_state st ( k_block_size, k_blocks );
+            boost::thread decompressor ( worker ( this, in, st ));
+            try {
+                boost::uintmax_t offset = 0;
+                for ( ;; ) {
+                    unsigned b;
+                    {
+                    const double t0 = detail::decompress_clock ();
+                    boost::unique_lock<boost::mutex> lock ( st.mutex );
+                    while ( st.full_blocks.empty () && !st.finished )
+                        st.changed.wait ( lock );
+                    stats_.wait_seconds += detail::decompress_clock () - t0;
+                    if ( st.full_blocks.empty ()) {
+                        if ( st.error )
+                            boost::rethrow_exception ( st.error );
+                        break;
+                        }
+                    b = st.full_blocks.front ();
+                    st.full_blocks.pop_front ();
+                    }
+
+                    const char *first = &st.storage [ b * k_block_size ];
+                    const double t0 = detail::decompress_clock ();
+                    consume ( first, first + st.lengths [ b ], offset );
+                    stats_.consume_seconds += detail::decompress_clock () - t0;
+                    offset += st.lengths [ b ];
+                    ++stats_.blocks;
+
+                    {
+                    boost::lock_guard<boost::mutex> lock ( st.mutex );
+                    st.free_blocks.push_back ( b );
+                    }
+                    st.changed.notify_all ();
+                    }
+                stats_.bytes_out = offset;
+                }
+            catch ( ... ) {
+                {
+                boost::lock_guard<boost::mutex> lock ( st.mutex );
+                st.stop = true;
+                }
+                st.changed.notify_all ();
+                decompressor.join ();
+                throw;
+                }
+            decompressor.join ();
+            stats_.total_seconds = detail::decompress_clock () - start;
+            return consume;
+            }
+
+        /// \fn operator () ( const std::string &path, Consumer consume )
+        /// \brief Open and decompress the file at 'path'
+        template <typename Consumer>
+        Consumer operator () ( const std::string &path, Consumer consume ) {
+            std::ifstream in ( path.c_str (), std::ios::in | std::ios::binary );
+            if ( !in )
+                BOOST_THROW_EXCEPTION ( decompress_error () << decompress_message ( "can't open the file" )
+                                                            << boost::errinfo_file_name ( path ));
+            try {
+                return (*this) ( in, consume );
+                }
+            catch ( boost::exception &e ) {
+                e << boost::errinfo_file_name ( path );
+                throw;
+                }
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const std::size_t k_block_size;
+        const unsigned k_blocks;
+        const std::size_t k_input_size;
+        decompress_stats stats_;
+
+        struct worker {
+            worker ( decompress_pipeline *p, std::istream &in, detail::decompress_state &st )
+                : pipeline_ ( p ), in_ ( &in ), st_ ( &st ) {}
+            void operator () () const { pipeline_->decompress ( *in_, *st_ ); }
+            decompress_pipeline *pipeline_;
+            std::istream *in_;
+            detail::decompress_state *st_;
+            };
+
+    //  The body of the decompressing thread
+        void decompress ( std::istream &in, detail::decompress_state &st ) {
+            try {
+                std::vector<char> input ( k_input_size );
+                std::size_t in_len = read_some ( in, &input [ 0 ], input.size ());
+                static const unsigned char zstd_magic [] = { 0x28, 0xB5, 0x2F, 0xFD };
+                if ( in_len >= 4 && std::memcmp ( &input [ 0 ], zstd_magic, 4 ) == 0 ) {
+#ifdef BOOST_ALGORITHM_HAS_ZSTD
+                    detail::zstd_decoder decoder;
+                    run ( decoder, in, input, in_len, st );
+#else
+                    detail::throw_decompress_error ( "zstd support is not compiled in (define BOOST_ALGORITHM_HAS_ZSTD)" );
+#endif
+                    }
+                else {
+                    detail::gzip_decoder decoder;
+                    run ( decoder, in, input, in_len, st );
+                    }
+                }
+            catch ( ... ) {
+                boost::lock_guard<boost::mutex> lock ( st.mutex );
+                st.error = boost::current_exception ();
+                }
+
+            {
+            boost::lock_guard<boost::mutex> lock ( st.mutex );
+            st.finished = true;
+            }
+            st.changed.notify_all ();
+            }
+
+        template <typename Decoder>
+        void run ( Decoder &decoder, std::istream &in, std::vector<char> &input, std::size_t in_len,
+                   detail::decompress_state &st ) {
+            const char *in_ptr = &input [ 0 ];
+            bool in_member = false;     // part way through a gzip member or zstd frame
+            bool eof = in_len == 0;
+            bool stalled = false;       // at the end of the input, and the decoder has nothing more
+            stats_.bytes_in = in_len;
+
+            while ( !stalled && ( in_member || in_len > 0 || !eof )) {
+            //  Get an empty block
+                unsigned b;
+                {
+                boost::unique_lock<boost::mutex> lock ( st.mutex );
+                while ( st.free_blocks.empty () && !st.stop )
+                    st.changed.wait ( lock );
+                if ( st.stop )
+                    return;
+                b = st.free_blocks.front ();
+                st.free_blocks.pop_front ();
+                }
+
+            //  Fill it. The decoder may have output left over even when there's no more input.
+                char *const block = &st.storage [ b * k_block_size ];
+                char *out = block;
+                std::size_t out_len = k_block_size;
+                const double t0 = detail::decompress_clock ();
+                while ( out_len > 0 ) {
+                    if ( in_len == 0 && !eof ) {
+                        in_ptr = &input [ 0 ];
+                        in_len = read_some ( in, &input [ 0 ], input.size ());
+                        stats_.bytes_in += in_len;
+                        eof = in_len == 0;
+                        }
+                    if ( in_len == 0 && !in_member ) {
+                        stalled = true;
+                        break;
+                        }
+                    const std::size_t before = in_len + out_len;
+                    in_member = !decoder.decode ( in_ptr, in_len, out, out_len );
+                    if ( in_len + out_len == before ) {
+                        if ( in_len > 0 )
+                            detail::throw_decompress_error ( "the decompressor made no progress" );
+                        stalled = true;
+                        break;
+                        }
+                    }
+                stats_.decompress_seconds += detail::decompress_clock () - t0;
+
+            //  Hand it over
+                {
+                boost::lock_guard<boost::mutex> lock ( st.mutex );
+                st.lengths [ b ] = out - block;
+                if ( out != block )
+                    st.full_blocks.push_back ( b );
+                else
+                    st.free_blocks.push_back ( b );
+                }
+                st.changed.notify_all ();
+                }
+
+            if ( in_member )
+                detail::throw_decompress_error ( "the compressed data ends in the middle of a stream" );
+            }
+
+        static std::size_t read_some ( std::istream &in, char *buf, std::size_t len ) {
+            in.read ( buf, static_cast<std::streamsize> ( len ));
+            return static_cast<std::size_t> ( in.gcount ());
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_DECOMPRESS_PIPELINE_HPP
@@ -0,0 +1,115 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_INDEX_IO_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_INDEX_IO_HPP
+
+#include <algorithm>    // for std::min
+#include <cstring>      // for std::memcmp
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+namespace boost { namespace algorithm {
+
+/*!
+    \struct index_format_error
+    \brief  Thrown when a saved index can't be read back: it is truncated,
+            it was written by a different version (or with a different index
+            type), or it doesn't belong to the corpus it is being loaded for.
+*/
+struct index_format_error : virtual boost::exception, virtual std::exception {};
+
+namespace detail {
+/// \cond DOXYGEN_HIDE
+
+//  Saved indexes are raw arrays in the byte order of the machine that
+//  wrote them, after a small header.
+
+    template <typename T>
+    void write_pod ( std::ostream &out, const T &val ) {
+        out.write ( reinterpret_cast<const char *> ( &val ), sizeof ( T ));
+        }
+
+    template <typename T>
+    T read_pod ( std::istream &in ) {
+        T retVal;
+        if ( !in.read ( reinterpret_cast<char *> ( &retVal ), sizeof ( T )))
+            BOOST_THROW_EXCEPTION ( index_format_error ());
+        return retVal;
+        }
+
+    template <typename T>
+    void write_vector ( std::ostream &out, const std::vector<T> &v ) {
+        write_pod ( out, static_cast<boost::uint64_t> ( v.size ()));
+        if ( !v.empty ())
+            out.write ( reinterpret_cast<const char *> ( &v [ 0 ] ), v.size () * sizeof ( T ));
+        }
+
+//  The count in front of the array can't be trusted: it is checked against
+//  what a vector can hold, and the array is read a piece at a time, so that
+//  a damaged count runs into the end of the stream before the vector grows
+//  much past the stream's size.
+    template <typename T>
+    void read_vector ( std::istream &in, std::vector<T> &v ) {
+        const boost::uint64_t count = read_pod<boost::uint64_t> ( in );
+        const std::size_t chunk = ( std::size_t ( 1 ) << 20 ) / sizeof ( T ) + 1;
+        if ( count > static_cast<boost::uint64_t> ( v.max_size ()))
+            BOOST_THROW_EXCEPTION ( index_format_error ());
+
+        v.clear ();
+        while ( v.size () < count ) {
+            const std::size_t pos = v.size ();
+            const std::size_t len = static_cast<std::size_t> ( std::min<boost::uint64_t> ( count - pos, chunk ));
+            v.resize ( pos + len );
+            if ( !in.read ( reinterpret_cast<char *> ( &v [ pos ] ), len * sizeof ( T )))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            }
+        }
+
+//  The header: a four character tag, a format version, and the size of the
+//  index type, so that an index can't be loaded into the wrong kind of object.
+    inline void write_index_header ( std::ostream &out, const char *tag,
+                                        boost::uint32_t version, boost::uint32_t index_size ) {
+        out.write ( tag, 4 );
+        write_pod ( out, version );
+        write_pod ( out, index_size );
+        }
+
+    inline void read_index_header ( std::istream &in, const char *tag,
+                                        boost::uint32_t version, boost::uint32_t index_size ) {
+        char buf [ 4 ];
+        if ( !in.read ( buf, 4 ) || std::memcmp ( buf, tag, 4 ) != 0 )
+            BOOST_THROW_EXCEPTION ( index_format_error ());
+        if ( read_pod<boost::uint32_t> ( in ) != version )
+            BOOST_THROW_EXCEPTION ( index_format_error ());
+        if ( read_pod<boost::uint32_t> ( in ) != index_size )
+            BOOST_THROW_EXCEPTION ( index_format_error ());
+        }
+
+//  64-bit FNV-1a, to tie a saved index to its corpus
+    template <typename Iter>
+    boost::uint64_t fnv1a ( Iter first, Iter last, boost::uint64_t h = 0xcbf29ce484222325ULL ) {
+        for ( ; first != last; ++first ) {
+            h ^= static_cast<unsigned char> ( *first );
+            h *= 0x100000001b3ULL;
+            }
+        return h;
+        }
+
+/// \endcond
+}
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_INDEX_IO_HPP
@@ -0,0 +1,185 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_SAIS_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_SAIS_HPP
+
+#include <algorithm>    // for std::fill
+#include <cstddef>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//
+//  Suffix array construction by induced sorting (SA-IS), in linear time.
+//
+//  Nong, G., Zhang, S. and Chan, W.H. "Two Efficient Algorithms for Linear
+//      Time Suffix Array Construction", IEEE Transactions on Computers 60(10),
+//      1471-1484 (2011)
+//
+//  The text 's' has 'n' symbols in [0, K), and the last one must be a unique
+//  smallest symbol (the sentinel). 'Index' must be a signed integer type.
+//
+
+//  Is 'i' a left-most S-type position?
+    template <typename Index>
+    bool sais_is_lms ( const std::vector<bool> &t, Index i ) {
+        return i > 0 && t [ i ] && !t [ i - 1 ];
+        }
+
+    template <typename Text, typename Index>
+    void sais_buckets ( const Text &s, std::vector<Index> &bkt, Index n, Index K, bool end ) {
+        std::fill ( bkt.begin (), bkt.begin () + K, Index ( 0 ));
+        for ( Index i = 0; i < n; ++i )
+            ++bkt [ s [ i ]];
+        Index sum = 0;
+        for ( Index i = 0; i < K; ++i ) {
+            sum += bkt [ i ];
+            bkt [ i ] = end ? sum : sum - bkt [ i ];
+            }
+        }
+
+//  Induce the L-type suffixes from the (sorted) S-type ones, left to right
+    template <typename Text, typename Index>
+    void sais_induce_l ( const std::vector<bool> &t, Index *SA, const Text &s,
+                                std::vector<Index> &bkt, Index n, Index K ) {
+        sais_buckets ( s, bkt, n, K, false );
+        for ( Index i = 0; i < n; ++i ) {
+            const Index j = SA [ i ] - 1;
+            if ( j >= 0 && !t [ j ] )
+                SA [ bkt [ s [ j ]]++ ] = j;
+            }
+        }
+
+//  Induce the S-type suffixes from the L-type ones, right to left
+    template <typename Text, typename Index>
+    void sais_induce_s ( const std::vector<bool> &t, Index *SA, const Text &s,
+                                std::vector<Index> &bkt, Index n, Index K ) {
+        sais_buckets ( s, bkt, n, K, true );
+        for ( Index i = n - 1; i >= 0; --i ) {
+            const Index j = SA [ i ] - 1;
+            if ( j >= 0 && t [ j ] )
+                SA [ --bkt [ s [ j ]]] = j;
+            }
+        }
+
+    template <typename Text, typename Index>
+    void sais ( const Text &s, Index *SA, Index n, Index K ) {
+        BOOST_ASSERT ( n > 0 );
+        if ( n == 1 ) {
+            SA [ 0 ] = 0;
+            return;
+            }
+
+    //  Classify the suffixes; true == S-type. The sentinel is S-type.
+        std::vector<bool> t ( n, false );
+        t [ n - 1 ] = true;
+        for ( Index i = n - 3; i >= 0; --i )
+            t [ i ] = s [ i ] < s [ i + 1 ] || ( s [ i ] == s [ i + 1 ] && t [ i + 1 ] );
+
+    //  Stage 1: sort the LMS substrings
+        std::vector<Index> bkt ( K );
+        sais_buckets ( s, bkt, n, K, true );
+        std::fill ( SA, SA + n, Index ( -1 ));
+        for ( Index i = 1; i < n; ++i )
+            if ( sais_is_lms ( t, i ))
+                SA [ --bkt [ s [ i ]]] = i;
+        sais_induce_l ( t, SA, s, bkt, n, K );
+        sais_induce_s ( t, SA, s, bkt, n, K );
+
+    //  Move the sorted LMS substrings to the front of SA
+        Index n1 = 0;
+        for ( Index i = 0; i < n; ++i )
+            if ( sais_is_lms ( t, SA [ i ] ))
+                SA [ n1++ ] = SA [ i ];
+
+    //  Name them; equal substrings get the same name. Two LMS positions are
+    //  at least two apart, so pos/2 gives each its own slot.
+        std::fill ( SA + n1, SA + n, Index ( -1 ));
+        Index name = 0, prev = -1;
+        for ( Index i = 0; i < n1; ++i ) {
+            const Index pos = SA [ i ];
+            bool diff = false;
+            for ( Index d = 0; d < n; ++d ) {
+                if ( prev == -1 || s [ pos + d ] != s [ prev + d ] || t [ pos + d ] != t [ prev + d ] ) {
+                    diff = true;
+                    break;
+                    }
+                else if ( d > 0 && ( sais_is_lms ( t, pos + d ) || sais_is_lms ( t, prev + d )))
+                    break;
+                }
+            if ( diff ) {
+                ++name;
+                prev = pos;
+                }
+            SA [ n1 + pos / 2 ] = name - 1;
+            }
+        for ( Index i = n - 1, j = n - 1; i >= n1; --i )
+            if ( SA [ i ] >= 0 )
+                SA [ j-- ] = SA [ i ];
+
+    //  Stage 2: sort the reduced problem, recursing if the names aren't unique
+        Index *SA1 = SA;
+        Index *s1  = SA + n - n1;
+        if ( name < n1 )
+            sais ( s1, SA1, n1, name );
+        else
+            for ( Index i = 0; i < n1; ++i )
+                SA1 [ s1 [ i ]] = i;
+
+    //  Stage 3: induce the full suffix array from the sorted LMS suffixes
+        sais_buckets ( s, bkt, n, K, true );
+        for ( Index i = 1, j = 0; i < n; ++i )
+            if ( sais_is_lms ( t, i ))
+                s1 [ j++ ] = i;
+        for ( Index i = 0; i < n1; ++i )
+            SA1 [ i ] = s1 [ SA1 [ i ]];
+        std::fill ( SA + n1, SA + n, Index ( -1 ));
+        for ( Index i = n1 - 1; i >= 0; --i ) {
+            const Index j = SA [ i ];
+            SA [ i ] = -1;
+            SA [ --bkt [ s [ j ]]] = j;
+            }
+        sais_induce_l ( t, SA, s, bkt, n, K );
+        sais_induce_s ( t, SA, s, bkt, n, K );
+        }
+
+//  Presents a corpus of bytes as a text for sais: each byte plus one,
+//  followed by a zero for the sentinel.
+    template <typename Iter, typename Index>
+    class sais_byte_text {
+    public:
+        sais_byte_text ( Iter first, Index n ) : first_ ( first ), n_ ( n ) {}
+        Index operator [] ( Index i ) const {
+            return i == n_ ? 0 : Index ( static_cast<unsigned char> ( first_ [ i ] )) + 1;
+            }
+    private:
+        Iter first_;
+        Index n_;
+        };
+
+//  Build the suffix array of the n bytes starting at 'first'; no sentinel in the result
+    template <typename Iter, typename Index>
+    void build_suffix_array ( Iter first, Index n, std::vector<Index> &sa ) {
+        sa.resize ( n + 1 );
+        sais ( sais_byte_text<Iter, Index> ( first, n ), &sa [ 0 ], n + 1, Index ( 257 ));
+    //  The sentinel sorts first; drop it
+        BOOST_ASSERT ( sa [ 0 ] == n );
+        sa.erase ( sa.begin ());
+        }
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_SAIS_HPP
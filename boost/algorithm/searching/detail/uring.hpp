@@ -0,0 +1,173 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_URING_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_URING_HPP
+
+//  Define BOOST_ALGORITHM_NO_IO_URING to always use the thread pool.
+#if !defined ( BOOST_ALGORITHM_NO_IO_URING ) && defined ( __linux__ ) && defined ( __GNUC__ ) && defined ( __has_include )
+#if __has_include ( <linux/io_uring.h> )
+#define BOOST_ALGORITHM_HAS_IO_URING
+#endif
+#endif
+
+#ifdef BOOST_ALGORITHM_HAS_IO_URING
+
+#include <algorithm>    // for std::max
+#include <cerrno>
+#include <cstring>      // for std::memset
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace boost { namespace algorithm { namespace detail {
+
+/*
+    Just enough of io_uring to queue reads and collect their completions,
+    using the system calls directly, so that nothing but the kernel headers
+    is needed. If the kernel doesn't have io_uring (or it has been turned
+    off), ok () is false.
+
+    Having io_uring isn't enough: IORING_OP_READ needs Linux 5.6 or later,
+    and on 5.1 to 5.5 every read would complete with -EINVAL. So the ring
+    asks the kernel (IORING_REGISTER_PROBE) whether it has the operation it
+    is going to use, and ok () is false if it doesn't -- or if it can't say,
+    since the probe came in 5.6 as well.
+
+    There is one thread submitting and reaping, so only the kernel's side of
+    each ring needs the acquire/release ordering.
+*/
+    class uring : private boost::noncopyable {
+    public:
+        explicit uring ( unsigned entries, unsigned op = IORING_OP_READ )
+                : fd_ ( -1 ), sq_ptr_ ( MAP_FAILED ), cq_ptr_ ( MAP_FAILED ), sqes_ ( MAP_FAILED ),
+                  sq_size_ ( 0 ), cq_size_ ( 0 ), sqes_size_ ( 0 ), to_submit_ ( 0 ) {
+            io_uring_params p;
+            std::memset ( &p, 0, sizeof ( p ));
+            fd_ = static_cast<int> ( syscall ( __NR_io_uring_setup, entries, &p ));
+            if ( fd_ < 0 )
+                return;
+
+            sq_size_ = p.sq_off.array + p.sq_entries * sizeof ( unsigned );
+            cq_size_ = p.cq_off.cqes  + p.cq_entries * sizeof ( io_uring_cqe );
+            const bool single_mmap = ( p.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+            if ( single_mmap )
+                sq_size_ = cq_size_ = (std::max) ( sq_size_, cq_size_ );
+            sqes_size_ = p.sq_entries * sizeof ( io_uring_sqe );
+
+            sq_ptr_ = mmap ( NULL, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING );
+            cq_ptr_ = single_mmap ? sq_ptr_
+                    : mmap ( NULL, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING );
+            sqes_   = mmap ( NULL, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES );
+            if ( sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes_ == MAP_FAILED || !supports ( op )) {
+                release ();
+                return;
+                }
+
+            char *sq = static_cast<char *> ( sq_ptr_ );
+            sq_tail_  = reinterpret_cast<unsigned *> ( sq + p.sq_off.tail );
+            sq_mask_  = *reinterpret_cast<unsigned *> ( sq + p.sq_off.ring_mask );
+            sq_array_ = reinterpret_cast<unsigned *> ( sq + p.sq_off.array );
+
+            char *cq = static_cast<char *> ( cq_ptr_ );
+            cq_head_  = reinterpret_cast<unsigned *> ( cq + p.cq_off.head );
+            cq_tail_  = reinterpret_cast<unsigned *> ( cq + p.cq_off.tail );
+            cq_mask_  = *reinterpret_cast<unsigned *> ( cq + p.cq_off.ring_mask );
+            cqes_     = reinterpret_cast<io_uring_cqe *> ( cq + p.cq_off.cqes );
+            }
+
+        ~uring () { release (); }
+
+        bool ok () const { return fd_ >= 0; }
+
+        /// \brief Queue a read of 'len' bytes from 'fd' at 'offset' into 'buf'.
+        ///     There must be no more reads outstanding than the ring has entries.
+        void read ( int fd, void *buf, unsigned len, boost::uint64_t offset, boost::uint64_t tag ) {
+            const unsigned tail = *sq_tail_;
+            const unsigned index = tail & sq_mask_;
+            io_uring_sqe &sqe = static_cast<io_uring_sqe *> ( sqes_ ) [ index ];
+            std::memset ( &sqe, 0, sizeof ( sqe ));
+            sqe.opcode    = IORING_OP_READ;
+            sqe.fd        = fd;
+            sqe.addr      = reinterpret_cast<boost::uint64_t> ( buf );
+            sqe.len       = len;
+            sqe.off       = offset;
+            sqe.user_data = tag;
+            sq_array_ [ index ] = index;
+            __atomic_store_n ( sq_tail_, tail + 1, __ATOMIC_RELEASE );
+            ++to_submit_;
+            }
+
+        /// \brief Submit the queued reads, and wait for one to finish.
+        ///     'result' is the number of bytes read, or -errno.
+        /// \return false (and sets errno) if io_uring_enter fails
+        bool wait ( boost::uint64_t &tag, int &result ) {
+            for ( ;; ) {
+                const unsigned head = *cq_head_;
+                if ( head != __atomic_load_n ( cq_tail_, __ATOMIC_ACQUIRE )) {
+                    const io_uring_cqe &cqe = cqes_ [ head & cq_mask_ ];
+                    tag    = cqe.user_data;
+                    result = cqe.res;
+                    __atomic_store_n ( cq_head_, head + 1, __ATOMIC_RELEASE );
+                    return true;
+                    }
+                const long r = syscall ( __NR_io_uring_enter, fd_, to_submit_, 1, IORING_ENTER_GETEVENTS, NULL, 0 );
+                if ( r < 0 ) {
+                    if ( errno == EINTR )
+                        continue;
+                    return false;
+                    }
+                to_submit_ -= static_cast<unsigned> ( r );
+                }
+            }
+
+    private:
+        int fd_;
+        void *sq_ptr_, *cq_ptr_, *sqes_;
+        std::size_t sq_size_, cq_size_, sqes_size_;
+        unsigned to_submit_;
+
+        unsigned *sq_tail_, *sq_array_, sq_mask_;
+        unsigned *cq_head_, *cq_tail_, cq_mask_;
+        io_uring_cqe *cqes_;
+
+    //  Whether the kernel can do 'op'
+        bool supports ( unsigned op ) const {
+            const unsigned num_ops = 256;
+            union {
+                io_uring_probe probe;
+                char bytes [ sizeof ( io_uring_probe ) + num_ops * sizeof ( io_uring_probe_op ) ];
+                } buf;
+            std::memset ( &buf, 0, sizeof ( buf ));
+            if ( syscall ( __NR_io_uring_register, fd_, IORING_REGISTER_PROBE, &buf.probe, num_ops ) < 0 )
+                return false;
+            return op <= buf.probe.last_op && op < num_ops
+                && ( buf.probe.ops [ op ].flags & IO_URING_OP_SUPPORTED ) != 0;
+            }
+
+        void release () {
+            if ( sqes_ != MAP_FAILED )                          munmap ( sqes_, sqes_size_ );
+            if ( cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_ )  munmap ( cq_ptr_, cq_size_ );
+            if ( sq_ptr_ != MAP_FAILED )                        munmap ( sq_ptr_, sq_size_ );
+            if ( fd_ >= 0 )                                     close ( fd_ );
+            sq_ptr_ = cq_ptr_ = sqes_ = MAP_FAILED;
+            fd_ = -1;
+            }
+        };
+
+}}}
+
+#endif  //  BOOST_ALGORITHM_HAS_IO_URING
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_URING_HPP
@@ -0,0 +1,366 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_FILE_SCANNER_HPP
+#define BOOST_ALGORITHM_FILE_SCANNER_HPP
+
+#include <algorithm>    // for std::sort, std::max
+#include <cstddef>      // for std::size_t
+#include <cstdio>       // for std::FILE, std::fopen, std::fread
+#include <deque>
+#include <exception>    // for std::exception
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching the files in a directory tree, in parallel.
+
+    A file_scanner walks the directory trees it is given, and searches every
+    regular file in them with a searcher object, on a pool of threads. The
+    matches are passed to a callback, on the calling thread, in a stable
+    order: file by file in sorted path order (the roots in the order they
+    were given), and in increasing offset within each file -- the same order,
+    whatever the number of threads.
+
+    Each thread has its own queue of files, and the files are dealt out to
+    the queues in turn. A thread takes files from the front of its own queue;
+    when that is empty it steals from the front of another thread's queue, so
+    that one big file doesn't hold up the rest of the queue behind it.
+
+    A file's matches are kept until every file before it has been handed to
+    the callback. So that one slow file early in the order doesn't make the
+    scanner hold the matches of the rest of the tree, no thread starts a file
+    more than max_ahead files (four for each thread, by default) past the
+    one the callback is waiting for.
+
+    Files of at least mmap_threshold bytes (1MB by default) are mapped into
+    memory and searched in place; smaller files (and any that can't be mapped)
+    are read whole into a buffer that each thread reuses.
+
+    The scanner keeps a copy of the searcher, which all the threads share; it
+    must be searching for a pattern of char. (All the searchers in this
+    library are safe to call from several threads at once.) Files that can't
+    be read, and directories that can't be listed, are skipped, and counted
+    in files_skipped (); the rest of the tree is still searched.
+
+    This component needs Boost.Filesystem and Boost.Thread to be linked in.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    struct scan_queue {
+        boost::mutex mutex;
+        std::deque<std::size_t> files;
+        };
+
+    struct scan_result {
+        scan_result () : done ( false ) {}
+        bool done;
+        std::vector<std::size_t> offsets;
+        };
+
+    struct scan_state : private boost::noncopyable {
+        scan_state ( const std::vector<boost::filesystem::path> &f, std::size_t threads, std::size_t ahead )
+            : files ( f ), queues ( new scan_queue [ threads ] ), num_queues ( threads ),
+              max_ahead ( ahead ), results ( f.size ()), next_out ( 0 ), stop ( false ) {
+            for ( std::size_t i = 0; i < files.size (); ++i )
+                queues [ i % num_queues ].files.push_back ( i );
+            }
+
+        const std::vector<boost::filesystem::path> &files;
+        boost::scoped_array<scan_queue> queues;
+        const std::size_t num_queues;
+        const std::size_t max_ahead;
+
+    //  Guarded by 'mutex'
+        boost::mutex mutex;
+        boost::condition_variable ready;        // a result is done
+        boost::condition_variable advanced;     // next_out has moved on
+        std::vector<scan_result> results;
+        std::size_t next_out;                   // the file the callback is waiting for
+        bool stop;
+        };
+}
+/// \endcond
+
+    template <typename Searcher>
+    class file_scanner : private boost::noncopyable {
+    public:
+        enum match_mode {
+            first_match,    // report the first match in each file
+            all_matches     // report every match, including ones that overlap
+            };
+
+        /// \brief Make a scanner that searches with 's', on 'threads' threads
+        ///     (or one per processor, if 'threads' is zero)
+        explicit file_scanner ( const Searcher &s, match_mode mode = first_match, unsigned threads = 0 )
+            : searcher_ ( s ), mode_ ( mode ),
+              k_threads ( threads != 0 ? threads : (std::max) ( 1U, boost::thread::hardware_concurrency ())),
+              mmap_threshold_ ( 1024 * 1024 ), max_ahead_ ( 4 * k_threads ),
+              files_scanned_ ( 0 ), files_skipped_ ( 0 ), bytes_scanned_ ( 0 ) {}
+
+        ~file_scanner () {}
+
+        /// \brief Map files of at least 'bytes' bytes, rather than reading them
+        void set_mmap_threshold ( boost::uintmax_t bytes ) { mmap_threshold_ = bytes; }
+
+        /// \brief Start no file more than 'files' files past the one the callback is waiting for
+        ///     (at least one). This bounds the matches that wait in memory to those of 'files' files.
+        void set_max_ahead ( std::size_t files ) { max_ahead_ = (std::max) ( files, std::size_t ( 1 )); }
+
+        /// \fn operator () ( const std::vector<boost::filesystem::path> &roots, Callback cb )
+        /// \brief Search all the files under 'roots', calling cb ( path, offset ) for each match
+        ///
+        /// \param roots    The files and directories to search
+        /// \param cb       Called on this thread as cb ( const boost::filesystem::path &, std::size_t )
+        ///
+        template <typename Callback>
+        void operator () ( const std::vector<boost::filesystem::path> &roots, Callback cb ) {
+            files_scanned_ = files_skipped_ = bytes_scanned_ = 0;
+
+            std::vector<boost::filesystem::path> files;
+            for ( std::size_t i = 0; i < roots.size (); ++i )
+                collect_files ( roots [ i ], files );
+
+            detail::scan_state st ( files, k_threads, max_ahead_ );
+            boost::thread_group workers;
+            try {
+                for ( std::size_t i = 0; i < k_threads; ++i )
+                    workers.create_thread ( worker ( this, i, st ));
+
+            //  Hand out the results in order, as they finish
+                std::vector<std::size_t> offsets;
+                for ( std::size_t i = 0; i < files.size (); ++i ) {
+                    {
+                    boost::unique_lock<boost::mutex> lock ( st.mutex );
+                    while ( !st.results [ i ].done )
+                        st.ready.wait ( lock );
+                    offsets.clear ();
+                    offsets.swap ( st.results [ i ].offsets );
+                    st.next_out = i + 1;
+                    st.advanced.notify_all ();
+                    }
+                    for ( std::size_t j = 0; j < offsets.size (); ++j )
+                        cb ( files [ i ], offsets [ j ] );
+                    }
+                }
+            catch ( ... ) {
+                {
+                boost::lock_guard<boost::mutex> lock ( st.mutex );
+                st.stop = true;
+                st.advanced.notify_all ();
+                }
+                workers.join_all ();
+                throw;
+                }
+            workers.join_all ();
+            }
+
+        template <typename Callback>
+        void operator () ( const boost::filesystem::path &root, Callback cb ) {
+            (*this) ( std::vector<boost::filesystem::path> ( 1, root ), cb );
+            }
+
+        /// \brief Statistics for the last scan
+        boost::uintmax_t files_scanned () const { return files_scanned_; }
+        boost::uintmax_t files_skipped () const { return files_skipped_; }
+        boost::uintmax_t bytes_scanned () const { return bytes_scanned_; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const Searcher searcher_;
+        const match_mode mode_;
+        const std::size_t k_threads;
+        boost::uintmax_t mmap_threshold_;
+        std::size_t max_ahead_;
+
+    //  Only changed while holding the scan_state's mutex
+        boost::uintmax_t files_scanned_, files_skipped_, bytes_scanned_;
+
+    //  The regular files under 'root', in sorted order.
+    //  The walk is done one directory at a time, so that a directory that can't
+    //  be listed is skipped (and counted) without ending the rest of the walk.
+    //  Symbolic links to directories are not followed.
+        void collect_files ( const boost::filesystem::path &root, std::vector<boost::filesystem::path> &files ) {
+            namespace fs = boost::filesystem;
+            boost::system::error_code ec;
+            if ( fs::is_regular_file ( root, ec )) {
+                files.push_back ( root );
+                return;
+                }
+            if ( !fs::is_directory ( root, ec )) {
+                ++files_skipped_;
+                return;
+                }
+
+            const std::size_t first = files.size ();
+            std::vector<fs::path> dirs ( 1, root );
+            while ( !dirs.empty ()) {
+                const fs::path dir = dirs.back ();
+                dirs.pop_back ();
+                fs::directory_iterator it ( dir, ec ), last;
+                for ( ; !ec && it != last; it.increment ( ec )) {
+                    boost::system::error_code ec2;
+                    if ( fs::is_directory ( it->symlink_status ( ec2 )))
+                        dirs.push_back ( it->path ());
+                    else if ( fs::is_regular_file ( it->status ( ec2 )))
+                        files.push_back ( it->path ());
+                    }
+                if ( ec ) {
+                    ++files_skipped_;
+                    ec.clear ();
+                    }
+                }
+            std::sort ( files.begin () + first, files.end ());
+            }
+
+    //  The body of each worker thread
+        struct worker {
+            worker ( file_scanner *scanner, std::size_t self, detail::scan_state &st )
+                : scanner_ ( scanner ), self_ ( self ), st_ ( &st ) {}
+            void operator () () const { scanner_->work ( self_, *st_ ); }
+            file_scanner *scanner_;
+            std::size_t self_;
+            detail::scan_state *st_;
+            };
+
+        void work ( std::size_t self, detail::scan_state &st ) {
+            std::vector<char> buffer;
+            std::vector<std::size_t> offsets;
+            std::size_t file;
+            while ( next_file ( self, st, file )) {
+                boost::uintmax_t bytes = 0;
+                offsets.clear ();
+                bool ok;
+                try { ok = scan_file ( st.files [ file ], buffer, offsets, bytes ); }
+                catch ( const std::exception & ) { ok = false; offsets.clear (); }
+
+                boost::lock_guard<boost::mutex> lock ( st.mutex );
+                if ( st.stop )
+                    break;
+                if ( ok ) {
+                    ++files_scanned_;
+                    bytes_scanned_ += bytes;
+                    }
+                else
+                    ++files_skipped_;
+                st.results [ file ].offsets.swap ( offsets );
+                st.results [ file ].done = true;
+                st.ready.notify_all ();
+                }
+            }
+
+    //  Take from the front of our own queue, or steal from the front of someone else's.
+    //  Each queue is in file order, so its front is the file that the callback will
+    //  want first. If every front is too far ahead of the callback, wait for it.
+    //  The file the callback is waiting for is always at the front of a queue (or
+    //  already being searched), so some thread can always take it.
+        bool next_file ( std::size_t self, detail::scan_state &st, std::size_t &file ) const {
+            for ( ;; ) {
+                std::size_t limit;
+                {
+                boost::lock_guard<boost::mutex> lock ( st.mutex );
+                if ( st.stop )
+                    return false;
+                limit = st.next_out + st.max_ahead;
+                }
+
+                bool any = false;
+                for ( std::size_t i = 0; i < st.num_queues; ++i ) {
+                    detail::scan_queue &q = st.queues [ ( self + i ) % st.num_queues ];
+                    boost::lock_guard<boost::mutex> lock ( q.mutex );
+                    if ( q.files.empty ())
+                        continue;
+                    any = true;
+                    if ( q.files.front () < limit ) {
+                        file = q.files.front ();
+                        q.files.pop_front ();
+                        return true;
+                        }
+                    }
+                if ( !any )
+                    return false;
+
+                boost::unique_lock<boost::mutex> lock ( st.mutex );
+                while ( !st.stop && st.next_out + st.max_ahead <= limit )
+                    st.advanced.wait ( lock );
+                }
+            }
+
+        bool scan_file ( const boost::filesystem::path &p, std::vector<char> &buffer,
+                         std::vector<std::size_t> &offsets, boost::uintmax_t &bytes ) const {
+            boost::system::error_code ec;
+            const boost::uintmax_t size = boost::filesystem::file_size ( p, ec );
+            if ( ec )
+                return false;
+            if ( size == 0 )
+                return true;
+
+            if ( size >= mmap_threshold_ ) {
+                try {
+                    namespace ip = boost::interprocess;
+                    const ip::file_mapping mapping ( p.string ().c_str (), ip::read_only );
+                    const ip::mapped_region region ( mapping, ip::read_only );
+                    const char *first = static_cast<const char *> ( region.get_address ());
+                    bytes = region.get_size ();
+                    search ( first, first + bytes, offsets );
+                    return true;
+                    }
+                catch ( const boost::interprocess::interprocess_exception & ) {}    // read it instead
+                }
+
+            std::FILE *f = std::fopen ( p.string ().c_str (), "rb" );
+            if ( f == NULL )
+                return false;
+            buffer.resize ( static_cast<std::size_t> ( size ));
+            const std::size_t n = std::fread ( &buffer [ 0 ], 1, buffer.size (), f );
+            const bool failed = std::ferror ( f ) != 0;
+            std::fclose ( f );
+            if ( failed )
+                return false;
+            bytes = n;
+            search ( &buffer [ 0 ], &buffer [ 0 ] + n, offsets );
+            return true;
+            }
+
+        void search ( const char *first, const char *last, std::vector<std::size_t> &offsets ) const {
+            for ( const char *p = first; ; ) {
+                const char *it = searcher_ ( p, last );
+                if ( it == last )
+                    break;
+                offsets.push_back ( it - first );
+                if ( mode_ == first_match )
+                    break;
+                p = it + 1;
+                }
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_FILE_SCANNER_HPP
@@ -0,0 +1,409 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_FM_INDEX_HPP
+#define BOOST_ALGORITHM_FM_INDEX_HPP
+
+#include <algorithm>    // for std::count, std::equal, std::fill
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <iterator>     // for std::iterator_traits
+#include <istream>
+#include <ostream>
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/integer_traits.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/detail/sais.hpp>
+#include <boost/algorithm/searching/detail/index_io.hpp>
+#include <boost/algorithm/searching/suffix_array.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    An FM-index (a compressed suffix array) over a static corpus of bytes.
+
+    The index holds the Burrows-Wheeler transform of the corpus, a table of
+    symbol counts taken every 'occ_sample' rows, and every 'sa_sample'th
+    entry of the suffix array. With those, it can count the occurrences of a
+    pattern in O(m) steps ("backward search"), and find each occurrence in
+    O(sa_sample) more. It does not need the corpus after it has been built,
+    so a saved index can be used on its own.
+
+    The count table only has columns for the bytes that appear in the corpus,
+    so an index over DNA is much smaller than one over text. With the default
+    sampling rates and four-byte indexes, a DNA index takes a little over 1.5
+    bytes per base; the suffix array takes 4.
+
+    Positions are reported as offsets from the start of the corpus.
+
+    Requirements:
+        * The corpus and patterns must be a one-byte integral type.
+        * Index must be a signed integer type that can hold the corpus length.
+*/
+
+    template <typename Index = std::ptrdiff_t>
+    class fm_index {
+        BOOST_STATIC_ASSERT (( boost::is_signed<Index>::value ));
+
+    public:
+        typedef Index index_type;
+
+        /// \brief Build the index for the corpus [first, last)
+        ///
+        /// \param first        The start of the corpus (Random Access Iterator)
+        /// \param last         One past the end of the corpus
+        /// \param sa_sample    Keep one suffix array entry for every this many corpus positions
+        /// \param occ_sample   Keep the symbol counts every this many rows
+        template <typename corpusIter>
+        fm_index ( corpusIter first, corpusIter last,
+                        std::size_t sa_sample = 32, std::size_t occ_sample = 64 )
+                : n_ ( std::distance ( first, last )), sa_sample_ ( sa_sample ), occ_sample_ ( occ_sample ) {
+            BOOST_ASSERT ( sa_sample > 0 && occ_sample > 0 );
+            std::vector<Index> sa;
+            if ( n_ > 0 )
+                detail::build_suffix_array ( first, Index ( n_ ), sa );
+            build ( first, sa );
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "fm_index", n_ );
+            }
+
+        /// \brief Build the index from an existing suffix array
+        template <typename corpusIter, typename saIndex>
+        explicit fm_index ( const suffix_array<corpusIter, saIndex> &sa,
+                        std::size_t sa_sample = 32, std::size_t occ_sample = 64 )
+                : n_ ( sa.size ()), sa_sample_ ( sa_sample ), occ_sample_ ( occ_sample ) {
+            BOOST_ASSERT ( sa_sample > 0 && occ_sample > 0 );
+            build ( sa.corpus_begin (), sa.array ());
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "fm_index", n_ );
+            }
+
+        /// \brief Load an index that was written by save
+        /// \throws index_format_error if the saved index is damaged. The tables that
+        ///     can be worked out from the BWT are checked against it, so loading takes
+        ///     O(n) time; a damaged index is never used to read outside the tables.
+        explicit fm_index ( std::istream &in ) {
+            detail::read_index_header ( in, "BAFM", k_version, sizeof ( Index ));
+            n_          = static_cast<std::size_t> ( detail::read_pod<boost::uint64_t> ( in ));
+            sa_sample_  = static_cast<std::size_t> ( detail::read_pod<boost::uint64_t> ( in ));
+            occ_sample_ = static_cast<std::size_t> ( detail::read_pod<boost::uint64_t> ( in ));
+            sigma_      = static_cast<std::size_t> ( detail::read_pod<boost::uint64_t> ( in ));
+            dollar_row_ = static_cast<std::size_t> ( detail::read_pod<boost::uint64_t> ( in ));
+            detail::read_vector ( in, code_ );
+            detail::read_vector ( in, C_ );
+            detail::read_vector ( in, bwt_ );
+            detail::read_vector ( in, occ_ );
+            detail::read_vector ( in, sampled_ );
+            detail::read_vector ( in, sampled_rank_ );
+            detail::read_vector ( in, samples_ );
+            if ( sa_sample_ == 0 || occ_sample_ == 0 || code_.size () != 256 || sigma_ > 256
+              || bwt_.empty () || bwt_.size () - 1 != n_ || n_ > static_cast<std::size_t> ( boost::integer_traits<Index>::const_max - 1 )
+              || C_.size () != sigma_ + 1 || dollar_row_ > n_
+              || occ_.size () != (( n_ + 1 ) / occ_sample_ + 1 ) * sigma_
+              || sampled_.size () != n_ / 64 + 1 || sampled_rank_.size () != sampled_.size ())
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            check_loaded ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "fm_index", n_ );
+            }
+
+        ~fm_index () {}
+
+        /// \brief Write the index to a stream, to be loaded later
+        void save ( std::ostream &out ) const {
+            detail::write_index_header ( out, "BAFM", k_version, sizeof ( Index ));
+            detail::write_pod ( out, static_cast<boost::uint64_t> ( n_ ));
+            detail::write_pod ( out, static_cast<boost::uint64_t> ( sa_sample_ ));
+            detail::write_pod ( out, static_cast<boost::uint64_t> ( occ_sample_ ));
+            detail::write_pod ( out, static_cast<boost::uint64_t> ( sigma_ ));
+            detail::write_pod ( out, static_cast<boost::uint64_t> ( dollar_row_ ));
+            detail::write_vector ( out, code_ );
+            detail::write_vector ( out, C_ );
+            detail::write_vector ( out, bwt_ );
+            detail::write_vector ( out, occ_ );
+            detail::write_vector ( out, sampled_ );
+            detail::write_vector ( out, sampled_rank_ );
+            detail::write_vector ( out, samples_ );
+            }
+
+        /// \fn equal_range ( patIter pat_first, patIter pat_last )
+        /// \brief The rows of the (conceptual) suffix array that start with the pattern.
+        ///     Row zero is the empty suffix at the end of the corpus.
+        template <typename patIter>
+        std::pair<std::size_t, std::size_t> equal_range ( patIter pat_first, patIter pat_last ) const {
+            std::size_t sp = 0, ep = n_ + 1;
+            while ( pat_last != pat_first ) {
+                const int c = code_ [ static_cast<unsigned char> ( *--pat_last ) ];
+                if ( c < 0 )
+                    return std::make_pair ( sp, sp );   // not in the corpus at all
+                sp = C_ [ c ] + rank ( c, sp );
+                ep = C_ [ c ] + rank ( c, ep );
+                if ( sp >= ep )
+                    return std::make_pair ( sp, sp );
+                }
+            return std::make_pair ( sp, ep );
+            }
+
+        /// \fn count ( patIter pat_first, patIter pat_last )
+        /// \brief The number of times the pattern occurs in the corpus
+        template <typename patIter>
+        std::size_t count ( patIter pat_first, patIter pat_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "fm_index", n_, std::distance ( pat_first, pat_last ));
+            std::size_t retVal = n_;
+            if ( pat_first != pat_last ) {
+                const std::pair<std::size_t, std::size_t> rows = equal_range ( pat_first, pat_last );
+                retVal = rows.second - rows.first;
+                }
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "fm_index", n_, std::distance ( pat_first, pat_last ), retVal );
+            return retVal;
+            }
+
+        /// \fn locate ( patIter pat_first, patIter pat_last, OutputIterator out )
+        /// \brief Writes the corpus positions of all the occurrences of the pattern.
+        ///     They come out in suffix order, not corpus order.
+        template <typename patIter, typename OutputIterator>
+        OutputIterator locate ( patIter pat_first, patIter pat_last, OutputIterator out ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "fm_index", n_, std::distance ( pat_first, pat_last ));
+            std::size_t matches = 0;
+            if ( pat_first != pat_last ) {
+                const std::pair<std::size_t, std::size_t> rows = equal_range ( pat_first, pat_last );
+                for ( std::size_t row = rows.first; row < rows.second; ++row )
+                    *out++ = position ( row );
+                matches = rows.second - rows.first;
+                }
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "fm_index", n_, std::distance ( pat_first, pat_last ), matches );
+            return out;
+            }
+
+        /// \fn operator () ( patIter pat_first, patIter pat_last )
+        /// \brief Finds the first occurrence of the pattern in the corpus
+        /// \return The offset of the first match, or size () if there isn't one
+        template <typename patIter>
+        std::size_t operator () ( patIter pat_first, patIter pat_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "fm_index", n_, std::distance ( pat_first, pat_last ));
+            std::size_t retVal = 0;     // empty pattern matches at start
+            if ( pat_first != pat_last ) {
+                const std::pair<std::size_t, std::size_t> rows = equal_range ( pat_first, pat_last );
+                retVal = n_;
+                for ( std::size_t row = rows.first; row < rows.second; ++row ) {
+                    const std::size_t pos = position ( row );
+                    if ( pos < retVal )
+                        retVal = pos;
+                    }
+                }
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "fm_index", n_, std::distance ( pat_first, pat_last ),
+                                                 retVal == n_ ? std::ptrdiff_t ( -1 ) : std::ptrdiff_t ( retVal ));
+            return retVal;
+            }
+
+        template <typename Range>
+        std::size_t operator () ( const Range &pattern ) const {
+            return (*this) ( boost::begin ( pattern ), boost::end ( pattern ));
+            }
+
+        /// \brief The length of the corpus
+        std::size_t size () const { return n_; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        static const boost::uint32_t k_version = 1;
+
+        std::size_t n_;
+        std::size_t sa_sample_;
+        std::size_t occ_sample_;
+        std::size_t sigma_;                     // number of distinct bytes in the corpus
+        std::size_t dollar_row_;                // the row whose BWT symbol is the sentinel
+        std::vector<int> code_;                 // byte -> column, or -1 if not in the corpus
+        std::vector<unsigned char> byte_of_;    // column -> byte
+        std::vector<Index> C_;                  // rows that start with a smaller symbol
+        std::vector<unsigned char> bwt_;        // n + 1 symbols
+        std::vector<Index> occ_;                // counts at every occ_sample'th row
+        std::vector<boost::uint64_t> sampled_;  // which rows have a suffix array sample
+        std::vector<Index> sampled_rank_;       // sampled rows before each word of sampled_
+        std::vector<Index> samples_;            // the samples, in row order
+
+        template <typename corpusIter, typename SA>
+        void build ( corpusIter first, const SA &sa ) {
+        //  The alphabet
+            code_.assign ( 256, -1 );
+            std::vector<std::size_t> freq ( 256, 0 );
+            for ( std::size_t i = 0; i < n_; ++i )
+                ++freq [ static_cast<unsigned char> ( first [ i ] ) ];
+            sigma_ = 0;
+            for ( std::size_t c = 0; c < 256; ++c )
+                if ( freq [ c ] != 0 )
+                    code_ [ c ] = static_cast<int> ( sigma_++ );
+            make_byte_of ();
+            C_.assign ( sigma_ + 1, 0 );
+            C_ [ 0 ] = 1;   // the sentinel row sorts first
+            for ( std::size_t c = 0, col = 0; c < 256; ++c )
+                if ( freq [ c ] != 0 ) {
+                    C_ [ col + 1 ] = C_ [ col ] + Index ( freq [ c ] );
+                    ++col;
+                    }
+
+        //  The BWT. Row 0 is the sentinel suffix; row i+1 is suffix sa[i].
+            bwt_.resize ( n_ + 1 );
+            bwt_ [ 0 ] = n_ > 0 ? static_cast<unsigned char> ( first [ n_ - 1 ] ) : 0;
+            dollar_row_ = 0;
+            for ( std::size_t i = 0; i < n_; ++i ) {
+                if ( sa [ i ] == 0 ) {
+                    dollar_row_ = i + 1;
+                    bwt_ [ i + 1 ] = 0;
+                    }
+                else
+                    bwt_ [ i + 1 ] = static_cast<unsigned char> ( first [ sa [ i ] - 1 ] );
+                }
+            if ( n_ == 0 )
+                dollar_row_ = 0;
+
+        //  The count checkpoints
+        //  (rank is asked about rows up to and including n + 1)
+            occ_.assign (( ( n_ + 1 ) / occ_sample_ + 1 ) * sigma_, 0 );
+            std::vector<Index> running ( sigma_, 0 );
+            for ( std::size_t row = 0; row <= n_ + 1; ++row ) {
+                if ( row % occ_sample_ == 0 )
+                    std::copy ( running.begin (), running.end (), occ_.begin () + ( row / occ_sample_ ) * sigma_ );
+                if ( row <= n_ && row != dollar_row_ )
+                    ++running [ code_ [ bwt_ [ row ]]];
+                }
+
+        //  The suffix array samples; the sentinel row (position n) is always kept
+            sampled_.assign ( n_ / 64 + 1, 0 );
+            samples_.clear ();
+            for ( std::size_t row = 0; row <= n_; ++row ) {
+                const std::size_t pos = row == 0 ? n_ : static_cast<std::size_t> ( sa [ row - 1 ] );
+                if ( row == 0 || pos % sa_sample_ == 0 ) {
+                    sampled_ [ row / 64 ] |= boost::uint64_t ( 1 ) << ( row % 64 );
+                    samples_.push_back ( Index ( pos ));
+                    }
+                }
+            sampled_rank_.assign ( sampled_.size (), 0 );
+            for ( std::size_t w = 1; w < sampled_.size (); ++w )
+                sampled_rank_ [ w ] = sampled_rank_ [ w - 1 ] + Index ( popcount ( sampled_ [ w - 1 ] ));
+            }
+
+    //  A loaded index must be one that build () could have made: the columns
+    //  are numbered in byte order, every symbol of the BWT has a column, and C_,
+    //  occ_ and sampled_rank_ are what the BWT and sampled_ say they are.
+        void check_loaded () {
+            for ( std::size_t c = 0, col = 0; c < code_.size (); ++c )
+                if ( code_ [ c ] != -1 && code_ [ c ] != static_cast<int> ( col++ ))
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+            make_byte_of ();
+            if ( byte_of_.size () != sigma_ )
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            if ( n_ > 0 && ( dollar_row_ == 0 || bwt_ [ dollar_row_ ] != 0 ))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+
+        //  The counts, the same way that build () makes them
+            std::vector<Index> running ( sigma_, 0 );
+            for ( std::size_t row = 0; row <= n_ + 1; ++row ) {
+                if ( row % occ_sample_ == 0
+                        && !std::equal ( running.begin (), running.end (), occ_.begin () + ( row / occ_sample_ ) * sigma_ ))
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+                if ( row <= n_ && row != dollar_row_ ) {
+                    if ( code_ [ bwt_ [ row ]] < 0 )
+                        BOOST_THROW_EXCEPTION ( index_format_error ());
+                    ++running [ code_ [ bwt_ [ row ]]];
+                    }
+                }
+            if ( C_ [ 0 ] != 1 )
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            for ( std::size_t c = 0; c < sigma_; ++c )
+                if ( running [ c ] == 0 || C_ [ c + 1 ] != C_ [ c ] + running [ c ] )
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+
+        //  The samples: the sentinel row is always sampled, there are no rows
+        //  past n, and each sample is a corpus position
+            if (( sampled_ [ 0 ] & 1 ) == 0 || ( sampled_.back () >> ( n_ % 64 )) > 1 )
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            Index rank = 0;
+            for ( std::size_t w = 0; w < sampled_.size (); ++w ) {
+                if ( sampled_rank_ [ w ] != rank )
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+                rank += Index ( popcount ( sampled_ [ w ] ));
+                }
+            if ( samples_.size () != static_cast<std::size_t> ( rank ))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            for ( std::size_t i = 0; i < samples_.size (); ++i )
+                if ( samples_ [ i ] < 0 || samples_ [ i ] > Index ( n_ ))
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+            }
+
+        void make_byte_of () {
+            byte_of_.clear ();
+            for ( std::size_t c = 0; c < code_.size (); ++c )
+                if ( code_ [ c ] >= 0 )
+                    byte_of_.push_back ( static_cast<unsigned char> ( c ));
+            }
+
+        static std::size_t popcount ( boost::uint64_t x ) {
+            std::size_t retVal = 0;
+            for ( ; x != 0; x &= x - 1 )
+                ++retVal;
+            return retVal;
+            }
+
+    //  The number of times column 'c' appears in bwt_ [ 0, row )
+        std::size_t rank ( int c, std::size_t row ) const {
+            const std::size_t block = row / occ_sample_;
+            std::size_t retVal = occ_ [ block * sigma_ + c ];
+            const unsigned char *p = &bwt_ [ 0 ];
+            const unsigned char byte = byte_of_ [ c ];
+            retVal += std::count ( p + block * occ_sample_, p + row, byte );
+        //  The sentinel is stored as a zero byte; don't count it
+            if ( byte == 0 && dollar_row_ >= block * occ_sample_ && dollar_row_ < row )
+                --retVal;
+            return retVal;
+            }
+
+    //  LF-mapping: the row of the suffix that starts one position earlier
+        std::size_t lf ( std::size_t row ) const {
+            const int c = code_ [ bwt_ [ row ]];
+            return C_ [ c ] + rank ( c, row );
+            }
+
+        bool is_sampled ( std::size_t row ) const {
+            return ( sampled_ [ row / 64 ] >> ( row % 64 )) & 1;
+            }
+
+        std::size_t sample ( std::size_t row ) const {
+            const boost::uint64_t below = sampled_ [ row / 64 ] & (( boost::uint64_t ( 1 ) << ( row % 64 )) - 1 );
+            return static_cast<std::size_t> ( samples_ [ sampled_rank_ [ row / 64 ] + popcount ( below ) ] );
+            }
+
+    //  The corpus position of the suffix in 'row'.
+    //  In a good index, the walk ends within sa_sample steps; a loaded index
+    //  whose BWT isn't one (which check_loaded can't see) could walk forever.
+        std::size_t position ( std::size_t row ) const {
+            std::size_t steps = 0;
+            while ( !is_sampled ( row )) {
+                if ( row == dollar_row_ )   // this suffix is the whole corpus
+                    return steps;
+                row = lf ( row );
+                if ( ++steps > n_ )
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+                }
+            return sample ( row ) + steps;
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_FM_INDEX_HPP
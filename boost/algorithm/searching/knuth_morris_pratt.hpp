@@ -18,11 +18,14 @@
 #include <boost/type_traits/is_same.hpp>
 
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/probes.hpp>
 
 // #define  BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DEBUG
 
 namespace boost { namespace algorithm {
 
+namespace detail { struct compiled_searcher_access; }   // see searcher_table.hpp
+
 // #define  NEW_KMP
 
 /*
@@ -52,9 +55,18 @@ namespace boost { namespace algorithm {
 #ifdef BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DEBUG
             detail::PrintTable ( skip_.begin (), skip_.end ());
 #endif
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "knuth_morris_pratt", k_pattern_length );
             }
             
         ~knuth_morris_pratt () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \brief The pattern that was passed into the constructor
+        typedef patIter pattern_iterator;
+        patIter pattern_begin () const { return pat_first; }
+        patIter pattern_end   () const { return pat_last; }
         
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -65,6 +77,39 @@ namespace boost { namespace algorithm {
         ///
         template <typename corpusIter>
         corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "knuth_morris_pratt", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "knuth_morris_pratt", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        /// \fn step ( difference_type matched, const T &c )
+        /// \brief Feeds one more element of a corpus to a search that is under way,
+        ///     for corpora that arrive one element at a time.
+        ///
+        /// \param matched  How many elements of the pattern had been matched (start with 0)
+        /// \param c        The next element of the corpus
+        /// \return         How many are matched now; pattern_length () means a match ends at 'c'
+        ///
+        template <typename T>
+        difference_type step ( difference_type matched, const T &c ) const {
+            if ( matched == k_pattern_length )
+                matched = skip_ [ matched ];
+            while ( matched >= 0 && !( pat_first [ matched ] == c ))
+                matched = skip_ [ matched ];
+            return matched + 1;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        friend struct detail::compiled_searcher_access;
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        std::vector <difference_type> skip_;
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
             BOOST_STATIC_ASSERT (( boost::is_same<
                 typename std::iterator_traits<patIter>::value_type, 
                 typename std::iterator_traits<corpusIter>::value_type>::value ));
@@ -78,12 +123,6 @@ namespace boost { namespace algorithm {
 
             return do_search   ( corpus_first, corpus_last, k_corpus_length );
             }
-    
-    private:
-/// \cond DOXYGEN_HIDE
-        patIter pat_first, pat_last;
-        const difference_type k_pattern_length;
-        std::vector <difference_type> skip_;
 
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -0,0 +1,364 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_MULTI_LITERAL_HPP
+#define BOOST_ALGORITHM_MULTI_LITERAL_HPP
+
+#include <algorithm>    // for std::min, std::equal
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <stdexcept>    // for std::length_error
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/probes.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A searcher for large sets of literal patterns (hundreds of thousands, or more).
+
+    An Aho-Corasick automaton for that many patterns is very large. This is
+    the Wu-Manber algorithm instead: a window as long as the shortest pattern
+    (up to 128 bytes) is slid along the corpus, and a hash of the last few
+    bytes of the window (the "block") is looked up in a shift table. Only
+    when the shift is zero is the window a candidate; then
+
+        * a hash of the first few bytes of the window (the prefix fingerprint)
+          is checked against a Bloom filter of the patterns' fingerprints,
+        * the patterns whose last block hashes the same way are stored next to
+          each other, with their fingerprints; those with the same fingerprint
+          are compared with the corpus.
+
+    Memory use is proportional to the total size of the patterns: the pattern
+    bytes, plus a few bytes per pattern for the tables. The shift table is
+    one byte per entry, and has at most 4M entries.
+
+    All the matches (including overlapping ones) are reported, in order of
+    position; matches at the same position are in order of pattern id.
+    A pattern's id is its position in the list given to the constructor.
+    Empty patterns never match.
+
+    Shift distances are at most the length of the shortest pattern, so a few
+    very short patterns slow the search down for all of them.
+
+    Requirements:
+        * Random access iterators
+        * The patterns and the corpus must be a one-byte integral type.
+*/
+
+/*!
+    \struct literal_match
+    \brief  A match reported by multi_literal_searcher
+*/
+    struct literal_match {
+        std::size_t pattern;    // the id of the pattern that matched
+        std::size_t position;   // the offset of the match from the start of the corpus
+
+        literal_match () : pattern ( 0 ), position ( 0 ) {}
+        literal_match ( std::size_t pat, std::size_t pos ) : pattern ( pat ), position ( pos ) {}
+
+        bool operator == ( const literal_match &rhs ) const {
+            return pattern == rhs.pattern && position == rhs.position;
+            }
+        bool operator != ( const literal_match &rhs ) const { return !( *this == rhs ); }
+        };
+
+    class multi_literal_searcher {
+    public:
+        /// \brief Build the searcher from a sequence of patterns
+        ///
+        /// \param patterns_first   The first pattern (an iterator over ranges)
+        /// \param patterns_last    One past the last pattern
+        ///
+        template <typename Iter>
+        multi_literal_searcher ( Iter patterns_first, Iter patterns_last ) {
+            init ( patterns_first, patterns_last );
+            }
+
+        template <typename Range>
+        explicit multi_literal_searcher ( const Range &patterns ) {
+            init ( boost::begin ( patterns ), boost::end ( patterns ));
+            }
+
+        ~multi_literal_searcher () {}
+
+        /// \brief The number of patterns
+        std::size_t size () const { return offsets_.size () - 1; }
+
+        /// \brief The bytes of memory held by the searcher
+        std::size_t memory_use () const {
+            return bytes_.capacity () + offsets_.capacity () * sizeof ( std::size_t )
+                + shift_.capacity () + bloom_.capacity () * sizeof ( boost::uint64_t )
+                + ( bucket_start_.capacity () + bucket_ids_.capacity () + bucket_fp_.capacity ())
+                            * sizeof ( boost::uint32_t );
+            }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out )
+        /// \brief Finds all the occurrences of all the patterns in one pass over the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          Where to write the matches (as literal_match)
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator operator () ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out ) const {
+            std::size_t matches = 0;
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "multi_literal_searcher", corpus_first, corpus_last, size ());
+            scan ( corpus_first, corpus_last, all_matches<OutputIterator> ( out, matches ));
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "multi_literal_searcher", std::distance ( corpus_first, corpus_last ), size (), matches );
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator operator () ( const Range &r, OutputIterator out ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ), out );
+            }
+
+        /// \fn find_first ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Finds the first match in the corpus
+        /// \return The position of the match and the id of the pattern, or
+        ///     ( corpus_last, size ()) if nothing matched.
+        template <typename corpusIter>
+        std::pair<corpusIter, std::size_t> find_first ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            literal_match m ( size (), 0 );
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "multi_literal_searcher", corpus_first, corpus_last, size ());
+            scan ( corpus_first, corpus_last, first_match ( m ));
+            const std::pair<corpusIter, std::size_t> retVal = m.pattern == size ()
+                ? std::make_pair ( corpus_last, size ()) : std::make_pair ( corpus_first + m.position, m.pattern );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "multi_literal_searcher", corpus_first, corpus_last, size (), retVal.first );
+            return retVal;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        enum { k_max_window = 128, k_prefix_length = 8 };
+
+        std::vector<unsigned char>  bytes_;         // all the patterns, end to end
+        std::vector<std::size_t>    offsets_;       // where each one starts; size () + 1 entries
+        std::size_t window_;                        // bytes examined at each position
+        std::size_t block_;                         // bytes hashed for the shift table
+        std::size_t shift_bits_, bucket_bits_;
+        std::vector<unsigned char>   shift_;
+        std::vector<boost::uint32_t> bucket_start_; // patterns grouped by the hash of their last block
+        std::vector<boost::uint32_t> bucket_ids_;
+        std::vector<boost::uint32_t> bucket_fp_;    // their prefix fingerprints
+        std::vector<boost::uint64_t> bloom_;
+        boost::uint32_t bloom_mask_;
+
+    //  Collectors for scan; they return true to stop the search
+        template <typename OutputIterator>
+        struct all_matches {
+            OutputIterator &out_;
+            std::size_t &count_;
+            all_matches ( OutputIterator &out, std::size_t &count ) : out_ ( out ), count_ ( count ) {}
+            bool operator () ( std::size_t pat, std::size_t pos ) const { *out_++ = literal_match ( pat, pos ); ++count_; return false; }
+            };
+
+        struct first_match {
+            literal_match &m_;
+            explicit first_match ( literal_match &m ) : m_ ( m ) {}
+            bool operator () ( std::size_t pat, std::size_t pos ) const { m_ = literal_match ( pat, pos ); return true; }
+            };
+
+        static std::size_t ceil_log2 ( std::size_t n ) {
+            std::size_t retVal = 0;
+            while (( std::size_t ( 1 ) << retVal ) < n )
+                ++retVal;
+            return retVal;
+            }
+
+        template <typename Iter>
+        boost::uint32_t block_key ( Iter p ) const {
+            boost::uint32_t key = 0;
+            for ( std::size_t i = 0; i < block_; ++i )
+                key |= boost::uint32_t ( static_cast<unsigned char> ( p [ i ] )) << ( 8 * i );
+            return key;
+            }
+
+    //  Blocks of one or two bytes index the tables directly; longer ones are hashed
+        boost::uint32_t shift_index ( boost::uint32_t key ) const {
+            return block_ <= 2 ? key : boost::uint32_t ( key * 2654435761U ) >> ( 32 - shift_bits_ );
+            }
+
+        boost::uint32_t bucket_index ( boost::uint32_t key ) const {
+            return block_ <= 2 ? key : boost::uint32_t ( key * 2654435761U ) >> ( 32 - bucket_bits_ );
+            }
+
+        template <typename Iter>
+        boost::uint32_t fingerprint ( Iter p ) const {
+            boost::uint32_t h = 2166136261U;
+            const std::size_t len = (std::min) ( window_, std::size_t ( k_prefix_length ));
+            for ( std::size_t i = 0; i < len; ++i ) {
+                h ^= static_cast<unsigned char> ( p [ i ] );
+                h *= 16777619U;
+                }
+            return h;
+            }
+
+        bool bloom_test ( boost::uint32_t fp ) const {
+            const boost::uint32_t a = fp & bloom_mask_, b = (( fp >> 16 ) | ( fp << 16 )) & bloom_mask_;
+            return (( bloom_ [ a / 64 ] >> ( a % 64 )) & ( bloom_ [ b / 64 ] >> ( b % 64 )) & 1 ) != 0;
+            }
+
+        void bloom_set ( boost::uint32_t fp ) {
+            const boost::uint32_t a = fp & bloom_mask_, b = (( fp >> 16 ) | ( fp << 16 )) & bloom_mask_;
+            bloom_ [ a / 64 ] |= boost::uint64_t ( 1 ) << ( a % 64 );
+            bloom_ [ b / 64 ] |= boost::uint64_t ( 1 ) << ( b % 64 );
+            }
+
+        template <typename Iter>
+        void init ( Iter patterns_first, Iter patterns_last ) {
+            offsets_.push_back ( 0 );
+            for ( ; patterns_first != patterns_last; ++patterns_first ) {
+                typedef typename std::iterator_traits<typename boost::range_iterator<const
+                    typename std::iterator_traits<Iter>::value_type>::type>::value_type value_type;
+                BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+                for ( typename boost::range_iterator<const typename std::iterator_traits<Iter>::value_type>::type
+                        it = boost::begin ( *patterns_first ); it != boost::end ( *patterns_first ); ++it )
+                    bytes_.push_back ( static_cast<unsigned char> ( *it ));
+                offsets_.push_back ( bytes_.size ());
+                }
+            if ( size () >= 0xffffffffU )
+                BOOST_THROW_EXCEPTION ( std::length_error ( "multi_literal_searcher: too many patterns" ));
+        //  Give back what push_back over-allocated
+            std::vector<unsigned char> ( bytes_ ).swap ( bytes_ );
+            std::vector<std::size_t> ( offsets_ ).swap ( offsets_ );
+            build ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "multi_literal_searcher", size ());
+            }
+
+        void build () {
+        //  The window is as long as the shortest (non-empty) pattern
+            const std::size_t count = size ();
+            std::size_t live = 0;
+            window_ = k_max_window;
+            for ( std::size_t i = 0; i < count; ++i )
+                if ( offsets_ [ i + 1 ] > offsets_ [ i ] ) {
+                    window_ = (std::min) ( window_, offsets_ [ i + 1 ] - offsets_ [ i ] );
+                    ++live;
+                    }
+            if ( live == 0 ) {
+                window_ = 0;
+                return;
+                }
+
+        //  Longer blocks make a crowded shift table less crowded
+            block_ = (std::min) ( window_, std::size_t ( live > 4096 ? 4 : 3 ));
+            const std::size_t blocks = live * ( window_ - block_ + 1 );
+            if ( block_ <= 2 )
+                shift_bits_ = bucket_bits_ = 8 * block_;
+            else {
+                shift_bits_  = (std::max) ( std::size_t ( 10 ), (std::min) ( std::size_t ( 22 ), ceil_log2 ( 2 * blocks )));
+                bucket_bits_ = (std::max) ( std::size_t ( 8 ),  (std::min) ( std::size_t ( 24 ), ceil_log2 ( live )));
+                }
+
+        //  The shift table
+            const unsigned char k_default_shift = static_cast<unsigned char> ( window_ - block_ + 1 );
+            shift_.assign ( std::size_t ( 1 ) << shift_bits_, k_default_shift );
+            for ( std::size_t i = 0; i < count; ++i ) {
+                if ( offsets_ [ i + 1 ] == offsets_ [ i ] ) continue;
+                const unsigned char *p = &bytes_ [ offsets_ [ i ]];
+                for ( std::size_t j = 0; j + block_ <= window_; ++j ) {
+                    unsigned char &s = shift_ [ shift_index ( block_key ( p + j )) ];
+                    const unsigned char shift = static_cast<unsigned char> ( window_ - block_ - j );
+                    if ( shift < s )
+                        s = shift;
+                    }
+                }
+
+        //  Group the patterns by their last block (a counting sort), and
+        //  set up the Bloom filter on their fingerprints; 16 bits a pattern.
+            const std::size_t k_buckets = std::size_t ( 1 ) << bucket_bits_;
+            const std::size_t bloom_bits = std::size_t ( 1 ) << (std::max) ( std::size_t ( 6 ), ceil_log2 ( 16 * live ));
+            bloom_.assign ( bloom_bits / 64, 0 );
+            bloom_mask_ = static_cast<boost::uint32_t> ( bloom_bits - 1 );
+            bucket_start_.assign ( k_buckets + 1, 0 );
+            std::vector<boost::uint32_t> which ( count );
+            for ( std::size_t i = 0; i < count; ++i ) {
+                if ( offsets_ [ i + 1 ] == offsets_ [ i ] ) continue;
+                which [ i ] = bucket_index ( block_key ( &bytes_ [ offsets_ [ i ] + window_ - block_ ] ));
+                ++bucket_start_ [ which [ i ] + 1 ];
+                }
+            for ( std::size_t b = 0; b < k_buckets; ++b )
+                bucket_start_ [ b + 1 ] += bucket_start_ [ b ];
+            bucket_ids_.resize ( live );
+            bucket_fp_.resize ( live );
+            std::vector<boost::uint32_t> next ( bucket_start_.begin (), bucket_start_.end () - 1 );
+            for ( std::size_t i = 0; i < count; ++i ) {
+                if ( offsets_ [ i + 1 ] == offsets_ [ i ] ) continue;
+                const boost::uint32_t fp = fingerprint ( &bytes_ [ offsets_ [ i ]] );
+                const boost::uint32_t slot = next [ which [ i ]]++;
+                bucket_ids_ [ slot ] = static_cast<boost::uint32_t> ( i );
+                bucket_fp_  [ slot ] = fp;
+                bloom_set ( fp );
+                }
+            }
+
+        template <typename corpusIter, typename Collector>
+        void scan ( corpusIter corpus_first, corpusIter corpus_last, Collector collect ) const {
+            typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+
+            const std::size_t n = std::distance ( corpus_first, corpus_last );
+            if ( window_ == 0 || n < window_ )
+                return;
+
+            const std::size_t last_window = n - window_;
+            std::size_t pos = 0;
+            while ( pos <= last_window ) {
+                const boost::uint32_t key = block_key ( corpus_first + ( pos + window_ - block_ ));
+                const std::size_t shift = shift_ [ shift_index ( key ) ];
+                if ( shift != 0 ) {
+                    pos += shift;
+                    continue;
+                    }
+
+            //  A candidate; check the Bloom filter, then the patterns in the bucket
+                const boost::uint32_t fp = fingerprint ( corpus_first + pos );
+                if ( bloom_test ( fp )) {
+                    const boost::uint32_t b = bucket_index ( key );
+                    for ( boost::uint32_t k = bucket_start_ [ b ]; k < bucket_start_ [ b + 1 ]; ++k ) {
+                        if ( bucket_fp_ [ k ] != fp )
+                            continue;
+                        const std::size_t id = bucket_ids_ [ k ];
+                        const std::size_t len = offsets_ [ id + 1 ] - offsets_ [ id ];
+                        if ( len <= n - pos && matches ( &bytes_ [ offsets_ [ id ]], len, corpus_first + pos ))
+                            if ( collect ( id, pos ))
+                                return;
+                        }
+                    }
+                ++pos;
+                }
+            }
+
+        template <typename corpusIter>
+        static bool matches ( const unsigned char *pat, std::size_t len, corpusIter it ) {
+            for ( std::size_t i = 0; i < len; ++i, ++it )
+                if ( pat [ i ] != static_cast<unsigned char> ( *it ))
+                    return false;
+            return true;
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_MULTI_LITERAL_HPP
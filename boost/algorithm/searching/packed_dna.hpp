@@ -0,0 +1,411 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+/// \file  packed_dna.hpp
+/// \brief A nucleotide sequence stored two bits per base, and a searcher
+///     that compares the packed words directly.
+
+#ifndef BOOST_ALGORITHM_PACKED_DNA_HPP
+#define BOOST_ALGORITHM_PACKED_DNA_HPP
+
+#include <cstddef>      // for std::ptrdiff_t, std::size_t
+#include <iterator>     // for std::random_access_iterator_tag
+#include <stdexcept>
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/algorithm/probes.hpp>
+
+namespace boost { namespace algorithm {
+
+/*!
+    \struct non_dna_input
+    \brief  Thrown when a character other than A, C, G, T (or U) is packed
+*/
+struct non_dna_input : virtual boost::exception, virtual std::exception {};
+
+namespace detail {
+/// \cond DOXYGEN_HIDE
+
+//  A = 0, C = 1, G = 2, T (or U) = 3; either case
+    inline unsigned dna_char_to_code ( char c ) {
+        switch ( c ) {
+            case 'A': case 'a':           return 0;
+            case 'C': case 'c':           return 1;
+            case 'G': case 'g':           return 2;
+            case 'T': case 't':
+            case 'U': case 'u':           return 3;
+            }
+        BOOST_THROW_EXCEPTION (non_dna_input ());
+        return 0;   // keep dumb compilers happy
+        }
+
+    inline char dna_code_to_char ( unsigned code ) {
+        return "ACGT" [ code & 0x03 ];
+        }
+
+/// \endcond
+}
+
+/// \class packed_dna_sequence
+/// \brief A sequence of nucleotides, stored 32 to a 64-bit word.
+///
+/// Base 'i' lives in bits 2*(i%32) and 2*(i%32)+1 of word i/32.
+/// The iterators are random-access, and yield the bases as the characters
+/// 'A', 'C', 'G' and 'T', so a packed sequence can be searched with any of
+/// the other searchers using a character pattern.
+///
+/// Like std::vector<bool>'s, they are proxy iterators: there is no char in
+/// memory for a base, so operator * returns one by value ('reference' is
+/// char), and there is no operator ->. They are tagged random-access, and
+/// work with the algorithms that only read through them (the searchers,
+/// std::equal, std::search, std::reverse_iterator, ...), but, strictly, the
+/// standard requires a forward iterator's 'reference' to be a real reference.
+/// Code that takes the address of *it, or keeps a const char & to it past the
+/// end of the expression, won't work.
+class packed_dna_sequence {
+public:
+    typedef char            value_type;
+    typedef std::size_t     size_type;
+    typedef std::ptrdiff_t  difference_type;
+    typedef boost::uint64_t word_type;
+
+    enum { k_bases_per_word = 32 };
+
+    class const_iterator {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef char                            value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef const char *                    pointer;    // there is no operator ->
+        typedef char                            reference;  // a proxy: the base, by value
+
+        const_iterator () : seq_ ( NULL ), pos_ ( 0 ) {}
+
+        char operator *  () const                   { return (*seq_) [ pos_ ]; }
+        char operator [] ( difference_type n ) const { return (*seq_) [ pos_ + n ]; }
+
+        const_iterator & operator ++ ()             { ++pos_; return *this; }
+        const_iterator & operator -- ()             { --pos_; return *this; }
+        const_iterator   operator ++ ( int )        { const_iterator t ( *this ); ++pos_; return t; }
+        const_iterator   operator -- ( int )        { const_iterator t ( *this ); --pos_; return t; }
+        const_iterator & operator += ( difference_type n ) { pos_ += n; return *this; }
+        const_iterator & operator -= ( difference_type n ) { pos_ -= n; return *this; }
+        const_iterator   operator +  ( difference_type n ) const { return const_iterator ( seq_, pos_ + n ); }
+        const_iterator   operator -  ( difference_type n ) const { return const_iterator ( seq_, pos_ - n ); }
+        friend const_iterator operator + ( difference_type n, const const_iterator &it ) { return it + n; }
+
+        difference_type operator - ( const const_iterator &rhs ) const {
+            return static_cast<difference_type> ( pos_ ) - static_cast<difference_type> ( rhs.pos_ );
+            }
+
+        bool operator == ( const const_iterator &rhs ) const { return pos_ == rhs.pos_ && seq_ == rhs.seq_; }
+        bool operator != ( const const_iterator &rhs ) const { return !( *this == rhs ); }
+        bool operator <  ( const const_iterator &rhs ) const { return pos_ <  rhs.pos_; }
+        bool operator >  ( const const_iterator &rhs ) const { return pos_ >  rhs.pos_; }
+        bool operator <= ( const const_iterator &rhs ) const { return pos_ <= rhs.pos_; }
+        bool operator >= ( const const_iterator &rhs ) const { return pos_ >= rhs.pos_; }
+
+    //  Where we are, for the packed searchers
+        const packed_dna_sequence *sequence () const { return seq_; }
+        size_type position () const { return pos_; }
+
+    private:
+        friend class packed_dna_sequence;
+        const_iterator ( const packed_dna_sequence *seq, size_type pos ) : seq_ ( seq ), pos_ ( pos ) {}
+
+        const packed_dna_sequence *seq_;
+        size_type pos_;
+        };
+
+    typedef const_iterator iterator;
+
+    packed_dna_sequence () : size_ ( 0 ), words_ ( 1, 0 ) {}
+
+    /// \brief Pack the characters in [first, last)
+    /// \throws non_dna_input if any of them is not a nucleotide
+    template <typename InputIterator>
+    packed_dna_sequence ( InputIterator first, InputIterator last ) : size_ ( 0 ), words_ ( 1, 0 ) {
+        for ( ; first != last; ++first )
+            push_back ( *first );
+        }
+
+    /// \brief Pack the characters in a range
+    /// \throws non_dna_input if any of them is not a nucleotide
+    template <typename Range>
+    explicit packed_dna_sequence ( const Range &r ) : size_ ( 0 ), words_ ( 1, 0 ) {
+        reserve ( std::distance ( boost::begin ( r ), boost::end ( r )));
+        for ( typename boost::range_iterator<const Range>::type it = boost::begin ( r ); it != boost::end ( r ); ++it )
+            push_back ( *it );
+        }
+
+    void push_back ( char c ) {
+        const word_type code = detail::dna_char_to_code ( c );
+        if ( size_ / k_bases_per_word + 1 >= words_.size ())
+            words_.push_back ( 0 );
+        words_ [ size_ / k_bases_per_word ] |= code << ( 2 * ( size_ % k_bases_per_word ));
+        ++size_;
+        }
+
+    void reserve ( size_type n ) { words_.reserve ( n / k_bases_per_word + 2 ); }
+    void clear () { size_ = 0; words_.assign ( 1, 0 ); }
+
+    size_type size  () const { return size_; }
+    bool      empty () const { return size_ == 0; }
+
+    /// \brief The base at position i, as 0 (A), 1 (C), 2 (G) or 3 (T)
+    unsigned code ( size_type i ) const {
+        BOOST_ASSERT ( i < size_ );
+        return static_cast<unsigned> ( words_ [ i / k_bases_per_word ] >> ( 2 * ( i % k_bases_per_word ))) & 0x03;
+        }
+
+    /// \brief The base at position i, as a character
+    char operator [] ( size_type i ) const { return detail::dna_code_to_char ( code ( i )); }
+
+    /// \brief The (up to) 32 bases starting at position 'pos', packed into a word.
+    /// Positions past the end of the sequence read as zero.
+    word_type window ( size_type pos ) const {
+        BOOST_ASSERT ( pos < size_ );
+        const size_type w     = pos / k_bases_per_word;
+        const size_type shift = 2 * ( pos % k_bases_per_word );
+        word_type retVal = words_ [ w ] >> shift;
+    //  There is always a word after the last base, so this is safe
+        if ( shift != 0 )
+            retVal |= words_ [ w + 1 ] << ( 64 - shift );
+        return retVal;
+        }
+
+    /// \brief The packed storage; always has (at least) one zero word past the last base
+    const std::vector<word_type> &words () const { return words_; }
+
+    const_iterator begin () const { return const_iterator ( this, 0 ); }
+    const_iterator end   () const { return const_iterator ( this, size_ ); }
+
+private:
+    size_type size_;
+    std::vector<word_type> words_;
+    };
+
+
+/*
+    A searcher for packed_dna_sequences.
+
+    Instead of comparing one base at a time, this compares 32 bases at a time,
+    by pulling a (possibly unaligned) word out of the corpus and comparing it
+    against the packed pattern under a mask.
+
+    For patterns of 12 or more bases, it also does a Horspool search over
+    packed 8-mers: the 16 bits for the eight bases ending at the end of the
+    window index a 64K-entry shift table. Every 8-mer is in the table, so
+    there are no collisions, and the shifts are close to the pattern length
+    even though there are only four letters in the alphabet.
+
+    The interface is the same as the other searchers; the corpus is a pair of
+    packed_dna_sequence::const_iterators (or a packed_dna_sequence). find_in
+    searches bases that are packed the same way somewhere else (a mapped
+    file, say): anything with packed_dna_sequence's window ( pos ) will do.
+*/
+
+    class packed_dna_searcher {
+        typedef packed_dna_sequence::word_type      word_type;
+        typedef packed_dna_sequence::size_type      size_type;
+        typedef packed_dna_sequence::const_iterator corpus_iterator;
+        typedef unsigned short                      shift_type;
+
+        static const size_type k_qgram_length = 8;
+        static const size_type k_min_qgram_pattern = 12;
+        static const shift_type k_max_shift = 0xFFFF;
+
+    public:
+        /// \brief Pack the pattern in [first, last)
+        /// \throws non_dna_input if the pattern is not all nucleotides
+        template <typename patIter>
+        packed_dna_searcher ( patIter first, patIter last )
+                : pattern_ ( first, last ), mismatch_shift_ ( 1 ) {
+            build_tables ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "packed_dna_searcher", pattern_.size ());
+            }
+
+        explicit packed_dna_searcher ( const packed_dna_sequence &pattern )
+                : pattern_ ( pattern ), mismatch_shift_ ( 1 ) {
+            build_tables ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "packed_dna_searcher", pattern_.size ());
+            }
+
+        ~packed_dna_searcher () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return pattern_.size (); }
+
+        /// \fn operator ( corpus_iterator corpus_first, corpus_iterator corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        corpus_iterator operator () ( corpus_iterator corpus_first, corpus_iterator corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "packed_dna_searcher", corpus_first, corpus_last, pattern_.size ());
+            const corpus_iterator retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "packed_dna_searcher", corpus_first, corpus_last, pattern_.size (), retVal );
+            return retVal;
+            }
+
+        corpus_iterator operator () ( const packed_dna_sequence &corpus ) const {
+            return (*this) ( corpus.begin (), corpus.end ());
+            }
+
+        /// \fn find_in ( const PackedSequence &corpus, std::size_t first, std::size_t last )
+        /// \brief Searches bases [first, last) of anything packed like a packed_dna_sequence
+        ///
+        /// \param corpus   Has window ( pos ), the 32 bases from 'pos' in a word, as
+        ///                 packed_dna_sequence::window; positions past 'last' may read as anything
+        /// \param first    The position to start searching at
+        /// \param last     One past the last position to search
+        /// \return         The position of the first match, or 'last' if there is none
+        ///
+        template <typename PackedSequence>
+        std::size_t find_in ( const PackedSequence &corpus, std::size_t first, std::size_t last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "packed_dna_searcher", last - first, pattern_.size ());
+            const size_type retVal = this->find_position ( corpus, first, last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "packed_dna_searcher", last - first, pattern_.size (),
+                        retVal == last ? std::ptrdiff_t ( -1 ) : static_cast<std::ptrdiff_t> ( retVal - first ));
+            return retVal;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        packed_dna_sequence pattern_;
+        std::vector<word_type> chunks_;     // the pattern, 32 bases at a time
+        std::vector<word_type> masks_;      // which bits of each chunk are used
+        std::vector<shift_type> skip_;      // indexed by packed 8-mer; empty for short patterns
+        size_type mismatch_shift_;
+
+    //  The search itself; operator () adds the trace points
+        corpus_iterator find ( corpus_iterator corpus_first, corpus_iterator corpus_last ) const {
+            BOOST_ASSERT ( corpus_first.sequence () == corpus_last.sequence ());
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+
+            const size_type first = corpus_first.position ();
+            const size_type last  = corpus_last.position ();
+            const size_type found = find_position ( *corpus_first.sequence (), first, last );
+            return found == last ? corpus_last : corpus_first + ( found - first );
+            }
+
+        template <typename PackedSequence>
+        size_type find_position ( const PackedSequence &corpus, size_type first, size_type last ) const {
+            if ( first == last )     return last;    // if nothing to search, we didn't find it!
+            if ( pattern_.empty ())  return first;   // empty pattern matches at start
+
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( last - first < pattern_.size ())
+                return last;
+
+            return skip_.empty ()
+                ? slide_search    ( corpus, first, last )
+                : horspool_search ( corpus, first, last );
+            }
+
+        void build_tables () {
+            const size_type m = pattern_.size ();
+            for ( size_type i = 0; i < m; i += packed_dna_sequence::k_bases_per_word ) {
+                word_type mask = ~word_type ( 0 );
+                if ( m - i < packed_dna_sequence::k_bases_per_word )
+                    mask = ( word_type ( 1 ) << ( 2 * ( m - i ))) - 1;
+                chunks_.push_back ( pattern_.window ( i ) & mask );
+                masks_.push_back  ( mask );
+                }
+
+            if ( m >= k_min_qgram_pattern ) {
+                skip_.assign ( 1U << ( 2 * k_qgram_length ), clamp_shift ( m - k_qgram_length + 1 ));
+                for ( size_type i = k_qgram_length - 1; i < m - 1; ++i )
+                    skip_ [ qgram ( pattern_, i ) ] = clamp_shift ( m - 1 - i );
+                const std::size_t last = qgram ( pattern_, m - 1 );
+                mismatch_shift_ = skip_ [ last ];
+                skip_ [ last ] = 0;
+                }
+            }
+
+        static shift_type clamp_shift ( size_type s ) {
+            if ( s > k_max_shift )
+                return k_max_shift;
+            return static_cast<shift_type> ( s );
+            }
+
+    //  The eight bases that end at position 'end'
+        template <typename PackedSequence>
+        static std::size_t qgram ( const PackedSequence &seq, size_type end ) {
+            return static_cast<std::size_t> ( seq.window ( end + 1 - k_qgram_length ) & 0xFFFF );
+            }
+
+    //  Does the pattern match the corpus at 'pos'?
+        template <typename PackedSequence>
+        bool matches_at ( const PackedSequence &corpus, size_type pos ) const {
+            for ( size_type i = 0; i < chunks_.size (); ++i )
+                if (( corpus.window ( pos + i * packed_dna_sequence::k_bases_per_word ) & masks_ [ i ] ) != chunks_ [ i ] )
+                    return false;
+            return true;
+            }
+
+    //  Try every position, 32 bases at a time
+        template <typename PackedSequence>
+        size_type slide_search ( const PackedSequence &corpus, size_type first, size_type last ) const {
+            const size_type last_pos = last - pattern_.size ();
+            const word_type chunk0 = chunks_ [ 0 ];
+            const word_type mask0  = masks_  [ 0 ];
+            for ( size_type pos = first; pos <= last_pos; ++pos )
+                if (( corpus.window ( pos ) & mask0 ) == chunk0 && matches_at ( corpus, pos ))
+                    return pos;
+            return last;
+            }
+
+    //  Horspool on packed 8-mers
+        template <typename PackedSequence>
+        size_type horspool_search ( const PackedSequence &corpus, size_type first, size_type last ) const {
+            const size_type m = pattern_.size ();
+            size_type end = first + m - 1;  // the corpus position under the end of the pattern
+            for (;;) {
+                shift_type k;
+                while (( k = skip_ [ qgram ( corpus, end ) ] ) != 0 ) {
+                    end += k;
+                    if ( end >= last )
+                        return last;
+                    }
+
+                if ( matches_at ( corpus, end + 1 - m ))
+                    return end + 1 - m;
+
+                end += mismatch_shift_;
+                if ( end >= last )
+                    return last;
+                }
+            }
+/// \endcond
+        };
+
+/// \fn packed_dna_search ( const packed_dna_sequence &corpus, const packed_dna_sequence &pattern )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus   The sequence to search
+/// \param pattern  The sequence to search for
+///
+    inline packed_dna_sequence::const_iterator packed_dna_search (
+            const packed_dna_sequence &corpus, const packed_dna_sequence &pattern ) {
+        packed_dna_searcher pds ( pattern );
+        return pds ( corpus );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_PACKED_DNA_HPP
@@ -0,0 +1,343 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_PREFIX_MATCHER_HPP
+#define BOOST_ALGORITHM_PREFIX_MATCHER_HPP
+
+#include <algorithm>    // for std::sort, std::min
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <stdexcept>    // for std::length_error
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A compiled set of prefixes, for classifying keys by which prefixes they
+    start with (URL routing, ACL tables, ...).
+
+    The prefixes are built into a trie, stored in a few flat arrays:
+
+        * Nodes with many children (and always the root) have a 256 entry
+          table, indexed by the next byte of the key.
+        * Nodes with only a few have a short list of (byte, child) pairs,
+          which is searched in order.
+        * Runs of nodes with one child and no prefix ending at them are
+          collapsed: the node at the end of the run holds the bytes of the
+          run, which are compared all at once.
+
+    longest () finds the longest prefix of a key that is in the set, and
+    all () finds every one of them. longest_each () does many keys at once:
+    it walks the trie for eight keys in turn, a node at a time, and asks the
+    processor to fetch each key's next node while it works on the others, so
+    that the cache misses overlap instead of being waited for one by one.
+
+    A prefix's id is its position in the list given to the constructor. If
+    the same prefix is given more than once, longest () reports the smallest
+    id, and all () reports all of them. An empty prefix matches every key.
+
+    Requirements:
+        * The prefixes and the keys must be a one-byte integral type.
+        * Random access iterators for the keys
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    const boost::uint32_t prefix_dense = 0xFFFFFFFFU;   // as a child count: a 256 entry table
+    const boost::uint32_t prefix_none  = 0xFFFFFFFFU;   // as a child: there isn't one
+
+    inline void prefix_prefetch ( const void *p ) {
+#if defined ( __GNUC__ )
+        __builtin_prefetch ( p );
+#else
+        (void) p;
+#endif
+        }
+}
+/// \endcond
+
+    class prefix_matcher {
+    public:
+        /// \brief Build the matcher from a sequence of prefixes
+        ///
+        /// \param patterns_first   The first prefix (an iterator over ranges)
+        /// \param patterns_last    One past the last prefix
+        ///
+        template <typename Iter>
+        prefix_matcher ( Iter patterns_first, Iter patterns_last ) {
+            init ( patterns_first, patterns_last );
+            }
+
+        template <typename Range>
+        explicit prefix_matcher ( const Range &patterns ) {
+            init ( boost::begin ( patterns ), boost::end ( patterns ));
+            }
+
+        ~prefix_matcher () {}
+
+        /// \brief The number of prefixes; also the id returned when nothing matches
+        std::size_t size () const { return count_; }
+
+        /// \brief The bytes of memory held by the matcher
+        std::size_t memory_use () const {
+            return nodes_.capacity () * sizeof ( node ) + bytes_.capacity () + labels_.capacity ()
+                + ( children_.capacity () + ids_.capacity ()) * sizeof ( boost::uint32_t );
+            }
+
+        /// \fn longest ( keyIter key_first, keyIter key_last )
+        /// \brief Finds the longest prefix of the key that is in the set
+        /// \return The id of the prefix, or size () if there isn't one
+        ///
+        template <typename keyIter>
+        std::size_t longest ( keyIter key_first, keyIter key_last ) const {
+            lane<keyIter> l ( key_first, key_last, count_ );
+            null_output none;
+            while ( step ( l, none ))
+                ;
+            return l.best;
+            }
+
+        template <typename Range>
+        std::size_t longest ( const Range &key ) const {
+            return longest ( boost::begin ( key ), boost::end ( key ));
+            }
+
+        /// \fn all ( keyIter key_first, keyIter key_last, OutputIterator out )
+        /// \brief Finds every prefix of the key that is in the set
+        /// \return The output iterator, after the ids; shortest prefix first
+        ///
+        template <typename keyIter, typename OutputIterator>
+        OutputIterator all ( keyIter key_first, keyIter key_last, OutputIterator out ) const {
+            lane<keyIter> l ( key_first, key_last, count_ );
+            while ( step ( l, out ))
+                ;
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator all ( const Range &key, OutputIterator out ) const {
+            return all ( boost::begin ( key ), boost::end ( key ), out );
+            }
+
+        /// \fn longest_each ( Iter keys_first, Iter keys_last, OutputIterator out )
+        /// \brief Finds the longest matching prefix of each of a batch of keys
+        ///
+        /// \param keys_first   The first key (an iterator over ranges)
+        /// \param keys_last    One past the last key
+        /// \param out          Where to write the id for each key, in order (size () for none)
+        ///
+        template <typename Iter, typename OutputIterator>
+        OutputIterator longest_each ( Iter keys_first, Iter keys_last, OutputIterator out ) const {
+            typedef typename boost::range_iterator<const typename std::iterator_traits<Iter>::value_type>::type keyIter;
+            std::vector<lane<keyIter> > lanes;
+            lanes.reserve ( k_lanes );
+            while ( keys_first != keys_last ) {
+                lanes.clear ();
+                for ( ; keys_first != keys_last && lanes.size () < k_lanes; ++keys_first )
+                    lanes.push_back ( lane<keyIter> ( boost::begin ( *keys_first ), boost::end ( *keys_first ), count_ ));
+
+            //  One node for each key in turn, until they're all done
+                null_output none;
+                for ( std::size_t live = lanes.size (); live != 0; ) {
+                    live = 0;
+                    for ( std::size_t i = 0; i < lanes.size (); ++i )
+                        if ( !lanes [ i ].done ) {
+                            if ( step ( lanes [ i ], none ))
+                                ++live;
+                            else
+                                lanes [ i ].done = true;
+                            }
+                    }
+                for ( std::size_t i = 0; i < lanes.size (); ++i )
+                    *out++ = lanes [ i ].best;
+                }
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator longest_each ( const Range &keys, OutputIterator out ) const {
+            return longest_each ( boost::begin ( keys ), boost::end ( keys ), out );
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        enum { k_lanes = 8, k_max_sparse = 16 };
+
+        struct node {
+            boost::uint32_t path, path_length;      // bytes to match on entering the node, in bytes_
+            boost::uint32_t ids, id_count;          // the prefixes that end here, in ids_
+            boost::uint32_t children, child_count;  // in children_ (and labels_, if sparse)
+            };
+
+        std::size_t count_;
+        std::vector<node> nodes_;               // nodes_ [ 0 ] is the root
+        std::vector<unsigned char> bytes_;      // the collapsed paths
+        std::vector<unsigned char> labels_;     // the bytes for sparse children
+        std::vector<boost::uint32_t> children_;
+        std::vector<boost::uint32_t> ids_;
+
+    //  The state of one key's walk down the trie
+        template <typename keyIter>
+        struct lane {
+            lane ( keyIter f, keyIter l, std::size_t none )
+                : first ( f ), length ( std::distance ( f, l )), pos ( 0 ), n ( 0 ), best ( none ), done ( false ) {}
+            keyIter first;
+            std::size_t length, pos;
+            boost::uint32_t n;      // the node we're about to enter
+            std::size_t best;
+            bool done;
+            };
+
+        struct null_output {
+            null_output &operator *  ()    { return *this; }
+            null_output &operator ++ ( int ) { return *this; }
+            null_output &operator =  ( boost::uint32_t ) { return *this; }
+            };
+
+    //  Enter the lane's node; report the prefixes ending there, and move
+    //  to the next one. Returns false when the walk is over.
+        template <typename keyIter, typename OutputIterator>
+        bool step ( lane<keyIter> &l, OutputIterator &out ) const {
+            const node &nd = nodes_ [ l.n ];
+            if ( l.length - l.pos < nd.path_length )
+                return false;
+            const unsigned char *path = nd.path_length ? &bytes_ [ nd.path ] : NULL;
+            for ( boost::uint32_t i = 0; i < nd.path_length; ++i )
+                if ( static_cast<unsigned char> ( l.first [ l.pos + i ] ) != path [ i ] )
+                    return false;
+            l.pos += nd.path_length;
+            if ( nd.id_count != 0 ) {
+                l.best = ids_ [ nd.ids ];
+                for ( boost::uint32_t i = 0; i < nd.id_count; ++i )
+                    *out++ = ids_ [ nd.ids + i ];
+                }
+            if ( l.pos == l.length )
+                return false;
+
+            const boost::uint32_t next = child ( nd, static_cast<unsigned char> ( l.first [ l.pos ] ));
+            if ( next == detail::prefix_none )
+                return false;
+            detail::prefix_prefetch ( &nodes_ [ next ] );
+            ++l.pos;
+            l.n = next;
+            return true;
+            }
+
+        boost::uint32_t child ( const node &nd, unsigned char c ) const {
+            if ( nd.child_count == detail::prefix_dense )
+                return children_ [ nd.children + c ];
+            for ( boost::uint32_t i = 0; i < nd.child_count; ++i )
+                if ( labels_ [ nd.children + i ] == c )
+                    return children_ [ nd.children + i ];
+            return detail::prefix_none;
+            }
+
+        template <typename Iter>
+        void init ( Iter patterns_first, Iter patterns_last ) {
+            std::vector<std::vector<unsigned char> > patterns;
+            for ( ; patterns_first != patterns_last; ++patterns_first ) {
+                typedef typename boost::range_iterator<const typename std::iterator_traits<Iter>::value_type>::type pat_iter;
+                typedef typename std::iterator_traits<pat_iter>::value_type value_type;
+                BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+                patterns.push_back ( std::vector<unsigned char> ());
+                for ( pat_iter it = boost::begin ( *patterns_first ); it != boost::end ( *patterns_first ); ++it )
+                    patterns.back ().push_back ( static_cast<unsigned char> ( *it ));
+                }
+            count_ = patterns.size ();
+            if ( count_ >= 0xffffffffU )
+                BOOST_THROW_EXCEPTION ( std::length_error ( "prefix_matcher: too many prefixes" ));
+
+        //  Sorted, a prefix comes before everything that starts with it; equal ones by id
+            std::vector<boost::uint32_t> order ( count_ );
+            for ( std::size_t i = 0; i < count_; ++i )
+                order [ i ] = static_cast<boost::uint32_t> ( i );
+            std::sort ( order.begin (), order.end (), by_pattern ( patterns ));
+
+            nodes_.push_back ( node ());
+            build ( patterns, order, 0, count_, 0, 0 );
+            if ( bytes_.size () >= 0xffffffffU || children_.size () >= 0xffffffffU )
+                BOOST_THROW_EXCEPTION ( std::length_error ( "prefix_matcher: too many prefixes" ));
+            }
+
+        struct by_pattern {
+            const std::vector<std::vector<unsigned char> > &p_;
+            explicit by_pattern ( const std::vector<std::vector<unsigned char> > &p ) : p_ ( p ) {}
+            bool operator () ( boost::uint32_t a, boost::uint32_t b ) const {
+                return p_ [ a ] < p_ [ b ] || ( p_ [ a ] == p_ [ b ] && a < b );
+                }
+            };
+
+    //  Fill in node 'n' from the patterns order [ lo, hi ), which all agree up to 'depth'
+        void build ( const std::vector<std::vector<unsigned char> > &patterns, const std::vector<boost::uint32_t> &order,
+                     std::size_t lo, std::size_t hi, std::size_t depth, boost::uint32_t n ) {
+        //  Collapse the bytes they all share (but not at the root, which is always a table)
+            std::size_t end = depth;
+            if ( n != 0 ) {
+                const std::vector<unsigned char> &a = patterns [ order [ lo ]], &b = patterns [ order [ hi - 1 ]];
+                const std::size_t limit = (std::min) ( a.size (), b.size ());
+                while ( end < limit && a [ end ] == b [ end ] )
+                    ++end;
+                }
+            nodes_ [ n ].path        = static_cast<boost::uint32_t> ( bytes_.size ());
+            nodes_ [ n ].path_length = static_cast<boost::uint32_t> ( end - depth );
+            if ( end > depth )
+                bytes_.insert ( bytes_.end (), patterns [ order [ lo ]].begin () + depth, patterns [ order [ lo ]].begin () + end );
+
+        //  The patterns that end here come first
+            nodes_ [ n ].ids = static_cast<boost::uint32_t> ( ids_.size ());
+            for ( ; lo < hi && patterns [ order [ lo ]].size () == end; ++lo )
+                ids_.push_back ( order [ lo ] );
+            nodes_ [ n ].id_count = static_cast<boost::uint32_t> ( ids_.size () - nodes_ [ n ].ids );
+
+        //  The rest are grouped by their next byte
+            std::vector<std::size_t> starts;
+            for ( std::size_t i = lo; i < hi; ++i )
+                if ( i == lo || patterns [ order [ i ]][ end ] != patterns [ order [ i - 1 ]][ end ] )
+                    starts.push_back ( i );
+            starts.push_back ( hi );
+            const std::size_t groups = starts.size () - 1;
+
+            const bool dense = n == 0 || groups > k_max_sparse;
+            const std::size_t slots = dense ? 256 : groups;
+            nodes_ [ n ].children    = static_cast<boost::uint32_t> ( children_.size ());
+            nodes_ [ n ].child_count = dense ? detail::prefix_dense : static_cast<boost::uint32_t> ( groups );
+            children_.resize ( children_.size () + slots, detail::prefix_none );
+            if ( !dense )
+                labels_.resize ( children_.size (), 0 );
+
+        //  Make all the children first, so that they're next to each other
+            const boost::uint32_t first_child = static_cast<boost::uint32_t> ( nodes_.size ());
+            nodes_.resize ( nodes_.size () + groups );
+            for ( std::size_t g = 0; g < groups; ++g ) {
+                const unsigned char c = patterns [ order [ starts [ g ]]][ end ];
+                const std::size_t slot = nodes_ [ n ].children + ( dense ? c : g );
+                children_ [ slot ] = static_cast<boost::uint32_t> ( first_child + g );
+                if ( !dense )
+                    labels_ [ slot ] = c;
+                }
+            for ( std::size_t g = 0; g < groups; ++g )
+                build ( patterns, order, starts [ g ], starts [ g + 1 ], end + 1, static_cast<boost::uint32_t> ( first_child + g ));
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_PREFIX_MATCHER_HPP
@@ -0,0 +1,260 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_QGRAM_HORSPOOL_SEARCH_HPP
+#define BOOST_ALGORITHM_QGRAM_HORSPOOL_SEARCH_HPP
+
+#include <algorithm>    // for std::equal, std::search
+#include <iterator>     // for std::iterator_traits
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+
+#include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/probes.hpp>
+
+// #define  BOOST_ALGORITHM_QGRAM_HORSPOOL_DEBUG
+
+namespace boost { namespace algorithm {
+
+/*
+    A Boyer-Moore-Horspool search that skips on q-grams (runs of 'Q' elements)
+    instead of single elements. This is the single-pattern case of the
+    Wu-Manber algorithm.
+
+    With a small alphabet (DNA, say, or mostly-binary data), almost every
+    element of the corpus appears near the end of the pattern, and BMH's
+    shifts are only one to three elements long. A run of two or three elements
+    is much less likely to appear in the pattern, so the shifts grow with the
+    length of the pattern again.
+
+    The q-gram is hashed into a table with 64K entries. For Q == 2 the hash is
+    just the two bytes, so there are no collisions. For larger Q, collisions
+    only make the shifts shorter, never wrong.
+
+    Like tuned_boyer_moore, the entry for the last q-gram of the pattern is
+    zero, and the search loop only stops to compare the pattern when it gets
+    a zero shift.
+
+    Patterns shorter than Q are handed off to std::search.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type, which must be a
+            one-byte integral type (char, unsigned char, etc).
+        * 2 <= Q <= 4
+
+    Wu, S. and Manber, U. "A Fast Algorithm for Multi-Pattern Searching",
+        Technical Report TR-94-17, University of Arizona (1994)
+*/
+
+    template <typename patIter, std::size_t Q = 2>
+    class qgram_horspool {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename boost::make_unsigned<value_type>::type unsigned_value_type;
+        typedef unsigned short shift_type;
+
+        BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+        BOOST_STATIC_ASSERT (( Q >= 2 && Q <= 4 ));
+
+        static const std::size_t k_table_size = 1U << 16;
+        static const std::size_t k_hash_shift = 16 / Q;
+        static const shift_type  k_max_shift  = 0xFFFF;
+
+    public:
+        qgram_horspool ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  skip_ (), mismatch_shift_ ( 1 ) {
+            if ( k_pattern_length >= static_cast<difference_type> ( Q ))
+                build_skip_table ();
+#ifdef BOOST_ALGORITHM_QGRAM_HORSPOOL_DEBUG
+            detail::PrintTable ( skip_.begin (), skip_.end ());
+#endif
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "qgram_horspool", k_pattern_length );
+            }
+
+        ~qgram_horspool () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \brief The pattern that was passed into the constructor
+        typedef patIter pattern_iterator;
+        patIter pattern_begin () const { return pat_first; }
+        patIter pattern_end   () const { return pat_last; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "qgram_horspool", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "qgram_horspool", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        std::vector<shift_type> skip_;
+        difference_type mismatch_shift_;
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+        //  Too short to have a q-gram
+            if ( skip_.empty ())
+                return std::search ( corpus_first, corpus_last, pat_first, pat_last );
+
+        //  Do the search
+            return this->do_search ( corpus_first, corpus_last, k_corpus_length );
+            }
+
+    //  Hash the Q elements that end at 'last'
+        template <typename Iter>
+        static std::size_t hash ( Iter last ) {
+            std::size_t h = 0;
+            for ( std::size_t i = Q; i > 0; --i )
+                h = ( h << k_hash_shift ) ^ static_cast<unsigned_value_type> ( *( last - i ));
+            return h & ( k_table_size - 1 );
+            }
+
+        static shift_type clamp_shift ( difference_type s ) {
+            if ( s > k_max_shift )
+                return k_max_shift;
+            return static_cast<shift_type> ( s );
+            }
+
+        void build_skip_table () {
+        //  Any q-gram that is not in the pattern lets us skip past it entirely
+            const difference_type k_default = k_pattern_length - Q + 1;
+            skip_.assign ( k_table_size, clamp_shift ( k_default ));
+
+        //  A q-gram ending at position 'i' can be lined up by shifting (m - 1 - i)
+        //  Keep the smallest shift for each entry; for Q > 2 different
+        //  q-grams can hash to the same entry.
+            for ( difference_type i = Q - 1; i < k_pattern_length - 1; ++i ) {
+                const std::size_t h = hash ( pat_first + i + 1 );
+                const shift_type  s = clamp_shift ( k_pattern_length - 1 - i );
+                if ( s < skip_ [ h ] )
+                    skip_ [ h ] = s;
+                }
+
+        //  Remember the shift for the last q-gram, then replace it with the
+        //  zero that makes the search loop stop and compare.
+            const std::size_t last_hash = hash ( pat_last );
+            mismatch_shift_ = skip_ [ last_hash ];
+            skip_ [ last_hash ] = 0;
+            }
+
+        /// \fn do_search ( corpusIter corpus_first, corpusIter corpus_last, difference_type k_corpus_length )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param k_corpus_length The length of the corpus to search
+        ///
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last,
+                                                difference_type k_corpus_length ) const {
+            const shift_type *skip = &skip_ [ 0 ];
+        //  'pos' is one past the end of the window we are looking at
+            difference_type pos = k_pattern_length;
+            difference_type k;
+
+            for (;;) {
+                while (( k = skip [ hash ( corpus_first + pos ) ] ) != 0 ) {
+                    pos += k;
+                    if ( pos > k_corpus_length )
+                        return corpus_last;
+                    }
+
+            //  The last q-gram (probably) matches; check the whole pattern
+                const corpusIter candidate = corpus_first + ( pos - k_pattern_length );
+                if ( std::equal ( pat_first, pat_last, candidate ))
+                    return candidate;
+
+                pos += mismatch_shift_;
+                if ( pos > k_corpus_length )
+                    break;
+                }
+
+            return corpus_last;     // We didn't find anything
+            }
+/// \endcond
+        };
+
+/// \fn qgram_horspool_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, using two-element q-grams.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter qgram_horspool_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        qgram_horspool<patIter> qh ( pat_first, pat_last );
+        return qh ( corpus_first, corpus_last );
+        }
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::qgram_horspool<typename boost::range_iterator<const Range>::type>
+    make_qgram_horspool ( const Range &r ) {
+        return boost::algorithm::qgram_horspool
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::qgram_horspool<typename boost::range_iterator<Range>::type>
+    make_qgram_horspool ( Range &r ) {
+        return boost::algorithm::qgram_horspool
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_QGRAM_HORSPOOL_SEARCH_HPP
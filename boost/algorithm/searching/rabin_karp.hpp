@@ -0,0 +1,449 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_RABIN_KARP_HPP
+#define BOOST_ALGORITHM_RABIN_KARP_HPP
+
+#include <algorithm>    // for std::sort, std::equal, std::max
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <stdexcept>    // for std::invalid_argument, std::length_error
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/multi_literal.hpp>  // for literal_match
+
+namespace boost { namespace algorithm {
+
+/*
+    Rabin-Karp searching, with a rolling hash.
+
+    A hash of each window of the corpus is kept up to date as the window
+    slides along, in constant time a step: the polynomial hash
+        h = c[0] * B^(m-1) + c[1] * B^(m-2) + ... + c[m-1]     (mod 2^64)
+    becomes h * B + c[m] - c[0] * B^m. That is two multiplies and no table
+    lookups, so it doesn't depend on what was read before, except through h.
+    The window is only compared with a pattern when their hashes are equal.
+
+    rabin_karp is the single pattern version, with the same interface as the
+    other searchers; it is mostly useful as a baseline.
+
+    rabin_karp_set searches for a set of patterns that are all the same
+    length (content hashes, opcode sequences, ...), which can be tens of
+    thousands strong. The patterns' hashes go in a flat open-addressed hash
+    table, and in front of that, a one bit per entry filter, 16 bits a
+    pattern, small enough to stay in cache. Most windows are rejected by the
+    filter; the rest are looked up in the table, and compared with each of
+    the patterns with that hash. Like multi_literal_searcher, it reports all
+    the matches as literal_match, in order of position, then pattern id.
+
+    Requirements:
+        * Random access iterators
+        * For rabin_karp_set, the patterns and the corpus must be a one-byte
+          integral type. rabin_karp takes any type that boost::hash can hash.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    const boost::uint64_t rabin_karp_base = 0x100000001B3ULL;   // the 64 bit FNV prime
+
+    inline boost::uint64_t rabin_karp_power ( std::size_t m ) {
+        boost::uint64_t retVal = 1;
+        for ( std::size_t i = 0; i < m; ++i )
+            retVal *= rabin_karp_base;
+        return retVal;
+        }
+
+//  What each element adds to the hash: integers are used as they are (so char
+//  and unsigned char agree); anything else is hashed
+    template <typename T>
+    boost::uint64_t rabin_karp_value ( const T &t, boost::true_type ) {
+        return static_cast<boost::uint64_t> ( static_cast<typename boost::make_unsigned<T>::type> ( t ));
+        }
+
+    template <typename T>
+    boost::uint64_t rabin_karp_value ( const T &t, boost::false_type ) { return boost::hash<T> () ( t ); }
+
+    template <typename T>
+    boost::uint64_t rabin_karp_value ( const T &t ) {
+        return rabin_karp_value ( t, boost::integral_constant<bool, boost::is_integral<T>::value> ());
+        }
+
+    template <typename Iter>
+    boost::uint64_t rabin_karp_hash ( Iter first, std::size_t m ) {
+        boost::uint64_t retVal = 0;
+        for ( std::size_t i = 0; i < m; ++i )
+            retVal = retVal * rabin_karp_base + rabin_karp_value ( first [ i ] );
+        return retVal;
+        }
+}
+/// \endcond
+
+/*!
+    \class rabin_karp
+    \brief Rabin-Karp search for a single pattern
+*/
+    template <typename patIter>
+    class rabin_karp {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+    public:
+        rabin_karp ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( first, last )),
+                  hash_ ( detail::rabin_karp_hash ( first, k_pattern_length )),
+                  power_ ( detail::rabin_karp_power ( k_pattern_length )) {
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "rabin_karp", k_pattern_length );
+            }
+
+        ~rabin_karp () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \brief The pattern that was passed into the constructor
+        typedef patIter pattern_iterator;
+        patIter pattern_begin () const { return pat_first; }
+        patIter pattern_end   () const { return pat_last; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "rabin_karp", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "rabin_karp", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const std::size_t k_pattern_length;
+        const boost::uint64_t hash_;
+        const boost::uint64_t power_;   // B^m
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last )       return corpus_first; // empty pattern matches at start
+
+            const std::size_t n = std::distance ( corpus_first, corpus_last );
+            if ( n < k_pattern_length )
+                return corpus_last;
+
+            const std::size_t m = k_pattern_length;
+            boost::uint64_t h = detail::rabin_karp_hash ( corpus_first, m );
+            for ( std::size_t pos = 0; ; ++pos ) {
+                if ( h == hash_ && std::equal ( pat_first, pat_last, corpus_first + pos ))
+                    return corpus_first + pos;
+                if ( pos + m == n )
+                    break;
+                h = h * detail::rabin_karp_base + detail::rabin_karp_value ( corpus_first [ pos + m ] )
+                      - power_ * detail::rabin_karp_value ( corpus_first [ pos ] );
+                }
+            return corpus_last;
+            }
+/// \endcond
+        };
+
+
+/*!
+    \class rabin_karp_set
+    \brief Rabin-Karp search for a set of patterns that are all the same length
+*/
+    class rabin_karp_set {
+    public:
+        /// \brief Build the searcher from a sequence of patterns, which must all be the same length
+        ///
+        /// \param patterns_first   The first pattern (an iterator over ranges)
+        /// \param patterns_last    One past the last pattern
+        ///
+        template <typename Iter>
+        rabin_karp_set ( Iter patterns_first, Iter patterns_last ) {
+            init ( patterns_first, patterns_last );
+            }
+
+        template <typename Range>
+        explicit rabin_karp_set ( const Range &patterns ) {
+            init ( boost::begin ( patterns ), boost::end ( patterns ));
+            }
+
+        ~rabin_karp_set () {}
+
+        /// \brief The number of patterns
+        std::size_t size () const { return count_; }
+
+        /// \brief The length of every pattern, and of every match
+        std::size_t pattern_length () const { return length_; }
+
+        /// \brief The bytes of memory held by the searcher
+        std::size_t memory_use () const {
+            return bytes_.capacity () + filter_.capacity () * sizeof ( boost::uint64_t )
+                + ( slots_.capacity () + starts_.capacity () + ids_.capacity ()) * sizeof ( boost::uint32_t )
+                + hashes_.capacity () * sizeof ( boost::uint64_t );
+            }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Finds the first place in the corpus where any of the patterns occurs
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            return find_first ( corpus_first, corpus_last ).first;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out )
+        /// \brief Finds all the occurrences of all the patterns in one pass over the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          Where to write the matches (as literal_match)
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator operator () ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out ) const {
+            std::size_t matches = 0;
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "rabin_karp_set", corpus_first, corpus_last, size ());
+            scan ( corpus_first, corpus_last, all_matches<OutputIterator> ( out, matches ));
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "rabin_karp_set", std::distance ( corpus_first, corpus_last ), size (), matches );
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator operator () ( const Range &r, OutputIterator out ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ), out );
+            }
+
+        /// \fn find_first ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Finds the first match in the corpus
+        /// \return The position of the match and the id of the pattern, or
+        ///     ( corpus_last, size ()) if nothing matched.
+        template <typename corpusIter>
+        std::pair<corpusIter, std::size_t> find_first ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            literal_match m ( size (), 0 );
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "rabin_karp_set", corpus_first, corpus_last, size ());
+            scan ( corpus_first, corpus_last, first_match ( m ));
+            const std::pair<corpusIter, std::size_t> retVal = m.pattern == size ()
+                ? std::make_pair ( corpus_last, size ()) : std::make_pair ( corpus_first + m.position, m.pattern );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "rabin_karp_set", corpus_first, corpus_last, size (), retVal.first );
+            return retVal;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        std::size_t count_, length_;
+        std::vector<unsigned char>   bytes_;    // all the patterns, end to end
+        boost::uint64_t power_;                 // B^length_
+        std::vector<boost::uint64_t> filter_;   // one bit for each of 2^filter_bits_ hash values
+        std::size_t filter_bits_, slot_bits_;
+        std::vector<boost::uint32_t> slots_;    // the open-addressed table; index into hashes_, plus one
+        std::vector<boost::uint64_t> hashes_;   // the distinct hashes
+        std::vector<boost::uint32_t> starts_;   // the patterns with hashes_ [ i ] are ids_ [ starts_ [ i ], starts_ [ i + 1 ] )
+        std::vector<boost::uint32_t> ids_;
+
+    //  Collectors for scan; they return true to stop the search
+        template <typename OutputIterator>
+        struct all_matches {
+            OutputIterator &out_;
+            std::size_t &count_;
+            all_matches ( OutputIterator &out, std::size_t &count ) : out_ ( out ), count_ ( count ) {}
+            bool operator () ( std::size_t pat, std::size_t pos ) const { *out_++ = literal_match ( pat, pos ); ++count_; return false; }
+            };
+
+        struct first_match {
+            literal_match &m_;
+            explicit first_match ( literal_match &m ) : m_ ( m ) {}
+            bool operator () ( std::size_t pat, std::size_t pos ) const { m_ = literal_match ( pat, pos ); return true; }
+            };
+
+        static std::size_t ceil_log2 ( std::size_t n ) {
+            std::size_t retVal = 0;
+            while (( std::size_t ( 1 ) << retVal ) < n )
+                ++retVal;
+            return retVal;
+            }
+
+    //  The high bits of the hash are the well mixed ones
+        std::size_t filter_index ( boost::uint64_t h ) const {
+            return static_cast<std::size_t> ( h >> ( 64 - filter_bits_ ));
+            }
+
+        std::size_t slot_index ( boost::uint64_t h ) const {
+            return static_cast<std::size_t> (( h * 0x9E3779B97F4A7C15ULL ) >> ( 64 - slot_bits_ ));
+            }
+
+    //  The index into hashes_ of 'h', or -1
+        std::ptrdiff_t lookup ( boost::uint64_t h ) const {
+            const std::size_t mask = slots_.size () - 1;
+            for ( std::size_t s = slot_index ( h ); slots_ [ s ] != 0; s = ( s + 1 ) & mask )
+                if ( hashes_ [ slots_ [ s ] - 1 ] == h )
+                    return slots_ [ s ] - 1;
+            return -1;
+            }
+
+        template <typename Iter>
+        void init ( Iter patterns_first, Iter patterns_last ) {
+            count_ = length_ = 0;
+            for ( ; patterns_first != patterns_last; ++patterns_first ) {
+                typedef typename boost::range_iterator<const typename std::iterator_traits<Iter>::value_type>::type pat_iter;
+                typedef typename std::iterator_traits<pat_iter>::value_type value_type;
+                BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+                const std::size_t before = bytes_.size ();
+                for ( pat_iter it = boost::begin ( *patterns_first ); it != boost::end ( *patterns_first ); ++it )
+                    bytes_.push_back ( static_cast<unsigned char> ( *it ));
+                const std::size_t len = bytes_.size () - before;
+                if ( count_ == 0 )
+                    length_ = len;
+                else if ( len != length_ )
+                    BOOST_THROW_EXCEPTION ( std::invalid_argument ( "rabin_karp_set: the patterns are not all the same length" ));
+                ++count_;
+                }
+            if ( count_ >= 0xffffffffU )
+                BOOST_THROW_EXCEPTION ( std::length_error ( "rabin_karp_set: too many patterns" ));
+            std::vector<unsigned char> ( bytes_ ).swap ( bytes_ );
+            build ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "rabin_karp_set", size ());
+            }
+
+        void build () {
+            power_ = detail::rabin_karp_power ( length_ );
+            if ( count_ == 0 || length_ == 0 )
+                return;     // nothing will match
+
+        //  Group the patterns by hash
+            std::vector<std::pair<boost::uint64_t, boost::uint32_t> > by_hash ( count_ );
+            for ( std::size_t i = 0; i < count_; ++i )
+                by_hash [ i ] = std::make_pair ( detail::rabin_karp_hash ( &bytes_ [ i * length_ ], length_ ),
+                                                  static_cast<boost::uint32_t> ( i ));
+            std::sort ( by_hash.begin (), by_hash.end ());
+            ids_.resize ( count_ );
+            for ( std::size_t i = 0; i < count_; ++i ) {
+                if ( i == 0 || by_hash [ i ].first != by_hash [ i - 1 ].first ) {
+                    hashes_.push_back ( by_hash [ i ].first );
+                    starts_.push_back ( static_cast<boost::uint32_t> ( i ));
+                    }
+                ids_ [ i ] = by_hash [ i ].second;
+                }
+            starts_.push_back ( static_cast<boost::uint32_t> ( count_ ));
+
+        //  The table is at most half full; the filter has 16 bits a hash
+            const std::size_t distinct = hashes_.size ();
+            slot_bits_   = (std::max) ( std::size_t ( 4 ), ceil_log2 ( 2 * distinct ));
+            filter_bits_ = (std::max) ( std::size_t ( 6 ), ceil_log2 ( 16 * distinct ));
+            slots_.assign ( std::size_t ( 1 ) << slot_bits_, 0 );
+            filter_.assign (( std::size_t ( 1 ) << filter_bits_ ) / 64, 0 );
+            const std::size_t mask = slots_.size () - 1;
+            for ( std::size_t i = 0; i < distinct; ++i ) {
+                std::size_t s = slot_index ( hashes_ [ i ] );
+                while ( slots_ [ s ] != 0 )
+                    s = ( s + 1 ) & mask;
+                slots_ [ s ] = static_cast<boost::uint32_t> ( i + 1 );
+                const std::size_t f = filter_index ( hashes_ [ i ] );
+                filter_ [ f / 64 ] |= boost::uint64_t ( 1 ) << ( f % 64 );
+                }
+            }
+
+        template <typename corpusIter, typename Collector>
+        void scan ( corpusIter corpus_first, corpusIter corpus_last, Collector collect ) const {
+            typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+
+            const std::size_t m = length_;
+            const std::size_t n = std::distance ( corpus_first, corpus_last );
+            if ( hashes_.empty () || n < m )
+                return;
+
+            boost::uint64_t h = detail::rabin_karp_hash ( corpus_first, m );
+            for ( std::size_t pos = 0; ; ++pos ) {
+                const std::size_t f = filter_index ( h );
+                if (( filter_ [ f / 64 ] >> ( f % 64 )) & 1 ) {
+                    const std::ptrdiff_t e = lookup ( h );
+                    if ( e >= 0 )
+                        for ( boost::uint32_t k = starts_ [ e ]; k < starts_ [ e + 1 ]; ++k ) {
+                            const unsigned char *p = &bytes_ [ ids_ [ k ] * m ];
+                            std::size_t i = 0;
+                            while ( i < m && static_cast<unsigned char> ( corpus_first [ pos + i ] ) == p [ i ] )
+                                ++i;
+                            if ( i == m && collect ( ids_ [ k ], pos ))
+                                return;
+                            }
+                    }
+                if ( pos + m == n )
+                    break;
+                h = h * detail::rabin_karp_base + static_cast<unsigned char> ( corpus_first [ pos + m ] )
+                      - power_ * static_cast<unsigned char> ( corpus_first [ pos ] );
+                }
+            }
+/// \endcond
+        };
+
+
+/// \fn rabin_karp_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter rabin_karp_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        rabin_karp<patIter> rk ( pat_first, pat_last );
+        return rk ( corpus_first, corpus_last );
+        }
+
+    //  Creator function -- takes a pattern range, returns an object
+    template <typename Range>
+    boost::algorithm::rabin_karp<typename boost::range_iterator<const Range>::type>
+    make_rabin_karp ( const Range &r ) {
+        return boost::algorithm::rabin_karp
+            <typename boost::range_iterator<const Range>::type> ( boost::begin ( r ), boost::end ( r ));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_RABIN_KARP_HPP
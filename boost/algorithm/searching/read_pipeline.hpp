@@ -0,0 +1,378 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_READ_PIPELINE_HPP
+#define BOOST_ALGORITHM_READ_PIPELINE_HPP
+
+#include <algorithm>    // for std::min, std::max
+#include <cerrno>
+#include <cstddef>      // for std::size_t
+#include <ctime>        // for clock_gettime
+#include <deque>
+#include <exception>
+#include <stdexcept>    // for std::invalid_argument
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/exception/exception.hpp>
+#include <boost/exception/errinfo_errno.hpp>
+#include <boost/exception/errinfo_file_name.hpp>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <boost/algorithm/searching/detail/uring.hpp>
+#include <boost/algorithm/searching/stream_matcher.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Reading a file and searching it at the same time.
+
+    A read_pipeline reads a file in fixed-size chunks, keeping several reads
+    in flight, and hands the chunks to a consumer (a search, say) in file
+    order. While the consumer works on one chunk, the following ones are
+    being read, so neither the device nor the processor sits idle waiting
+    for the other.
+
+    The reads go through io_uring, talking to the kernel directly, when the
+    kernel says it can do IORING_OP_READ (Linux 5.6 or later, and not turned
+    off); otherwise a small pool of threads calls pread. Kernels 5.1 to 5.5
+    have io_uring, but not its read, and use the threads. The chunks are read into a fixed pool of
+    buffers, which is allocated once and reused for every file; chunk k is
+    always read into buffer k % depth.
+
+    Each run records how long was spent waiting for reads, and how long was
+    spent in the consumer. If most of the time is waiting, the run is I/O
+    bound; if most is in the consumer, it is CPU bound.
+
+    stream_matcher (in stream_matcher.hpp) is a consumer that reports the
+    offsets of every match of a searcher's pattern, including the ones that
+    cross chunk boundaries.
+
+    This needs a POSIX system, and Boost.Thread to be linked in.
+*/
+
+/*!
+    \struct read_error
+    \brief  Thrown when a file can't be opened or read. Carries the errno,
+            and the file name when there is one.
+*/
+struct read_error : virtual boost::exception, virtual std::exception {};
+
+    struct pipeline_stats {
+        pipeline_stats () : bytes ( 0 ), reads ( 0 ), total_seconds ( 0 ), wait_seconds ( 0 ), consume_seconds ( 0 ) {}
+
+        boost::uintmax_t bytes;     // delivered to the consumer
+        boost::uintmax_t reads;     // read requests, including ones to finish short reads
+        double total_seconds;
+        double wait_seconds;        // waiting for a read to finish
+        double consume_seconds;     // in the consumer
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline double pipeline_clock () {
+        timespec ts;
+        clock_gettime ( CLOCK_MONOTONIC, &ts );
+        return ts.tv_sec + ts.tv_nsec / 1e9;
+        }
+
+//  The fallback: a few threads calling pread, with the same interface as detail::uring
+    class pread_pool : private boost::noncopyable {
+    public:
+        explicit pread_pool ( unsigned threads ) : stop_ ( false ) {
+            for ( unsigned i = 0; i < threads; ++i )
+                threads_.create_thread ( worker ( this ));
+            }
+
+        ~pread_pool () {
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            stop_ = true;
+            }
+            requested_.notify_all ();
+            threads_.join_all ();
+            }
+
+        void read ( int fd, void *buf, unsigned len, boost::uint64_t offset, boost::uint64_t tag ) {
+            const request r = { fd, buf, len, offset, tag, 0 };
+            {
+            boost::lock_guard<boost::mutex> lock ( mutex_ );
+            requests_.push_back ( r );
+            }
+            requested_.notify_one ();
+            }
+
+        bool wait ( boost::uint64_t &tag, int &result ) {
+            boost::unique_lock<boost::mutex> lock ( mutex_ );
+            while ( completions_.empty ())
+                completed_.wait ( lock );
+            tag    = completions_.front ().tag;
+            result = completions_.front ().result;
+            completions_.pop_front ();
+            return true;
+            }
+
+    private:
+        struct request {
+            int fd;
+            void *buf;
+            unsigned len;
+            boost::uint64_t offset, tag;
+            int result;
+            };
+
+        struct worker {
+            explicit worker ( pread_pool *pool ) : pool_ ( pool ) {}
+            void operator () () const { pool_->work (); }
+            pread_pool *pool_;
+            };
+
+        void work () {
+            for ( ;; ) {
+                request r;
+                {
+                boost::unique_lock<boost::mutex> lock ( mutex_ );
+                while ( requests_.empty () && !stop_ )
+                    requested_.wait ( lock );
+                if ( requests_.empty ())
+                    return;
+                r = requests_.front ();
+                requests_.pop_front ();
+                }
+
+                ssize_t n;
+                do { n = ::pread ( r.fd, r.buf, r.len, static_cast<off_t> ( r.offset )); }
+                while ( n < 0 && errno == EINTR );
+                r.result = n < 0 ? -errno : static_cast<int> ( n );
+
+                {
+                boost::lock_guard<boost::mutex> lock ( mutex_ );
+                completions_.push_back ( r );
+                }
+                completed_.notify_one ();
+                }
+            }
+
+        boost::mutex mutex_;
+        boost::condition_variable requested_, completed_;
+        std::deque<request> requests_, completions_;
+        bool stop_;
+        boost::thread_group threads_;
+        };
+}
+/// \endcond
+
+    class read_pipeline : private boost::noncopyable {
+    public:
+        enum backend_type { automatic_backend, uring_backend, pread_backend };
+
+        /// \brief Make a pipeline that reads 'buffer_size' bytes at a time, with up to 'depth' reads in flight.
+        ///     If io_uring is asked for but not available, the thread pool is used instead.
+        /// \throws std::invalid_argument if 'buffer_size' or 'depth' is zero
+        explicit read_pipeline ( std::size_t buffer_size = 1024 * 1024, unsigned depth = 8,
+                                 backend_type backend = automatic_backend )
+                : k_buffer_size ( buffer_size ), k_depth ( depth ),
+                  buffers_ ( buffer_size * depth ), backend_ ( pread_backend ) {
+            if ( buffer_size == 0 )
+                BOOST_THROW_EXCEPTION ( std::invalid_argument ( "read_pipeline: the buffer size must not be zero" ));
+            if ( depth == 0 )
+                BOOST_THROW_EXCEPTION ( std::invalid_argument ( "read_pipeline: the depth must not be zero" ));
+#ifdef BOOST_ALGORITHM_HAS_IO_URING
+            if ( backend != pread_backend ) {
+                uring_.reset ( new detail::uring ( depth ));
+                if ( uring_->ok ())
+                    backend_ = uring_backend;
+                else
+                    uring_.reset ();
+                }
+#else
+            (void) backend;
+#endif
+            if ( backend_ == pread_backend )
+                pool_.reset ( new detail::pread_pool ( (std::min) ( depth, 4U )));
+            }
+
+        ~read_pipeline () {}
+
+        /// \brief The way the reads are done: uring_backend or pread_backend
+        backend_type backend () const { return backend_; }
+
+        /// \brief The timings of the last run
+        const pipeline_stats &stats () const { return stats_; }
+
+        /// \fn operator () ( int fd, Consumer consume )
+        /// \brief Read the regular file 'fd', calling consume ( first, last, offset ) for each chunk, in order
+        ///
+        /// \param fd       An open file descriptor
+        /// \param consume  Called as consume ( const char *first, const char *last, boost::uintmax_t offset )
+        /// \return         The consumer, like std::for_each
+        /// \throws read_error if the file can't be read
+        ///
+        template <typename Consumer>
+        Consumer operator () ( int fd, Consumer consume ) {
+#ifdef BOOST_ALGORITHM_HAS_IO_URING
+            if ( backend_ == uring_backend )
+                return run ( *uring_, fd, consume );
+#endif
+            return run ( *pool_, fd, consume );
+            }
+
+        /// \fn operator () ( const std::string &path, Consumer consume )
+        /// \brief Open and read the file at 'path'
+        template <typename Consumer>
+        Consumer operator () ( const std::string &path, Consumer consume ) {
+            const int fd = ::open ( path.c_str (), O_RDONLY );
+            if ( fd < 0 )
+                BOOST_THROW_EXCEPTION ( read_error () << boost::errinfo_errno ( errno ) << boost::errinfo_file_name ( path ));
+            try {
+                consume = (*this) ( fd, consume );
+                }
+            catch ( boost::exception &e ) {
+                ::close ( fd );
+                e << boost::errinfo_file_name ( path );
+                throw;
+                }
+            catch ( ... ) {
+                ::close ( fd );
+                throw;
+                }
+            ::close ( fd );
+            return consume;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const std::size_t k_buffer_size;
+        const unsigned k_depth;
+        std::vector<char> buffers_;
+        backend_type backend_;
+#ifdef BOOST_ALGORITHM_HAS_IO_URING
+        boost::scoped_ptr<detail::uring> uring_;
+#endif
+        boost::scoped_ptr<detail::pread_pool> pool_;
+        pipeline_stats stats_;
+
+    //  The state of each buffer
+        struct slot {
+            boost::uintmax_t offset;    // where in the file this chunk starts
+            std::size_t want;           // how long the chunk is
+            std::size_t have;           // how much has been read
+            bool done;
+            };
+
+        template <typename Reader>
+        void submit ( Reader &reader, int fd, std::vector<slot> &slots, std::size_t b ) {
+            slot &s = slots [ b ];
+            reader.read ( fd, &buffers_ [ b * k_buffer_size + s.have ], static_cast<unsigned> ( s.want - s.have ),
+                          s.offset + s.have, b );
+            ++stats_.reads;
+            }
+
+        template <typename Reader, typename Consumer>
+        Consumer run ( Reader &reader, int fd, Consumer &consume ) {
+            stats_ = pipeline_stats ();
+            const double start = detail::pipeline_clock ();
+
+            struct stat st;
+            if ( ::fstat ( fd, &st ) != 0 )
+                BOOST_THROW_EXCEPTION ( read_error () << boost::errinfo_errno ( errno ));
+            const boost::uintmax_t size = st.st_size;
+            boost::uintmax_t chunks = ( size + k_buffer_size - 1 ) / k_buffer_size;
+
+            std::vector<slot> slots ( k_depth );
+            boost::uintmax_t next_submit = 0, next_deliver = 0;
+            unsigned in_flight = 0;
+            try {
+                while ( next_deliver < chunks ) {
+                //  Keep the pipeline full
+                    while ( next_submit < chunks && next_submit < next_deliver + k_depth ) {
+                        const std::size_t b = next_submit % k_depth;
+                        slot &s = slots [ b ];
+                        s.offset = next_submit * k_buffer_size;
+                        s.want   = static_cast<std::size_t> ( (std::min) ( size - s.offset, boost::uintmax_t ( k_buffer_size )));
+                        s.have   = 0;
+                        s.done   = false;
+                        submit ( reader, fd, slots, b );
+                        ++in_flight;
+                        ++next_submit;
+                        }
+
+                //  Wait for the next chunk in order
+                    const std::size_t b = next_deliver % k_depth;
+                    while ( !slots [ b ].done ) {
+                        boost::uint64_t tag;
+                        int result;
+                        const double t0 = detail::pipeline_clock ();
+                        if ( !reader.wait ( tag, result ))
+                            BOOST_THROW_EXCEPTION ( read_error () << boost::errinfo_errno ( errno ));
+                        stats_.wait_seconds += detail::pipeline_clock () - t0;
+                        --in_flight;
+
+                        slot &s = slots [ tag ];
+                        if ( result < 0 )
+                            BOOST_THROW_EXCEPTION ( read_error () << boost::errinfo_errno ( -result ));
+                        s.have += result;
+                        if ( result == 0 ) {    // the file got shorter; stop here
+                            s.done = true;
+                            chunks = (std::min) ( chunks, s.offset / k_buffer_size + 1 );
+                            }
+                        else if ( s.have < s.want ) {
+                            submit ( reader, fd, slots, tag );
+                            ++in_flight;
+                            }
+                        else
+                            s.done = true;
+                        }
+
+                    const slot &s = slots [ b ];
+                    const char *first = &buffers_ [ b * k_buffer_size ];
+                    const double t0 = detail::pipeline_clock ();
+                    consume ( first, first + s.have, s.offset );
+                    stats_.consume_seconds += detail::pipeline_clock () - t0;
+                    stats_.bytes += s.have;
+                    ++next_deliver;
+                    }
+                }
+            catch ( ... ) {
+            //  Don't leave reads going into the buffers
+                boost::uint64_t tag;
+                int result;
+                while ( in_flight > 0 && reader.wait ( tag, result ))
+                    --in_flight;
+                throw;
+                }
+
+        //  Reads that were already in flight when the file turned out to be short
+            boost::uint64_t tag;
+            int result;
+            while ( in_flight > 0 && reader.wait ( tag, result ))
+                --in_flight;
+
+            stats_.total_seconds = detail::pipeline_clock () - start;
+            return consume;
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_READ_PIPELINE_HPP
@@ -0,0 +1,265 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_REPLACE_HPP
+#define BOOST_ALGORITHM_SEARCH_REPLACE_HPP
+
+#include <algorithm>    // for std::copy, std::max
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <stdexcept>    // for std::invalid_argument
+#include <vector>
+
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Search and replace, using any of the searcher objects.
+
+    All of these replace the non-overlapping matches of the searcher's
+    pattern, from left to right, as repeated searches would find them. The
+    searcher must have a pattern_length () member; an empty pattern matches
+    nothing here, so the corpus is copied unchanged.
+
+        replace_all             copies the corpus to an output iterator,
+                                copying the unchanged spans with std::copy
+        replace_all_copy        returns a new sequence; a counting pass first
+                                finds its exact size, so it is allocated once
+        replace_all_in_place    rewrites the corpus, when the replacement is
+                                no longer than the pattern
+        stream_replacer         replaces across a sequence of chunks, holding
+                                back only the last (pattern length - 1) elements
+                                of each chunk, in case a match starts there
+*/
+
+/// \fn count_matches ( corpusIter corpus_first, corpusIter corpus_last, const Searcher &s )
+/// \brief Counts the non-overlapping matches of the searcher's pattern in the corpus
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param s            The searcher
+///
+    template <typename corpusIter, typename Searcher>
+    std::size_t count_matches ( corpusIter corpus_first, corpusIter corpus_last, const Searcher &s ) {
+        const std::size_t m = s.pattern_length ();
+        std::size_t retVal = 0;
+        if ( m == 0 )
+            return retVal;
+        for ( ;; ) {
+            corpusIter it = s ( corpus_first, corpus_last );
+            if ( it == corpus_last )
+                break;
+            ++retVal;
+            corpus_first = it + m;
+            }
+        return retVal;
+        }
+
+    template <typename Range, typename Searcher>
+    std::size_t count_matches ( const Range &corpus, const Searcher &s ) {
+        return count_matches ( boost::begin ( corpus ), boost::end ( corpus ), s );
+        }
+
+
+/// \fn replace_all ( corpusIter corpus_first, corpusIter corpus_last, const Searcher &s,
+///                   replIter repl_first, replIter repl_last, OutputIterator out )
+/// \brief Copies the corpus to 'out', replacing each match of the searcher's pattern
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param s            The searcher
+/// \param repl_first   The start of the replacement
+/// \param repl_last    One past the end of the replacement
+/// \param out          Where to write the result
+///
+    template <typename corpusIter, typename Searcher, typename replIter, typename OutputIterator>
+    OutputIterator replace_all ( corpusIter corpus_first, corpusIter corpus_last, const Searcher &s,
+                                 replIter repl_first, replIter repl_last, OutputIterator out ) {
+        const std::size_t m = s.pattern_length ();
+        if ( m != 0 ) {
+            for ( ;; ) {
+                corpusIter it = s ( corpus_first, corpus_last );
+                if ( it == corpus_last )
+                    break;
+                out = std::copy ( corpus_first, it, out );
+                out = std::copy ( repl_first, repl_last, out );
+                corpus_first = it + m;
+                }
+            }
+        return std::copy ( corpus_first, corpus_last, out );
+        }
+
+    template <typename Range, typename Searcher, typename Replacement, typename OutputIterator>
+    OutputIterator replace_all ( const Range &corpus, const Searcher &s,
+                                 const Replacement &replacement, OutputIterator out ) {
+        return replace_all ( boost::begin ( corpus ), boost::end ( corpus ), s,
+                             boost::begin ( replacement ), boost::end ( replacement ), out );
+        }
+
+
+/// \fn replace_all_copy ( const Sequence &corpus, const Searcher &s, const Replacement &replacement )
+/// \brief Returns a copy of the corpus with each match of the searcher's pattern replaced.
+///     The matches are counted first, so that the result can be allocated at its final size.
+///
+    template <typename Sequence, typename Searcher, typename Replacement>
+    Sequence replace_all_copy ( const Sequence &corpus, const Searcher &s, const Replacement &replacement ) {
+        const std::size_t count = count_matches ( corpus, s );
+        const std::size_t repl_length = std::distance ( boost::begin ( replacement ), boost::end ( replacement ));
+        Sequence retVal;
+        if ( count == 0 )
+            retVal = corpus;
+        else {
+            retVal.resize ( corpus.size () + count * repl_length - count * s.pattern_length ());
+            replace_all ( corpus, s, replacement, retVal.begin ());
+            }
+        return retVal;
+        }
+
+
+/// \fn replace_all_in_place ( corpusIter corpus_first, corpusIter corpus_last, const Searcher &s,
+///                            replIter repl_first, replIter repl_last )
+/// \brief Replaces each match of the searcher's pattern in the corpus, moving the rest of
+///     the corpus down to close the gaps.
+///
+/// \return The new end of the corpus (like std::remove)
+/// \throws std::invalid_argument if the replacement is longer than the pattern
+///
+    template <typename corpusIter, typename Searcher, typename replIter>
+    corpusIter replace_all_in_place ( corpusIter corpus_first, corpusIter corpus_last, const Searcher &s,
+                                      replIter repl_first, replIter repl_last ) {
+        const std::size_t m = s.pattern_length ();
+        if ( static_cast<std::size_t> ( std::distance ( repl_first, repl_last )) > m )
+            BOOST_THROW_EXCEPTION ( std::invalid_argument ( "replace_all_in_place: the replacement is longer than the pattern" ));
+        if ( m == 0 )
+            return corpus_last;
+
+    //  The searcher only looks at [cur, corpus_last), which hasn't been written yet
+        corpusIter out = corpus_first, cur = corpus_first;
+        for ( ;; ) {
+            corpusIter it = s ( cur, corpus_last );
+            if ( it == corpus_last )
+                break;
+            out = ( out == cur ) ? it : std::copy ( cur, it, out );
+            out = std::copy ( repl_first, repl_last, out );
+            cur = it + m;
+            }
+        return ( out == cur ) ? corpus_last : std::copy ( cur, corpus_last, out );
+        }
+
+    template <typename Sequence, typename Searcher, typename Replacement>
+    void replace_all_in_place ( Sequence &corpus, const Searcher &s, const Replacement &replacement ) {
+        corpus.erase ( replace_all_in_place ( corpus.begin (), corpus.end (), s,
+                                boost::begin ( replacement ), boost::end ( replacement )), corpus.end ());
+        }
+
+
+/*!
+    \class stream_replacer
+    \brief Replaces the matches of a searcher's pattern in a corpus that arrives in chunks.
+
+    Each chunk is searched where it is (it must have random access iterators);
+    only the last (pattern length - 1) elements that aren't part of a match are
+    copied, to be searched again with the start of the next chunk. The output
+    is the same as replace_all would make from all the chunks joined together.
+*/
+    template <typename Searcher, typename OutputIterator, typename T = char>
+    class stream_replacer {
+    public:
+        template <typename Replacement>
+        stream_replacer ( const Searcher &s, const Replacement &replacement, OutputIterator out )
+            : searcher_ ( s ), k_pattern_length ( s.pattern_length ()),
+              replacement_ ( boost::begin ( replacement ), boost::end ( replacement )),
+              out_ ( out ), count_ ( 0 ) {}
+
+        ~stream_replacer () {}
+
+        /// \brief Process the next chunk of the corpus
+        template <typename chunkIter>
+        void operator () ( chunkIter first, chunkIter last ) {
+            const std::size_t n = std::distance ( first, last );
+            if ( carry_.empty ()) {
+                first += scan ( first, last );
+                carry_.assign ( first, last );
+                }
+            else if ( n < k_pattern_length ) {
+            //  A small chunk; add it to what was held back
+                carry_.insert ( carry_.end (), first, last );
+                carry_.erase ( carry_.begin (), carry_.begin () + scan ( carry_.begin (), carry_.end ()));
+                }
+            else {
+            //  Look for matches that start in what was held back, and end in this chunk
+                const std::size_t held = carry_.size ();
+                carry_.insert ( carry_.end (), first, first + ( k_pattern_length - 1 ));
+                first += scan ( carry_.begin (), carry_.end ()) - held;
+                first += scan ( first, last );
+                carry_.assign ( first, last );
+                }
+            }
+
+        template <typename Range>
+        void operator () ( const Range &chunk ) {
+            (*this) ( boost::begin ( chunk ), boost::end ( chunk ));
+            }
+
+        /// \brief Write out whatever was held back; call this after the last chunk
+        OutputIterator finish () {
+            out_ = std::copy ( carry_.begin (), carry_.end (), out_ );
+            carry_.clear ();
+            return out_;
+            }
+
+        /// \brief The number of matches replaced so far
+        std::size_t replacements () const { return count_; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        Searcher searcher_;
+        const std::size_t k_pattern_length;
+        std::vector<T> replacement_;
+        std::vector<T> carry_;
+        OutputIterator out_;
+        std::size_t count_;
+
+    //  Replace the matches in [first, last), and write out everything that
+    //  can't be the start of a match that runs past 'last'.
+    //  Returns how much of [first, last) was used up.
+        template <typename Iter>
+        std::size_t scan ( Iter first, Iter last ) {
+            const std::size_t n = std::distance ( first, last );
+            if ( k_pattern_length == 0 ) {
+                out_ = std::copy ( first, last, out_ );
+                return n;
+                }
+            if ( n < k_pattern_length )
+                return 0;
+
+            std::size_t pos = 0;
+            for ( ;; ) {
+                Iter it = searcher_ ( first + pos, last );
+                if ( it == last )
+                    break;
+                out_ = std::copy ( first + pos, it, out_ );
+                out_ = std::copy ( replacement_.begin (), replacement_.end (), out_ );
+                ++count_;
+                pos = ( it - first ) + k_pattern_length;
+                }
+            const std::size_t stop = (std::max) ( pos, n - k_pattern_length + 1 );
+            out_ = std::copy ( first + pos, first + stop, out_ );
+            return stop;
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_REPLACE_HPP
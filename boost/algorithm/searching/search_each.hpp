@@ -0,0 +1,239 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_EACH_HPP
+#define BOOST_ALGORITHM_SEARCH_EACH_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcmp
+#include <iterator>     // for std::iterator_traits, std::distance
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/algorithm/searching/byte_set.hpp>   // for is_contiguous_byte_iterator, and the SSE2 configuration
+#include <boost/algorithm/searching/tuning.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching for one pattern in many small corpora.
+
+    search_each ( searcher, corpora_first, corpora_last, out ) searches each of
+    the corpora in [corpora_first, corpora_last) for the searcher's pattern,
+    and writes the offset of the first match in each one to 'out' -- or the
+    length of that corpus, if the pattern isn't there. Each corpus is a range:
+    a std::string, a boost::iterator_range, a std::pair of pointers, ...
+
+    When the corpora are each only a few dozen bytes long, most of the time
+    in calling the searcher goes to its setup and length checks, not the
+    search. Here, the pattern is looked at once for the whole batch, and when
+    the searcher exposes its pattern (all the searchers here that hold a
+    pattern do), and both the pattern and the corpora are contiguous bytes,
+    corpora of up to current_search_tuning ().short_corpus bytes (256 unless
+    it has been calibrated; see tuning.hpp) are not passed to the searcher
+    at all. Instead, sixteen candidate positions at a time are tested
+    (with SSE2, or thirty-two with AVX2 where the processor has it) by
+    comparing the first and last bytes of the pattern, and only the
+    candidates that pass are compared in full. Longer corpora go to the
+    searcher.
+
+    The searcher is only read, so a batch can be split between threads: each
+    thread calls search_each (or search_each_part) on its own slice of the
+    corpora, writing to its own slice of the results.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Does the searcher expose its pattern, as pattern_begin () and pattern_end ()?
+    template <typename Searcher>
+    struct has_pattern_range {
+        template <typename U> static char test ( typename U::pattern_iterator * );
+        template <typename U> static long test ( ... );
+        static const bool value = sizeof ( test<Searcher> ( 0 )) == 1;
+        };
+
+    template <typename Searcher, typename corpusIter, bool = has_pattern_range<Searcher>::value>
+    struct search_each_fast_path : public boost::false_type {};
+
+    template <typename Searcher, typename corpusIter>
+    struct search_each_fast_path<Searcher, corpusIter, true> : public boost::integral_constant<bool,
+            is_contiguous_byte_iterator<typename Searcher::pattern_iterator>::value &&
+            is_contiguous_byte_iterator<corpusIter>::value> {};
+
+//  The vector kernels for search_short test the candidates at [i, limit)
+//  a block at a time. They return true if pat is at p + i; otherwise, i is
+//  where the scalar loop should pick up.
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+    inline bool search_short_sse2 ( const unsigned char *p, std::size_t limit,
+                                    const unsigned char *pat, std::size_t m, std::size_t &i ) {
+        const __m128i vfirst = _mm_set1_epi8 ( static_cast<char> ( pat [ 0 ] ));
+        const __m128i vlast  = _mm_set1_epi8 ( static_cast<char> ( pat [ m - 1 ] ));
+        for ( ; i + 16 <= limit; i += 16 ) {
+            const __m128i a = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p + i ));
+            const __m128i b = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p + i + m - 1 ));
+            unsigned mask = static_cast<unsigned> ( _mm_movemask_epi8 (
+                            _mm_and_si128 ( _mm_cmpeq_epi8 ( a, vfirst ), _mm_cmpeq_epi8 ( b, vlast ))));
+            while ( mask != 0 ) {
+                const std::size_t j = i + byte_set_first_bit ( mask );
+                if ( m <= 2 || std::memcmp ( p + j + 1, pat + 1, m - 2 ) == 0 ) {
+                    i = j;
+                    return true;
+                    }
+                mask &= mask - 1;
+                }
+            }
+        return false;
+        }
+#endif
+
+#ifdef BOOST_ALGORITHM_BYTE_SET_AVX2
+    BOOST_ALGORITHM_TARGET ( "avx2" )
+    inline bool search_short_avx2 ( const unsigned char *p, std::size_t limit,
+                                    const unsigned char *pat, std::size_t m, std::size_t &i ) {
+        const __m256i vfirst = _mm256_set1_epi8 ( static_cast<char> ( pat [ 0 ] ));
+        const __m256i vlast  = _mm256_set1_epi8 ( static_cast<char> ( pat [ m - 1 ] ));
+        for ( ; i + 32 <= limit; i += 32 ) {
+            const __m256i a = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( p + i ));
+            const __m256i b = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( p + i + m - 1 ));
+            unsigned mask = static_cast<unsigned> ( _mm256_movemask_epi8 (
+                            _mm256_and_si256 ( _mm256_cmpeq_epi8 ( a, vfirst ), _mm256_cmpeq_epi8 ( b, vlast ))));
+            while ( mask != 0 ) {
+                const std::size_t j = i + byte_set_first_bit ( mask );
+                if ( m <= 2 || std::memcmp ( p + j + 1, pat + 1, m - 2 ) == 0 ) {
+                    i = j;
+                    return true;
+                    }
+                mask &= mask - 1;
+                }
+            }
+        return false;
+        }
+#endif
+
+//  Find pat [0, m) in p [0, n), for 0 < m, with the kernels for 'level'; returns n if it isn't there
+    inline std::size_t search_short ( const unsigned char *p, std::size_t n,
+                                      const unsigned char *pat, std::size_t m, simd_level level ) {
+        if ( n < m )
+            return n;
+        const std::size_t limit = n - m + 1;    // the number of places a match can start
+        std::size_t i = 0;
+#ifdef BOOST_ALGORITHM_BYTE_SET_AVX2
+        if ( level >= simd_avx2 && search_short_avx2 ( p, limit, pat, m, i ))
+            return i;
+#endif
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+        if ( level >= simd_sse2 && search_short_sse2 ( p, limit, pat, m, i ))
+            return i;
+#endif
+        (void) level;
+        const unsigned char first = pat [ 0 ], last = pat [ m - 1 ];
+        for ( ; i < limit; ++i )
+            if ( p [ i ] == first && p [ i + m - 1 ] == last
+                    && ( m <= 2 || std::memcmp ( p + i + 1, pat + 1, m - 2 ) == 0 ))
+                return i;
+        return n;
+        }
+
+    inline std::size_t search_short ( const unsigned char *p, std::size_t n,
+                                      const unsigned char *pat, std::size_t m ) {
+        return search_short ( p, n, pat, m, active_simd_level ());
+        }
+
+    template <typename Searcher, typename CorporaIter, typename OutputIterator>
+    OutputIterator search_each ( const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+                                 OutputIterator out, boost::false_type ) {
+        typedef typename std::iterator_traits<CorporaIter>::value_type corpus_type;
+        typedef typename boost::range_iterator<const corpus_type>::type corpusIter;
+
+        const std::size_t m = s.pattern_length ();
+        for ( ; corpora_first != corpora_last; ++corpora_first, ++out ) {
+            const corpusIter first = boost::begin ( *corpora_first );
+            const corpusIter last  = boost::end   ( *corpora_first );
+            const std::size_t n = std::distance ( first, last );
+            *out = n < m ? n : static_cast<std::size_t> ( std::distance ( first, s ( first, last )));
+            }
+        return out;
+        }
+
+    template <typename Searcher, typename CorporaIter, typename OutputIterator>
+    OutputIterator search_each ( const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+                                 OutputIterator out, boost::true_type ) {
+        typedef typename std::iterator_traits<CorporaIter>::value_type corpus_type;
+        typedef typename boost::range_iterator<const corpus_type>::type corpusIter;
+
+        const std::size_t m = s.pattern_length ();
+        const std::size_t short_corpus = current_search_tuning ().short_corpus;
+        const simd_level level = active_simd_level ();
+        const unsigned char *pat = m == 0 ? NULL
+                    : reinterpret_cast<const unsigned char *> ( &*s.pattern_begin ());
+        for ( ; corpora_first != corpora_last; ++corpora_first, ++out ) {
+            const corpusIter first = boost::begin ( *corpora_first );
+            const corpusIter last  = boost::end   ( *corpora_first );
+            const std::size_t n = last - first;
+            if ( m == 0 || n < m )
+                *out = m == 0 ? 0 : n;
+            else if ( n <= short_corpus )
+                *out = search_short ( reinterpret_cast<const unsigned char *> ( &*first ), n, pat, m, level );
+            else
+                *out = static_cast<std::size_t> ( s ( first, last ) - first );
+            }
+        return out;
+        }
+}
+/// \endcond
+
+
+/// \fn search_each ( const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last, OutputIterator out )
+/// \brief Searches each of the corpora for the searcher's pattern
+///
+/// \param s             The searcher
+/// \param corpora_first The first of the corpora to search; each one is a range
+/// \param corpora_last  One past the last of the corpora
+/// \param out           Where to write the results: for each corpus, the offset
+///                      of the first match, or the length of the corpus
+///
+    template <typename Searcher, typename CorporaIter, typename OutputIterator>
+    OutputIterator search_each ( const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+                                 OutputIterator out ) {
+        typedef typename std::iterator_traits<CorporaIter>::value_type corpus_type;
+        typedef typename boost::range_iterator<const corpus_type>::type corpusIter;
+        return detail::search_each ( s, corpora_first, corpora_last, out,
+            boost::integral_constant<bool, detail::search_each_fast_path<Searcher, corpusIter>::value> ());
+        }
+
+    template <typename Searcher, typename CorporaRange, typename OutputIterator>
+    OutputIterator search_each ( const Searcher &s, const CorporaRange &corpora, OutputIterator out ) {
+        return search_each ( s, boost::begin ( corpora ), boost::end ( corpora ), out );
+        }
+
+
+/// \fn search_each_part ( const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+///                        ResultIter results, std::size_t part, std::size_t parts )
+/// \brief Does one of 'parts' equal slices of a search_each. Calls with part = 0 .. parts-1
+///     (from different threads, say) together fill in all the results.
+///
+/// \param results  The results for the whole batch (Random Access Iterator)
+///
+    template <typename Searcher, typename CorporaIter, typename ResultIter>
+    void search_each_part ( const Searcher &s, CorporaIter corpora_first, CorporaIter corpora_last,
+                            ResultIter results, std::size_t part, std::size_t parts ) {
+        const std::size_t n = corpora_last - corpora_first;
+        const std::size_t lo = n / parts * part       + ( n % parts ) * part       / parts;
+        const std::size_t hi = n / parts * ( part + 1 ) + ( n % parts ) * ( part + 1 ) / parts;
+        search_each ( s, corpora_first + lo, corpora_first + hi, results + lo );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_EACH_HPP
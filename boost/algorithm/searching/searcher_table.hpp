@@ -0,0 +1,450 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCHER_TABLE_HPP
+#define BOOST_ALGORITHM_SEARCHER_TABLE_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcpy, std::memcmp
+#include <iterator>     // for std::iterator_traits
+#include <ostream>
+#include <stdexcept>    // for std::length_error
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/detail/index_io.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Saved searcher tables.
+
+    A program that builds the same thousands of searchers every time it starts
+    (and in every process) can build them once, save the patterns and their
+    tables with a searcher_table_builder, and then map the file into memory.
+    A searcher_table over that memory hands out compiled_searchers that search
+    using the tables in place: nothing is copied or rebuilt, and processes
+    that map the same file share its pages.
+
+    The saved form has no pointers in it, only offsets from the start of the
+    file, so it can be mapped at any address. It starts with a header:
+    an eight character tag, a format version, a byte order mark, the number
+    of searchers, the total size, and a checksum of everything after the
+    header. Tables are four-byte integers in the byte order of the machine
+    that wrote them; a table written on a machine with the other byte order
+    is rejected, not byte-swapped.
+
+    Only searchers whose pattern is a one-byte integral type can be saved.
+
+    Layout (all offsets are from the start of the table, and are multiples of 8):
+        header          (40 bytes)
+        directory       (count entries of 16 bytes: kind, pattern length, offset)
+        searchers       (pattern bytes, padded to 8; then the tables)
+            Boyer-Moore:            skip [ 256 ], suffix [ m + 1 ]
+            Boyer-Moore-Horspool:   skip [ 256 ]
+            Knuth-Morris-Pratt:     skip [ m + 1 ]
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    struct searcher_table_header {
+        char            tag [ 8 ];
+        boost::uint32_t version;
+        boost::uint32_t byte_order;
+        boost::uint32_t count;
+        boost::uint32_t reserved;
+        boost::uint64_t size;           // of the whole table, header included
+        boost::uint64_t checksum;       // of everything after the header
+        };
+
+    struct searcher_table_entry {
+        boost::uint32_t kind;
+        boost::uint32_t pattern_length;
+        boost::uint64_t offset;
+        };
+
+    BOOST_STATIC_ASSERT ( sizeof ( searcher_table_header ) == 40 );
+    BOOST_STATIC_ASSERT ( sizeof ( searcher_table_entry )  == 16 );
+
+    static const char k_searcher_table_tag [ 8 ] = { 'B', 'A', 'S', 'R', 'C', 'H', 'T', 'B' };
+    enum { k_searcher_table_version = 1, k_searcher_table_byte_order = 0x01020304 };
+
+    inline std::size_t searcher_table_pad ( std::size_t n ) { return ( n + 7 ) & ~std::size_t ( 7 ); }
+
+//  The searchers make this a friend, so that their tables can be saved
+    struct compiled_searcher_access {
+        template <typename patIter, typename traits>
+        static void save ( const boyer_moore<patIter, traits> &s, std::vector<boost::int32_t> &tables ) {
+            for ( int c = 0; c < 256; ++c )
+                tables.push_back ( static_cast<boost::int32_t> ( s.skip_ [ static_cast<
+                        typename std::iterator_traits<patIter>::value_type> ( c ) ] ));
+            tables.insert ( tables.end (), s.suffix_.begin (), s.suffix_.end ());
+            }
+
+        template <typename patIter, typename traits>
+        static void save ( const boyer_moore_horspool<patIter, traits> &s, std::vector<boost::int32_t> &tables ) {
+            for ( int c = 0; c < 256; ++c )
+                tables.push_back ( static_cast<boost::int32_t> ( s.skip_ [ static_cast<
+                        typename std::iterator_traits<patIter>::value_type> ( c ) ] ));
+            }
+
+        template <typename patIter>
+        static void save ( const knuth_morris_pratt<patIter> &s, std::vector<boost::int32_t> &tables ) {
+            tables.insert ( tables.end (), s.skip_.begin (), s.skip_.end ());
+            }
+
+        template <typename patIter, typename Searcher>
+        static std::pair<patIter, patIter> pattern ( const Searcher &s ) {
+            return std::make_pair ( s.pat_first, s.pat_last );
+            }
+        };
+}
+/// \endcond
+
+/*!
+    \class compiled_searcher
+    \brief A searcher whose pattern and tables live in a searcher_table.
+        It is cheap to copy, and is valid as long as the table's memory is.
+*/
+    class compiled_searcher {
+    public:
+        enum kind_type { boyer_moore_kind = 1, boyer_moore_horspool_kind = 2, knuth_morris_pratt_kind = 3 };
+
+        compiled_searcher ( kind_type kind, const unsigned char *pattern, std::size_t pattern_length,
+                                                const boost::int32_t *tables )
+            : kind_ ( kind ), pat_ ( pattern ), k_pattern_length ( pattern_length ), tables_ ( tables ) {
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "compiled_searcher", k_pattern_length );
+            }
+
+        typedef const unsigned char *pattern_iterator;
+
+        kind_type kind () const { return kind_; }
+        const unsigned char *pattern_begin () const { return pat_; }
+        const unsigned char *pattern_end   () const { return pat_ + k_pattern_length; }
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the saved pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "compiled_searcher", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "compiled_searcher", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        kind_type kind_;
+        const unsigned char *pat_;
+        std::size_t k_pattern_length;
+        const boost::int32_t *tables_;
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( k_pattern_length == 0 )       return corpus_first; // empty pattern matches at start
+
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( corpus_last - corpus_first < (std::ptrdiff_t) k_pattern_length )
+                return corpus_last;
+
+            switch ( kind_ ) {
+                case boyer_moore_kind:          return bm_search  ( corpus_first, corpus_last );
+                case boyer_moore_horspool_kind: return bmh_search ( corpus_first, corpus_last );
+                case knuth_morris_pratt_kind:   return kmp_search ( corpus_first, corpus_last );
+                }
+            BOOST_ASSERT ( false );
+            return corpus_last;
+            }
+
+        template <typename T>
+        static unsigned char byte ( T c ) { return static_cast<unsigned char> ( c ); }
+
+    //  These are the loops from the searchers, reading the saved tables
+        template <typename corpusIter>
+        corpusIter bm_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            const boost::int32_t *skip   = tables_;
+            const boost::int32_t *suffix = tables_ + 256;
+            const std::ptrdiff_t m = k_pattern_length;
+            corpusIter curPos = corpus_first;
+            const corpusIter lastPos = corpus_last - m;
+
+            while ( curPos <= lastPos ) {
+                std::ptrdiff_t j = m;
+                while ( pat_ [ j - 1 ] == byte ( curPos [ j - 1 ] )) {
+                    if ( --j == 0 )
+                        return curPos;
+                    }
+                const std::ptrdiff_t k = skip [ byte ( curPos [ j - 1 ] ) ];
+                const std::ptrdiff_t s = j - k - 1;
+                if ( k < j && s > suffix [ j ] )
+                    curPos += s;
+                else
+                    curPos += suffix [ j ];
+                }
+            return corpus_last;
+            }
+
+        template <typename corpusIter>
+        corpusIter bmh_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            const boost::int32_t *skip = tables_;
+            const std::size_t m = k_pattern_length;
+            corpusIter curPos = corpus_first;
+            const corpusIter lastPos = corpus_last - m;
+
+            while ( curPos <= lastPos ) {
+                std::size_t j = m - 1;
+                while ( pat_ [ j ] == byte ( curPos [ j ] )) {
+                    if ( j == 0 )
+                        return curPos;
+                    j--;
+                    }
+                curPos += skip [ byte ( curPos [ m - 1 ] ) ];
+                }
+            return corpus_last;
+            }
+
+        template <typename corpusIter>
+        corpusIter kmp_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            const boost::int32_t *skip = tables_;
+            const std::ptrdiff_t m = k_pattern_length;
+            const std::ptrdiff_t last_match = ( corpus_last - corpus_first ) - m;
+            std::ptrdiff_t match_start = 0, idx = 0;
+
+            while ( match_start <= last_match ) {
+                while ( pat_ [ idx ] == byte ( corpus_first [ match_start + idx ] )) {
+                    if ( ++idx == m )
+                        return corpus_first + match_start;
+                    }
+                match_start += idx - skip [ idx ];
+                idx = skip [ idx ] >= 0 ? skip [ idx ] : 0;
+                }
+            return corpus_last;
+            }
+/// \endcond
+        };
+
+
+/*!
+    \class searcher_table_builder
+    \brief Collects searchers, and writes their patterns and tables to a stream
+        in the form that searcher_table reads.
+*/
+    class searcher_table_builder {
+    public:
+        searcher_table_builder () {}
+
+        /// \brief Add a searcher to the table
+        /// \return The index of the searcher in the table
+        template <typename patIter, typename traits>
+        std::size_t add ( const boyer_moore<patIter, traits> &s ) {
+            return add_entry<patIter> ( compiled_searcher::boyer_moore_kind, s );
+            }
+
+        template <typename patIter, typename traits>
+        std::size_t add ( const boyer_moore_horspool<patIter, traits> &s ) {
+            return add_entry<patIter> ( compiled_searcher::boyer_moore_horspool_kind, s );
+            }
+
+        template <typename patIter>
+        std::size_t add ( const knuth_morris_pratt<patIter> &s ) {
+            return add_entry<patIter> ( compiled_searcher::knuth_morris_pratt_kind, s );
+            }
+
+        std::size_t size () const { return entries_.size (); }
+
+        /// \brief Write the table to a stream
+        void write ( std::ostream &out ) const {
+            detail::searcher_table_header h;
+            std::memcpy ( h.tag, detail::k_searcher_table_tag, sizeof ( h.tag ));
+            h.version    = detail::k_searcher_table_version;
+            h.byte_order = detail::k_searcher_table_byte_order;
+            h.count      = static_cast<boost::uint32_t> ( entries_.size ());
+            h.reserved   = 0;
+
+        //  The directory, with offsets from the start of the table
+            std::vector<detail::searcher_table_entry> dir ( entries_ );
+            const std::size_t dir_end = sizeof ( h ) + dir.size () * sizeof ( detail::searcher_table_entry );
+            for ( std::size_t i = 0; i < dir.size (); ++i )
+                dir [ i ].offset += dir_end;
+            const char *dir_bytes = dir.empty () ? NULL : reinterpret_cast<const char *> ( &dir [ 0 ] );
+            const std::size_t dir_size = dir.size () * sizeof ( detail::searcher_table_entry );
+
+            h.size     = dir_end + data_.size ();
+            h.checksum = detail::fnv1a ( data_.begin (), data_.end (), detail::fnv1a ( dir_bytes, dir_bytes + dir_size ));
+
+            out.write ( reinterpret_cast<const char *> ( &h ), sizeof ( h ));
+            if ( dir_size != 0 )
+                out.write ( dir_bytes, dir_size );
+            if ( !data_.empty ())
+                out.write ( &data_ [ 0 ], data_.size ());
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        std::vector<detail::searcher_table_entry> entries_;     // offsets are from the start of data_
+        std::vector<char> data_;
+
+        template <typename patIter, typename Searcher>
+        std::size_t add_entry ( compiled_searcher::kind_type kind, const Searcher &s ) {
+            typedef typename std::iterator_traits<patIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+
+            const std::pair<patIter, patIter> pat = detail::compiled_searcher_access::pattern<patIter> ( s );
+            const std::size_t m = std::distance ( pat.first, pat.second );
+            if ( m >= 0x7fffffff )
+                BOOST_THROW_EXCEPTION ( std::length_error ( "searcher_table_builder: pattern too long" ));
+
+            std::vector<boost::int32_t> tables;
+            detail::compiled_searcher_access::save ( s, tables );
+
+            detail::searcher_table_entry e;
+            e.kind           = kind;
+            e.pattern_length = static_cast<boost::uint32_t> ( m );
+            e.offset         = data_.size ();
+            entries_.push_back ( e );
+
+            std::size_t pos = data_.size ();
+            data_.resize ( pos + detail::searcher_table_pad ( m )
+                        + detail::searcher_table_pad ( tables.size () * sizeof ( boost::int32_t )), 0 );
+            for ( patIter it = pat.first; it != pat.second; ++it )
+                data_ [ pos++ ] = static_cast<char> ( *it );
+            pos = e.offset + detail::searcher_table_pad ( m );
+            if ( !tables.empty ())
+                std::memcpy ( &data_ [ pos ], &tables [ 0 ], tables.size () * sizeof ( boost::int32_t ));
+            return entries_.size () - 1;
+            }
+/// \endcond
+        };
+
+
+/*!
+    \class searcher_table
+    \brief A read-only view of a saved table of searchers; usually over a
+        memory-mapped file. Nothing is copied; the memory must stay valid
+        (and unchanged) while the table or its searchers are in use.
+*/
+    class searcher_table {
+    public:
+        /// \brief Check the table in [data, data + size), and get ready to use it
+        ///
+        /// \param data     The start of the table; must be aligned to 8 bytes (as mapped files are)
+        /// \param size     The number of bytes available
+        /// \param verify_checksum  Check the contents against the checksum in the header.
+        ///                 This reads the whole table; turn it off to only touch the pages that are used.
+        ///                 Without it, only the header and the directory are checked: the patterns
+        ///                 and the skip tables are trusted completely, and a damaged skip table
+        ///                 can make a search read outside the corpus. Only turn it off for
+        ///                 tables that this program (or one it trusts) wrote.
+        /// \throws index_format_error if the table is damaged, or was written by a
+        ///                 different version, or on a machine with a different byte order
+        searcher_table ( const void *data, std::size_t size, bool verify_checksum = true )
+                : base_ ( static_cast<const unsigned char *> ( data )), count_ ( 0 ) {
+            if ( reinterpret_cast<std::size_t> ( base_ ) % 8 != 0 || size < sizeof ( detail::searcher_table_header ))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            const detail::searcher_table_header &h = header ();
+        //  The header's size must cover the header and the directory, before
+        //  anything is read from either, so that none of the subtractions
+        //  below can wrap.
+            if ( std::memcmp ( h.tag, detail::k_searcher_table_tag, sizeof ( h.tag )) != 0
+              || h.version    != detail::k_searcher_table_version
+              || h.byte_order != detail::k_searcher_table_byte_order
+              || h.size > size
+              || h.size < sizeof ( h )
+              || h.count > ( h.size - sizeof ( h )) / sizeof ( detail::searcher_table_entry ))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            const boost::uint64_t dir_end = sizeof ( h ) + boost::uint64_t ( h.count ) * sizeof ( detail::searcher_table_entry );
+            BOOST_ASSERT ( dir_end <= h.size );
+            if ( verify_checksum &&
+                    detail::fnv1a ( base_ + sizeof ( h ), base_ + h.size ) != h.checksum )
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+
+        //  Make sure that every searcher lies inside the table, after the directory
+            count_ = h.count;
+            for ( std::size_t i = 0; i < count_; ++i ) {
+                const detail::searcher_table_entry &e = entry ( i );
+                if (( e.kind < compiled_searcher::boyer_moore_kind || e.kind > compiled_searcher::knuth_morris_pratt_kind )
+                  || e.offset % 8 != 0 || e.offset < dir_end || e.offset > h.size
+                  || entry_size ( e ) > h.size - e.offset )
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+                }
+            }
+
+        /// \brief The number of searchers in the table
+        std::size_t size () const { return count_; }
+
+        /// \brief The i'th searcher that was added to the table
+        compiled_searcher operator [] ( std::size_t i ) const {
+            BOOST_ASSERT ( i < count_ );
+            const detail::searcher_table_entry &e = entry ( i );
+            const unsigned char *p = base_ + e.offset;
+            return compiled_searcher ( static_cast<compiled_searcher::kind_type> ( e.kind ), p, e.pattern_length,
+                    reinterpret_cast<const boost::int32_t *> ( p + detail::searcher_table_pad ( e.pattern_length )));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const unsigned char *base_;
+        std::size_t count_;
+
+        const detail::searcher_table_header &header () const {
+            return *reinterpret_cast<const detail::searcher_table_header *> ( base_ );
+            }
+
+        const detail::searcher_table_entry &entry ( std::size_t i ) const {
+            return reinterpret_cast<const detail::searcher_table_entry *>
+                        ( base_ + sizeof ( detail::searcher_table_header )) [ i ];
+            }
+
+        static boost::uint64_t entry_size ( const detail::searcher_table_entry &e ) {
+            const boost::uint64_t m = e.pattern_length;
+            boost::uint64_t tables = 0;
+            switch ( e.kind ) {
+                case compiled_searcher::boyer_moore_kind:           tables = 256 + m + 1;   break;
+                case compiled_searcher::boyer_moore_horspool_kind:  tables = 256;           break;
+                case compiled_searcher::knuth_morris_pratt_kind:    tables = m + 1;         break;
+                }
+            return detail::searcher_table_pad ( e.pattern_length ) + tables * sizeof ( boost::int32_t );
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCHER_TABLE_HPP
@@ -0,0 +1,120 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_SPLIT_VIEW_HPP
+#define BOOST_ALGORITHM_SEARCH_SPLIT_VIEW_HPP
+
+#include <cstddef>      // for std::size_t
+
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/iterator_range.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A lazy view of the fields of a corpus, split on a delimiter.
+
+    The delimiter is the pattern of a searcher object (any of them), so it can
+    be more than one element long: "\r\n", "||", and so on. The fields are
+    found one at a time, as the view is iterated, and each one is an
+    iterator_range into the corpus; nothing is copied, and nothing is
+    allocated.
+
+    The fields are the same ones that boost::algorithm::split makes (with
+    token_compress_off): n delimiters make n+1 fields, some of which may be
+    empty, and an empty corpus is a single empty field. An empty delimiter
+    never matches, so the whole corpus is one field.
+
+    The view and its iterators hold a pointer to the searcher, not a copy;
+    the searcher (and the corpus) must outlive them.
+*/
+
+    template <typename corpusIter, typename Searcher>
+    class split_view {
+    public:
+        typedef boost::iterator_range<corpusIter> value_type;
+
+        class iterator : public boost::iterator_facade <
+                iterator, value_type, boost::forward_traversal_tag, value_type > {
+        public:
+            iterator () : searcher_ ( NULL ), k_delimiter_length ( 0 ), at_end_ ( true ) {}
+
+        private:
+/// \cond DOXYGEN_HIDE
+            friend class split_view;
+            friend class boost::iterator_core_access;
+
+            iterator ( corpusIter first, corpusIter last, const Searcher *s, std::size_t delimiter_length )
+                    : searcher_ ( s ), k_delimiter_length ( delimiter_length ),
+                      field_first_ ( first ), corpus_last ( last ), at_end_ ( false ) {
+                field_last_ = find_delimiter ();
+                }
+
+            value_type dereference () const { return value_type ( field_first_, field_last_ ); }
+
+            bool equal ( const iterator &other ) const {
+                if ( at_end_ || other.at_end_ )
+                    return at_end_ == other.at_end_;
+                return field_first_ == other.field_first_;
+                }
+
+            void increment () {
+                if ( field_last_ == corpus_last ) {
+                    at_end_ = true;
+                    return;
+                    }
+                field_first_ = field_last_ + k_delimiter_length;
+                field_last_ = find_delimiter ();
+                }
+
+            corpusIter find_delimiter () const {
+                return k_delimiter_length == 0 ? corpus_last : (*searcher_) ( field_first_, corpus_last );
+                }
+
+            const Searcher *searcher_;
+            std::size_t k_delimiter_length;
+            corpusIter field_first_, field_last_, corpus_last;
+            bool at_end_;
+/// \endcond
+            };
+
+        typedef iterator const_iterator;
+
+        split_view ( corpusIter first, corpusIter last, const Searcher &s )
+            : corpus_first ( first ), corpus_last ( last ),
+              searcher_ ( &s ), k_delimiter_length ( s.pattern_length ()) {}
+
+        ~split_view () {}
+
+        iterator begin () const { return iterator ( corpus_first, corpus_last, searcher_, k_delimiter_length ); }
+        iterator end   () const { return iterator (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        corpusIter corpus_first, corpus_last;
+        const Searcher *searcher_;
+        std::size_t k_delimiter_length;
+/// \endcond
+        };
+
+    //  Creator function -- take a corpus range and a searcher, return a view of the fields
+    template <typename Range, typename Searcher>
+    boost::algorithm::split_view<typename boost::range_iterator<const Range>::type, Searcher>
+    make_split_view ( const Range &r, const Searcher &s ) {
+        return boost::algorithm::split_view
+            <typename boost::range_iterator<const Range>::type, Searcher> ( boost::begin ( r ), boost::end ( r ), s );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_SPLIT_VIEW_HPP
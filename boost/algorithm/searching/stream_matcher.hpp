@@ -0,0 +1,96 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_STREAM_MATCHER_HPP
+#define BOOST_ALGORITHM_STREAM_MATCHER_HPP
+
+#include <algorithm>    // for std::min, std::max
+#include <cstddef>      // for std::size_t
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+namespace boost { namespace algorithm {
+
+/*!
+    \class stream_matcher
+    \brief A consumer for read_pipeline (or anything else that hands out a
+        corpus in order, in chunks) that writes the offset of every match of a
+        searcher's pattern to an output iterator, including overlapping matches
+        and matches that cross from one chunk into the next.
+
+    Only the last (pattern length - 1) bytes of each chunk are copied, to be
+    searched again with the start of the next one.
+*/
+    template <typename Searcher, typename OutputIterator>
+    class stream_matcher {
+    public:
+        stream_matcher ( const Searcher &s, OutputIterator out )
+            : searcher_ ( &s ), k_pattern_length ( s.pattern_length ()), out_ ( out ),
+              carry_offset_ ( 0 ), checked_ ( 0 ) {}
+
+        /// \brief Search the chunk [first, last), which starts at 'offset' in the whole corpus
+        void operator () ( const char *first, const char *last, boost::uintmax_t offset ) {
+            if ( k_pattern_length == 0 )
+                return;
+            const std::size_t n = last - first;
+            const std::size_t keep = k_pattern_length - 1;
+
+        //  Matches that start in the end of the last chunk
+            if ( !carry_.empty ()) {
+                const std::size_t held = carry_.size ();
+                carry_.insert ( carry_.end (), first, first + (std::min) ( n, keep ));
+                search ( &carry_ [ 0 ], &carry_ [ 0 ] + carry_.size (), carry_offset_ );
+                carry_.resize ( held );
+                }
+            search ( first, last, offset );
+
+        //  Keep the last (pattern length - 1) bytes
+            if ( n >= keep )
+                carry_.assign ( last - keep, last );
+            else {
+                carry_.insert ( carry_.end (), first, last );
+                if ( carry_.size () > keep )
+                    carry_.erase ( carry_.begin (), carry_.end () - keep );
+                }
+            carry_offset_ = offset + n - carry_.size ();
+            }
+
+        /// \brief The output iterator, after all the matches so far
+        OutputIterator out () const { return out_; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const Searcher *searcher_;
+        std::size_t k_pattern_length;
+        OutputIterator out_;
+        std::vector<char> carry_;
+        boost::uintmax_t carry_offset_;
+        boost::uintmax_t checked_;      // every match starting before here has been reported
+
+        void search ( const char *first, const char *last, boost::uintmax_t offset ) {
+            const std::size_t n = last - first;
+            if ( n < k_pattern_length )
+                return;
+            for ( const char *p = first; ; ) {
+                const char *it = (*searcher_) ( p, last );
+                if ( it == last )
+                    break;
+                if ( offset + ( it - first ) >= checked_ )
+                    *out_++ = offset + ( it - first );
+                p = it + 1;
+                }
+            checked_ = (std::max) ( checked_, offset + ( n - k_pattern_length + 1 ));
+            }
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_STREAM_MATCHER_HPP
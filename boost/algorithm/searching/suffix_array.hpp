@@ -0,0 +1,242 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
+#define BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
+
+#include <cstddef>      // for std::size_t, std::ptrdiff_t
+#include <iterator>     // for std::iterator_traits
+#include <istream>
+#include <ostream>
+#include <utility>      // for std::pair
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_signed.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/detail/sais.hpp>
+#include <boost/algorithm/searching/detail/index_io.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A suffix array over a static corpus.
+
+    The other searchers preprocess the pattern, and then look through the
+    whole corpus for it. When the corpus doesn't change, and there are many
+    different patterns to look for, it is better to preprocess the corpus
+    instead. A suffix array is the positions of all the suffixes of the corpus,
+    in sorted order; all the occurrences of a pattern are next to each other
+    in it, and can be found by binary search in O(m log n) time.
+
+    The array is built in linear time by induced sorting (SA-IS), and can be
+    saved to a stream and loaded back, so that it only has to be built once.
+
+    Like the pattern in the searcher objects, the corpus must not change (or
+    go away) while the suffix array is being used.
+
+    Requirements:
+        * Random access iterators
+        * The corpus and patterns must be a one-byte integral type.
+        * Index must be a signed integer type that can hold the corpus length.
+          Four byte indexes (boost::int32_t) take half the memory of the default.
+*/
+
+    template <typename corpusIter, typename Index = std::ptrdiff_t>
+    class suffix_array {
+        typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+        BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+        BOOST_STATIC_ASSERT (( boost::is_signed<Index>::value ));
+
+    public:
+        typedef Index index_type;
+
+        /// \brief Build the suffix array for the corpus [first, last)
+        suffix_array ( corpusIter first, corpusIter last )
+                : corpus_first ( first ), corpus_last ( last ),
+                  k_corpus_length ( std::distance ( first, last )) {
+            if ( k_corpus_length > 0 )
+                detail::build_suffix_array ( corpus_first, Index ( k_corpus_length ), sa_ );
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "suffix_array", k_corpus_length );
+            }
+
+        /// \brief Load a suffix array for the corpus [first, last) that was written by save
+        /// \throws index_format_error if the saved array is damaged, or for a different corpus
+        suffix_array ( corpusIter first, corpusIter last, std::istream &in )
+                : corpus_first ( first ), corpus_last ( last ),
+                  k_corpus_length ( std::distance ( first, last )) {
+            detail::read_index_header ( in, "BASA", k_version, sizeof ( Index ));
+            if ( detail::read_pod<boost::uint64_t> ( in ) != static_cast<boost::uint64_t> ( k_corpus_length )
+              || detail::read_pod<boost::uint64_t> ( in ) != detail::fnv1a ( first, last ))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+            detail::read_vector ( in, sa_ );
+            if ( sa_.size () != static_cast<std::size_t> ( k_corpus_length ))
+                BOOST_THROW_EXCEPTION ( index_format_error ());
+        //  Every entry must be a position in the corpus; the searches read from there
+            for ( std::size_t i = 0; i < sa_.size (); ++i )
+                if ( sa_ [ i ] < 0 || sa_ [ i ] >= Index ( k_corpus_length ))
+                    BOOST_THROW_EXCEPTION ( index_format_error ());
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "suffix_array", k_corpus_length );
+            }
+
+        ~suffix_array () {}
+
+        /// \brief Write the suffix array to a stream, to be loaded later
+        void save ( std::ostream &out ) const {
+            detail::write_index_header ( out, "BASA", k_version, sizeof ( Index ));
+            detail::write_pod ( out, static_cast<boost::uint64_t> ( k_corpus_length ));
+            detail::write_pod ( out, detail::fnv1a ( corpus_first, corpus_last ));
+            detail::write_vector ( out, sa_ );
+            }
+
+        /// \fn equal_range ( patIter pat_first, patIter pat_last )
+        /// \brief The rows of the suffix array that start with the pattern
+        ///
+        /// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+        /// \param pat_last     One past the end of the pattern
+        ///
+        template <typename patIter>
+        std::pair<std::size_t, std::size_t> equal_range ( patIter pat_first, patIter pat_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<patIter>::value_type>::value ));
+
+        //  First row that is not less than the pattern
+            std::size_t lo = 0, hi = sa_.size ();
+            while ( lo < hi ) {
+                const std::size_t mid = lo + ( hi - lo ) / 2;
+                if ( compare ( sa_ [ mid ], pat_first, pat_last ) < 0 )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+                }
+
+        //  First row that is greater than the pattern
+            std::size_t lo2 = lo;
+            hi = sa_.size ();
+            while ( lo2 < hi ) {
+                const std::size_t mid = lo2 + ( hi - lo2 ) / 2;
+                if ( compare ( sa_ [ mid ], pat_first, pat_last ) <= 0 )
+                    lo2 = mid + 1;
+                else
+                    hi = mid;
+                }
+            return std::make_pair ( lo, lo2 );
+            }
+
+        /// \fn count ( patIter pat_first, patIter pat_last )
+        /// \brief The number of times the pattern occurs in the corpus
+        template <typename patIter>
+        std::size_t count ( patIter pat_first, patIter pat_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "suffix_array", k_corpus_length, std::distance ( pat_first, pat_last ));
+            const std::pair<std::size_t, std::size_t> rows = equal_range ( pat_first, pat_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "suffix_array", k_corpus_length, std::distance ( pat_first, pat_last ),
+                                                 rows.second - rows.first );
+            return rows.second - rows.first;
+            }
+
+        /// \fn locate ( patIter pat_first, patIter pat_last, OutputIterator out )
+        /// \brief Writes the corpus positions of all the occurrences of the pattern.
+        ///     They come out in suffix order, not corpus order.
+        template <typename patIter, typename OutputIterator>
+        OutputIterator locate ( patIter pat_first, patIter pat_last, OutputIterator out ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "suffix_array", k_corpus_length, std::distance ( pat_first, pat_last ));
+            const std::pair<std::size_t, std::size_t> rows = equal_range ( pat_first, pat_last );
+            for ( std::size_t i = rows.first; i < rows.second; ++i )
+                *out++ = static_cast<std::size_t> ( sa_ [ i ] );
+            BOOST_ALGORITHM_PROBE_SEARCH_END_N ( "suffix_array", k_corpus_length, std::distance ( pat_first, pat_last ),
+                                                 rows.second - rows.first );
+            return out;
+            }
+
+        /// \fn operator () ( patIter pat_first, patIter pat_last )
+        /// \brief Finds the first occurrence of the pattern in the corpus
+        ///
+        /// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+        /// \param pat_last     One past the end of the pattern
+        /// \return An iterator to the first match in the corpus, or the end of the corpus
+        template <typename patIter>
+        corpusIter operator () ( patIter pat_first, patIter pat_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN_N ( "suffix_array", k_corpus_length, std::distance ( pat_first, pat_last ));
+            const corpusIter retVal = this->find ( pat_first, pat_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "suffix_array", corpus_first, corpus_last, std::distance ( pat_first, pat_last ), retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        corpusIter operator () ( const Range &pattern ) const {
+            return (*this) ( boost::begin ( pattern ), boost::end ( pattern ));
+            }
+
+        /// \brief The suffix array itself
+        const std::vector<Index> &array () const { return sa_; }
+        corpusIter corpus_begin () const { return corpus_first; }
+        corpusIter corpus_end   () const { return corpus_last; }
+        std::size_t size () const { return sa_.size (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        static const boost::uint32_t k_version = 1;
+
+        corpusIter corpus_first, corpus_last;
+        const typename std::iterator_traits<corpusIter>::difference_type k_corpus_length;
+        std::vector<Index> sa_;
+
+    //  Compare the suffix at 'pos' to the pattern, looking at no more than
+    //  the length of the pattern. Zero means that the suffix starts with the pattern.
+        template <typename patIter>
+        int compare ( Index pos, patIter pat_first, patIter pat_last ) const {
+            corpusIter it = corpus_first + pos;
+            for ( ; pat_first != pat_last; ++pat_first, ++it ) {
+                if ( it == corpus_last )
+                    return -1;      // the suffix is a proper prefix of the pattern
+                const unsigned char c = static_cast<unsigned char> ( *it );
+                const unsigned char p = static_cast<unsigned char> ( *pat_first );
+                if ( c != p )
+                    return c < p ? -1 : 1;
+                }
+            return 0;
+            }
+
+    //  The first occurrence; operator () adds the trace points
+        template <typename patIter>
+        corpusIter find ( patIter pat_first, patIter pat_last ) const {
+            if ( pat_first == pat_last ) return corpus_first;   // empty pattern matches at start
+            const std::pair<std::size_t, std::size_t> rows = equal_range ( pat_first, pat_last );
+            if ( rows.first == rows.second )
+                return corpus_last;
+            Index first = sa_ [ rows.first ];
+            for ( std::size_t i = rows.first + 1; i < rows.second; ++i )
+                if ( sa_ [ i ] < first )
+                    first = sa_ [ i ];
+            return corpus_first + first;
+            }
+/// \endcond
+        };
+
+    //  Creator function -- take a corpus range, return a suffix array
+    template <typename Range>
+    boost::algorithm::suffix_array<typename boost::range_iterator<const Range>::type>
+    make_suffix_array ( const Range &r ) {
+        return boost::algorithm::suffix_array
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
@@ -0,0 +1,234 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_TUNED_BOYER_MOORE_SEARCH_HPP
+#define BOOST_ALGORITHM_TUNED_BOYER_MOORE_SEARCH_HPP
+
+#include <algorithm>    // for std::equal
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+#include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/probes.hpp>
+
+// #define  BOOST_ALGORITHM_TUNED_BOYER_MOORE_DEBUG
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of Hume and Sunday's "Tuned Boyer-Moore" search.
+
+    This is Boyer-Moore-Horspool with the skip loop pulled out of the match
+    loop. The skip table entry for the last character of the pattern is set
+    to zero, so that the "fast loop" can do nothing but table lookups and
+    additions (three to a trip) until it lands on a position where the last
+    character matches. Only then do we compare the rest of the pattern; on a
+    mismatch, we shift by the distance that Horspool would have used for that
+    character.
+
+    The fast loop is only run while there are at least three pattern lengths
+    of corpus left, so it never needs to check for running off the end. The
+    last part of the corpus is handled one shift at a time, with a bounds check.
+    This is slower than planting a copy of the pattern after the end of the
+    corpus (the "guard zone" in the paper), but it does not require a writable
+    corpus.
+
+    On ordinary text, this runs about even with boyer_moore_horspool; the
+    comparison that it leaves out of the skip loop is well predicted. It wins
+    where the end of the pattern is common in the corpus, and the start
+    isn't (padded records, say): BMH compares back through the common part
+    at every position, while this compares from the start, and fails at once.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+        * Additional requirements may be imposed by the skip table, such as:
+        ** Numeric type (array-based skip table)
+        ** Hashable type (map-based skip table)
+
+    Hume, A. and Sunday, D.M. "Fast String Searching",
+        Software - Practice and Experience 21(11), 1221-1248 (1991)
+*/
+
+    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    class tuned_boyer_moore {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        tuned_boyer_moore ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  skip_ ( k_pattern_length, k_pattern_length ),
+                  mismatch_shift_ ( k_pattern_length ) {
+
+        //  Build the skip table - the same as BMH's
+            std::size_t i = 0;
+            if ( first != last ) {  // empty pattern?
+                for ( patIter iter = first; iter != last-1; ++iter, ++i )
+                    skip_.insert ( *iter, k_pattern_length - 1 - i );
+
+            //  Remember the shift for the last character, and then replace
+            //  it with the zero that stops the fast loop.
+                mismatch_shift_ = skip_ [ *(last-1) ];
+                skip_.insert ( *(last-1), 0 );
+                }
+#ifdef BOOST_ALGORITHM_TUNED_BOYER_MOORE_DEBUG
+            skip_.PrintSkipTable ();
+#endif
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "tuned_boyer_moore", k_pattern_length );
+            }
+
+        ~tuned_boyer_moore () {}
+
+        /// \brief The length of the pattern; the length of every match
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \brief The pattern that was passed into the constructor
+        typedef patIter pattern_iterator;
+        patIter pattern_begin () const { return pat_first; }
+        patIter pattern_end   () const { return pat_last; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "tuned_boyer_moore", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "tuned_boyer_moore", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        typename traits::skip_table_t skip_;
+        difference_type mismatch_shift_;
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+        //  Do the search
+            return this->do_search ( corpus_first, corpus_last, k_corpus_length );
+            }
+
+        /// \fn do_search ( corpusIter corpus_first, corpusIter corpus_last, difference_type k_corpus_length )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param k_corpus_length The length of the corpus to search
+        ///
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last,
+                                                difference_type k_corpus_length ) const {
+            const difference_type k_tail = k_pattern_length - 1;
+        //  Each shift is at most k_pattern_length, so three of them starting
+        //  before 'k_fast_end' can't run off the end. (This may be negative)
+            const difference_type k_fast_end = k_corpus_length - 3 * k_pattern_length;
+            difference_type pos = k_tail;   // the corpus position under the end of the pattern
+            difference_type k;
+
+            for (;;) {
+                k = skip_ [ corpus_first [ pos ]];
+
+            //  The fast loop; once 'k' is zero, the extra adds are harmless
+                while ( k != 0 && pos < k_fast_end ) {
+                    pos += k; k = skip_ [ corpus_first [ pos ]];
+                    pos += k; k = skip_ [ corpus_first [ pos ]];
+                    pos += k; k = skip_ [ corpus_first [ pos ]];
+                    }
+
+            //  Near the end of the corpus; one shift at a time
+                while ( k != 0 ) {
+                    pos += k;
+                    if ( pos >= k_corpus_length )
+                        return corpus_last;
+                    k = skip_ [ corpus_first [ pos ]];
+                    }
+
+            //  The last element matches; check the rest of the pattern
+                const corpusIter candidate = corpus_first + ( pos - k_tail );
+                if ( std::equal ( pat_first, pat_first + k_tail, candidate ))
+                    return candidate;
+
+                pos += mismatch_shift_;
+                if ( pos >= k_corpus_length )
+                    break;
+                }
+
+            return corpus_last;     // We didn't find anything
+            }
+/// \endcond
+        };
+
+/// \fn tuned_boyer_moore_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter tuned_boyer_moore_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        tuned_boyer_moore<patIter> tbm ( pat_first, pat_last );
+        return tbm ( corpus_first, corpus_last );
+        }
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::tuned_boyer_moore<typename boost::range_iterator<const Range>::type>
+    make_tuned_boyer_moore ( const Range &r ) {
+        return boost::algorithm::tuned_boyer_moore
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::tuned_boyer_moore<typename boost::range_iterator<Range>::type>
+    make_tuned_boyer_moore ( Range &r ) {
+        return boost::algorithm::tuned_boyer_moore
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_TUNED_BOYER_MOORE_SEARCH_HPP
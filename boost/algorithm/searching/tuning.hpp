@@ -0,0 +1,176 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_TUNING_HPP
+#define BOOST_ALGORITHM_SEARCH_TUNING_HPP
+
+#include <cstddef>      // for std::size_t
+#include <fstream>
+#include <istream>
+#include <iterator>     // for std::distance
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include <boost/exception/all.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/algorithm/execution.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    The thresholds that choose between algorithms.
+
+    Where one algorithm hands off to another depends on the machine, so the
+    crossover points are kept in a search_tuning, rather than being built
+    in. The library reads them from current_search_tuning (), which starts
+    out with defaults that suit most current x86 machines.
+
+    calibrate_search_tuning () (in calibrate.hpp) measures the search
+    crossovers on the machine it runs on, and calibrate_parallel_min_grain
+    () (in parallel.hpp) the size below which the parallel algorithms
+    don't bother with threads. The results can be used at once, or saved to a
+    small text file with save_search_tuning, and read back at startup with
+    load_search_tuning:
+
+        # boost.algorithm search tuning
+        short_corpus 256
+        horspool_max_pattern 64
+        parallel_min_grain 1024
+
+    Keys that aren't known are ignored, and missing keys keep their default
+    values, so a file written by one version can be read by another.
+
+    Set current_search_tuning () before starting any threads that search;
+    it is not guarded.
+*/
+
+    //  The default for search_tuning::short_corpus
+    static const std::size_t search_each_short_corpus = 256;
+
+/*!
+    \struct search_tuning
+    \brief  Crossover points between algorithms
+*/
+    struct search_tuning {
+        search_tuning () : short_corpus ( search_each_short_corpus ), horspool_max_pattern ( 64 ),
+                           parallel_min_grain ( execution::parallel_min_grain ) {}
+
+        std::size_t short_corpus;           // search_each: corpora up to this long don't go to the searcher
+        std::size_t horspool_max_pattern;   // calibrated_search: patterns up to this long use
+                                            // boyer_moore_horspool, longer ones boyer_moore
+        std::size_t parallel_min_grain;     // parallel.hpp: inputs up to this long are done on the
+                                            // calling thread, and no piece is smaller by default
+
+        bool operator == ( const search_tuning &rhs ) const {
+            return short_corpus == rhs.short_corpus && horspool_max_pattern == rhs.horspool_max_pattern
+                && parallel_min_grain == rhs.parallel_min_grain;
+            }
+        bool operator != ( const search_tuning &rhs ) const { return !( *this == rhs ); }
+        };
+
+/*!
+    \struct tuning_format_error
+    \brief  Thrown when a tuning file can't be opened, or has a value that isn't a number
+*/
+    struct tuning_format_error : virtual boost::exception, virtual std::exception {};
+
+    typedef boost::error_info<struct tag_tuning_line, std::string> tuning_line;
+
+
+/// \fn current_search_tuning ()
+/// \brief The settings that the library uses
+    inline search_tuning &current_search_tuning () {
+        static search_tuning t;
+        return t;
+        }
+
+/// \fn write_search_tuning ( std::ostream &out, const search_tuning &t )
+/// \brief Writes the settings as text, one "key value" line each
+    inline void write_search_tuning ( std::ostream &out, const search_tuning &t ) {
+        out << "# boost.algorithm search tuning\n"
+            << "short_corpus "         << t.short_corpus         << "\n"
+            << "horspool_max_pattern " << t.horspool_max_pattern << "\n"
+            << "parallel_min_grain "   << t.parallel_min_grain   << "\n";
+        }
+
+/// \fn read_search_tuning ( std::istream &in )
+/// \brief Reads settings written by write_search_tuning; anything not mentioned gets its default
+    inline search_tuning read_search_tuning ( std::istream &in ) {
+        search_tuning retVal;
+        std::string line;
+        while ( std::getline ( in, line )) {
+            std::istringstream words ( line );
+            std::string key;
+            if ( !( words >> key ) || key [ 0 ] == '#' )
+                continue;
+
+            std::size_t *field = NULL;
+            if      ( key == "short_corpus" )         field = &retVal.short_corpus;
+            else if ( key == "horspool_max_pattern" ) field = &retVal.horspool_max_pattern;
+            else if ( key == "parallel_min_grain" )   field = &retVal.parallel_min_grain;
+            else
+                continue;   // from some other version
+
+            std::string rest;
+            if ( !( words >> *field ) || ( words >> rest ))
+                BOOST_THROW_EXCEPTION ( tuning_format_error () << tuning_line ( line ));
+            }
+        return retVal;
+        }
+
+/// \fn save_search_tuning ( const std::string &path, const search_tuning &t )
+/// \brief Writes the settings to the file 'path'
+    inline void save_search_tuning ( const std::string &path, const search_tuning &t ) {
+        std::ofstream out ( path.c_str ());
+        write_search_tuning ( out, t );
+        if ( !out.flush ())
+            BOOST_THROW_EXCEPTION ( tuning_format_error () << boost::errinfo_file_name ( path ));
+        }
+
+/// \fn load_search_tuning ( const std::string &path )
+/// \brief Reads the settings from the file 'path'
+    inline search_tuning load_search_tuning ( const std::string &path ) {
+        std::ifstream in ( path.c_str ());
+        if ( !in )
+            BOOST_THROW_EXCEPTION ( tuning_format_error () << boost::errinfo_file_name ( path ));
+        try { return read_search_tuning ( in ); }
+        catch ( tuning_format_error &e ) {
+            e << boost::errinfo_file_name ( path );
+            throw;
+            }
+        }
+
+
+/// \fn calibrated_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, with boyer_moore_horspool or
+///     boyer_moore, whichever current_search_tuning () says is faster for
+///     a pattern of this length.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter calibrated_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        if ( static_cast<std::size_t> ( std::distance ( pat_first, pat_last )) <= current_search_tuning ().horspool_max_pattern )
+            return boyer_moore_horspool_search ( corpus_first, corpus_last, pat_first, pat_last );
+        return boyer_moore_search ( corpus_first, corpus_last, pat_first, pat_last );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_TUNING_HPP
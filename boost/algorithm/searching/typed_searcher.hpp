@@ -0,0 +1,298 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_TYPED_SEARCHER_HPP
+#define BOOST_ALGORITHM_TYPED_SEARCHER_HPP
+
+#include <algorithm>    // for std::reverse, std::equal
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcpy, std::memcmp
+#include <iterator>     // for std::iterator_traits
+#include <stdexcept>    // for std::invalid_argument
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_arithmetic.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/byte_set.hpp>   // for is_contiguous_byte_iterator and the SSE2 test
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching a buffer of bytes for values of some other type.
+
+    A typed_searcher<T> searches a byte buffer (a file, a packet capture, ...)
+    for a value of the arithmetic type T, or a sequence of them, stored in a
+    given byte order. The values are turned into bytes once, when the
+    searcher is made, so the buffer is never reinterpreted as T, and has no
+    alignment requirements of its own.
+
+    A match must start at an offset from the start of the corpus that is a
+    multiple of 'alignment'. By default that is sizeof ( T ), which finds
+    values stored in an array of T; an alignment of 1 finds them anywhere.
+
+    When the corpus is contiguous and the processor has SSE2, sixteen bytes
+    are tested at a time, and the alignment (if it divides sixteen) is
+    applied to the result as a mask:
+
+        * If the alignment is a multiple of sizeof ( T ), each T-sized lane is
+          compared with the first value of the pattern.
+        * Otherwise, the first and last bytes of the first value are compared
+          at every offset.
+
+    The rest of the pattern is only compared at the offsets that pass.
+
+    Requirements:
+        * T is an arithmetic type
+        * The corpus is a one-byte integral type
+        * Random access iterators
+*/
+
+    enum byte_order {
+        native_byte_order,
+        little_endian_byte_order,
+        big_endian_byte_order
+        };
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline bool is_little_endian () {
+        const boost::uint16_t one = 1;
+        return *reinterpret_cast<const unsigned char *> ( &one ) == 1;
+        }
+}
+/// \endcond
+
+    template <typename T>
+    class typed_searcher {
+        BOOST_STATIC_ASSERT (( boost::is_arithmetic<T>::value ));
+    public:
+        /// \brief Search for 'value', stored in 'order', at offsets that are a multiple of 'alignment'
+        explicit typed_searcher ( const T &value, byte_order order = native_byte_order,
+                                  std::size_t alignment = sizeof ( T ))
+                : k_alignment ( alignment ) {
+            init ( &value, &value + 1, order );
+            }
+
+        /// \brief Search for the sequence of values [first, last)
+        template <typename Iter>
+        typed_searcher ( Iter first, Iter last, byte_order order = native_byte_order,
+                         std::size_t alignment = sizeof ( T ))
+                : k_alignment ( alignment ) {
+            init ( first, last, order );
+            }
+
+        ~typed_searcher () {}
+
+        /// \brief The length of every match, in bytes
+        std::size_t pattern_length () const { return pattern_.size (); }
+
+        std::size_t alignment () const { return k_alignment; }
+
+        /// \brief The bytes being searched for
+        const std::vector<unsigned char> &pattern_bytes () const { return pattern_; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the bytes of the corpus for the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+            BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "typed_searcher", corpus_first, corpus_last, pattern_.size ());
+            const corpusIter retVal = corpus_first == corpus_last || pattern_.empty () ? corpus_first
+                : dispatch ( corpus_first, corpus_last, boost::integral_constant<bool,
+                        detail::is_contiguous_byte_iterator<corpusIter>::value> ());
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "typed_searcher", corpus_first, corpus_last, pattern_.size (), retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+        /// \brief Finds the pattern in [first, last)
+        const unsigned char *find ( const unsigned char *first, const unsigned char *last ) const {
+            const std::size_t m = pattern_.size ();
+            if ( m == 0 )
+                return first;
+            const unsigned char *p = first;
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+            if ( 16 % k_alignment == 0 && active_simd_level () >= simd_sse2 ) {
+                const unsigned char *found;
+                if ( k_alignment % sizeof ( T ) == 0 && 16 % sizeof ( T ) == 0 )
+                    found = find_lanes ( p, last );
+                else
+                    found = find_ends ( p, last );
+                if ( found != NULL )
+                    return found;
+                }
+#endif
+        //  The rest (or all) of it, one aligned offset at a time
+            const std::size_t n = last - first;
+            for ( std::size_t o = p - first; o <= n && n - o >= m; o += k_alignment )
+                if ( std::memcmp ( first + o, &pattern_ [ 0 ], m ) == 0 )
+                    return first + o;
+            return last;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        std::size_t k_alignment;
+        std::vector<unsigned char> pattern_;
+
+        template <typename Iter>
+        void init ( Iter first, Iter last, byte_order order ) {
+            if ( k_alignment == 0 )
+                BOOST_THROW_EXCEPTION ( std::invalid_argument ( "typed_searcher: the alignment must not be zero" ));
+            const bool swap = ( order == little_endian_byte_order && !detail::is_little_endian ())
+                           || ( order == big_endian_byte_order   &&  detail::is_little_endian ());
+            unsigned char bytes [ sizeof ( T ) ];
+            for ( ; first != last; ++first ) {
+                const T value = *first;
+                std::memcpy ( bytes, &value, sizeof ( T ));
+                if ( swap )
+                    std::reverse ( bytes, bytes + sizeof ( T ));
+                pattern_.insert ( pattern_.end (), bytes, bytes + sizeof ( T ));
+                }
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "typed_searcher", pattern_.size ());
+            }
+
+        template <typename corpusIter>
+        corpusIter dispatch ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            const std::size_t m = pattern_.size ();
+            const std::size_t n = corpus_last - corpus_first;
+            for ( std::size_t o = 0; o <= n && n - o >= m; o += k_alignment ) {
+                std::size_t i = 0;
+                while ( i < m && static_cast<unsigned char> ( corpus_first [ o + i ] ) == pattern_ [ i ] )
+                    ++i;
+                if ( i == m )
+                    return corpus_first + o;
+                }
+            return corpus_last;
+            }
+
+        template <typename corpusIter>
+        corpusIter dispatch ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            const unsigned char *first = reinterpret_cast<const unsigned char *> ( &*corpus_first );
+            const unsigned char *last  = first + ( corpus_last - corpus_first );
+            return corpus_first + ( find ( first, last ) - first );
+            }
+
+#ifdef BOOST_ALGORITHM_BYTE_SET_SSE2
+    //  The bits of a sixteen bit mask that are at aligned offsets
+        unsigned aligned_mask () const {
+            unsigned retVal = 0;
+            for ( std::size_t i = 0; i < 16; i += k_alignment )
+                retVal |= 1U << i;
+            return retVal;
+            }
+
+    //  Check the candidates in 'mask', at offsets from 'p'; returns the match,
+    //  'last' if the candidates have run past the end, or NULL to carry on.
+        const unsigned char *check ( const unsigned char *p, const unsigned char *last, unsigned mask ) const {
+            const std::size_t m = pattern_.size ();
+            for ( ; mask != 0; mask &= mask - 1 ) {
+                const unsigned char *c = p + detail::byte_set_first_bit ( mask );
+                if ( static_cast<std::size_t> ( last - c ) < m )
+                    return last;
+                if ( std::memcmp ( c, &pattern_ [ 0 ], m ) == 0 )
+                    return c;
+                }
+            return NULL;
+            }
+
+    //  These return the match, or NULL with 'p' left where the scalar code should pick up.
+    //  Compare whole T-sized lanes with the first value
+        const unsigned char *find_lanes ( const unsigned char *&p, const unsigned char *last ) const {
+            unsigned char repeated [ 16 ];
+            for ( std::size_t i = 0; i < 16; ++i )
+                repeated [ i ] = pattern_ [ i % sizeof ( T ) ];
+            const __m128i needle = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( repeated ));
+            const unsigned aligned = aligned_mask ();
+
+            for ( ; last - p >= 16; p += 16 ) {
+                unsigned mask = static_cast<unsigned> ( _mm_movemask_epi8 ( _mm_cmpeq_epi8 (
+                            _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p )), needle )));
+            //  Leave a bit set at the start of each lane whose bytes all matched
+                for ( std::size_t s = 1; s < sizeof ( T ); s <<= 1 )
+                    mask &= mask >> s;
+                const unsigned char *found = check ( p, last, mask & aligned );
+                if ( found != NULL )
+                    return found;
+                }
+            return NULL;
+            }
+
+    //  Compare the first and last bytes of the first value
+        const unsigned char *find_ends ( const unsigned char *&p, const unsigned char *last ) const {
+            const std::size_t k = sizeof ( T ) - 1;
+            const __m128i head = _mm_set1_epi8 ( static_cast<char> ( pattern_ [ 0 ] ));
+            const __m128i tail = _mm_set1_epi8 ( static_cast<char> ( pattern_ [ k ] ));
+            const unsigned aligned = aligned_mask ();
+
+            for ( ; static_cast<std::size_t> ( last - p ) >= 16 + k; p += 16 ) {
+                const __m128i hits = _mm_and_si128 (
+                    _mm_cmpeq_epi8 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p )), head ),
+                    _mm_cmpeq_epi8 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( p + k )), tail ));
+                const unsigned char *found = check ( p, last, static_cast<unsigned> ( _mm_movemask_epi8 ( hits )) & aligned );
+                if ( found != NULL )
+                    return found;
+                }
+            return NULL;
+            }
+#endif
+/// \endcond
+        };
+
+/// \fn typed_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       const T &value, byte_order order, std::size_t alignment )
+/// \brief Searches a byte buffer for a value of type T
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param value        The value to search for
+/// \param order        The byte order it is stored in
+/// \param alignment    Matches start at a multiple of this many bytes from corpus_first
+///
+    template <typename T, typename corpusIter>
+    corpusIter typed_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            const T &value, byte_order order = native_byte_order, std::size_t alignment = sizeof ( T )) {
+        typed_searcher<T> ts ( value, order, alignment );
+        return ts ( corpus_first, corpus_last );
+        }
+
+    //  Creator function -- takes a range of values, returns an object
+    template <typename Range>
+    boost::algorithm::typed_searcher<typename std::iterator_traits<typename boost::range_iterator<const Range>::type>::value_type>
+    make_typed_searcher ( const Range &r, byte_order order = native_byte_order,
+            std::size_t alignment = sizeof ( typename std::iterator_traits<typename boost::range_iterator<const Range>::type>::value_type )) {
+        return boost::algorithm::typed_searcher<typename std::iterator_traits<typename boost::range_iterator<const Range>::type>::value_type>
+                ( boost::begin ( r ), boost::end ( r ), order, alignment );
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_TYPED_SEARCHER_HPP
@@ -0,0 +1,424 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_UTF8_HPP
+#define BOOST_ALGORITHM_SEARCH_UTF8_HPP
+
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <vector>
+
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/probes.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching UTF-8 text.
+
+    The searchers compare bytes, so a pattern that starts with a UTF-8
+    continuation byte (or ends part way through a multi-byte sequence) can
+    match in the middle of a character. utf8_searcher wraps a byte searcher,
+    and only reports matches that start and end on code point boundaries,
+    which it checks by looking at the class of the byte at each end. When the
+    pattern starts with a lead (or ASCII) byte and ends with a complete
+    character -- which is the case for any well-formed UTF-8 pattern --
+    every match is on a boundary already, and the byte searcher is called
+    directly, with nothing added.
+
+    utf8_icase_searcher does case-insensitive searching, using simple (one
+    to one) Unicode case folding for ASCII, Latin-1, Latin Extended-A, Latin
+    Extended Additional, Greek, Cyrillic, Armenian and the fullwidth Latin
+    letters. For each character of the pattern it works out, once, the UTF-8
+    encodings of every character that folds to the same thing, and searches
+    with a Horspool skip table built over all of them. Only variants with the
+    same encoded length as the pattern character are used, so the few folds
+    that change the length (KELVIN SIGN and 'k', LONG S and 's', and so on)
+    are not matched. A pattern with no letters that have case variants is
+    searched with boyer_moore_horspool, so digits and punctuation cost
+    nothing extra.
+
+    Requirements (both searchers):
+        * Random access iterators
+        * The pattern and corpus must be a one-byte integral type, holding UTF-8
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    inline bool utf8_is_continuation ( unsigned char c ) { return ( c & 0xC0 ) == 0x80; }
+
+//  The length of the sequence that starts with 'lead', or 0 if it isn't a lead byte
+    inline std::size_t utf8_sequence_length ( unsigned char lead ) {
+        if ( lead < 0x80 ) return 1;
+        if ( lead < 0xC2 ) return 0;
+        if ( lead < 0xE0 ) return 2;
+        if ( lead < 0xF0 ) return 3;
+        if ( lead < 0xF5 ) return 4;
+        return 0;
+        }
+
+//  Decode the sequence at p [ 0, len ); returns the length used, or 0 if it is malformed
+    inline std::size_t utf8_decode ( const unsigned char *p, std::size_t len, boost::uint32_t &cp ) {
+        const std::size_t n = utf8_sequence_length ( p [ 0 ] );
+        if ( n == 0 || n > len )
+            return 0;
+        static const unsigned char lead_mask [] = { 0, 0x7F, 0x1F, 0x0F, 0x07 };
+        cp = p [ 0 ] & lead_mask [ n ];
+        for ( std::size_t i = 1; i < n; ++i ) {
+            if ( !utf8_is_continuation ( p [ i ] ))
+                return 0;
+            cp = ( cp << 6 ) | ( p [ i ] & 0x3F );
+            }
+        static const boost::uint32_t smallest [] = { 0, 0, 0x80, 0x800, 0x10000 };
+        if ( cp < smallest [ n ] || cp > 0x10FFFF || ( cp >= 0xD800 && cp <= 0xDFFF ))
+            return 0;   // overlong, too big, or a surrogate
+        return n;
+        }
+
+    inline std::size_t utf8_encode ( boost::uint32_t cp, unsigned char *out ) {
+        if ( cp < 0x80 )    { out [ 0 ] = static_cast<unsigned char> ( cp ); return 1; }
+        if ( cp < 0x800 )   { out [ 0 ] = static_cast<unsigned char> ( 0xC0 | ( cp >> 6 ));
+                              out [ 1 ] = static_cast<unsigned char> ( 0x80 | ( cp & 0x3F )); return 2; }
+        if ( cp < 0x10000 ) { out [ 0 ] = static_cast<unsigned char> ( 0xE0 | ( cp >> 12 ));
+                              out [ 1 ] = static_cast<unsigned char> ( 0x80 | (( cp >> 6 ) & 0x3F ));
+                              out [ 2 ] = static_cast<unsigned char> ( 0x80 | ( cp & 0x3F )); return 3; }
+        out [ 0 ] = static_cast<unsigned char> ( 0xF0 | ( cp >> 18 ));
+        out [ 1 ] = static_cast<unsigned char> ( 0x80 | (( cp >> 12 ) & 0x3F ));
+        out [ 2 ] = static_cast<unsigned char> ( 0x80 | (( cp >> 6 ) & 0x3F ));
+        out [ 3 ] = static_cast<unsigned char> ( 0x80 | ( cp & 0x3F ));
+        return 4;
+        }
+
+//  Simple case folding (to lower case) for the scripts listed above
+    inline boost::uint32_t utf8_fold ( boost::uint32_t cp ) {
+        if ( cp < 0x80 )
+            return ( cp >= 'A' && cp <= 'Z' ) ? cp + 0x20 : cp;
+        if ( cp < 0x100 ) {
+            if ( cp >= 0xC0 && cp <= 0xDE && cp != 0xD7 ) return cp + 0x20;
+            if ( cp == 0xB5 ) return 0x3BC;                     // MICRO SIGN
+            return cp;
+            }
+        if ( cp < 0x180 ) {
+            if ( cp == 0x178 ) return 0xFF;
+            if (( cp >= 0x100 && cp <= 0x12F ) || ( cp >= 0x132 && cp <= 0x137 ) || ( cp >= 0x14A && cp <= 0x177 ))
+                return cp | 1;                                  // upper case is even
+            if (( cp >= 0x139 && cp <= 0x148 ) || ( cp >= 0x179 && cp <= 0x17E ))
+                return ( cp & 1 ) ? cp + 1 : cp;                // upper case is odd
+            return cp;
+            }
+        if ( cp >= 0x370 && cp < 0x400 ) {
+            if ( cp == 0x386 ) return 0x3AC;
+            if ( cp >= 0x388 && cp <= 0x38A ) return cp + 0x25;
+            if ( cp == 0x38C ) return 0x3CC;
+            if ( cp == 0x38E || cp == 0x38F ) return cp + 0x3F;
+            if (( cp >= 0x391 && cp <= 0x3A1 ) || ( cp >= 0x3A3 && cp <= 0x3AB )) return cp + 0x20;
+            if ( cp == 0x3C2 ) return 0x3C3;                    // final sigma
+            return cp;
+            }
+        if ( cp >= 0x400 && cp < 0x530 ) {
+            if ( cp <= 0x40F ) return cp + 0x50;
+            if ( cp <= 0x42F ) return cp + 0x20;
+            if ( cp == 0x4C0 ) return 0x4CF;
+            if (( cp >= 0x460 && cp <= 0x481 ) || ( cp >= 0x48A && cp <= 0x4BF ) || cp >= 0x4D0 )
+                return cp | 1;
+            if ( cp >= 0x4C1 && cp <= 0x4CE )
+                return ( cp & 1 ) ? cp + 1 : cp;
+            return cp;
+            }
+        if ( cp >= 0x531 && cp <= 0x556 ) return cp + 0x30;
+        if (( cp >= 0x1E00 && cp <= 0x1E95 ) || ( cp >= 0x1EA0 && cp <= 0x1EFF )) return cp | 1;
+        if ( cp >= 0xFF21 && cp <= 0xFF3A ) return cp + 0x20;
+        return cp;
+        }
+
+//  Every character that utf8_fold changes is in one of these ranges
+    inline void utf8_case_variants ( boost::uint32_t cp, std::vector<boost::uint32_t> &out ) {
+        static const boost::uint32_t ranges [][2] = {
+            { 0x41, 0x5A }, { 0xB5, 0xB5 }, { 0xC0, 0xDE }, { 0x100, 0x17F }, { 0x386, 0x3AB }, { 0x3C2, 0x3C2 },
+            { 0x400, 0x52F }, { 0x531, 0x556 }, { 0x1E00, 0x1EFF }, { 0xFF21, 0xFF3A } };
+        const boost::uint32_t folded = utf8_fold ( cp );
+        out.clear ();
+        out.push_back ( folded );
+        for ( std::size_t i = 0; i < sizeof ( ranges ) / sizeof ( ranges [ 0 ] ); ++i )
+            for ( boost::uint32_t c = ranges [ i ][ 0 ]; c <= ranges [ i ][ 1 ]; ++c )
+                if ( c != folded && utf8_fold ( c ) == folded )
+                    out.push_back ( c );
+        }
+}
+/// \endcond
+
+
+/*!
+    \class utf8_searcher
+    \brief A byte searcher that only reports matches on code point boundaries
+*/
+    template <typename patIter, typename Searcher = boyer_moore_horspool<patIter> >
+    class utf8_searcher {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+    public:
+        utf8_searcher ( patIter first, patIter last )
+                : searcher_ ( first, last ), k_pattern_length ( std::distance ( first, last )),
+                  check_ ( !on_boundaries ( first, last )) {
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "utf8_searcher", k_pattern_length );
+            }
+
+        ~utf8_searcher () {}
+
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern, skipping matches that aren't on code point boundaries
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "utf8_searcher", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "utf8_searcher", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        Searcher searcher_;
+        std::size_t k_pattern_length;
+        bool check_;    // can a match start or end inside a character?
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            if ( !check_ )
+                return searcher_ ( corpus_first, corpus_last );
+
+            for ( corpusIter p = corpus_first; ; ++p ) {
+                const corpusIter it = searcher_ ( p, corpus_last );
+                if ( it == corpus_last )
+                    return corpus_last;
+                const corpusIter end = it + k_pattern_length;
+                if ( !detail::utf8_is_continuation ( static_cast<unsigned char> ( *it ))
+                        && ( end == corpus_last || !detail::utf8_is_continuation ( static_cast<unsigned char> ( *end ))))
+                    return it;
+                p = it;
+                }
+            }
+
+    //  Does the pattern start at a boundary, and end with a complete sequence?
+        static bool on_boundaries ( patIter first, patIter last ) {
+            if ( first == last )
+                return true;
+            if ( detail::utf8_is_continuation ( static_cast<unsigned char> ( *first )))
+                return false;
+            patIter lead = last;
+            do { --lead; } while ( detail::utf8_is_continuation ( static_cast<unsigned char> ( *lead )));
+            const std::size_t n = detail::utf8_sequence_length ( static_cast<unsigned char> ( *lead ));
+            return n == static_cast<std::size_t> ( std::distance ( lead, last ));
+            }
+/// \endcond
+        };
+
+
+/*!
+    \class utf8_icase_searcher
+    \brief Case-insensitive searching of UTF-8 text, with simple case folding
+*/
+    template <typename patIter>
+    class utf8_icase_searcher {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        BOOST_STATIC_ASSERT (( boost::is_integral<value_type>::value && sizeof ( value_type ) == 1 ));
+    public:
+        utf8_icase_searcher ( patIter first, patIter last )
+                : exact_ ( first, last ), k_pattern_length ( std::distance ( first, last )), folds_ ( false ) {
+            const std::vector<unsigned char> pat ( first, last );
+            std::vector<boost::uint32_t> variants;
+            unsigned char buf [ 4 ];
+            for ( std::size_t pos = 0; pos < pat.size (); ) {
+                unit u;
+                u.offset = pos;
+                u.first_variant = variant_bytes_.size ();
+                boost::uint32_t cp;
+                u.length = detail::utf8_decode ( &pat [ pos ], pat.size () - pos, cp );
+                if ( u.length == 0 ) {
+                //  Not UTF-8; match the byte as it is
+                    u.length = 1;
+                    variant_bytes_.push_back ( pat [ pos ] );
+                    }
+                else {
+                    detail::utf8_case_variants ( cp, variants );
+                    for ( std::size_t i = 0; i < variants.size (); ++i )
+                        if ( detail::utf8_encode ( variants [ i ], buf ) == u.length )
+                            variant_bytes_.insert ( variant_bytes_.end (), buf, buf + u.length );
+                    }
+                u.variants = ( variant_bytes_.size () - u.first_variant ) / u.length;
+                if ( u.variants > 1 )
+                    folds_ = true;
+                units_.push_back ( u );
+                pos += u.length;
+                }
+            if ( folds_ )
+                build_tables ();
+            BOOST_ALGORITHM_PROBE_SEARCHER_CREATE ( "utf8_icase_searcher", k_pattern_length );
+            }
+
+        ~utf8_icase_searcher () {}
+
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern, ignoring case
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_ALGORITHM_PROBE_SEARCH_BEGIN ( "utf8_icase_searcher", corpus_first, corpus_last, k_pattern_length );
+            const corpusIter retVal = this->find ( corpus_first, corpus_last );
+            BOOST_ALGORITHM_PROBE_SEARCH_END ( "utf8_icase_searcher", corpus_first, corpus_last, k_pattern_length, retVal );
+            return retVal;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) ( boost::begin ( r ), boost::end ( r ));
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        struct unit {           // one character of the pattern
+            std::size_t offset, length;
+            std::size_t first_variant, variants;
+            };
+
+        boyer_moore_horspool<patIter> exact_;
+        std::size_t k_pattern_length;
+        bool folds_;            // does any character have more than one variant?
+        std::vector<unit> units_;
+        std::vector<unsigned char> variant_bytes_;
+        std::size_t skip_ [ 256 ];
+        bool last_byte_ [ 256 ];
+
+    //  The search itself; operator () adds the trace points
+        template <typename corpusIter>
+        corpusIter find ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            if ( !folds_ )
+                return exact_ ( corpus_first, corpus_last );
+            if ( corpus_last - corpus_first < static_cast<std::ptrdiff_t> ( k_pattern_length ))
+                return corpus_last;
+
+            const corpusIter lastPos = corpus_last - k_pattern_length;
+            for ( corpusIter curPos = corpus_first; curPos <= lastPos; ) {
+                const unsigned char c = static_cast<unsigned char> ( curPos [ k_pattern_length - 1 ] );
+                if ( last_byte_ [ c ] && matches ( curPos ))
+                    return curPos;
+                curPos += skip_ [ c ];
+                }
+            return corpus_last;
+            }
+
+    //  The Horspool skip table, over every byte any variant has at each position
+        void build_tables () {
+            for ( int c = 0; c < 256; ++c ) {
+                skip_ [ c ] = k_pattern_length;
+                last_byte_ [ c ] = false;
+                }
+            for ( std::size_t i = 0; i < units_.size (); ++i ) {
+                const unit &u = units_ [ i ];
+                for ( std::size_t v = 0; v < u.variants; ++v )
+                    for ( std::size_t j = 0; j < u.length; ++j ) {
+                        const std::size_t pos = u.offset + j;
+                        const unsigned char c = variant_bytes_ [ u.first_variant + v * u.length + j ];
+                        if ( pos == k_pattern_length - 1 )
+                            last_byte_ [ c ] = true;
+                        else if ( skip_ [ c ] > k_pattern_length - 1 - pos )
+                            skip_ [ c ] = k_pattern_length - 1 - pos;
+                        }
+                }
+            }
+
+        template <typename corpusIter>
+        bool matches ( corpusIter pos ) const {
+            for ( std::size_t i = 0; i < units_.size (); ++i ) {
+                const unit &u = units_ [ i ];
+                const unsigned char *v = &variant_bytes_ [ u.first_variant ];
+                bool found = false;
+                for ( std::size_t k = 0; !found && k < u.variants; ++k, v += u.length ) {
+                    std::size_t j = 0;
+                    while ( j < u.length && static_cast<unsigned char> ( pos [ u.offset + j ] ) == v [ j ] )
+                        ++j;
+                    found = j == u.length;
+                    }
+                if ( !found )
+                    return false;
+                }
+            return true;
+            }
+/// \endcond
+        };
+
+
+/// \fn utf8_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches UTF-8 text for the pattern, only matching on code point boundaries
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter utf8_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        utf8_searcher<patIter> us ( pat_first, pat_last );
+        return us ( corpus_first, corpus_last );
+        }
+
+/// \fn utf8_icase_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches UTF-8 text for the pattern, ignoring case
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter utf8_icase_search (
+            corpusIter corpus_first, corpusIter corpus_last,
+            patIter pat_first, patIter pat_last ) {
+        utf8_icase_searcher<patIter> us ( pat_first, pat_last );
+        return us ( corpus_first, corpus_last );
+        }
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::utf8_searcher<typename boost::range_iterator<const Range>::type>
+    make_utf8_searcher ( const Range &r ) {
+        return boost::algorithm::utf8_searcher
+            <typename boost::range_iterator<const Range>::type> ( boost::begin ( r ), boost::end ( r ));
+        }
+
+    template <typename Range>
+    boost::algorithm::utf8_icase_searcher<typename boost::range_iterator<const Range>::type>
+    make_utf8_icase_searcher ( const Range &r ) {
+        return boost::algorithm::utf8_icase_searcher
+            <typename boost::range_iterator<const Range>::type> ( boost::begin ( r ), boost::end ( r ));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_UTF8_HPP
@@ -0,0 +1,85 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+//  A small recursive grep, which is also a throughput benchmark for the searchers:
+//
+//      file_scanner_example [-a] [-c] [-j threads] pattern path...
+//
+//          -a          report every match in each file, not just the first
+//          -c          don't print the matches, just count them
+//          -j threads  the number of threads (the default is one per processor)
+//
+//  The matches are printed as "path:offset", and a summary (files, bytes,
+//  time and MB/s) is written to stderr at the end.
+
+#include <cstdlib>      // for std::atoi
+#include <cstring>      // for std::strcmp
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/file_scanner.hpp>
+
+namespace ba = boost::algorithm;
+namespace fs = boost::filesystem;
+
+typedef ba::boyer_moore_horspool<std::string::const_iterator> searcher_type;
+
+struct print_match {
+    print_match ( bool quiet, unsigned long &count ) : quiet_ ( quiet ), count_ ( count ) {}
+    void operator () ( const fs::path &p, std::size_t offset ) const {
+        ++count_;
+        if ( !quiet_ )
+            std::cout << p.string () << ':' << offset << '\n';
+        }
+    bool quiet_;
+    unsigned long &count_;
+    };
+
+int usage () {
+    std::cerr << "usage: file_scanner_example [-a] [-c] [-j threads] pattern path..." << std::endl;
+    return 1;
+    }
+
+int main ( int argc, char *argv [] ) {
+    bool all = false, quiet = false;
+    unsigned threads = 0;
+    int i = 1;
+    for ( ; i < argc && argv [i][0] == '-'; ++i ) {
+        if      ( std::strcmp ( argv [i], "-a" ) == 0 ) all = true;
+        else if ( std::strcmp ( argv [i], "-c" ) == 0 ) quiet = true;
+        else if ( std::strcmp ( argv [i], "-j" ) == 0 && i + 1 < argc ) threads = std::atoi ( argv [++i] );
+        else return usage ();
+        }
+    if ( argc - i < 2 )
+        return usage ();
+
+    const std::string pattern ( argv [i++] );
+    std::vector<fs::path> roots ( argv + i, argv + argc );
+
+//  The searcher is built once, and shared by all the threads
+    const searcher_type searcher ( pattern.begin (), pattern.end ());
+    ba::file_scanner<searcher_type> scanner ( searcher,
+        all ? ba::file_scanner<searcher_type>::all_matches : ba::file_scanner<searcher_type>::first_match, threads );
+
+    unsigned long matches = 0;
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time ();
+    scanner ( roots, print_match ( quiet, matches ));
+    const double seconds = ( boost::posix_time::microsec_clock::universal_time () - start ).total_microseconds () / 1e6;
+
+    std::cout.flush ();
+    std::cerr << scanner.files_scanned () << " files (" << scanner.files_skipped () << " skipped), "
+              << scanner.bytes_scanned () << " bytes, " << matches << " matches in "
+              << seconds << " s: " << ( seconds > 0 ? scanner.bytes_scanned () / seconds / 1e6 : 0.0 ) << " MB/s"
+              << std::endl;
+    return matches == 0 ? 1 : 0;
+    }
@@ -12,16 +12,17 @@
 #include <string>
 
 #include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/perf_counters.hpp>
 
 #define	kNumTests	100000
 
 namespace test0 {
 //	No work; just the loop
-	unsigned long tohex ( const char *source ) {
-		std::clock_t b_time = std::clock ();
+	boost::algorithm::perf_sample tohex ( boost::algorithm::perf_counters &counters, const char *source ) {
+		counters.start ();
 		for ( int i = 0; i < kNumTests; ++i ) {
 			}
-		return std::clock () - b_time;
+		return counters.stop ();
 		}
 
 	}
@@ -29,11 +30,11 @@ namespace test0 {
 namespace test1 {
 //	C version
 //	No memory allocation - just write the data into a buffer
-	unsigned long tohex ( const char *source ) {
+	boost::algorithm::perf_sample tohex ( boost::algorithm::perf_counters &counters, const char *source ) {
 		char output [ 1000 ];
 		const char *ptr;
 		char *out;
-		std::clock_t b_time = std::clock ();
+		counters.start ();
 		
 		for ( int i = 0; i < kNumTests; ++i ) {
 			ptr = source;
@@ -46,29 +47,29 @@ namespace test1 {
 			}
 //		*out = 0;
 //		std::cout << "Test1 got: " << &output[0] << std::endl;
-		return std::clock () - b_time;
+		return counters.stop ();
 		}
 
 	}
 	
 namespace test2 {
 //	No memory allocation - just write the data into a buffer
-	unsigned long tohex ( const char *source ) {
+	boost::algorithm::perf_sample tohex ( boost::algorithm::perf_counters &counters, const char *source ) {
 		char output [ 1000 ];
-		std::clock_t b_time = std::clock ();
+		counters.start ();
 		for ( int i = 0; i < kNumTests; ++i ) {
 			boost::algorithm::hex ( source, output );
 			}
 //		output [ 2 * std::strlen ( source ) ] = '\0';
 //		std::cout << "Test2 got: " << &output[0] << std::endl;
-		return std::clock () - b_time;
+		return counters.stop ();
 		}
 	}
 	
 namespace test3 {
 //	Should be slowest; has (posible) memory allocation each time through the loop.
-	unsigned long tohex ( const char *source ) {
-		std::clock_t b_time = std::clock ();
+	boost::algorithm::perf_sample tohex ( boost::algorithm::perf_counters &counters, const char *source ) {
+		counters.start ();
 		std::string result;
 		std::back_insert_iterator<std::string> back = std::back_inserter ( result );
 
@@ -78,7 +79,7 @@ namespace test3 {
 			}
 	//	std::cout << "Test3 got: " << result << std::endl;			
 	//	std::cout << "Test3 got: " << result.size () << std::endl;			
-		return std::clock () - b_time;
+		return counters.stop ();
 		}
 	}
 
@@ -86,36 +87,33 @@ namespace test3 {
 #define	kMediumTest		"asdkfjafadsmfadmfa13413241vdadsfa"
 #define	kLongTest		"asdlfkjaf23418q49qfakljfa;kldfjklaefjlaldk;sfal;sdjfl;ajsdfl;ajlsdfajlsdflk;adkls;fkljaewlr;a"
 
+void report ( const char *prompt, const boost::algorithm::perf_sample &s ) {
+	std::cout << prompt << " took " << ((double) s.ticks) / CLOCKS_PER_SEC << " seconds;\t" << s.ticks << " ticks" << std::endl;
+	std::cout << "\t";
+	boost::algorithm::print_perf_sample ( std::cout, s ) << std::endl;
+	}
 
 int main ( int argc, char *argv [] ) {
-	unsigned long zero, one, two, three;
+	boost::algorithm::perf_counters counters;
+	boost::algorithm::perf_sample zero;
 	std::cout << "There are " << CLOCKS_PER_SEC << " ticks per second" << std::endl;
-	zero  = test0::tohex ( kShortTest );
-	std::cout << "Empty tests took " << ((double) zero)   / CLOCKS_PER_SEC << " seconds;\t" << zero  << " ticks" << std::endl;
+	zero  = test0::tohex ( counters, kShortTest );
+	report ( "Empty tests", zero );
 
 	std::cout << "Running tohex short tests " << kNumTests << " times" << std::endl;
-	one   = test1::tohex ( kShortTest );
-	two   = test2::tohex ( kShortTest );
-	three = test3::tohex ( kShortTest );
-	std::cout << "Test1 took " << ((double) one)   / CLOCKS_PER_SEC << " seconds;\t" << one   << " ticks" << std::endl;
-	std::cout << "Test2 took " << ((double) two)   / CLOCKS_PER_SEC << " seconds;\t" << two   << " ticks" << std::endl;
-	std::cout << "Test3 took " << ((double) three) / CLOCKS_PER_SEC << " seconds;\t" << three << " ticks" << std::endl;
+	report ( "Test1", test1::tohex ( counters, kShortTest ));
+	report ( "Test2", test2::tohex ( counters, kShortTest ));
+	report ( "Test3", test3::tohex ( counters, kShortTest ));
 
 	std::cout << "Running tohex medium tests " << kNumTests << " times" << std::endl;
-	one   = test1::tohex ( kMediumTest );
-	two   = test2::tohex ( kMediumTest );
-	three = test3::tohex ( kMediumTest );
-	std::cout << "Test1 took " << ((double) one)   / CLOCKS_PER_SEC << " seconds;\t" << one   << " ticks" << std::endl;
-	std::cout << "Test2 took " << ((double) two)   / CLOCKS_PER_SEC << " seconds;\t" << two   << " ticks" << std::endl;
-	std::cout << "Test3 took " << ((double) three) / CLOCKS_PER_SEC << " seconds;\t" << three << " ticks" << std::endl;
+	report ( "Test1", test1::tohex ( counters, kMediumTest ));
+	report ( "Test2", test2::tohex ( counters, kMediumTest ));
+	report ( "Test3", test3::tohex ( counters, kMediumTest ));
 
 	std::cout << "Running tohex long tests " << kNumTests << " times" << std::endl;
-	one   = test1::tohex ( kLongTest );
-	two   = test2::tohex ( kLongTest );
-	three = test3::tohex ( kLongTest );
-	std::cout << "Test1 took " << ((double) one)   / CLOCKS_PER_SEC << " seconds;\t" << one   << " ticks" << std::endl;
-	std::cout << "Test2 took " << ((double) two)   / CLOCKS_PER_SEC << " seconds;\t" << two   << " ticks" << std::endl;
-	std::cout << "Test3 took " << ((double) three) / CLOCKS_PER_SEC << " seconds;\t" << three << " ticks" << std::endl;
+	report ( "Test1", test1::tohex ( counters, kLongTest ));
+	report ( "Test2", test2::tohex ( counters, kLongTest ));
+	report ( "Test3", test3::tohex ( counters, kLongTest ));
 
 	return 0;
 	}
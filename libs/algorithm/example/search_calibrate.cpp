@@ -0,0 +1,39 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <iostream>     //  for cout, etc.
+#include <exception>
+
+#include <boost/algorithm/parallel.hpp>
+#include <boost/algorithm/searching/calibrate.hpp>
+#include <boost/algorithm/searching/tuning.hpp>
+
+namespace ba = boost::algorithm;
+
+//  Usage: search_calibrate [file]
+//  Measures the search thresholds, and the parallel one, on this machine, prints them, and (if a
+//  file is named) saves them there, to be read at startup with
+//  ba::current_search_tuning () = ba::load_search_tuning ( file );
+
+int main ( int argc, char *argv [] ) {
+    try {
+        ba::search_tuning t = ba::calibrate_search_tuning ();
+        t.parallel_min_grain = ba::calibrate_parallel_min_grain ();
+        ba::write_search_tuning ( std::cout, t );
+        if ( argc > 1 ) {
+            ba::save_search_tuning ( argv [ 1 ], t );
+            std::cout << "Saved to " << argv [ 1 ] << std::endl;
+            }
+        }
+    catch ( const std::exception &e ) {
+        std::cerr << "search_calibrate: " << boost::diagnostic_information ( e ) << std::endl;
+        return 1;
+        }
+    return 0;
+    }
@@ -0,0 +1,493 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/config.hpp>
+
+//  This is the program's one translation unit that replaces operator new
+#define BOOST_ALGORITHM_COUNT_ALLOCATIONS
+#include <boost/algorithm/allocation_counter.hpp>
+
+#include <algorithm>
+#include <boost/algorithm/all_of.hpp>
+#include <boost/algorithm/any_of.hpp>
+#include <boost/algorithm/none_of.hpp>
+#include <boost/algorithm/one_of.hpp>
+#include <boost/algorithm/ordered.hpp>
+#include <boost/algorithm/minmax_element.hpp>
+#include <boost/algorithm/hex.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/tuned_boyer_moore.hpp>
+#include <boost/algorithm/searching/qgram_horspool.hpp>
+#include <boost/algorithm/searching/rabin_karp.hpp>
+#include <boost/algorithm/searching/byte_set.hpp>
+#include <boost/algorithm/searching/typed_searcher.hpp>
+#include <boost/algorithm/searching/multi_literal.hpp>
+#include <boost/algorithm/searching/prefix_matcher.hpp>
+#include <boost/algorithm/searching/baker_bird.hpp>
+#include <boost/algorithm/searching/search_each.hpp>
+#include <boost/algorithm/searching/packed_dna.hpp>
+#include <boost/algorithm/searching/utf8.hpp>
+#include <boost/algorithm/searching/searcher_table.hpp>
+#include <boost/algorithm/searching/suffix_array.hpp>
+#include <boost/algorithm/searching/fm_index.hpp>
+#include <boost/algorithm/searching/replace.hpp>
+#include <boost/algorithm/searching/split_view.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+/*
+    Allocation accounting.
+
+    The global operator new and operator delete are replaced (by
+    allocation_counter.hpp), so that every allocation in the program is
+    counted. An allocation_scope takes a snapshot of the counts when it is
+    made, and reports what was allocated since. counting_allocator does the
+    same for the one container that uses it.
+
+    The hot paths (searching with a searcher that has been built, hex into an
+    output iterator, and the algorithms that reduce a sequence to a value)
+    must not allocate at all. Building a searcher may allocate, but only a
+    bounded number of times, and a bounded number of bytes; the bounds below
+    are what the searchers do now, so that any growth is noticed.
+*/
+
+namespace {
+    using ba::allocation_scope;
+
+//  An allocator that counts what is allocated through it, in the counter
+//  it was given, or (if it was made by a container) in shared_count ()
+    template <typename T>
+    class counting_allocator : public std::allocator<T> {
+    public:
+        typedef std::size_t size_type;
+        typedef T *pointer;
+        template <typename U> struct rebind { typedef counting_allocator<U> other; };
+
+        static std::size_t &shared_count () {
+            static std::size_t count = 0;
+            return count;
+            }
+
+        counting_allocator () : count_ ( &shared_count ()) {}
+        explicit counting_allocator ( std::size_t *count ) : count_ ( count ) {}
+        template <typename U>
+        counting_allocator ( const counting_allocator<U> &other ) : count_ ( other.count_ ) {}
+
+        pointer allocate ( size_type n, const void * = 0 ) {
+            ++*count_;
+            return std::allocator<T>::allocate ( n );
+            }
+
+        std::size_t *count_;
+        };
+
+    template <typename T, typename U>
+    bool operator == ( const counting_allocator<T> &a, const counting_allocator<U> &b ) { return a.count_ == b.count_; }
+    template <typename T, typename U>
+    bool operator != ( const counting_allocator<T> &a, const counting_allocator<U> &b ) { return a.count_ != b.count_; }
+
+//  'expr' must not allocate
+#define CHECK_NO_ALLOCATION(expr)   {                                           \
+    allocation_scope s_;                                                        \
+    expr;                                                                       \
+    BOOST_CHECK_MESSAGE ( s_.allocations () == 0,                               \
+        #expr " allocated " << s_.allocations () << " times" ); }
+
+//  What was allocated in 's' must be no more than 'calls' allocations, of no more than 'bytes' in all
+    void check_bounded ( const char *what, const allocation_scope &s, std::size_t calls, std::size_t bytes ) {
+        const std::size_t allocations = s.allocations ();    // before the output allocates anything
+        const std::size_t allocated   = s.bytes ();
+        std::cout << what << ": " << allocations << " allocations, " << allocated << " bytes" << std::endl;
+        BOOST_CHECK_MESSAGE ( allocations <= calls,
+            what << " allocated " << allocations << " times (at most " << calls << ")" );
+        BOOST_CHECK_MESSAGE ( allocated <= bytes,
+            what << " allocated " << allocated << " bytes (at most " << bytes << ")" );
+        }
+
+//  A vector grown to n elements a piece at a time, doubling its capacity as
+//  it goes, is allocated at most ceil ( log2 ( n )) + 1 times
+    std::size_t growths ( std::size_t n ) {
+        std::size_t retVal = 0;
+        for ( std::size_t capacity = 1; n != 0 && capacity < 2 * n; capacity *= 2 )
+            ++retVal;
+        return retVal;
+        }
+
+//  prefix_matcher copies each of the k patterns a byte at a time into a list
+//  of vectors; without moves (C++03), growing that list copies the patterns
+//  already in it again, fewer than k copies in all. Then it sorts an index,
+//  and builds the trie a node at a time. There are at most 2k nodes, since
+//  each one (but the root) is the end of a pattern or where they branch. Each
+//  node makes a vector of where its groups of children start, and adds to
+//  each of the four arrays of the trie (the nodes, the path bytes, the child
+//  slots and their labels) at most once. The ids are added one at a time.
+    std::size_t prefix_matcher_allocations ( const std::vector<std::string> &patterns ) {
+        const std::size_t k = patterns.size ();
+        std::size_t retVal = growths ( k ) + k;         // the list of copies
+        for ( std::size_t i = 0; i < k; ++i )
+            retVal += growths ( patterns [ i ].size ());
+        retVal += 1;                                    // the sorted index
+        retVal += 2 * k * ( growths ( k + 1 ) + 4 );    // the nodes
+        return retVal + growths ( k );                  // the ids
+        }
+
+    const std::string corpus =
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor "
+        "incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud "
+        "exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat.";
+    const std::string found   = "ullamco laboris";
+    const std::string missing = "ullamco labors";
+
+    typedef std::string::const_iterator str_iter;
+
+//  Searching with a searcher that has been built doesn't allocate, found or not
+    template <typename Searcher>
+    void check_searcher ( const char *what, std::size_t calls, std::size_t bytes ) {
+        allocation_scope build;
+        Searcher s ( found.begin (), found.end ());
+        check_bounded ( what, build, calls, bytes );
+
+        Searcher s2 ( missing.begin (), missing.end ());
+        str_iter r1, r2, r3;
+        CHECK_NO_ALLOCATION ( r1 = s  ( corpus.begin (), corpus.end ()));
+        CHECK_NO_ALLOCATION ( r2 = s2 ( corpus.begin (), corpus.end ()));
+        CHECK_NO_ALLOCATION ( r3 = s  ( corpus.begin (), corpus.begin () + 3 ));
+        BOOST_CHECK ( r1 == std::search ( corpus.begin (), corpus.end (), found.begin (), found.end ()));
+        BOOST_CHECK ( r2 == corpus.end ());
+        BOOST_CHECK ( r3 == corpus.begin () + 3 );
+
+    //  Nor does destroying it free anything it didn't allocate
+        allocation_scope destroy;
+        {
+            Searcher s3 ( found.begin (), found.end ());
+        }
+        BOOST_CHECK_EQUAL ( destroy.allocations (), destroy.frees ());
+        }
+
+    void test_searchers () {
+        const std::size_t m = found.size ();
+        const std::size_t d = sizeof ( std::ptrdiff_t );
+
+    //  suffix_, and three temporaries: the reversed pattern and two prefix tables
+        check_searcher<ba::boyer_moore<str_iter> >          ( "boyer_moore",          4, ( m + 1 ) * d + m + 2 * m * d );
+    //  The skip tables for bytes are arrays in the searcher
+        check_searcher<ba::boyer_moore_horspool<str_iter> > ( "boyer_moore_horspool", 0, 0 );
+        check_searcher<ba::tuned_boyer_moore<str_iter> >    ( "tuned_boyer_moore",    0, 0 );
+        check_searcher<ba::rabin_karp<str_iter> >           ( "rabin_karp",           0, 0 );
+    //  The failure table
+        check_searcher<ba::knuth_morris_pratt<str_iter> >   ( "knuth_morris_pratt",   1, ( m + 1 ) * d );
+    //  The hashed q-gram table
+        check_searcher<ba::qgram_horspool<str_iter> >       ( "qgram_horspool",       1, ( 1U << 16 ) * sizeof ( unsigned short ));
+
+    //  Patterns of wider types use a hash map for the skip table: a bucket array, and a node per distinct element
+        std::vector<int> ints ( 64 );
+        for ( std::size_t i = 0; i < ints.size (); ++i )
+            ints [ i ] = static_cast<int> ( i * 7919 % 101 );
+        std::vector<int> pat ( ints.begin () + 20, ints.begin () + 30 );
+        {
+            allocation_scope build;
+            ba::boyer_moore_horspool<std::vector<int>::const_iterator> s ( pat.begin (), pat.end ());
+            check_bounded ( "boyer_moore_horspool<int>", build, pat.size () + 2, 64 * pat.size () + 1024 );
+            std::vector<int>::const_iterator r;
+            CHECK_NO_ALLOCATION ( r = s ( ints.begin (), ints.end ()));
+            BOOST_CHECK ( r == ints.begin () + 20 );
+        }
+        }
+
+    void test_other_searchers () {
+    //  byte_set_searcher is a bit mask
+        {
+            allocation_scope build;
+            ba::byte_set_searcher s ( std::string ( ",." ));
+            const std::size_t temporary = sizeof ( ",." ) + 64;     // the argument itself, if it isn't a short string
+            check_bounded ( "byte_set_searcher", build, 1, temporary );
+            str_iter r;
+            CHECK_NO_ALLOCATION ( r = s ( corpus.begin (), corpus.end ()));
+            BOOST_CHECK ( r == corpus.begin () + corpus.find ( ',' ));
+        }
+
+    //  typed_searcher holds the bytes of the pattern
+        {
+            const unsigned short value = 0x6f6c;    // "lo" on a little-endian machine
+            allocation_scope build;
+            ba::typed_searcher<unsigned short> s ( value, ba::little_endian_byte_order, 1 );
+            check_bounded ( "typed_searcher", build, 1, sizeof ( value ));
+            const unsigned char *first = reinterpret_cast<const unsigned char *> ( corpus.data ());
+            const unsigned char *r;
+            CHECK_NO_ALLOCATION ( r = s ( first, first + corpus.size ()));
+            BOOST_CHECK ( r == first + corpus.find ( "lo" ));
+        }
+
+    //  The multi-pattern searchers report matches through an output iterator.
+    //  Their tables are built a piece at a time, so what is allocated is bounded
+    //  by twice what they end up holding.
+        std::vector<std::string> patterns;
+        patterns.push_back ( "dolor" );
+        patterns.push_back ( "labor" );
+        patterns.push_back ( "magna" );
+        {
+            allocation_scope build;
+            ba::multi_literal_searcher s ( patterns );
+            check_bounded ( "multi_literal_searcher", build, 32, 2 * s.memory_use () + 1024 );
+            ba::literal_match out [ 16 ];
+            ba::literal_match *end;
+            std::pair<str_iter, std::size_t> first;
+            CHECK_NO_ALLOCATION ( end = s ( corpus.begin (), corpus.end (), out ));
+            CHECK_NO_ALLOCATION ( first = s.find_first ( corpus.begin (), corpus.end ()));
+            BOOST_CHECK_EQUAL ( end - out, 5 );
+            BOOST_CHECK_EQUAL ( first.second, 0U );
+        }
+        {
+            allocation_scope build;
+            ba::rabin_karp_set s ( patterns );
+            check_bounded ( "rabin_karp_set", build, 32, 2 * s.memory_use () + 1024 );
+            ba::literal_match out [ 16 ];
+            ba::literal_match *end;
+            str_iter r;
+            CHECK_NO_ALLOCATION ( end = s ( corpus.begin (), corpus.end (), out ));
+            CHECK_NO_ALLOCATION ( r = s ( corpus.begin (), corpus.end ()));
+            BOOST_CHECK_EQUAL ( end - out, 5 );
+            BOOST_CHECK ( r == corpus.begin () + corpus.find ( "dolor" ));
+        }
+        {
+            allocation_scope build;
+            ba::prefix_matcher s ( patterns );
+            check_bounded ( "prefix_matcher", build, prefix_matcher_allocations ( patterns ), 2 * s.memory_use () + 1024 );
+            const std::string key = "labors of love";
+            std::size_t id;
+            std::size_t ids [ 4 ];
+            CHECK_NO_ALLOCATION ( id = s.longest ( key ));
+            CHECK_NO_ALLOCATION ( s.all ( key, ids ));
+            BOOST_CHECK_EQUAL ( id, 1U );
+        }
+
+    //  Baker-Bird keeps one counter per column of the text while it searches
+        {
+            const char text [] = "abcabc" "cabcab" "bcabca";
+            const char pat  [] = "ab" "ca";
+            ba::baker_bird_searcher<char> s ( ba::strided_view<char> ( pat, 2, 2 ));
+            ba::baker_bird_searcher<char>::position out [ 8 ];
+            allocation_scope search;
+            ba::baker_bird_searcher<char>::position *end = s ( ba::strided_view<char> ( text, 6, 3 ), out );
+            check_bounded ( "baker_bird_searcher::operator ()", search, 1, 6 * sizeof ( std::size_t ) + 64 );
+            BOOST_CHECK_EQUAL ( end - out, 4 );
+        }
+
+    //  search_each writes the matches to the output iterator, and needs nothing else
+        {
+            ba::boyer_moore_horspool<str_iter> s ( found.begin (), found.end ());
+            std::vector<std::string> corpora ( 3, corpus );
+            std::size_t out [ 4 ];
+            CHECK_NO_ALLOCATION ( ba::search_each ( s, corpora.begin (), corpora.end (), out ));
+            BOOST_CHECK_EQUAL ( out [ 2 ], corpus.find ( found ));
+        }
+        }
+
+    void test_more_searchers () {
+    //  packed_dna_searcher packs the pattern, and keeps a skip table of 8-mers for long ones
+        {
+            const std::string dna     = "ACGTTGCAACGTACGGTACCATGCATGCAAGTCCGATTACAGATTACAGGCA";
+            const std::string needle  = "GATTACAGATTACA";
+            const ba::packed_dna_sequence packed ( dna );
+            allocation_scope build;
+            ba::packed_dna_searcher s ( needle.begin (), needle.end ());
+            check_bounded ( "packed_dna_searcher", build, 8, ( 1U << 16 ) * sizeof ( unsigned short ) + 256 );
+            ba::packed_dna_sequence::const_iterator r;
+            CHECK_NO_ALLOCATION ( r = s ( packed ));
+            BOOST_CHECK ( r == packed.begin () + dna.find ( needle ));
+        }
+
+    //  utf8_searcher holds the pattern in an inner searcher; utf8_icase_searcher copies
+    //  it, and builds two tables of its case variants, which grow as they are filled
+        {
+            const std::string text = "na\xC3\xAFve caf\xC3\xA9 CAF\xC3\x89";
+            const std::string pat  = "caf\xC3\xA9";
+            allocation_scope build;
+            ba::utf8_searcher<str_iter> s ( pat.begin (), pat.end ());
+            check_bounded ( "utf8_searcher", build, 0, 0 );
+            str_iter r;
+            CHECK_NO_ALLOCATION ( r = s ( text.begin (), text.end ()));
+            BOOST_CHECK ( r == text.begin () + 7 );
+
+            build.reset ();
+            ba::utf8_icase_searcher<str_iter> si ( pat.begin (), pat.end ());
+            check_bounded ( "utf8_icase_searcher", build, 16, 64 * pat.size ());
+            CHECK_NO_ALLOCATION ( r = si ( text.begin () + 8, text.end ()));
+            BOOST_CHECK ( r == text.begin () + 13 );
+        }
+
+    //  A compiled_searcher is a view of a saved table; making one and searching with it allocate nothing
+        {
+            ba::searcher_table_builder builder;
+            builder.add ( ba::boyer_moore<str_iter> ( found.begin (), found.end ()));
+            builder.add ( ba::knuth_morris_pratt<str_iter> ( missing.begin (), missing.end ()));
+            std::ostringstream out;
+            builder.write ( out );
+            const std::string bytes = out.str ();
+            std::vector<double> mem ( bytes.size () / sizeof ( double ) + 1 );     // aligned, as a mapped file would be
+            std::copy ( bytes.begin (), bytes.end (), reinterpret_cast<char *> ( &mem [ 0 ] ));
+            const ba::searcher_table table ( &mem [ 0 ], bytes.size ());
+
+            str_iter r1, r2;
+            CHECK_NO_ALLOCATION ( r1 = table [ 0 ] ( corpus.begin (), corpus.end ()));
+            CHECK_NO_ALLOCATION ( r2 = table [ 1 ] ( corpus.begin (), corpus.end ()));
+            BOOST_CHECK ( r1 == corpus.begin () + corpus.find ( found ));
+            BOOST_CHECK ( r2 == corpus.end ());
+        }
+
+    //  The indexes allocate when they are built; a query doesn't
+        {
+            const std::string ut = "ut";
+            const ba::suffix_array<str_iter> sa ( corpus.begin (), corpus.end ());
+            const ba::fm_index<> fm ( corpus.begin (), corpus.end ());
+            std::size_t out [ 8 ];
+            std::size_t *end;
+            str_iter r;
+            std::size_t n, pos;
+            CHECK_NO_ALLOCATION ( r = sa ( found.begin (), found.end ()));
+            CHECK_NO_ALLOCATION ( n = sa.count ( ut.begin (), ut.end ()));
+            CHECK_NO_ALLOCATION ( end = sa.locate ( ut.begin (), ut.end (), out ));
+            BOOST_CHECK ( r == corpus.begin () + corpus.find ( found ));
+            BOOST_CHECK_EQUAL ( end - out, static_cast<std::ptrdiff_t> ( n ));
+
+            CHECK_NO_ALLOCATION ( pos = fm ( found.begin (), found.end ()));
+            CHECK_NO_ALLOCATION ( n = fm.count ( ut.begin (), ut.end ()));
+            CHECK_NO_ALLOCATION ( end = fm.locate ( ut.begin (), ut.end (), out ));
+            BOOST_CHECK_EQUAL ( pos, corpus.find ( found ));
+            BOOST_CHECK_EQUAL ( end - out, static_cast<std::ptrdiff_t> ( n ));
+        }
+
+    //  replace_all and split_view only call the searcher
+        {
+            const std::string ut = "ut";
+            const std::string repl = "UT";
+            ba::boyer_moore_horspool<str_iter> s ( ut.begin (), ut.end ());
+            char buf [ 512 ];
+            char *end;
+            CHECK_NO_ALLOCATION ( end = ba::replace_all ( corpus, s, repl, buf ));
+            BOOST_CHECK_EQUAL ( end - buf, static_cast<std::ptrdiff_t> ( corpus.size ()));
+
+            typedef ba::split_view<str_iter, ba::boyer_moore_horspool<str_iter> > view;
+            std::size_t fields = 0, length = 0;
+            CHECK_NO_ALLOCATION (
+                const view v ( corpus.begin (), corpus.end (), s );
+                for ( view::iterator it = v.begin (); it != v.end (); ++it ) {
+                    ++fields;
+                    length += it->size ();
+                    }
+                );
+            BOOST_CHECK_EQUAL ( length + 2 * ( fields - 1 ), corpus.size ());
+
+        //  replace_all_copy allocates the result once, at its final size
+            typedef std::basic_string<char, std::char_traits<char>, counting_allocator<char> > counted_string;
+            const counted_string in ( corpus.begin (), corpus.end ());
+            const counted_string ut_in ( ut.begin (), ut.end ());
+            ba::boyer_moore_horspool<counted_string::const_iterator> cs ( ut_in.begin (), ut_in.end ());
+            const std::size_t before = counting_allocator<char>::shared_count ();
+            const counted_string replaced = ba::replace_all_copy ( in, cs, repl );
+            BOOST_CHECK_EQUAL ( counting_allocator<char>::shared_count () - before, 1U );
+            BOOST_CHECK_EQUAL ( replaced.size (), in.size ());
+        }
+        }
+
+    void test_hex () {
+        char buf [ 1024 ];
+        const unsigned int ints [] = { 1, 2, 0xdeadbeef };
+        char *end;
+        CHECK_NO_ALLOCATION ( end = ba::hex ( corpus.begin (), corpus.end (), buf ));
+        BOOST_CHECK_EQUAL ( end - buf, static_cast<std::ptrdiff_t> ( 2 * corpus.size ()));
+        CHECK_NO_ALLOCATION ( end = ba::hex ( "abc", buf ));
+        CHECK_NO_ALLOCATION ( end = ba::hex ( ints, ints + 3, buf ));
+        CHECK_NO_ALLOCATION ( end = ba::hex ( corpus, buf ));
+
+        char back [ 512 ];
+        char *back_end;
+        CHECK_NO_ALLOCATION ( back_end = ba::unhex ( buf, end, back ));
+        CHECK_NO_ALLOCATION ( back_end = ba::unhex ( "616263", back ));
+        BOOST_CHECK ( std::string ( back, back_end ) == "abc" );
+
+    //  The container versions allocate the result once, at its final size
+        typedef std::basic_string<char, std::char_traits<char>, counting_allocator<char> > counted_string;
+        const counted_string in ( corpus.begin (), corpus.end ());
+        const std::size_t before = counting_allocator<char>::shared_count ();
+        allocation_scope whole;
+        const counted_string out = ba::hex ( in );
+        BOOST_CHECK_EQUAL ( out.size (), 2 * in.size ());
+        BOOST_CHECK_EQUAL ( counting_allocator<char>::shared_count () - before, 1U );
+        BOOST_CHECK_EQUAL ( whole.allocations (), 1U );
+        }
+
+    bool is_odd ( int i ) { return i % 2 == 1; }
+
+    void test_reductions () {
+        std::vector<int> v;
+        for ( int i = 0; i < 1000; ++i )
+            v.push_back ( i );
+        bool b;
+        std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator> mm;
+        std::vector<int>::const_iterator it;
+        const std::vector<int> &cv = v;
+
+        CHECK_NO_ALLOCATION ( b = ba::all_of  ( cv, is_odd ));
+        CHECK_NO_ALLOCATION ( b = ba::any_of  ( cv, is_odd ));
+        CHECK_NO_ALLOCATION ( b = ba::none_of ( cv, is_odd ));
+        CHECK_NO_ALLOCATION ( b = ba::one_of  ( cv, is_odd ));
+        CHECK_NO_ALLOCATION ( b = ba::all_of_equal  ( cv, 3 ));
+        CHECK_NO_ALLOCATION ( b = ba::any_of_equal  ( cv, 3 ));
+        CHECK_NO_ALLOCATION ( b = ba::none_of_equal ( cv, 3 ));
+        CHECK_NO_ALLOCATION ( b = ba::one_of_equal  ( cv, 3 ));
+        CHECK_NO_ALLOCATION ( b = ba::is_increasing ( cv ));
+        CHECK_NO_ALLOCATION ( b = ba::is_decreasing ( cv ));
+        CHECK_NO_ALLOCATION ( b = ba::is_strictly_increasing ( cv ));
+        CHECK_NO_ALLOCATION ( b = ba::is_strictly_decreasing ( cv ));
+        CHECK_NO_ALLOCATION ( it = ba::is_ordered ( cv, std::less<int> ()));
+        CHECK_NO_ALLOCATION ( mm = ba::minmax_element ( cv.begin (), cv.end ()));
+        BOOST_CHECK ( b == false );
+        BOOST_CHECK ( it == cv.end ());
+        BOOST_CHECK ( *mm.first == 0 && *mm.second == 999 );
+        }
+
+    void test_harness () {
+    //  The harness itself sees allocations
+        BOOST_REQUIRE ( allocation_scope::counting ());
+        allocation_scope s;
+        std::vector<int> *p = new std::vector<int> ( 10 );
+        BOOST_CHECK_EQUAL ( s.allocations (), 2U );
+        BOOST_CHECK ( s.bytes () >= 10 * sizeof ( int ) + sizeof ( std::vector<int> ));
+        delete p;
+        BOOST_CHECK_EQUAL ( s.frees (), 2U );
+
+        std::size_t count = 0;
+        std::vector<int, counting_allocator<int> > v ( ( counting_allocator<int> ( &count )));
+        v.reserve ( 100 );
+        v.resize ( 100 );
+        BOOST_CHECK_EQUAL ( count, 1U );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_harness ();
+    test_searchers ();
+    test_other_searchers ();
+    test_more_searchers ();
+    test_hex ();
+    test_reductions ();
+    return 0;
+}
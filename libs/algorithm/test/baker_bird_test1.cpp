@@ -0,0 +1,128 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/baker_bird.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+    typedef std::pair<std::size_t, std::size_t> position;
+
+//  The slow way: compare the pattern at every position
+    template <typename T>
+    std::vector<position> reference ( const ba::strided_view<T> &text, const ba::strided_view<T> &pat ) {
+        std::vector<position> retVal;
+        for ( std::size_t r = 0; r + pat.height <= text.height; ++r )
+            for ( std::size_t c = 0; c + pat.width <= text.width; ++c ) {
+                bool ok = true;
+                for ( std::size_t i = 0; ok && i < pat.height; ++i )
+                    for ( std::size_t j = 0; ok && j < pat.width; ++j )
+                        ok = text ( r + i, c + j ) == pat ( i, j );
+                if ( ok )
+                    retVal.push_back ( position ( r, c ));
+                }
+        return retVal;
+        }
+
+    template <typename T>
+    std::vector<position> search ( const ba::strided_view<T> &text, const ba::strided_view<T> &pat ) {
+        std::vector<position> retVal;
+        ba::baker_bird_search ( text, pat, std::back_inserter ( retVal ));
+        return retVal;
+        }
+
+    void test_simple () {
+        const std::string text =
+            "abcabc"
+            "xyzxyz"
+            "abcabc"
+            "xyzxyz";
+        const std::string pat = "ca" "zx";
+        const ba::strided_view<char> tv ( text.data (), 6, 4 );
+        const ba::strided_view<char> pv ( pat.data (), 2, 2 );
+        std::vector<position> expected;
+        expected.push_back ( position ( 0, 2 ));
+        expected.push_back ( position ( 2, 2 ));
+        BOOST_CHECK ( search ( tv, pv ) == expected );
+
+    //  A block of a larger array, found in a block of another
+        const std::string big =
+            "..abca.."
+            "..xyzx.."
+            "........";
+        const ba::strided_view<char> block ( big.data () + 4, 2, 2, 8 );
+        BOOST_CHECK ( search ( tv, block ) == expected );
+        const ba::strided_view<char> inner ( big.data () + 2, 4, 2, 8 );
+        BOOST_CHECK ( search ( inner, pv ).size () == 1 && search ( inner, pv ) [ 0 ] == position ( 0, 2 ));
+
+    //  Repeated rows, and a pattern larger than the text
+        const std::string ones ( 5 * 5, '1' );
+        const ba::strided_view<char> all ( ones.data (), 5, 5 );
+        const ba::strided_view<char> three ( ones.data (), 3, 3 );
+        BOOST_CHECK ( search ( all, three ).size () == 9 );
+        BOOST_CHECK ( search ( three, all ).empty ());
+
+        ba::baker_bird_searcher<char> bb ( pv );
+        BOOST_CHECK ( bb.pattern_width () == 2 && bb.pattern_height () == 2 );
+        const ba::baker_bird_searcher<char> copy ( bb );
+        std::vector<position> found;
+        copy ( tv, std::back_inserter ( found ));
+        BOOST_CHECK ( found == expected );
+
+        BOOST_CHECK_THROW ( ba::baker_bird_searcher<char> ( ba::strided_view<char> ( pat.data (), 0, 2 )), std::invalid_argument );
+        }
+
+    template <typename T>
+    void test_random ( int alphabet ) {
+        for ( int i = 0; i < 300; ++i ) {
+            const std::size_t tw = 1 + std::rand () % 20, th = 1 + std::rand () % 20, ts = tw + std::rand () % 3;
+            const std::size_t pw = 1 + std::rand () % 4,  ph = 1 + std::rand () % 4;
+            std::vector<T> text ( ts * th ), pat ( pw * ph );
+            for ( std::size_t j = 0; j < text.size (); ++j )
+                text [ j ] = static_cast<T> ( std::rand () % alphabet );
+            for ( std::size_t j = 0; j < pat.size (); ++j )
+                pat [ j ] = static_cast<T> ( std::rand () % alphabet );
+            const ba::strided_view<T> tv ( &text [ 0 ], tw, th, ts );
+            const ba::strided_view<T> pv ( &pat [ 0 ], pw, ph );
+            BOOST_CHECK ( search ( tv, pv ) == reference ( tv, pv ));
+            }
+        }
+
+//  Feeding knuth_morris_pratt one element at a time finds every (overlapping) match
+    void test_kmp_step () {
+        const std::string pat = "abab";
+        const std::string corpus = "xabababxabab";
+        ba::knuth_morris_pratt<std::string::const_iterator> kmp ( pat.begin (), pat.end ());
+        std::vector<std::size_t> ends;
+        std::ptrdiff_t matched = 0;
+        for ( std::size_t i = 0; i < corpus.size (); ++i )
+            if (( matched = kmp.step ( matched, corpus [ i ] )) == static_cast<std::ptrdiff_t> ( pat.size ()))
+                ends.push_back ( i );
+        BOOST_CHECK ( ends.size () == 3 && ends [ 0 ] == 4 && ends [ 1 ] == 6 && ends [ 2 ] == 11 );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_simple ();
+    test_kmp_step ();
+    std::srand ( 7 );
+    test_random<char> ( 2 );
+    test_random<unsigned> ( 3 );
+    test_random<double> ( 2 );
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/byte_set.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    void check_one ( const std::string &set, const std::string &corpus ) {
+        const ba::byte_set_searcher bs ( set );
+        const std::size_t expected = std::find_first_of ( corpus.begin (), corpus.end (), set.begin (), set.end ()) - corpus.begin ();
+
+    //  String iterators and pointers take the vector path (if there is one)
+        BOOST_CHECK_EQUAL ((std::size_t) ( bs ( corpus.begin (), corpus.end ()) - corpus.begin ()), expected );
+        BOOST_CHECK_EQUAL ((std::size_t) ( bs ( corpus ) - corpus.begin ()), expected );
+        if ( !corpus.empty ()) {
+            const unsigned char *p = reinterpret_cast<const unsigned char *> ( corpus.data ());
+            BOOST_CHECK_EQUAL ((std::size_t) ( bs.find ( p, p + corpus.size ()) - p ), expected );
+            }
+
+    //  Lists don't
+        std::list<char> l ( corpus.begin (), corpus.end ());
+        BOOST_CHECK_EQUAL ((std::size_t) std::distance ( l.begin (), bs ( l.begin (), l.end ())), expected );
+
+        BOOST_CHECK ( ba::byte_set_search ( corpus.begin (), corpus.end (), set.begin (), set.end ())
+                            == corpus.begin () + expected );
+        }
+
+    void test_simple () {
+        const std::string delims ( "\r\n\"\\," );
+        const ba::byte_set_searcher bs ( delims );
+        BOOST_CHECK_EQUAL ( bs.size (), 5U );
+        BOOST_CHECK ( bs.contains ( ',' ));
+        BOOST_CHECK ( !bs.contains ( 'a' ));
+
+        check_one ( delims, "" );
+        check_one ( delims, "abc" );
+        check_one ( delims, "abc,def" );
+        check_one ( delims, "a fairly long line of text without any delimiters in it at all" );
+        check_one ( delims, "a fairly long line of text with a delimiter at the very end\n" );
+        check_one ( delims, "\"quoted\"" );
+        check_one ( "", "nothing can match" );
+        check_one ( "aaaa", "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbba" );
+
+    //  Bytes with the high bit set
+        check_one ( "\x80\xff", "plain ascii text, then a high byte: \xff" );
+        check_one ( "\x80\xff", std::string ( 100, '\x7f' ) + "\x80" );
+        check_one ( std::string ( 1, '\0' ), std::string ( "abcdefghijklmnopqrstuvwxyz" ) + '\0' );
+
+    //  Sets that are too big to compare one member at a time
+        std::string letters;
+        for ( char c = 'a'; c <= 'z'; ++c ) letters += c;
+        check_one ( letters, "0123456789 !@#$%^&*() 0123456789 x" );
+        std::string all;
+        for ( int c = 0; c < 256; ++c ) all += static_cast<char> ( c );
+        check_one ( all, "anything" );
+        BOOST_CHECK_EQUAL ( ba::byte_set_searcher ( all ).size (), 256U );
+
+    //  Unsigned bytes, in a vector
+        std::vector<unsigned char> v ( 40, 7 );
+        v.push_back ( 200 );
+        const unsigned char s [] = { 200, 201 };
+        BOOST_CHECK ( ba::byte_set_searcher ( s, s + 2 ) ( v.begin (), v.end ()) == v.end () - 1 );
+        }
+
+    void test_random () {
+        std::srand ( 1 );
+        for ( int i = 0; i < 3000; ++i ) {
+        //  Sets of every size; sparse and dense
+            std::string set;
+            const int members = std::rand () % ( i % 3 == 0 ? 200 : 20 );
+            for ( int j = 0; j < members; ++j )
+                set += static_cast<char> ( std::rand () % 256 );
+            std::string corpus;
+            const int len = std::rand () % 100;
+            for ( int j = 0; j < len; ++j ) {
+                char c;
+                do { c = static_cast<char> ( std::rand () % 256 ); }
+                while ( set.find ( c ) != std::string::npos && std::rand () % 50 != 0 );
+                corpus += c;
+                }
+            check_one ( set, corpus );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_simple ();
+    test_random ();
+    return 0;
+}
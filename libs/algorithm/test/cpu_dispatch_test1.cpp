@@ -0,0 +1,124 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/cpu_dispatch.hpp>
+#include <boost/algorithm/searching/byte_set.hpp>
+#include <boost/algorithm/searching/search_each.hpp>
+#include <boost/algorithm/searching/typed_searcher.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+//  Every kernel is run at every level up to what this machine has, and
+//  checked against the obvious loop.
+
+namespace {
+
+//  Zero and the high bytes, which the vector compares get wrong first if the
+//  sign is mishandled; and lengths on both sides of each vector width
+    std::string random_bytes ( std::size_t len ) {
+        static const char bytes [] = { 'a', '\0', '\xff' };
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += bytes [ std::rand () % 3 ];
+        return retVal;
+        }
+
+    std::size_t random_length () {
+        static const std::size_t widths [] = { 16, 32, 64, 128 };
+        const std::size_t w = widths [ std::rand () % 4 ];
+        return w * ( 1 + std::rand () % 2 ) + std::rand () % 5 - 2;
+        }
+
+    void test_levels () {
+        for ( int i = ba::simd_scalar; i <= ba::simd_avx512; ++i ) {
+            const ba::simd_level level = static_cast<ba::simd_level> ( i );
+            BOOST_CHECK ( ba::detail::parse_simd_level ( ba::simd_level_name ( level ), ba::simd_scalar ) == level );
+            }
+        BOOST_CHECK ( ba::detail::parse_simd_level ( "mmx", ba::simd_sse2 ) == ba::simd_sse2 );
+        BOOST_CHECK ( ba::detail::parse_simd_level ( NULL, ba::simd_avx2 ) == ba::simd_avx2 );
+
+        BOOST_CHECK ( ba::active_simd_level () == ba::detected_simd_level ());
+        const ba::simd_level saved = ba::force_simd_level ( ba::simd_scalar );
+        BOOST_CHECK ( ba::active_simd_level () == ba::simd_scalar );
+        BOOST_CHECK ( ba::force_simd_level ( saved ) == ba::simd_scalar );
+        BOOST_CHECK ( ba::active_simd_level () == ba::detected_simd_level ());
+#if defined ( BOOST_ALGORITHM_BYTE_SET_SSE2 ) && !defined ( BOOST_ALGORITHM_NO_SIMD )
+        if ( std::getenv ( "BOOST_ALGORITHM_SIMD" ) == NULL )
+            BOOST_CHECK ( ba::detected_simd_level () >= ba::simd_sse2 );
+#endif
+        }
+
+    void test_byte_set () {
+        const std::string sets [] = { "q", "xyz", "aeiouAEI", "0123456789abcdefXYZ", "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~\x80\xff" };
+        for ( std::size_t s = 0; s < sizeof ( sets ) / sizeof ( sets [ 0 ] ); ++s ) {
+            const ba::byte_set_searcher bs ( sets [ s ].begin (), sets [ s ].end ());
+            for ( std::size_t len = 0; len < 200; len += 7 ) {
+                std::string corpus ( len, ' ' );
+                for ( std::size_t at = 0; at <= len; at += 5 ) {
+                    if ( at < len )
+                        corpus [ at ] = sets [ s ][ at % sets [ s ].size () ];
+                    const std::string::const_iterator expected = std::find_first_of (
+                            corpus.begin (), corpus.end (), sets [ s ].begin (), sets [ s ].end ());
+                    BOOST_CHECK ( bs ( corpus.begin (), corpus.end ()) == expected );
+                    if ( at < len )
+                        corpus [ at ] = ' ';
+                    }
+                }
+            }
+        }
+
+    void test_search_short () {
+        for ( int trial = 0; trial < 2000; ++trial ) {
+            const std::string corpus = random_bytes ( random_length ());
+            const std::string pat = random_bytes ( 1 + std::rand () % 6 );
+            const std::size_t expected = std::search ( corpus.begin (), corpus.end (), pat.begin (), pat.end ()) - corpus.begin ();
+            BOOST_CHECK_EQUAL ( ba::detail::search_short (
+                    reinterpret_cast<const unsigned char *> ( corpus.data ()), corpus.size (),
+                    reinterpret_cast<const unsigned char *> ( pat.data ()), pat.size ()), expected );
+            }
+        }
+
+    void test_typed () {
+        const boost::uint32_t magic = 0x01020304;
+        const ba::typed_searcher<boost::uint32_t> ts ( magic );
+        const std::vector<unsigned char> &pat = ts.pattern_bytes ();
+        std::vector<unsigned char> corpus ( 100, 0 );
+        for ( std::size_t at = 0; at + 4 <= corpus.size (); at += 3 ) {
+            std::copy ( pat.begin (), pat.end (), corpus.begin () + at );
+            const std::size_t expected = at % 4 == 0 ? at : corpus.size ();    // only aligned matches count
+            BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( ts ( corpus.begin (), corpus.end ()) - corpus.begin ()), expected );
+            std::fill ( corpus.begin (), corpus.end (), 0 );
+            }
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_levels ();
+    const ba::simd_level top = ba::detected_simd_level ();
+    for ( int i = ba::simd_scalar; i <= top; ++i ) {
+        const ba::simd_level level = static_cast<ba::simd_level> ( i );
+        std::cout << "Testing at " << ba::simd_level_name ( level ) << std::endl;
+        ba::force_simd_level ( level );
+        BOOST_CHECK ( ba::active_simd_level () == level );
+        test_byte_set ();
+        test_search_short ();
+        test_typed ();
+        }
+    ba::force_simd_level ( ba::simd_avx512 );
+    return 0;
+}
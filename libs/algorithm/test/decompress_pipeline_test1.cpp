@@ -0,0 +1,151 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/decompress_pipeline.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef ba::boyer_moore_horspool<std::string::const_iterator> searcher_type;
+    typedef std::back_insert_iterator<std::vector<boost::uintmax_t> > offset_inserter;
+
+    struct gather {
+        gather ( std::string &s ) : str ( &s ) {}
+        void operator () ( const char *first, const char *last, boost::uintmax_t offset ) {
+            BOOST_CHECK_EQUAL ( offset, str->size ());
+            str->append ( first, last );
+            }
+        std::string *str;
+        };
+
+//  A consumer that gives up part way
+    struct fail_after {
+        fail_after ( int n ) : count ( n ) {}
+        void operator () ( const char *, const char *, boost::uintmax_t ) {
+            if ( --count == 0 )
+                throw std::runtime_error ( "enough" );
+            }
+        int count;
+        };
+
+    std::string gzip ( const std::string &data ) {
+        z_stream zs;
+        std::memset ( &zs, 0, sizeof ( zs ));
+        deflateInit2 ( &zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY );
+        std::string out ( deflateBound ( &zs, data.size ()) + 32, '\0' );
+        zs.next_in   = reinterpret_cast<Bytef *> ( const_cast<char *> ( data.data ()));
+        zs.avail_in  = data.size ();
+        zs.next_out  = reinterpret_cast<Bytef *> ( &out [0] );
+        zs.avail_out = out.size ();
+        BOOST_REQUIRE ( deflate ( &zs, Z_FINISH ) == Z_STREAM_END );
+        out.resize ( zs.total_out );
+        deflateEnd ( &zs );
+        return out;
+        }
+
+#ifdef BOOST_ALGORITHM_HAS_ZSTD
+    std::string zstd ( const std::string &data ) {
+        std::string out ( ZSTD_compressBound ( data.size ()), '\0' );
+        const std::size_t n = ZSTD_compress ( &out [0], out.size (), data.data (), data.size (), 3 );
+        BOOST_REQUIRE ( !ZSTD_isError ( n ));
+        out.resize ( n );
+        return out;
+        }
+#endif
+
+    std::vector<boost::uintmax_t> all_matches ( const std::string &corpus, const std::string &pat ) {
+        std::vector<boost::uintmax_t> retVal;
+        for ( std::string::size_type pos = corpus.find ( pat ); pos != std::string::npos; pos = corpus.find ( pat, pos + 1 ))
+            retVal.push_back ( pos );
+        return retVal;
+        }
+
+    void check_one ( const std::string &compressed, const std::string &expected ) {
+        const std::size_t sizes [] = { 1, 100, 4096, 1 << 20 };
+        for ( std::size_t i = 0; i < sizeof ( sizes ) / sizeof ( sizes [0] ); ++i ) {
+            ba::decompress_pipeline pipeline ( sizes [i], 3, 1000 );
+            std::istringstream in ( compressed );
+            std::string seen;
+            pipeline ( in, gather ( seen ));
+            BOOST_CHECK ( seen == expected );
+            BOOST_CHECK_EQUAL ( pipeline.stats ().bytes_in, compressed.size ());
+            BOOST_CHECK_EQUAL ( pipeline.stats ().bytes_out, expected.size ());
+
+            if ( sizes [i] == 1 ) continue;     // too slow with every pattern
+            const std::string pats [] = { "abc", "needle in a haystack", "a" };
+            for ( std::size_t j = 0; j < sizeof ( pats ) / sizeof ( pats [0] ); ++j ) {
+                const searcher_type s ( pats [j].begin (), pats [j].end ());
+                std::vector<boost::uintmax_t> found;
+                std::istringstream in2 ( compressed );
+                pipeline ( in2, ba::stream_matcher<searcher_type, offset_inserter> ( s, std::back_inserter ( found )));
+                BOOST_CHECK ( found == all_matches ( expected, pats [j] ));
+                }
+            }
+        }
+
+    void check_bad ( const std::string &compressed ) {
+        ba::decompress_pipeline pipeline ( 4096 );
+        std::istringstream in ( compressed );
+        std::string seen;
+        BOOST_CHECK_THROW ( pipeline ( in, gather ( seen )), ba::decompress_error );
+        }
+
+    void test_decompress () {
+        std::srand ( 1 );
+        std::string data;
+        for ( int i = 0; i < 200000; ++i )
+            data += static_cast<char> ( 'a' + std::rand () % 4 );
+        for ( std::size_t pos = 0; pos < data.size (); pos += 9973 )
+            data.replace ( pos, 20, "needle in a haystack" );
+
+        const std::string gz = gzip ( data );
+        check_one ( gz, data );
+        check_one ( gzip ( data.substr ( 0, 1000 )) + gzip ( "" ) + gzip ( data.substr ( 1000 )), data );   // several members
+        check_one ( "", "" );
+
+        check_bad ( gz.substr ( 0, gz.size () / 2 ));      // cut short
+        check_bad ( gz.substr ( 0, gz.size () - 1 ));
+        check_bad ( "this is not compressed at all" );
+        std::string damaged = gz;
+        damaged [ damaged.size () / 2 ] ^= 0x55;
+        check_bad ( damaged );
+
+#ifdef BOOST_ALGORITHM_HAS_ZSTD
+        const std::string zs = zstd ( data );
+        check_one ( zs, data );
+        check_one ( zstd ( data.substr ( 0, 5000 )) + zstd ( data.substr ( 5000 )), data );
+        check_bad ( zs.substr ( 0, zs.size () / 2 ));
+#else
+        check_bad ( std::string ( "\x28\xB5\x2F\xFD", 4 ) + "zstd, but not compiled in" );
+#endif
+
+    //  The consumer throwing stops the decompressor
+        ba::decompress_pipeline pipeline ( 1000, 2 );
+        std::istringstream in ( gz );
+        BOOST_CHECK_THROW ( pipeline ( in, fail_after ( 3 )), std::runtime_error );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_decompress ();
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include <boost/algorithm/searching/boyer_moore.hpp>
 #include <boost/algorithm/searching/boyer_moore_horspool.hpp>
 #include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/tuned_boyer_moore.hpp>
 
 #include <boost/test/included/test_exec_monitor.hpp>
 
@@ -40,6 +41,12 @@ int test_main( int argc, char *argv [] )
         == cs.begin ()
         );
 
+    BOOST_CHECK ( 
+        boost::algorithm::tuned_boyer_moore_search (
+            cs.begin (), cs.end (), estr.begin (), estr.end ())
+        == cs.begin ()
+        );
+
 //  empty corpus, non-empty pattern
     BOOST_CHECK ( 
         boost::algorithm::boyer_moore_search (
@@ -59,6 +66,12 @@ int test_main( int argc, char *argv [] )
         == estr.end ()
         );
 
+    BOOST_CHECK ( 
+        boost::algorithm::tuned_boyer_moore_search (
+            estr.begin (), estr.end (), str.begin (), str.end ())
+        == estr.end ()
+        );
+
 //  non-empty corpus, empty pattern
     BOOST_CHECK ( 
         boost::algorithm::boyer_moore_search (
@@ -78,6 +91,12 @@ int test_main( int argc, char *argv [] )
         == str.begin ()
         );
 
+    BOOST_CHECK ( 
+        boost::algorithm::tuned_boyer_moore_search (
+            str.begin (), str.end (), estr.begin (), estr.end ())
+        == str.begin ()
+        );
+
    (void) argv; (void) argc;
    return 0;
 }
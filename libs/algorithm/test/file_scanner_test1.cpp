@@ -0,0 +1,215 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/file_scanner.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ba = boost::algorithm;
+namespace fs = boost::filesystem;
+
+namespace {
+
+    typedef std::vector<std::pair<std::string, std::size_t> > match_list;
+    typedef ba::boyer_moore_horspool<std::string::const_iterator> searcher_type;
+
+    struct collect {
+        collect ( match_list &m ) : matches ( m ) {}
+        void operator () ( const fs::path &p, std::size_t offset ) const {
+            matches.push_back ( std::make_pair ( p.string (), offset ));
+            }
+        match_list &matches;
+        };
+
+    void write_file ( const fs::path &p, const std::string &contents ) {
+        fs::ofstream out ( p, std::ios::binary );
+        out << contents;
+        }
+
+//  Every match, the slow way, in the order the scanner promises
+    match_list expected_matches ( const std::vector<std::pair<fs::path, std::string> > &files,
+                                  const std::string &pat, bool all ) {
+        std::vector<std::pair<fs::path, std::string> > sorted ( files );
+        std::sort ( sorted.begin (), sorted.end ());
+        match_list retVal;
+        for ( std::size_t i = 0; i < sorted.size (); ++i ) {
+            const std::string &s = sorted [i].second;
+            for ( std::string::size_type pos = s.find ( pat ); pos != std::string::npos; pos = s.find ( pat, pos + 1 )) {
+                retVal.push_back ( std::make_pair ( sorted [i].first.string (), pos ));
+                if ( !all )
+                    break;
+                }
+            }
+        return retVal;
+        }
+
+    void test_scan () {
+        const fs::path root = fs::temp_directory_path () / fs::unique_path ( "file_scanner_test-%%%%-%%%%" );
+        fs::create_directories ( root / "a" / "b" );
+        fs::create_directories ( root / "c" );
+
+        std::srand ( 1 );
+        std::vector<std::pair<fs::path, std::string> > files;
+        const char *dirs [] = { "", "a", "a/b", "c" };
+        for ( int i = 0; i < 60; ++i ) {
+            std::string contents;
+            const int len = i % 20 == 0 ? 100000 + std::rand () % 100000 : std::rand () % 2000;
+            for ( int j = 0; j < len; ++j )
+                contents += static_cast<char> ( 'a' + std::rand () % 4 );
+            if ( i % 7 == 0 )
+                contents.insert ( contents.size () / 2, "needle" );
+            const fs::path p = root / dirs [ i % 4 ] / ( "file" + std::string ( 1, 'A' + i % 26 ) + std::string ( 1, 'a' + i / 26 ));
+            write_file ( p, contents );
+            files.push_back ( std::make_pair ( p, contents ));
+            }
+        write_file ( root / "empty", "" );
+        files.push_back ( std::make_pair ( root / "empty", std::string ()));
+
+        const std::string pats [] = { "needle", "abcd", "dd" };
+        for ( std::size_t i = 0; i < sizeof ( pats ) / sizeof ( pats [0] ); ++i ) {
+            const searcher_type s ( pats [i].begin (), pats [i].end ());
+            for ( unsigned threads = 1; threads <= 4; threads += 3 ) {
+                for ( int all = 0; all < 2; ++all ) {
+                    ba::file_scanner<searcher_type> scanner ( s,
+                        all ? ba::file_scanner<searcher_type>::all_matches : ba::file_scanner<searcher_type>::first_match, threads );
+                    scanner.set_mmap_threshold ( 50000 );   // map the big files, read the rest
+
+                    match_list matches;
+                    scanner ( root, collect ( matches ));
+                    BOOST_CHECK ( matches == expected_matches ( files, pats [i], all != 0 ));
+                    BOOST_CHECK_EQUAL ( scanner.files_scanned (), files.size ());
+                    BOOST_CHECK_EQUAL ( scanner.files_skipped (), 0U );
+                    }
+                }
+            }
+
+    //  A file as a root, and a root that isn't there
+        const searcher_type s ( pats [0].begin (), pats [0].end ());
+        ba::file_scanner<searcher_type> scanner ( s );
+        std::vector<fs::path> roots;
+        roots.push_back ( files [0].first );
+        roots.push_back ( root / "no such directory" );
+        match_list matches;
+        scanner ( roots, collect ( matches ));
+        BOOST_CHECK_EQUAL ( matches.size (), 1U );
+        BOOST_CHECK_EQUAL ( scanner.files_scanned (), 1U );
+        BOOST_CHECK_EQUAL ( scanner.files_skipped (), 1U );
+
+        fs::remove_all ( root );
+        }
+
+//  A directory that can't be listed is skipped; the directories after it are still searched
+    void test_unreadable () {
+        const fs::path root = fs::temp_directory_path () / fs::unique_path ( "file_scanner_test-%%%%-%%%%" );
+        const char *dirs [] = { "a", "b", "c" };
+        for ( int i = 0; i < 3; ++i ) {
+            fs::create_directories ( root / dirs [ i ] );
+            write_file ( root / dirs [ i ] / "file", "a needle" );
+            }
+        fs::permissions ( root / "b", fs::no_perms );
+
+    //  (Someone who can read it anyway, like root, has nothing to test)
+        boost::system::error_code ec;
+        fs::directory_iterator probe ( root / "b", ec );
+        if ( ec ) {
+            const std::string pat ( "needle" );
+            const searcher_type s ( pat.begin (), pat.end ());
+            ba::file_scanner<searcher_type> scanner ( s );
+            match_list matches;
+            scanner ( root, collect ( matches ));
+            BOOST_CHECK_EQUAL ( matches.size (), 2U );
+            BOOST_CHECK_EQUAL ( scanner.files_scanned (), 2U );
+            BOOST_CHECK_EQUAL ( scanner.files_skipped (), 1U );
+            if ( matches.size () == 2 )
+                BOOST_CHECK ( matches [ 1 ].first == ( root / "c" / "file" ).string ());
+            }
+        else
+            std::cout << "test_unreadable: every directory is readable; nothing to test" << std::endl;
+
+        fs::permissions ( root / "b", fs::owner_all );
+        fs::remove_all ( root );
+        }
+
+//  Counts the files searched (in first_match mode, it is called once for each file)
+    struct counting_searcher {
+        counting_searcher ( const searcher_type &s, boost::mutex &m, std::size_t &count )
+            : s_ ( s ), m_ ( &m ), count_ ( &count ) {}
+        const char *operator () ( const char *first, const char *last ) const {
+            { boost::lock_guard<boost::mutex> lock ( *m_ ); ++*count_; }
+            return s_ ( first, last );
+            }
+        searcher_type s_;
+        boost::mutex *m_;
+        std::size_t *count_;
+        };
+
+//  The callback is slow; how many files had been started when it got to each one
+    struct slow_collect {
+        slow_collect ( boost::mutex &m, const std::size_t &count, std::vector<std::size_t> &started )
+            : m_ ( m ), count_ ( count ), started_ ( started ) {}
+        void operator () ( const fs::path &, std::size_t ) const {
+            { boost::lock_guard<boost::mutex> lock ( m_ ); started_.push_back ( count_ ); }
+            boost::this_thread::sleep ( boost::posix_time::milliseconds ( 2 ));
+            }
+        boost::mutex &m_;
+        const std::size_t &count_;
+        std::vector<std::size_t> &started_;
+        };
+
+//  The threads don't get more than max_ahead files ahead of the callback
+    void test_max_ahead () {
+        const fs::path root = fs::temp_directory_path () / fs::unique_path ( "file_scanner_test-%%%%-%%%%" );
+        fs::create_directories ( root );
+        const std::size_t num_files = 40;
+        for ( std::size_t i = 0; i < num_files; ++i )
+            write_file ( root / ( "file" + std::string ( 1, 'a' + i / 26 ) + std::string ( 1, 'a' + i % 26 )), "a needle in a haystack" );
+
+        const std::string pat ( "needle" );
+        boost::mutex m;
+        std::size_t count = 0;
+        const counting_searcher s ( searcher_type ( pat.begin (), pat.end ()), m, count );
+        for ( std::size_t ahead = 1; ahead <= 4; ahead *= 2 ) {
+            count = 0;
+            std::vector<std::size_t> started;
+            ba::file_scanner<counting_searcher> scanner ( s, ba::file_scanner<counting_searcher>::first_match, 4 );
+            scanner.set_max_ahead ( ahead );
+            scanner ( root, slow_collect ( m, count, started ));
+            BOOST_CHECK_EQUAL ( started.size (), num_files );
+            BOOST_CHECK_EQUAL ( count, num_files );
+        //  When the callback has file i, only files up to i + ahead can have been started
+            for ( std::size_t i = 0; i < started.size (); ++i )
+                BOOST_CHECK_MESSAGE ( started [ i ] <= i + 1 + ahead,
+                    "max_ahead " << ahead << ": " << started [ i ] << " files started at file " << i );
+            }
+        fs::remove_all ( root );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_scan ();
+    test_unreadable ();
+    test_max_ahead ();
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/multi_literal.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::string random_text ( std::size_t len, int alphabet ) {
+        std::string retVal ( len, 'a' );
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal [ i ] += static_cast<char> ( std::rand () % alphabet );
+        return retVal;
+        }
+
+//  A piece of the corpus, usually with one element changed to a 'z' (which
+//  the corpus doesn't have). Its blocks are all in the shift table, so the
+//  search can't skip past it, and has to check the candidates.
+    std::string near_miss ( const std::string &corpus, std::size_t len ) {
+        if ( corpus.size () <= len )
+            return std::string ( len, 'z' );
+        std::string retVal = corpus.substr ( std::rand () % ( corpus.size () - len ), len );
+        if ( std::rand () % 4 != 0 )
+            retVal [ std::rand () % len ] = 'z';
+        return retVal;
+        }
+
+//  Every match of every pattern, the slow way
+    std::vector<ba::literal_match> brute_force ( const std::vector<std::string> &patterns, const std::string &corpus ) {
+        std::vector<ba::literal_match> retVal;
+        for ( std::size_t pos = 0; pos < corpus.size (); ++pos )
+            for ( std::size_t id = 0; id < patterns.size (); ++id )
+                if ( !patterns [ id ].empty () && corpus.compare ( pos, patterns [ id ].size (), patterns [ id ] ) == 0 )
+                    retVal.push_back ( ba::literal_match ( id, pos ));
+        return retVal;
+        }
+
+    void check_one ( const std::vector<std::string> &patterns, const std::string &corpus ) {
+        const ba::multi_literal_searcher mls ( patterns );
+        const std::vector<ba::literal_match> expected = brute_force ( patterns, corpus );
+
+        std::vector<ba::literal_match> found;
+        mls ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+        BOOST_CHECK ( found == expected );
+        if ( found != expected )
+            std::cout << "Found " << found.size () << " matches; expected " << expected.size () << std::endl;
+
+        const std::pair<std::string::const_iterator, std::size_t> first = mls.find_first ( corpus.begin (), corpus.end ());
+        if ( expected.empty ()) {
+            BOOST_CHECK ( first.first == corpus.end ());
+            BOOST_CHECK_EQUAL ( first.second, patterns.size ());
+            }
+        else {
+            BOOST_CHECK_EQUAL ((std::size_t) ( first.first - corpus.begin ()), expected [ 0 ].position );
+            BOOST_CHECK_EQUAL ( first.second, expected [ 0 ].pattern );
+            }
+        }
+
+    void test_simple () {
+        std::vector<std::string> patterns;
+        patterns.push_back ( "he" );
+        patterns.push_back ( "she" );
+        patterns.push_back ( "his" );
+        patterns.push_back ( "hers" );
+        patterns.push_back ( "" );          // never matches
+        patterns.push_back ( "he" );        // duplicates are reported separately
+        check_one ( patterns, "ushers" );
+        check_one ( patterns, "his hershey, and hers; she said" );
+        check_one ( patterns, "" );
+        check_one ( patterns, "h" );
+
+        std::vector<ba::literal_match> found;
+        const std::string corpus ( "ushers" );
+        const ba::multi_literal_searcher mls ( patterns );
+        mls ( corpus, std::back_inserter ( found ));
+        BOOST_REQUIRE_EQUAL ( found.size (), 4U );
+        BOOST_CHECK ( found [ 0 ] == ba::literal_match ( 1, 1 ));   // she
+        BOOST_CHECK ( found [ 1 ] == ba::literal_match ( 0, 2 ));   // he
+        BOOST_CHECK ( found [ 2 ] == ba::literal_match ( 3, 2 ));   // hers
+        BOOST_CHECK ( found [ 3 ] == ba::literal_match ( 5, 2 ));   // he, again
+
+    //  No patterns at all
+        check_one ( std::vector<std::string> (), "anything" );
+        check_one ( std::vector<std::string> ( 3 ), "anything" );
+
+    //  Bytes with the high bit set
+        std::vector<std::string> high;
+        high.push_back ( "\xff\xfe" );
+        high.push_back ( "\x80\xff\xfe\x01" );
+        check_one ( high, "abc\x80\xff\xfe\x01\xff\xfe" );
+        }
+
+    void test_random () {
+        std::srand ( 1 );
+        for ( int i = 0; i < 300; ++i ) {
+            const int alphabet = 2 + std::rand () % 6;
+            std::vector<std::string> patterns;
+            const int count = 1 + std::rand () % ( i % 10 == 0 ? 5000 : 40 );
+            const std::size_t min_len = 1 + std::rand () % 12;
+            std::string corpus = random_text ( std::rand () % 2000, alphabet );
+            for ( int j = 0; j < count; ++j )
+                patterns.push_back ( near_miss ( corpus, min_len + std::rand () % 10 ));
+        //  Plant some of the patterns in the corpus
+            for ( int j = 0; j < 5 && !corpus.empty (); ++j ) {
+                const std::string &p = patterns [ std::rand () % patterns.size () ];
+                corpus.insert ( std::rand () % corpus.size (), p );
+                }
+            check_one ( patterns, corpus );
+            }
+        }
+
+    void test_large () {
+    //  A hundred thousand hex "hashes", and a corpus with some of them in it
+        std::srand ( 2 );
+        std::vector<std::string> patterns;
+        std::size_t total = 0;
+        for ( int i = 0; i < 100000; ++i ) {
+            std::string p;
+            for ( int j = 0; j < 16; ++j )
+                p += "0123456789abcdef" [ std::rand () % 16 ];
+            total += p.size ();
+            patterns.push_back ( p );
+            }
+        const ba::multi_literal_searcher mls ( patterns );
+        BOOST_CHECK_EQUAL ( mls.size (), patterns.size ());
+        BOOST_CHECK ( mls.memory_use () < 16 * total );
+
+        std::string corpus;
+        std::vector<ba::literal_match> expected;
+        for ( int i = 0; i < 1000; ++i ) {
+            corpus += "lorem ipsum dolor sit amet ";
+            if ( i % 100 == 7 ) {
+                expected.push_back ( ba::literal_match ( i * 37, corpus.size ()));
+                corpus += patterns [ i * 37 ];
+                }
+            }
+        std::vector<ba::literal_match> found;
+        mls ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+        BOOST_CHECK ( found == expected );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_simple ();
+    test_random ();
+    test_large ();
+    return 0;
+}
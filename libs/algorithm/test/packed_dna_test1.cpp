@@ -0,0 +1,134 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/packed_dna.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::string random_dna ( std::size_t len, int alphabet ) {
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += "ACGT" [ std::rand () % alphabet ];
+        return retVal;
+        }
+
+    void test_sequence () {
+        const std::string dna ( "GATACACCTACCTTCACCAGTTACTCTATGCACTAGGTGCGCCAGGCCCATGCACAAGGGCTT" );
+        ba::packed_dna_sequence ps ( dna );
+
+        BOOST_CHECK_EQUAL ( ps.size (), dna.size ());
+        BOOST_CHECK ( std::equal ( ps.begin (), ps.end (), dna.begin ()));
+        BOOST_CHECK ( std::string ( ps.begin (), ps.end ()) == dna );
+        BOOST_CHECK ( ps.end () - ps.begin () == (std::ptrdiff_t) dna.size ());
+        BOOST_CHECK_EQUAL ( ps [ 0 ], 'G' );
+        BOOST_CHECK_EQUAL ( ps.code ( 0 ), 2U );
+        BOOST_CHECK_EQUAL ( ps.begin () [ 3 ], 'A' );
+
+    //  Proxy iterators, like vector<bool>'s; the algorithms that only read work
+        typedef std::reverse_iterator<ba::packed_dna_sequence::const_iterator> reverse;
+        BOOST_CHECK ( std::equal ( reverse ( ps.end ()), reverse ( ps.begin ()), dna.rbegin ()));
+        BOOST_CHECK_EQUAL ( std::count ( ps.begin (), ps.end (), 'A' ), std::count ( dna.begin (), dna.end (), 'A' ));
+        const std::string cat ( "CAT" );
+        BOOST_CHECK_EQUAL ( std::search ( ps.begin (), ps.end (), cat.begin (), cat.end ()) - ps.begin (),
+                            static_cast<std::ptrdiff_t> ( dna.find ( cat )));
+
+    //  Two bits per base, plus the padding word at the end
+        BOOST_CHECK ( ps.words ().size () <= dna.size () / 32 + 2 );
+
+    //  Lower case, and U for T
+        ba::packed_dna_sequence lc ( std::string ( "acgu" ));
+        BOOST_CHECK ( std::string ( lc.begin (), lc.end ()) == "ACGT" );
+
+    //  Not nucleotides
+        BOOST_CHECK_THROW ( ba::packed_dna_sequence ( std::string ( "ACGN" )), ba::non_dna_input );
+
+    //  An empty sequence
+        ba::packed_dna_sequence empty;
+        BOOST_CHECK ( empty.empty ());
+        BOOST_CHECK ( empty.begin () == empty.end ());
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle,
+                                    std::size_t first, std::size_t last ) {
+        ba::packed_dna_sequence corpus ( haystack );
+        ba::packed_dna_searcher pds ( needle.begin (), needle.end ());
+
+        const std::size_t expected = std::search ( haystack.begin () + first, haystack.begin () + last,
+                                            needle.begin (), needle.end ()) - haystack.begin ();
+        const std::size_t found    = pds ( corpus.begin () + first, corpus.begin () + last ) - corpus.begin ();
+        if ( found != expected ) {
+            std::cout << "Searching for '" << needle << "'" << std::endl;
+            std::cout << "  in '" << haystack << "' [" << first << ", " << last << ")" << std::endl;
+            std::cout << "  expected " << expected << "; got " << found << std::endl;
+            }
+        BOOST_CHECK_EQUAL ( found, expected );
+        BOOST_CHECK_EQUAL ( pds.find_in ( corpus, first, last ), expected );    // by position
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        check_one ( haystack, needle, 0, haystack.size ());
+        }
+
+    void test_searcher () {
+        const std::string dna ( "GATACACCTACCTTCACCAGTTACTCTATGCACTAGGTGCGCCAGGCCCATGCACAAGGGCTT" );
+        check_one ( dna, "GATA" );
+        check_one ( dna, "AAGGGCTT" );
+        check_one ( dna, "CCAGGCC" );
+        check_one ( dna, "CCAGGCA" );
+        check_one ( dna, "ACTAGGTGCGCCAGGCCCATG" );                 // long enough for the 8-mer table
+        check_one ( dna, "ACTAGGTGCGCCAGGCCCATGA" );                // not there
+        check_one ( dna, dna );
+        check_one ( dna, dna + "A" );
+        check_one ( dna, "" );
+        check_one ( "", "ACGT" );
+        check_one ( dna, "CACC", 5, dna.size ());                   // skip the first match
+        check_one ( dna, "GATA", 1, dna.size ());
+
+    //  Random tests; short and long patterns, on part of the corpus
+        std::srand ( 1 );
+        for ( int i = 0; i < 2000; ++i ) {
+            const int alphabet = 1 + std::rand () % 4;
+            std::string haystack = random_dna ( std::rand () % 400, alphabet );
+            std::string needle   = random_dna ( 1 + std::rand () % ( i % 2 ? 80 : 14 ), alphabet );
+            if ( i % 3 == 0 && haystack.size () > needle.size ()) {
+                std::size_t pos = std::rand () % ( haystack.size () - needle.size () + 1 );
+                haystack.replace ( pos, needle.size (), needle );
+                }
+            const std::size_t first = haystack.size () / 4;
+            check_one ( haystack, needle );
+            check_one ( haystack, needle, first, haystack.size () - first );
+            }
+
+    //  The other searchers work on packed sequences, too
+        ba::packed_dna_sequence corpus ( dna );
+        const std::string pat ( "GCGCCAGG" );
+        ba::boyer_moore_horspool<std::string::const_iterator> bmh ( pat.begin (), pat.end ());
+        BOOST_CHECK ( bmh ( corpus.begin (), corpus.end ()) - corpus.begin () == (std::ptrdiff_t) dna.find ( pat ));
+        BOOST_CHECK ( ba::packed_dna_search ( corpus, ba::packed_dna_sequence ( pat )) - corpus.begin ()
+                                                == (std::ptrdiff_t) dna.find ( pat ));
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_sequence ();
+    test_searcher ();
+    return 0;
+}
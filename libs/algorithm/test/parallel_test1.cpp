@@ -0,0 +1,356 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/parallel.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+namespace ex = boost::algorithm::execution;
+
+namespace {
+
+//  Runs tasks on a pool, and counts them
+    class counting_executor : public ba::executor {
+    public:
+        counting_executor () : pool_ ( 3 ), count_ ( 0 ) {}
+        void execute ( const task &t ) {
+            { boost::lock_guard<boost::mutex> lock ( mutex_ ); ++count_; }
+            pool_.execute ( t );
+            }
+        std::size_t concurrency () const { return 3; }
+        std::size_t count () const { boost::lock_guard<boost::mutex> lock ( mutex_ ); return count_; }
+    private:
+        ba::thread_pool pool_;
+        mutable boost::mutex mutex_;
+        std::size_t count_;
+        };
+
+//  Runs tasks on the calling thread, at once
+    class inline_executor : public ba::executor {
+    public:
+        void execute ( const task &t ) { t (); }
+        std::size_t concurrency () const { return 4; }
+        };
+
+//  Never runs anything
+    class lazy_executor : public ba::executor {
+    public:
+        void execute ( const task & ) {}
+        std::size_t concurrency () const { return 8; }
+        };
+
+    struct mark {
+        explicit mark ( std::vector<int> &v ) : v_ ( &v ) {}
+        void operator () ( std::size_t lo, std::size_t hi ) const {
+            for ( std::size_t i = lo; i < hi; ++i )
+                ( *v_ ) [ i ] += 1;
+            }
+        std::vector<int> *v_;
+        };
+
+    struct mark_task {
+        mark_task ( std::vector<int> &v, std::size_t lo, std::size_t hi ) : m_ ( v ), lo_ ( lo ), hi_ ( hi ) {}
+        void operator () () const { m_ ( lo_, hi_ ); }
+        mark m_;
+        std::size_t lo_, hi_;
+        };
+
+    struct thrower {
+        void operator () ( std::size_t lo, std::size_t hi ) const {
+            if ( lo <= 5000 && 5000 < hi )
+                throw std::runtime_error ( "piece with 5000" );
+            }
+        };
+
+    template <typename Policy>
+    void check_parallel_for ( const Policy &policy, std::size_t n ) {
+        std::vector<int> v ( n, 0 );
+        ba::parallel_for ( policy, n, mark ( v ));
+        BOOST_CHECK ( std::count ( v.begin (), v.end (), 1 ) == static_cast<std::ptrdiff_t> ( n ));
+        }
+
+    void test_parallel_for () {
+        counting_executor ce;
+        inline_executor ie;
+        lazy_executor le;
+        const std::size_t sizes [] = { 0, 1, 100, 1024, 1025, 10000, 100000 };
+        for ( std::size_t i = 0; i < sizeof ( sizes ) / sizeof ( sizes [ 0 ] ); ++i ) {
+            check_parallel_for ( ex::seq, sizes [ i ] );
+            check_parallel_for ( ex::par, sizes [ i ] );
+            check_parallel_for ( ex::par_unseq, sizes [ i ] );
+            check_parallel_for ( ex::par.with_grain ( 7 ), sizes [ i ] );
+            check_parallel_for ( ex::par.on ( ce ).with_grain ( 100 ), sizes [ i ] );
+            check_parallel_for ( ex::par.on ( ie ).with_grain ( 100 ), sizes [ i ] );
+            check_parallel_for ( ex::par.on ( le ).with_grain ( 100 ), sizes [ i ] );  // all on this thread
+            }
+
+    //  The sequential policy, and small inputs, never touch the executor
+        const std::size_t before = ce.count ();
+        check_parallel_for ( ex::par.on ( ce ), 1000 );
+        check_parallel_for ( ex::par.on ( ce ).with_grain ( 5000 ), 5000 );
+        BOOST_CHECK_EQUAL ( ce.count (), before );
+        check_parallel_for ( ex::par.on ( ce ).with_grain ( 10 ), 1000 );
+        BOOST_CHECK ( ce.count () > before );
+        BOOST_CHECK ( ce.count () <= before + 3 );  // no more helpers than the executor's concurrency
+
+    //  An exception in a piece comes out on this thread
+        BOOST_CHECK_THROW ( ba::parallel_for ( ex::par.with_grain ( 100 ), 100000, thrower ()), std::runtime_error );
+        BOOST_CHECK_THROW ( ba::parallel_for ( ex::par.on ( ie ).with_grain ( 100 ), 100000, thrower ()), std::exception );
+        BOOST_CHECK_THROW ( ba::parallel_for ( ex::seq, 100000, thrower ()), std::runtime_error );
+        }
+
+    void test_min_grain () {
+    //  The default grain, and the size below which the executor isn't used,
+    //  come from current_search_tuning ()
+        const ba::search_tuning saved = ba::current_search_tuning ();
+        counting_executor ce;
+        std::size_t before = ce.count ();
+        check_parallel_for ( ex::par.on ( ce ), 1000 );
+        BOOST_CHECK_EQUAL ( ce.count (), before );
+
+        ba::current_search_tuning ().parallel_min_grain = 100;
+        check_parallel_for ( ex::par.on ( ce ), 1000 );
+        BOOST_CHECK ( ce.count () > before );
+        const ba::detail::parallel_plan plan = ba::detail::make_parallel_plan ( ex::par.on ( ce ), 1000 );
+        BOOST_CHECK ( plan.exec == &ce );
+        BOOST_CHECK_EQUAL ( plan.grain, 100U );     // 1000 / 16 is less than the least grain
+
+        ba::current_search_tuning ().parallel_min_grain = 100000;
+        before = ce.count ();
+        check_parallel_for ( ex::par.on ( ce ), 50000 );
+        BOOST_CHECK_EQUAL ( ce.count (), before );
+
+    //  Zero is taken as one, not as 'never on the calling thread'
+        ba::current_search_tuning ().parallel_min_grain = 0;
+        BOOST_CHECK ( ba::detail::make_parallel_plan ( ex::par.on ( ce ), 1 ).exec == NULL );
+        check_parallel_for ( ex::par.on ( ce ), 1000 );
+        ba::current_search_tuning () = saved;
+
+        const std::size_t g = ba::calibrate_parallel_min_grain ( 0.0005, &ce );
+        BOOST_CHECK ( g >= 256 && g <= 1024 * 1024 );
+        }
+
+    void test_pool () {
+        std::vector<int> v ( 1000, 0 );
+        {
+        ba::thread_pool pool ( 4 );
+        BOOST_CHECK_EQUAL ( pool.concurrency (), 4U );
+        for ( std::size_t i = 0; i < v.size (); i += 10 )
+            pool.execute ( mark_task ( v, i, i + 10 ));
+        }   // waits for the tasks
+        BOOST_CHECK ( std::count ( v.begin (), v.end (), 1 ) == 1000 );
+        BOOST_CHECK ( ba::default_executor ().concurrency () >= 1 );
+        }
+
+    struct is_odd { bool operator () ( int i ) const { return i % 2 != 0; } };
+    struct greater_than { explicit greater_than ( int k ) : k_ ( k ) {} bool operator () ( int i ) const { return i > k_; } int k_; };
+    struct less_than { explicit less_than ( int k ) : k_ ( k ) {} bool operator () ( int i ) const { return i < k_; } int k_; };
+
+    template <typename Policy>
+    void check_algorithms ( const Policy &policy ) {
+        std::vector<int> v ( 50000 );
+        for ( std::size_t i = 0; i < v.size (); ++i )
+            v [ i ] = static_cast<int> ( i * 2 );
+        const std::list<int> l ( v.begin (), v.end ());
+
+        BOOST_CHECK (  ba::all_of  ( policy, v, greater_than ( -1 )));
+        BOOST_CHECK ( !ba::all_of  ( policy, v, greater_than ( 0 )));
+        BOOST_CHECK (  ba::none_of ( policy, v, is_odd ()));
+        BOOST_CHECK ( !ba::any_of  ( policy, v.begin (), v.end (), is_odd ()));
+        BOOST_CHECK (  ba::any_of  ( policy, l, greater_than ( 99996 )));
+        BOOST_CHECK ( !ba::any_of  ( policy, l.begin (), l.end (), greater_than ( 99998 )));
+        BOOST_CHECK (  ba::any_of_equal  ( policy, v, 99998 ));
+        BOOST_CHECK ( !ba::any_of_equal  ( policy, v, 3 ));
+        BOOST_CHECK (  ba::none_of_equal ( policy, v.begin (), v.end (), 5 ));
+        BOOST_CHECK ( !ba::all_of_equal  ( policy, v, 0 ));
+        BOOST_CHECK (  ba::all_of_equal  ( policy, std::vector<int> ( 5000, 7 ), 7 ));
+
+        BOOST_CHECK ( ba::is_strictly_increasing ( policy, v ));
+        BOOST_CHECK ( ba::is_increasing ( policy, v.begin (), v.end ()));
+        BOOST_CHECK ( !ba::is_decreasing ( policy, v ));
+        std::vector<int> w ( v );
+        w [ 30000 ] = 0;
+        w [ 40000 ] = 0;
+        BOOST_CHECK ( ba::is_ordered ( policy, w, std::less<int> ()) == w.begin () + 30000 );
+        BOOST_CHECK ( ba::is_ordered ( policy, w.begin (), w.end (), std::less<int> ()) ==
+                      ba::is_ordered ( w.begin (), w.end (), std::less<int> ()));
+        std::reverse ( w.begin (), w.end ());
+        BOOST_CHECK ( !ba::is_strictly_decreasing ( policy, w ));
+
+    //  Ties: the first smallest and the last largest
+        std::vector<int> m ( 30000, 5 );
+        m [ 7000 ] = m [ 20000 ] = 1;
+        m [ 3000 ] = m [ 25000 ] = 9;
+        std::pair<std::vector<int>::iterator, std::vector<int>::iterator> mm = ba::minmax_element ( policy, m );
+        BOOST_CHECK ( mm.first == m.begin () + 7000 && mm.second == m.begin () + 25000 );
+        mm = ba::minmax_element ( policy, m.begin (), m.end (), std::greater<int> ());
+        BOOST_CHECK ( mm == ba::minmax_element ( m.begin (), m.end (), std::greater<int> ()));
+        mm = ba::minmax_element ( policy, m, std::less<int> ());
+        BOOST_CHECK ( mm == ba::minmax_element ( m.begin (), m.end ()));
+        std::vector<int> empty;
+        BOOST_CHECK ( ba::minmax_element ( policy, empty ).first == empty.end ());
+
+        std::vector<long> iv ( 20000 );
+        ba::iota ( policy, iv, 10L );
+        for ( std::size_t i = 0; i < iv.size (); ++i )
+            if ( iv [ i ] != static_cast<long> ( i + 10 )) { BOOST_CHECK ( false ); break; }
+
+        const std::string bytes ( 20000, '\xA5' );
+        std::string hexed ( 40000, ' ' );
+        BOOST_CHECK ( ba::hex ( policy, bytes, hexed.begin ()) == hexed.end ());
+        BOOST_CHECK ( hexed == ba::hex ( bytes ));
+        std::string out;
+        ba::hex ( policy, bytes.begin (), bytes.end (), std::back_inserter ( out ));  // sequential
+        BOOST_CHECK ( out == hexed );
+
+        BOOST_CHECK (  ba::one_of ( policy, v, greater_than ( 99996 )));
+        BOOST_CHECK ( !ba::one_of ( policy, v.begin (), v.end (), greater_than ( 99994 )));
+        BOOST_CHECK ( !ba::one_of ( policy, v, is_odd ()));
+        BOOST_CHECK (  ba::one_of_equal ( policy, v, 40000 ));
+        BOOST_CHECK ( !ba::one_of_equal ( policy, v.begin (), v.end (), 3 ));
+        BOOST_CHECK ( !ba::one_of_equal ( policy, std::vector<int> ( 5000, 7 ), 7 ));
+        BOOST_CHECK (  ba::one_of ( policy, l, greater_than ( 99996 )));
+        BOOST_CHECK ( ba::find_if_not ( policy, v, greater_than ( 59999 )) == v.begin ());
+        BOOST_CHECK ( ba::find_if_not ( policy, v.begin (), v.end (), less_than ( 70000 )) == v.begin () + 35000 );
+        BOOST_CHECK ( ba::find_if_not ( policy, v, greater_than ( -1 )) == v.end ());
+        BOOST_CHECK ( *ba::find_if_not ( policy, l, less_than ( 70000 )) == 70000 );
+        BOOST_CHECK (  ba::is_partitioned ( policy, v, less_than ( 70000 )));
+        BOOST_CHECK (  ba::is_partitioned ( policy, v, is_odd ()));
+        BOOST_CHECK ( !ba::is_partitioned ( policy, v.begin (), v.end (), greater_than ( 70000 )));
+        w = v;
+        w [ 45000 ] = 1;
+        BOOST_CHECK ( !ba::is_partitioned ( policy, w, less_than ( 70000 )));
+        BOOST_CHECK (  ba::is_partitioned ( policy, l, less_than ( 70000 )));
+
+        std::vector<int> clamped ( v.size ());
+        BOOST_CHECK ( ba::clamp_range ( policy, v.begin (), v.end (), clamped.begin (), 1000, 2000 ) == clamped.end ());
+        std::vector<int> expected_clamp;
+        ba::clamp_range ( v, std::back_inserter ( expected_clamp ), 1000, 2000 );
+        BOOST_CHECK ( clamped == expected_clamp );
+        ba::clamp_range ( policy, v.begin (), v.end (), clamped.begin (), 2000, 1000, std::greater<int> ());
+        BOOST_CHECK ( clamped == expected_clamp );
+        std::vector<int> copied ( v.size (), -1 );
+        BOOST_CHECK ( ba::copy_n ( policy, v.begin (), 40000, copied.begin ()) == copied.begin () + 40000 );
+        BOOST_CHECK ( std::equal ( v.begin (), v.begin () + 40000, copied.begin ()) && copied [ 40000 ] == -1 );
+        BOOST_CHECK ( ba::copy_n ( policy, v.begin (), 0, copied.begin ()) == copied.begin ());
+        std::list<int> lcopy;
+        ba::copy_n ( policy, l.begin (), 100, std::back_inserter ( lcopy ));    // sequential
+        BOOST_CHECK ( lcopy.size () == 100 && lcopy.back () == 198 );
+
+    //  The kept elements' places depend on the pieces before them
+        std::vector<int> kept ( v.size (), -1 ), expected_kept;
+        ba::copy_if ( v, std::back_inserter ( expected_kept ), greater_than ( 12345 ));
+        BOOST_CHECK ( ba::copy_if ( policy, v.begin (), v.end (), kept.begin (), greater_than ( 12345 )) == kept.begin () + expected_kept.size ());
+        BOOST_CHECK ( std::equal ( expected_kept.begin (), expected_kept.end (), kept.begin ()) && kept [ expected_kept.size () ] == -1 );
+        w = v;
+        for ( std::size_t i = 0; i < w.size (); i += 7 )
+            w [ i ] = 1;
+        std::vector<int> odd ( w.size ());
+        const std::vector<int>::iterator odd_end = ba::copy_if ( policy, w, odd.begin (), is_odd ());
+        BOOST_CHECK ( odd_end - odd.begin () == ( std::ptrdiff_t ) (( w.size () + 6 ) / 7 ) && std::count ( odd.begin (), odd_end, 1 ) == odd_end - odd.begin ());
+        std::list<int> lkept;
+        ba::copy_if ( policy, l, std::back_inserter ( lkept ), greater_than ( 99990 ));   // sequential
+        BOOST_CHECK ( lkept.size () == 4 && lkept.front () == 99992 );
+        BOOST_CHECK ( ba::copy_if ( policy, empty, kept.begin (), is_odd ()) == kept.begin ());
+
+        std::vector<int> yes ( w.size ()), no ( w.size ()), expected_yes, expected_no;
+        ba::partition_copy ( w.begin (), w.end (), std::back_inserter ( expected_yes ), std::back_inserter ( expected_no ), less_than ( 60000 ));
+        std::pair<std::vector<int>::iterator, std::vector<int>::iterator> parts =
+            ba::partition_copy ( policy, w.begin (), w.end (), yes.begin (), no.begin (), less_than ( 60000 ));
+        BOOST_CHECK ( parts.first == yes.begin () + expected_yes.size () && parts.second == no.begin () + expected_no.size ());
+        BOOST_CHECK ( std::equal ( expected_yes.begin (), expected_yes.end (), yes.begin ()));
+        BOOST_CHECK ( std::equal ( expected_no.begin (), expected_no.end (), no.begin ()));
+        parts = ba::partition_copy ( policy, w, yes.begin (), no.begin (), is_odd ());
+        BOOST_CHECK ( parts.first - yes.begin () == odd_end - odd.begin () && parts.first - yes.begin () + parts.second - no.begin () == ( std::ptrdiff_t ) w.size ());
+
+    //  Values of unhex are at fixed places in the input
+        std::string unhexed ( bytes.size (), ' ' );
+        BOOST_CHECK ( ba::unhex ( policy, hexed, unhexed.begin ()) == unhexed.end ());
+        BOOST_CHECK ( unhexed == bytes );
+        std::vector<unsigned> words ( 5000 );
+        const std::string word_hex ( ba::hex ( std::string ( 20000, '\x3C' )));
+        BOOST_CHECK ( ba::unhex ( policy, word_hex.begin (), word_hex.end (), words.begin ()) == words.end ());
+        BOOST_CHECK ( std::count ( words.begin (), words.end (), 0x3C3C3C3Cu ) == 5000 );
+        std::string bad ( hexed );
+        bad [ 30001 ] = 'x';
+        BOOST_CHECK_THROW ( ba::unhex ( policy, bad, unhexed.begin ()), ba::non_hex_input );
+        bad [ 30001 ] = hexed [ 30001 ];
+        bad.erase ( bad.size () - 1 );
+        BOOST_CHECK_THROW ( ba::unhex ( policy, bad.begin (), bad.end (), unhexed.begin ()), ba::not_enough_input );
+        bad [ 20000 ] = 'x';
+        BOOST_CHECK_THROW ( ba::unhex ( policy, bad, unhexed.begin ()), ba::non_hex_input );    // the first error wins
+
+        std::vector<int> perm ( 5000 );
+        for ( std::size_t i = 0; i < perm.size (); ++i )
+            perm [ i ] = static_cast<int> ( i % 50 );
+        std::vector<int> shuffled ( perm );
+        std::reverse ( shuffled.begin () + 100, shuffled.end ());
+        BOOST_CHECK (  ba::is_permutation ( policy, perm.begin (), perm.end (), shuffled.begin ()));
+        BOOST_CHECK (  ba::is_permutation ( policy, perm, shuffled.begin (), std::equal_to<int> ()));
+        BOOST_CHECK (  ba::is_permutation ( policy, perm, perm.begin ()));
+        shuffled [ 4000 ] = 0;
+        BOOST_CHECK ( !ba::is_permutation ( policy, perm, shuffled.begin ()));
+        BOOST_CHECK ( !ba::is_permutation ( policy, perm.begin (), perm.end (), shuffled.begin (), std::equal_to<int> ()));
+        shuffled [ 4000 ] = 50;
+        BOOST_CHECK ( !ba::is_permutation ( policy, perm, shuffled.begin ()));
+        const std::list<int> lperm ( perm.begin (), perm.end ());
+        BOOST_CHECK (  ba::is_permutation ( policy, lperm, perm.begin ()));     // sequential
+
+    //  One corpus, with the match at or across the boundaries of the pieces
+        const std::string needle ( "needle" );
+        const std::size_t places [] = { 0, 327, 328, 332, 333, 994, 995, 999, 1000, 6245, 6249, 19994 };
+        for ( std::size_t i = 0; i < sizeof ( places ) / sizeof ( places [ 0 ] ); ++i ) {
+            std::string corpus ( 20000, 'n' );
+            corpus.replace ( places [ i ], needle.size (), needle );
+            corpus.replace ( 19994, needle.size (), needle );
+            const std::string::const_iterator first = corpus.begin (), last = corpus.end ();
+            BOOST_CHECK ( ba::boyer_moore_search ( policy, first, last, needle.begin (), needle.end ()) == first + places [ i ] );
+            BOOST_CHECK ( ba::boyer_moore_horspool_search ( policy, first, last, needle.begin (), needle.end ()) == first + places [ i ] );
+            BOOST_CHECK ( ba::knuth_morris_pratt_search ( policy, first, last, needle.begin (), needle.end ()) == first + places [ i ] );
+            }
+        const std::string nothing ( 20000, 'n' );
+        BOOST_CHECK ( ba::boyer_moore_search ( policy, nothing.begin (), nothing.end (), needle.begin (), needle.end ()) == nothing.end ());
+        BOOST_CHECK ( ba::boyer_moore_search ( policy, nothing.begin (), nothing.end (), needle.begin (), needle.begin ()) == nothing.begin ());
+        BOOST_CHECK ( ba::knuth_morris_pratt_search ( policy, needle.begin (), needle.end (), nothing.begin (), nothing.end ()) == needle.end ());
+        const std::string one ( 1, 'n' );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( policy, nothing.begin (), nothing.end (), one.begin (), one.end ()) == nothing.begin ());
+
+        std::vector<std::string> corpora;
+        for ( int i = 0; i < 5000; ++i )
+            corpora.push_back ( std::string ( i % 50, 'x' ) + ( i % 3 == 0 ? "needle" : "" ));
+        const std::string pat ( "needle" );
+        ba::boyer_moore_horspool<std::string::const_iterator> s ( pat.begin (), pat.end ());
+        std::vector<std::size_t> expected ( corpora.size ()), found ( corpora.size ());
+        ba::search_each ( s, corpora, expected.begin ());
+        BOOST_CHECK ( ba::search_each ( policy, s, corpora, found.begin ()) == found.end ());
+        BOOST_CHECK ( found == expected );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_pool ();
+    test_parallel_for ();
+    test_min_grain ();
+    check_algorithms ( ex::seq );
+    check_algorithms ( ex::par );
+    check_algorithms ( ex::par_unseq.with_grain ( 333 ));
+    inline_executor ie;
+    check_algorithms ( ex::par.on ( ie ).with_grain ( 1000 ));
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/perf_counters.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace ba = boost::algorithm;
+
+//  Hardware counters may or may not be available where the tests run (they
+//  usually aren't in containers); either way, measuring must work.
+
+namespace {
+
+    volatile unsigned long sink;
+
+    void busy ( unsigned long n ) {
+        unsigned long sum = 0;
+        for ( unsigned long i = 0; i < n; ++i )
+            sum += i * i;
+        sink = sum;
+        }
+
+    void test_sample () {
+        ba::perf_counters counters;
+        std::cout << "Hardware counters are " << ( counters.available () ? "" : "not " ) << "available" << std::endl;
+
+        for ( int round = 0; round < 2; ++round ) {
+            counters.start ();
+            busy ( 1000000 );
+            const ba::perf_sample s = counters.stop ();
+
+            for ( int i = 0; i < ba::perf_sample::num_events; ++i ) {
+                const ba::perf_sample::event e = static_cast<ba::perf_sample::event> ( i );
+                BOOST_CHECK ( !s.valid [ i ] || counters.available ( e ));
+                if ( !s.valid [ i ] )
+                    BOOST_CHECK ( s.counts [ i ] == 0 );
+                }
+        //  A million multiplies and adds
+            if ( s.valid [ ba::perf_sample::instructions ] )
+                BOOST_CHECK ( s.counts [ ba::perf_sample::instructions ] >= 1000000 );
+            if ( s.valid [ ba::perf_sample::cycles ] )
+                BOOST_CHECK ( s.counts [ ba::perf_sample::cycles ] > 0 );
+            BOOST_CHECK ( s.ipc () >= 0.0 );
+
+            std::ostringstream out;
+            ba::print_perf_sample ( out, s );
+            BOOST_CHECK ( !out.str ().empty ());
+            std::cout << s.ticks << " ticks; " << out.str () << std::endl;
+            }
+        }
+
+    void test_unmeasured () {
+    //  Nothing counted
+        ba::perf_sample s;
+        BOOST_CHECK ( s.ticks == 0 );
+        BOOST_CHECK ( s.ipc () == 0.0 );
+        std::ostringstream out;
+        ba::print_perf_sample ( out, s );
+        BOOST_CHECK ( out.str ().find ( "n/a" ) != std::string::npos );
+
+    //  Some counted, some not
+        s.valid  [ ba::perf_sample::cycles ] = true;
+        s.counts [ ba::perf_sample::cycles ] = 200;
+        s.valid  [ ba::perf_sample::instructions ] = true;
+        s.counts [ ba::perf_sample::instructions ] = 300;
+        BOOST_CHECK ( s.ipc () == 1.5 );
+        std::ostringstream out2;
+        ba::print_perf_sample ( out2, s );
+        BOOST_CHECK ( out2.str ().find ( "cycles 200" ) != std::string::npos );
+        BOOST_CHECK ( out2.str ().find ( "LLC-misses n/a" ) != std::string::npos );
+
+    //  A stop without a start doesn't read the counters
+        ba::perf_counters counters;
+        const ba::perf_sample s2 = counters.stop ();
+        for ( int i = 0; i < ba::perf_sample::num_events; ++i )
+            BOOST_CHECK ( !s2.valid [ i ] );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_sample ();
+    test_unmeasured ();
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/prefix_matcher.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::string random_tail ( std::size_t len, int alphabet ) {
+        std::string retVal ( len, 'a' );
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal [ i ] += static_cast<char> ( std::rand () % alphabet );
+        return retVal;
+        }
+
+//  Half the time, a string that starts with one of 'prefixes' (so that the
+//  trie has chains of nested prefixes, and keys that go past the longest one)
+    std::string extend ( const std::vector<std::string> &prefixes, std::size_t count, std::size_t len, int alphabet ) {
+        const std::string base = count != 0 && std::rand () % 2 == 0 ? prefixes [ std::rand () % count ] : std::string ();
+        return base + random_tail ( len, alphabet );
+        }
+
+    bool starts_with ( const std::string &key, const std::string &prefix ) {
+        return prefix.size () <= key.size () && std::equal ( prefix.begin (), prefix.end (), key.begin ());
+        }
+
+//  The slow way: every prefix, shortest first (then by id)
+    std::vector<std::size_t> brute_force ( const std::vector<std::string> &prefixes, const std::string &key ) {
+        std::vector<std::size_t> retVal;
+        for ( std::size_t len = 0; len <= key.size (); ++len )
+            for ( std::size_t id = 0; id < prefixes.size (); ++id )
+                if ( prefixes [ id ].size () == len && starts_with ( key, prefixes [ id ] ))
+                    retVal.push_back ( id );
+        return retVal;
+        }
+
+    std::size_t brute_longest ( const std::vector<std::string> &prefixes, const std::string &key ) {
+        std::size_t retVal = prefixes.size ();
+        for ( std::size_t id = 0; id < prefixes.size (); ++id )
+            if ( starts_with ( key, prefixes [ id ] ) && ( retVal == prefixes.size () || prefixes [ id ].size () > prefixes [ retVal ].size ()))
+                retVal = id;
+        return retVal;
+        }
+
+    void check ( const std::vector<std::string> &prefixes, const std::vector<std::string> &keys ) {
+        const ba::prefix_matcher pm ( prefixes );
+        BOOST_CHECK ( pm.size () == prefixes.size ());
+        std::vector<std::size_t> expected;
+        for ( std::size_t i = 0; i < keys.size (); ++i ) {
+            expected.push_back ( brute_longest ( prefixes, keys [ i ] ));
+            BOOST_CHECK ( pm.longest ( keys [ i ] ) == expected.back ());
+            std::vector<std::size_t> all;
+            pm.all ( keys [ i ].begin (), keys [ i ].end (), std::back_inserter ( all ));
+            BOOST_CHECK ( all == brute_force ( prefixes, keys [ i ] ));
+            }
+        std::vector<std::size_t> batch;
+        pm.longest_each ( keys, std::back_inserter ( batch ));
+        BOOST_CHECK ( batch == expected );
+        }
+
+    void test_routes () {
+        std::vector<std::string> routes;
+        routes.push_back ( "/api/" );
+        routes.push_back ( "/api/v1/users" );
+        routes.push_back ( "/api/v1/" );
+        routes.push_back ( "/static/" );
+        routes.push_back ( "/api/v1/" );    // a duplicate
+        routes.push_back ( "/" );
+
+        const ba::prefix_matcher pm ( routes.begin (), routes.end ());
+        BOOST_CHECK ( pm.longest ( std::string ( "/api/v1/users/17" )) == 1 );
+        BOOST_CHECK ( pm.longest ( std::string ( "/api/v1/orders" )) == 2 );
+        BOOST_CHECK ( pm.longest ( std::string ( "/api/v2" )) == 0 );
+        BOOST_CHECK ( pm.longest ( std::string ( "/index.html" )) == 5 );
+        BOOST_CHECK ( pm.longest ( std::string ( "index.html" )) == pm.size ());
+        BOOST_CHECK ( pm.longest ( std::string ()) == pm.size ());
+        BOOST_CHECK ( pm.memory_use () > 0 );
+
+        std::vector<std::size_t> all;
+        pm.all ( std::string ( "/api/v1/users" ), std::back_inserter ( all ));
+        BOOST_CHECK ( all.size () == 5 && all [ 0 ] == 5 && all [ 1 ] == 0 && all [ 2 ] == 2 && all [ 3 ] == 4 && all [ 4 ] == 1 );
+
+        std::vector<std::string> keys;
+        keys.push_back ( "/api/v1/users/17" );
+        keys.push_back ( "nothing" );
+        keys.push_back ( "/static/app.js" );
+        check ( routes, keys );
+
+    //  An empty prefix matches everything; an empty set matches nothing
+        std::vector<std::string> with_empty ( 1, "" );
+        with_empty.push_back ( "ab" );
+        keys.push_back ( "" );
+        keys.push_back ( "abc" );
+        check ( with_empty, keys );
+        check ( std::vector<std::string> (), keys );
+        }
+
+    void test_random () {
+        for ( int i = 0; i < 100; ++i ) {
+            const int alphabet = 1 + std::rand () % 26;    // wide alphabets make table nodes
+            std::vector<std::string> prefixes ( std::rand () % 200 );
+            for ( std::size_t j = 0; j < prefixes.size (); ++j )
+                prefixes [ j ] = extend ( prefixes, j, std::rand () % 4, alphabet );
+            std::vector<std::string> keys ( 50 );
+            for ( std::size_t j = 0; j < keys.size (); ++j )
+                keys [ j ] = extend ( prefixes, prefixes.size (), std::rand () % 6, alphabet );
+            check ( prefixes, keys );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    std::srand ( 3 );
+    test_routes ();
+    test_random ();
+    return 0;
+}
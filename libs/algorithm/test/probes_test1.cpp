@@ -0,0 +1,253 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+//  Send the trace points here, instead of to USDT probes, so that the test
+//  can see that they fire, and with what.
+
+namespace {
+    struct probe_event {
+        std::string name;
+        std::string kind;
+        std::vector<long> args;
+        };
+
+    std::vector<probe_event> events;
+
+    void record ( const char *name, const char *kind = "", long a1 = -99, long a2 = -99, long a3 = -99 ) {
+        probe_event e;
+        e.name = name;
+        e.kind = kind;
+        if ( a1 != -99 ) e.args.push_back ( a1 );
+        if ( a2 != -99 ) e.args.push_back ( a2 );
+        if ( a3 != -99 ) e.args.push_back ( a3 );
+        events.push_back ( e );
+        }
+
+    void record_count ( const char *name, std::size_t count ) {
+        record ( name, "", static_cast<long> ( count ));
+        }
+    }
+
+#define BOOST_ALGORITHM_PROBE0(name)                 record ( #name )
+#define BOOST_ALGORITHM_PROBE1(name, a1)             record_count ( #name, a1 )
+#define BOOST_ALGORITHM_PROBE2(name, a1, a2)         record ( #name, a1, a2 )
+#define BOOST_ALGORITHM_PROBE3(name, a1, a2, a3)     record ( #name, a1, a2, a3 )
+#define BOOST_ALGORITHM_PROBE4(name, a1, a2, a3, a4) record ( #name, a1, a2, a3, a4 )
+
+#include <boost/algorithm/hex.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/tuned_boyer_moore.hpp>
+#include <boost/algorithm/searching/qgram_horspool.hpp>
+#include <boost/algorithm/searching/rabin_karp.hpp>
+#include <boost/algorithm/searching/packed_dna.hpp>
+#include <boost/algorithm/searching/utf8.hpp>
+#include <boost/algorithm/searching/multi_literal.hpp>
+#include <boost/algorithm/searching/baker_bird.hpp>
+#include <boost/algorithm/searching/suffix_array.hpp>
+#include <boost/algorithm/searching/fm_index.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <iostream>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    void check_event ( std::size_t i, const char *name, const char *kind, long a1, long a2 = -99, long a3 = -99 ) {
+        BOOST_REQUIRE ( i < events.size ());
+        const probe_event &e = events [ i ];
+        BOOST_CHECK_EQUAL ( e.name, name );
+        BOOST_CHECK_EQUAL ( e.kind, kind );
+        std::vector<long> expected;
+        if ( a1 != -99 ) expected.push_back ( a1 );
+        if ( a2 != -99 ) expected.push_back ( a2 );
+        if ( a3 != -99 ) expected.push_back ( a3 );
+        BOOST_CHECK ( e.args == expected );
+        }
+
+    template <typename Searcher>
+    void check_searcher ( const char *kind ) {
+        const std::string corpus  = "the quick brown fox jumps over the lazy dog";
+        const std::string found   = "lazy";
+        const std::string missing = "cat";
+
+        events.clear ();
+        Searcher s ( found.begin (), found.end ());
+        BOOST_CHECK ( s ( corpus.begin (), corpus.end ()) == corpus.begin () + 35 );
+        BOOST_REQUIRE_EQUAL ( events.size (), 3U );
+        check_event ( 0, "searcher_create", kind, 4 );
+        check_event ( 1, "search_begin",    kind, 43, 4 );
+        check_event ( 2, "search_end",      kind, 43, 4, 35 );
+
+    //  Not found, and a corpus shorter than the pattern
+        events.clear ();
+        Searcher s2 ( missing.begin (), missing.end ());
+        BOOST_CHECK ( s2 ( corpus.begin (), corpus.end ()) == corpus.end ());
+        BOOST_CHECK ( s2 ( corpus.begin (), corpus.begin () + 2 ) == corpus.begin () + 2 );
+        BOOST_REQUIRE_EQUAL ( events.size (), 5U );
+        check_event ( 2, "search_end", kind, 43, 3, -1 );
+        check_event ( 4, "search_end", kind,  2, 3, -1 );
+        }
+
+    void test_packed_dna () {
+        const std::string dna = "ACGTACGTTTGACCA";
+        const std::string pat = "TTGA";
+        const ba::packed_dna_sequence corpus ( dna );
+        events.clear ();
+        ba::packed_dna_searcher s ( pat.begin (), pat.end ());
+        BOOST_CHECK ( s ( corpus ) == corpus.begin () + 8 );
+        BOOST_REQUIRE_EQUAL ( events.size (), 3U );
+        check_event ( 0, "searcher_create", "packed_dna_searcher", 4 );
+        check_event ( 2, "search_end",      "packed_dna_searcher", 15, 4, 8 );
+        }
+
+//  The inner searcher's probes fire inside the utf8_searcher's
+    void test_utf8 () {
+        typedef std::string::const_iterator iter;
+        const std::string corpus = "caf\xC3\xA9 cr\xC3\xA8me";
+        const std::string pat = "cr\xC3\xA8me";
+        ba::utf8_searcher<iter> s ( pat.begin (), pat.end ());
+        events.clear ();
+        BOOST_CHECK ( s ( corpus.begin (), corpus.end ()) == corpus.begin () + 6 );
+        BOOST_REQUIRE_EQUAL ( events.size (), 4U );
+        check_event ( 0, "search_begin", "utf8_searcher", 12, 6 );
+        check_event ( 1, "search_begin", "boyer_moore_horspool", 12, 6 );
+        check_event ( 2, "search_end",   "boyer_moore_horspool", 12, 6, 6 );
+        check_event ( 3, "search_end",   "utf8_searcher", 12, 6, 6 );
+        }
+
+//  Calls that report every match end with the number of matches
+    void test_multi_pattern () {
+        const std::string corpus = "she sells sea shells";
+        std::vector<std::string> patterns;
+        patterns.push_back ( "she" );
+        patterns.push_back ( "sea" );
+        patterns.push_back ( "cat" );
+
+        events.clear ();
+        const ba::multi_literal_searcher mls ( patterns );
+        std::vector<ba::literal_match> found;
+        mls ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+        BOOST_CHECK_EQUAL ( found.size (), 3U );
+        BOOST_REQUIRE_EQUAL ( events.size (), 3U );
+        check_event ( 0, "searcher_create", "multi_literal_searcher", 3 );
+        check_event ( 1, "search_begin",    "multi_literal_searcher", 20, 3 );
+        check_event ( 2, "search_end",      "multi_literal_searcher", 20, 3, 3 );
+
+        events.clear ();
+        const ba::rabin_karp_set rks ( patterns );
+        found.clear ();
+        rks ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+        BOOST_REQUIRE_EQUAL ( events.size (), 3U );
+        check_event ( 0, "searcher_create", "rabin_karp_set", 3 );
+        check_event ( 2, "search_end",      "rabin_karp_set", 20, 3, 3 );
+
+        const std::string grid =
+            "abab"
+            "cdcd";
+        const std::string block = "ab";
+        events.clear ();
+        ba::baker_bird_searcher<char> bb ( ba::strided_view<char> ( block.data (), 2, 1 ));
+        std::vector<std::pair<std::size_t, std::size_t> > at;
+        bb ( ba::strided_view<char> ( grid.data (), 4, 2 ), std::back_inserter ( at ));
+    //  Its knuth_morris_pratt over the pattern's rows is built first
+        BOOST_REQUIRE_EQUAL ( events.size (), 4U );
+        check_event ( 0, "searcher_create", "knuth_morris_pratt", 1 );
+        check_event ( 1, "searcher_create", "baker_bird_searcher", 2 );
+        check_event ( 2, "search_begin",    "baker_bird_searcher", 8, 2 );
+        check_event ( 3, "search_end",      "baker_bird_searcher", 8, 2, 2 );
+        }
+
+//  A query of an index is a search of the whole corpus
+    void test_indexes () {
+        typedef std::string::const_iterator iter;
+        const std::string corpus = "banana bandana";
+        const std::string ana = "ana";
+        const std::string cat = "cat";
+
+        events.clear ();
+        const ba::suffix_array<iter> sa ( corpus.begin (), corpus.end ());
+        BOOST_CHECK ( sa ( ana.begin (), ana.end ()) == corpus.begin () + 1 );
+        BOOST_CHECK_EQUAL ( sa.count ( ana.begin (), ana.end ()), 3U );
+        BOOST_REQUIRE_EQUAL ( events.size (), 5U );
+        check_event ( 0, "searcher_create", "suffix_array", 14 );
+        check_event ( 2, "search_end",      "suffix_array", 14, 3, 1 );
+        check_event ( 4, "search_end",      "suffix_array", 14, 3, 3 );
+
+        events.clear ();
+        const ba::fm_index<> fm ( corpus.begin (), corpus.end ());
+        BOOST_CHECK_EQUAL ( fm ( ana.begin (), ana.end ()), 1U );
+        BOOST_CHECK_EQUAL ( fm ( cat.begin (), cat.end ()), corpus.size ());
+        std::vector<std::size_t> at;
+        fm.locate ( ana.begin (), ana.end (), std::back_inserter ( at ));
+        BOOST_REQUIRE_EQUAL ( events.size (), 7U );
+        check_event ( 0, "searcher_create", "fm_index", 14 );
+        check_event ( 1, "search_begin",    "fm_index", 14, 3 );
+        check_event ( 2, "search_end",      "fm_index", 14, 3, 1 );
+        check_event ( 4, "search_end",      "fm_index", 14, 3, -1 );
+        check_event ( 6, "search_end",      "fm_index", 14, 3, 3 );
+        }
+
+    void test_hex () {
+        events.clear ();
+        const std::string in = "abc";
+        std::string out = ba::hex ( in );
+        BOOST_CHECK_EQUAL ( out, "616263" );
+        BOOST_REQUIRE_EQUAL ( events.size (), 2U );
+        check_event ( 0, "hex_encode_begin", "", -99 );
+        check_event ( 1, "hex_encode_end",   "", 3 );
+
+        events.clear ();
+        BOOST_CHECK_EQUAL ( ba::unhex ( out ), in );
+        ba::hex ( "ab", std::back_inserter ( out ));
+        BOOST_REQUIRE_EQUAL ( events.size (), 4U );
+        check_event ( 0, "hex_decode_begin", "", -99 );
+        check_event ( 1, "hex_decode_end",   "", 3 );
+        check_event ( 3, "hex_encode_end",   "", 2 );
+
+    //  A decode that fails still ends, with -1
+        events.clear ();
+        try { ba::unhex ( std::string ( "6Z" )); }
+        catch ( const ba::hex_decode_error & ) {}
+        BOOST_REQUIRE_EQUAL ( events.size (), 2U );
+        check_event ( 0, "hex_decode_begin", "", -99 );
+        check_event ( 1, "hex_decode_end",   "", -1 );
+
+        events.clear ();
+        std::string decoded;
+        try { ba::unhex ( "41424", std::back_inserter ( decoded )); }
+        catch ( const ba::hex_decode_error & ) {}
+        BOOST_REQUIRE_EQUAL ( events.size (), 2U );
+        check_event ( 1, "hex_decode_end",   "", -1 );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    typedef std::string::const_iterator iter;
+    check_searcher<ba::boyer_moore<iter> >          ( "boyer_moore" );
+    check_searcher<ba::boyer_moore_horspool<iter> > ( "boyer_moore_horspool" );
+    check_searcher<ba::knuth_morris_pratt<iter> >   ( "knuth_morris_pratt" );
+    check_searcher<ba::tuned_boyer_moore<iter> >    ( "tuned_boyer_moore" );
+    check_searcher<ba::qgram_horspool<iter> >       ( "qgram_horspool" );
+    check_searcher<ba::rabin_karp<iter> >           ( "rabin_karp" );
+    test_packed_dna ();
+    test_utf8 ();
+    test_multi_pattern ();
+    test_indexes ();
+    test_hex ();
+    return 0;
+}
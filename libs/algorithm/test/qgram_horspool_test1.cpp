@@ -0,0 +1,106 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/qgram_horspool.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <std::size_t Q>
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+
+        iter_type hBeg = haystack.begin ();
+        iter_type hEnd = haystack.end ();
+
+        ba::qgram_horspool<iter_type, Q> qh ( needle.begin (), needle.end ());
+        iter_type expected = std::search ( hBeg, hEnd, needle.begin (), needle.end ());
+        iter_type found    = qh ( hBeg, hEnd );
+        if ( found != expected ) {
+            std::cout << "Q = " << Q << "; searching for '" << needle << "'" << std::endl;
+            std::cout << "  in '" << haystack << "'" << std::endl;
+            std::cout << "  expected " << std::distance ( hBeg, expected )
+                      << "; got " << std::distance ( hBeg, found ) << std::endl;
+            }
+        BOOST_CHECK ( found == expected );
+        }
+
+    void check ( const std::string &haystack, const std::string &needle ) {
+        check_one<2> ( haystack, needle );
+        check_one<3> ( haystack, needle );
+        check_one<4> ( haystack, needle );
+        }
+
+//  Random strings over the first 'alphabet' letters of "ACGT"
+    std::string random_dna ( std::size_t len, int alphabet ) {
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += "ACGT" [ std::rand () % alphabet ];
+        return retVal;
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    const std::string dna ( "GATACACCTACCTTCACCAGTTACTCTATGCACTAGGTGCGCCAGGCCCATGCACAAGGG" );
+
+    check ( dna, "GATA" );          // At the beginning
+    check ( dna, "CAAGGG" );        // At the end
+    check ( dna, "CCAGGCC" );       // In the middle
+    check ( dna, "CCAGGCA" );       // Not there
+    check ( dna, dna );             // Find something in itself
+    check ( dna, dna + "A" );       // Longer than the corpus
+    check ( dna, "" );              // Empty pattern
+    check ( "",  "ACGT" );          // Empty corpus
+    check ( dna, "C" );             // Shorter than all of the q-grams
+    check ( dna, "GC" );
+    check ( dna, "TGC" );
+    check ( "AAAAAAAAAAAAAAAAAAAAB", "AAAB" );  // Lots of partial matches
+
+//  Bytes with the high bit set hash the same as any others
+    check ( "abc\xe0\xe1\xe2" "def", "\xe1\xe2" "d" );
+
+//  Random tests on small alphabets, where the q-grams matter most
+    std::srand ( 1 );
+    for ( int i = 0; i < 2000; ++i ) {
+        const int alphabet = 1 + std::rand () % 4;
+        std::string haystack = random_dna ( std::rand () % 300, alphabet );
+        std::string needle   = random_dna ( 1 + std::rand () % 20, alphabet );
+    //  Plant the pattern some of the time
+        if ( i % 3 == 0 && haystack.size () > needle.size ()) {
+            std::size_t pos = std::rand () % ( haystack.size () - needle.size () + 1 );
+            haystack.replace ( pos, needle.size (), needle );
+            }
+        check ( haystack, needle );
+        }
+
+//  The procedural and range interfaces
+    const std::string pat ( "CACTAGG" );
+    BOOST_CHECK ( ba::qgram_horspool_search ( dna.begin (), dna.end (), pat.begin (), pat.end ())
+                    == dna.begin () + dna.find ( pat ));
+    BOOST_CHECK ( ba::make_qgram_horspool ( pat ) ( dna ) == dna.begin () + dna.find ( pat ));
+
+//  Pointers and unsigned values
+    std::vector<unsigned char> bytes ( 1000, 0 );
+    bytes [ 500 ] = 1; bytes [ 503 ] = 1;
+    const unsigned char bpat [] = { 1, 0, 0, 1 };
+    ba::qgram_horspool<const unsigned char *> bqh ( bpat, bpat + sizeof ( bpat ));
+    BOOST_CHECK ( bqh ( &bytes[0], &bytes[0] + bytes.size ()) == &bytes[0] + 500 );
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/rabin_karp.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  Three bytes, two of them with the high bit set, so that a hash that
+//  rolled signed chars in and out would disagree with itself
+    std::string random_bytes ( std::size_t len ) {
+        static const char bytes [] = { 'a', '\x80', '\xff' };
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += bytes [ std::rand () % 3 ];
+        return retVal;
+        }
+
+//  Hex digits, like a content hash
+    std::string random_hex ( std::size_t len ) {
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += "0123456789abcdef" [ std::rand () % 16 ];
+        return retVal;
+        }
+
+//  Every match of every pattern, the slow way
+    std::vector<ba::literal_match> brute_force ( const std::vector<std::string> &patterns, const std::string &corpus ) {
+        std::vector<ba::literal_match> retVal;
+        for ( std::size_t pos = 0; pos < corpus.size (); ++pos )
+            for ( std::size_t id = 0; id < patterns.size (); ++id )
+                if ( !patterns [ id ].empty () && corpus.compare ( pos, patterns [ id ].size (), patterns [ id ] ) == 0 )
+                    retVal.push_back ( ba::literal_match ( id, pos ));
+        return retVal;
+        }
+
+    void test_single () {
+        for ( int i = 0; i < 2000; ++i ) {
+            const std::string corpus = random_bytes ( std::rand () % 60 );
+            const std::string pat    = random_bytes ( std::rand () % 6 );
+            const std::string::const_iterator expected = std::search ( corpus.begin (), corpus.end (), pat.begin (), pat.end ());
+            BOOST_CHECK ( ba::rabin_karp_search ( corpus.begin (), corpus.end (), pat.begin (), pat.end ())
+                          == ( pat.empty () && corpus.empty () ? corpus.end () : expected ));
+            }
+
+        const std::string corpus = "the quick brown fox";
+        const std::string pat = "brown";
+        ba::rabin_karp<std::string::const_iterator> rk ( pat.begin (), pat.end ());
+        BOOST_CHECK ( rk.pattern_length () == 5 );
+        BOOST_CHECK ( rk ( corpus ) - corpus.begin () == 10 );
+        BOOST_CHECK ( ba::make_rabin_karp ( pat ) ( corpus ) - corpus.begin () == 10 );
+        BOOST_CHECK ( rk ( corpus.begin (), corpus.begin () + 14 ) == corpus.begin () + 14 );
+        }
+
+    void check_set ( const std::vector<std::string> &patterns, const std::string &corpus ) {
+        const ba::rabin_karp_set rs ( patterns );
+        std::vector<ba::literal_match> found;
+        rs ( corpus, std::back_inserter ( found ));
+        const std::vector<ba::literal_match> expected = brute_force ( patterns, corpus );
+        BOOST_CHECK ( found == expected );
+
+        const std::pair<std::string::const_iterator, std::size_t> first = rs.find_first ( corpus.begin (), corpus.end ());
+        if ( expected.empty ()) {
+            BOOST_CHECK ( first.first == corpus.end () && first.second == rs.size ());
+            BOOST_CHECK ( rs ( corpus.begin (), corpus.end ()) == corpus.end ());
+            }
+        else {
+            BOOST_CHECK ( static_cast<std::size_t> ( first.first - corpus.begin ()) == expected [ 0 ].position );
+            BOOST_CHECK ( first.second == expected [ 0 ].pattern );
+            BOOST_CHECK ( static_cast<std::size_t> ( rs ( corpus ) - corpus.begin ()) == expected [ 0 ].position );
+            }
+        }
+
+    void test_set () {
+        std::vector<std::string> patterns;
+        patterns.push_back ( "abc" );
+        patterns.push_back ( "bca" );
+        patterns.push_back ( "abc" );   // duplicates are reported under both ids
+        patterns.push_back ( "zzz" );
+        check_set ( patterns, "abcabcab" );
+        check_set ( patterns, "" );
+        check_set ( patterns, "ab" );
+
+    //  Bytes with the high bit set hash the same in the patterns and the corpus
+        std::vector<std::string> high ( 1, "\xff\x80" );
+        check_set ( high, "a\xff\x80\xff\x80" );
+
+        const ba::rabin_karp_set rs ( patterns.begin (), patterns.end ());
+        BOOST_CHECK ( rs.size () == 4 && rs.pattern_length () == 3 );
+        BOOST_CHECK ( rs.memory_use () > 0 );
+
+        check_set ( std::vector<std::string> (), "abc" );
+        check_set ( std::vector<std::string> ( 3, std::string ()), "abc" );
+
+        patterns.push_back ( "abcd" );
+        BOOST_CHECK_THROW ( ba::rabin_karp_set rs2 ( patterns ), std::invalid_argument );
+
+        for ( int i = 0; i < 200; ++i ) {
+            const std::size_t len = 1 + std::rand () % 6;
+            std::vector<std::string> pats ( 1 + std::rand () % 30 );
+            for ( std::size_t j = 0; j < pats.size (); ++j )
+                pats [ j ] = random_bytes ( len );
+            check_set ( pats, random_bytes ( std::rand () % 200 ));
+            }
+        }
+
+//  Lots of long patterns, like content hashes
+    void test_many () {
+        std::vector<std::string> patterns;
+        for ( int i = 0; i < 20000; ++i )
+            patterns.push_back ( random_hex ( 32 ));
+        std::string corpus = random_hex ( 100000 );
+        corpus.replace ( 500, 32, patterns [ 12345 ] );
+        corpus.replace ( 99968, 32, patterns [ 7 ] );
+        check_set ( patterns, corpus );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    std::srand ( 5 );
+    test_single ();
+    test_set ();
+    test_many ();
+    return 0;
+}
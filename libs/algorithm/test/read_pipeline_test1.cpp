@@ -0,0 +1,156 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/read_pipeline.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef ba::boyer_moore_horspool<std::string::const_iterator> searcher_type;
+    typedef std::back_insert_iterator<std::vector<boost::uintmax_t> > offset_inserter;
+
+//  Gathers the chunks back into one string
+    struct gather {
+        gather ( std::string &s ) : str ( &s ) {}
+        void operator () ( const char *first, const char *last, boost::uintmax_t offset ) {
+            BOOST_CHECK_EQUAL ( offset, str->size ());
+            str->append ( first, last );
+            }
+        std::string *str;
+        };
+
+    std::vector<boost::uintmax_t> all_matches ( const std::string &corpus, const std::string &pat ) {
+        std::vector<boost::uintmax_t> retVal;
+        for ( std::string::size_type pos = corpus.find ( pat ); pos != std::string::npos; pos = corpus.find ( pat, pos + 1 ))
+            retVal.push_back ( pos );
+        return retVal;
+        }
+
+    std::string write_temp_file ( const std::string &contents ) {
+        char name [] = "/tmp/read_pipeline_test-XXXXXX";
+        const int fd = mkstemp ( name );
+        BOOST_REQUIRE ( fd >= 0 );
+        BOOST_REQUIRE ( ::write ( fd, contents.data (), contents.size ()) == (ssize_t) contents.size ());
+        ::close ( fd );
+        return name;
+        }
+
+    void check_file ( ba::read_pipeline &pipeline, const std::string &path, const std::string &contents ) {
+        std::string seen;
+        pipeline ( path, gather ( seen ));
+        BOOST_CHECK ( seen == contents );
+        BOOST_CHECK_EQUAL ( pipeline.stats ().bytes, contents.size ());
+
+        const std::string pats [] = { "abc", "aa", "a", "needle in a haystack", "abcdabcdabcdabcdabcdabcdabcd" };
+        for ( std::size_t i = 0; i < sizeof ( pats ) / sizeof ( pats [0] ); ++i ) {
+            const searcher_type s ( pats [i].begin (), pats [i].end ());
+            std::vector<boost::uintmax_t> found;
+            pipeline ( path, ba::stream_matcher<searcher_type, offset_inserter> ( s, std::back_inserter ( found )));
+            BOOST_CHECK ( found == all_matches ( contents, pats [i] ));
+            }
+        }
+
+    void test_pipeline ( ba::read_pipeline::backend_type backend ) {
+        std::srand ( 1 );
+        std::string contents;
+        for ( int i = 0; i < 100000; ++i )
+            contents += static_cast<char> ( 'a' + std::rand () % 4 );
+        for ( std::size_t pos = 0; pos < contents.size (); pos += 9973 )
+            contents.replace ( pos, 20, "needle in a haystack" );
+        const std::string path = write_temp_file ( contents );
+        const std::string empty_path = write_temp_file ( "" );
+
+    //  Chunks smaller and larger than the patterns, and different depths
+        const std::size_t sizes [] = { 1, 7, 4096, 1 << 20 };
+        for ( std::size_t i = 0; i < sizeof ( sizes ) / sizeof ( sizes [0] ); ++i ) {
+            for ( unsigned depth = 1; depth <= 8; depth *= 2 ) {
+                if ( sizes [i] == 1 && depth > 1 ) continue;     // slow, and nothing new
+                ba::read_pipeline pipeline ( sizes [i], depth, backend );
+                if ( backend == ba::read_pipeline::pread_backend )
+                    BOOST_CHECK ( pipeline.backend () == ba::read_pipeline::pread_backend );
+                check_file ( pipeline, path, contents );
+                check_file ( pipeline, empty_path, "" );
+                }
+            }
+
+    //  The stats add up
+        ba::read_pipeline pipeline ( 4096, 4, backend );
+        std::string seen;
+        pipeline ( path, gather ( seen ));
+        BOOST_CHECK_EQUAL ( pipeline.stats ().reads, ( contents.size () + 4095 ) / 4096 );
+        BOOST_CHECK ( pipeline.stats ().wait_seconds + pipeline.stats ().consume_seconds <= pipeline.stats ().total_seconds );
+
+    //  A file that isn't there
+        BOOST_CHECK_THROW ( pipeline ( std::string ( "/no/such/file" ), gather ( seen )), ba::read_error );
+
+    //  No buffers, or no reads in flight
+        BOOST_CHECK_THROW ( ba::read_pipeline ( 0, 4, backend ), std::invalid_argument );
+        BOOST_CHECK_THROW ( ba::read_pipeline ( 4096, 0, backend ), std::invalid_argument );
+
+        std::remove ( path.c_str ());
+        std::remove ( empty_path.c_str ());
+        }
+
+#ifdef BOOST_ALGORITHM_HAS_IO_URING
+//  A ring that says it is ok can really read; one that needs an operation
+//  the kernel doesn't have is not ok, and the pipeline doesn't use it
+    void test_uring_probe () {
+        const ba::detail::uring missing ( 4, 255 );     // no kernel has operation 255
+        BOOST_CHECK ( !missing.ok ());
+
+        const std::string contents ( "needle in a haystack" );
+        const std::string path = write_temp_file ( contents );
+        ba::detail::uring ring ( 4 );
+        const ba::read_pipeline pipeline ( 4096, 4 );
+        BOOST_CHECK (( pipeline.backend () == ba::read_pipeline::uring_backend ) == ring.ok ());
+        if ( ring.ok ()) {
+            const int fd = ::open ( path.c_str (), O_RDONLY );
+            BOOST_REQUIRE ( fd >= 0 );
+            char buf [ 64 ];
+            boost::uint64_t tag = 0;
+            int result = 0;
+            ring.read ( fd, buf, sizeof ( buf ), 0, 17 );
+            BOOST_CHECK ( ring.wait ( tag, result ));
+            BOOST_CHECK_EQUAL ( tag, 17U );
+            BOOST_CHECK_EQUAL ( result, static_cast<int> ( contents.size ()));
+            BOOST_CHECK ( std::string ( buf, buf + contents.size ()) == contents );
+            ::close ( fd );
+            }
+        else
+            std::cout << "io_uring reads aren't available; the pipeline uses pread" << std::endl;
+        std::remove ( path.c_str ());
+        }
+#endif
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_pipeline ( ba::read_pipeline::automatic_backend );
+    test_pipeline ( ba::read_pipeline::pread_backend );
+#ifdef BOOST_ALGORITHM_HAS_IO_URING
+    test_uring_probe ();
+#endif
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/replace.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The obvious way, with std::search and a string that grows as it goes
+    std::string naive_replace ( const std::string &corpus, const std::string &pat, const std::string &repl ) {
+        if ( pat.empty ()) return corpus;
+        std::string retVal;
+        std::string::const_iterator first = corpus.begin ();
+        for ( ;; ) {
+            std::string::const_iterator it = std::search ( first, corpus.end (), pat.begin (), pat.end ());
+            retVal.append ( first, it );
+            if ( it == corpus.end ())
+                break;
+            retVal += repl;
+            first = it + pat.size ();
+            }
+        return retVal;
+        }
+
+    template <typename Searcher>
+    void check_one ( const std::string &corpus, const std::string &pat, const std::string &repl ) {
+        const Searcher s ( pat.begin (), pat.end ());
+        const std::string expected = naive_replace ( corpus, pat, repl );
+        BOOST_CHECK_EQUAL ( s.pattern_length (), pat.size ());
+
+        std::string out;
+        ba::replace_all ( corpus, s, repl, std::back_inserter ( out ));
+        BOOST_CHECK_EQUAL ( out, expected );
+        BOOST_CHECK_EQUAL ( ba::replace_all_copy ( corpus, s, repl ), expected );
+
+        std::vector<char> v ( corpus.begin (), corpus.end ());
+        const std::vector<char> vr = ba::replace_all_copy ( v, s, repl );
+        BOOST_CHECK ( std::string ( vr.begin (), vr.end ()) == expected );
+
+        if ( repl.size () <= pat.size ()) {
+            std::string in_place = corpus;
+            ba::replace_all_in_place ( in_place, s, repl );
+            BOOST_CHECK_EQUAL ( in_place, expected );
+            }
+        else {
+            std::string in_place = corpus;
+            BOOST_CHECK_THROW ( ba::replace_all_in_place ( in_place, s, repl ), std::invalid_argument );
+            }
+
+    //  The same thing, a chunk at a time
+        const std::size_t chunk_sizes [] = { 1, 2, 3, 7, 64 };
+        for ( std::size_t i = 0; i < sizeof ( chunk_sizes ) / sizeof ( chunk_sizes [0] ); ++i ) {
+            std::string streamed;
+            ba::stream_replacer<Searcher, std::back_insert_iterator<std::string> >
+                sr ( s, repl, std::back_inserter ( streamed ));
+            for ( std::size_t pos = 0; pos < corpus.size (); pos += chunk_sizes [i] ) {
+            //  Each chunk is a separate string, that goes away after it is processed
+                const std::string chunk = corpus.substr ( pos, chunk_sizes [i] );
+                sr ( chunk );
+                }
+            sr.finish ();
+            BOOST_CHECK_EQUAL ( streamed, expected );
+            }
+        }
+
+    void check_all ( const std::string &corpus, const std::string &pat, const std::string &repl ) {
+        typedef std::string::const_iterator iter;
+        check_one<ba::boyer_moore<iter> >            ( corpus, pat, repl );
+        check_one<ba::boyer_moore_horspool<iter> >   ( corpus, pat, repl );
+        check_one<ba::knuth_morris_pratt<iter> >     ( corpus, pat, repl );
+        }
+
+    void test_simple () {
+        check_all ( "", "abc", "xyz" );
+        check_all ( "abc", "", "xyz" );
+        check_all ( "abc", "abc", "" );
+        check_all ( "abcabcabc", "abc", "X" );
+        check_all ( "abcabcabc", "abc", "XYZW" );
+        check_all ( "aaaaa", "aa", "b" );           // non-overlapping: "bba"
+        check_all ( "aaaaa", "aa", "aaa" );         // the replacement is not searched again
+        check_all ( "the cat sat on the mat", "at", "og" );
+        check_all ( "the cat sat on the mat", "the", "a" );
+        check_all ( "no matches here", "xyz", "abc" );
+
+        typedef std::string::const_iterator iter;
+        const std::string pat ( "aa" );
+        const ba::boyer_moore<iter> bm ( pat.begin (), pat.end ());
+        BOOST_CHECK_EQUAL ( ba::count_matches ( std::string ( "aaaaa" ), bm ), 2U );
+
+        std::string s ( "xaaxaax" );
+        std::string::iterator new_end = ba::replace_all_in_place ( s.begin (), s.end (), bm, pat.begin (), pat.begin () + 1 );
+        BOOST_CHECK_EQUAL ( std::string ( s.begin (), new_end ), "xaxax" );
+        }
+
+    void test_random () {
+        std::srand ( 1 );
+        for ( int i = 0; i < 500; ++i ) {
+        //  A small alphabet, so that there are plenty of matches
+            std::string corpus, pat, repl;
+            const int len = std::rand () % 200;
+            for ( int j = 0; j < len; ++j )
+                corpus += static_cast<char> ( 'a' + std::rand () % 3 );
+            const int plen = 1 + std::rand () % 6;
+            for ( int j = 0; j < plen; ++j )
+                pat += static_cast<char> ( 'a' + std::rand () % 3 );
+            const int rlen = std::rand () % 8;
+            for ( int j = 0; j < rlen; ++j )
+                repl += static_cast<char> ( 'A' + std::rand () % 3 );
+            check_all ( corpus, pat, repl );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_simple ();
+    test_random ();
+    return 0;
+}
@@ -0,0 +1,506 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <cstddef>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/tr1/tr1/unordered_map>  // the skip tables' hash map, for std::tr1::hash
+
+/*
+    Counting comparisons.
+
+    The searchers are run on inputs built to be hard for them, over an element
+    type whose operator == and operator != count how often they are called.
+    Each searcher's count must be within its bound; a change that makes a
+    searcher slower on some input fails here, whatever the machine and
+    however noisy its timing.
+
+    Let n be the length of the corpus, and m the length of the pattern.
+
+        knuth_morris_pratt      building: at most 2m comparisons
+                                searching: at most 2n
+        boyer_moore             building: at most 6m (two prefix tables, each
+                                    at most 3m the way they are computed here)
+                                searching: at most 3n (Cole's bound)
+        rabin_karp              searching: m for each place where the hash
+                                    matches; with no collisions, at most m
+                                    for each match, and m for the result.
+
+    The Horspool searchers have no bound that holds for every input (it is
+    m (n - m + 1) in the worst case), so each input below comes with what
+    boyer_moore_horspool, tuned_boyer_moore and qgram_horspool do on it,
+    worked out from how far they shift and where they compare:
+
+        boyer_moore_horspool    compares from the end of the pattern, at
+                                    every place that it stops
+        tuned_boyer_moore       compares (from the start) only where the last
+                                    element of the pattern matches
+        qgram_horspool          reads Q elements at every place that it stops,
+                                    and compares where the last Q match
+
+    qgram_horspool only searches bytes, so for it the corpus elements read
+    are counted, through the iterator, instead of the comparisons. So are the
+    words that packed_dna_searcher reads, for the DNA inputs at the end,
+    through a sequence that counts its windows.
+
+    The skip tables of the Boyer-Moore family look up corpus elements in a
+    hash map for a type like this one; those lookups don't count, since they
+    aren't comparisons of the pattern with the corpus.
+*/
+
+namespace {
+    std::size_t comparisons = 0;
+
+    struct counted {
+        char c;
+        };
+
+    bool operator == ( counted a, counted b ) { ++comparisons; return a.c == b.c; }
+    bool operator != ( counted a, counted b ) { ++comparisons; return a.c != b.c; }
+
+    std::size_t hash_value ( counted a ) { return static_cast<unsigned char> ( a.c ); }
+
+    struct uncounted_equal {
+        bool operator () ( counted a, counted b ) const { return a.c == b.c; }
+        };
+    }
+
+//  The skip tables' hash maps compare keys without counting
+namespace std {
+    template <> struct equal_to<counted> : public uncounted_equal {};
+#if !defined ( BOOST_NO_CXX11_HDR_FUNCTIONAL )
+    template <> struct hash<counted> {
+        std::size_t operator () ( counted a ) const { return hash_value ( a ); }
+        };
+#endif
+//  The skip tables use std::tr1::unordered_map; not every TR1 finds hash_value
+    namespace tr1 {
+        template <> struct hash<counted> {
+            std::size_t operator () ( counted a ) const { return hash_value ( a ); }
+            };
+        }
+    }
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/tuned_boyer_moore.hpp>
+#include <boost/algorithm/searching/rabin_karp.hpp>
+#include <boost/algorithm/searching/qgram_horspool.hpp>
+#include <boost/algorithm/searching/packed_dna.hpp>
+
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+namespace ba = boost::algorithm;
+
+namespace {
+    typedef std::vector<counted> vec;
+    typedef vec::const_iterator iter;
+
+    const std::size_t Q = 2;        // qgram_horspool's default q-gram length
+
+//  A corpus iterator that counts the elements read through it
+    std::size_t reads = 0;
+
+    class counting_reader : public boost::iterator_adaptor<counting_reader, const char *> {
+    public:
+        counting_reader () {}
+        explicit counting_reader ( const char *p ) : counting_reader::iterator_adaptor_ ( p ) {}
+
+    private:
+        friend class boost::iterator_core_access;
+        const char &dereference () const { ++reads; return *this->base (); }
+        };
+
+//  A packed sequence that counts the words read from it
+    std::size_t windows = 0;
+
+    struct counting_sequence {
+        explicit counting_sequence ( const ba::packed_dna_sequence &seq ) : seq_ ( seq ) {}
+        ba::packed_dna_sequence::word_type window ( std::size_t pos ) const { ++windows; return seq_.window ( pos ); }
+        const ba::packed_dna_sequence &seq_;
+        };
+
+    vec make ( const std::string &s ) {
+        vec retVal ( s.size ());
+        for ( std::size_t i = 0; i < s.size (); ++i )
+            retVal [ i ].c = s [ i ];
+        return retVal;
+        }
+
+    std::string repeat ( const std::string &s, std::size_t count ) {
+        std::string retVal;
+        for ( std::size_t i = 0; i < count; ++i )
+            retVal += s;
+        return retVal;
+        }
+
+//  The de Bruijn sequence B(k, order) over 'a', 'b', ...: every string of
+//  length 'order' occurs in it exactly once (cyclically). From the
+//  'Lyndon words' construction.
+    void de_bruijn ( std::size_t k, std::size_t order, std::size_t t, std::size_t p,
+                     std::vector<std::size_t> &a, std::string &out ) {
+        if ( t > order ) {
+            if ( order % p == 0 )
+                for ( std::size_t i = 1; i <= p; ++i )
+                    out += static_cast<char> ( 'a' + a [ i ] );
+            }
+        else {
+            a [ t ] = a [ t - p ];
+            de_bruijn ( k, order, t + 1, p, a, out );
+            for ( std::size_t j = a [ t - p ] + 1; j < k; ++j ) {
+                a [ t ] = j;
+                de_bruijn ( k, order, t + 1, t, a, out );
+                }
+            }
+        }
+
+    std::string de_bruijn ( std::size_t k, std::size_t order ) {
+        std::vector<std::size_t> a ( k * order + 1, 0 );
+        std::string retVal;
+        de_bruijn ( k, order, 1, 1, a, retVal );
+        return retVal;
+        }
+
+    struct bounds {
+        const char *name;
+        std::size_t build;      // comparisons allowed to build the searcher
+        std::size_t search;     // and to search
+        };
+
+    template <typename Searcher>
+    void check_one ( const bounds &b, const char *input, const vec &corpus, const vec &pattern ) {
+        const iter expected = std::search ( corpus.begin (), corpus.end (), pattern.begin (), pattern.end ());
+
+        comparisons = 0;
+        Searcher s ( pattern.begin (), pattern.end ());
+        const std::size_t built = comparisons;
+
+        comparisons = 0;
+        const iter res = s ( corpus.begin (), corpus.end ());
+        const std::size_t searched = comparisons;
+
+        std::cout << std::setw ( 22 ) << b.name << std::setw ( 26 ) << input
+                  << "  n = " << std::setw ( 6 ) << corpus.size () << "  m = " << std::setw ( 4 ) << pattern.size ()
+                  << "  build " << std::setw ( 5 ) << built << "  search " << std::setw ( 8 ) << searched
+                  << " (at most " << b.search << ")" << std::endl;
+
+        BOOST_CHECK ( res == expected );
+        BOOST_CHECK_MESSAGE ( built <= b.build,
+            b.name << " on " << input << ": " << built << " comparisons to build (at most " << b.build << ")" );
+        BOOST_CHECK_MESSAGE ( searched <= b.search,
+            b.name << " on " << input << ": " << searched << " comparisons to search (at most " << b.search << ")" );
+        }
+
+//  What the Horspool searchers may do on one input
+    struct horspool_bounds {
+        std::size_t bmh;        // comparisons, for boyer_moore_horspool
+        std::size_t tbm;        // comparisons, for tuned_boyer_moore
+        std::size_t qgram;      // elements read, for qgram_horspool
+        };
+
+    void check_qgram ( std::size_t bound, const char *input, const std::string &c, const std::string &p ) {
+        const std::size_t expected = std::min ( c.find ( p ), c.size ());
+        const counting_reader first ( c.data ()), last ( c.data () + c.size ());
+        ba::qgram_horspool<const char *> s ( p.data (), p.data () + p.size ());
+        reads = 0;
+        const counting_reader res = s ( first, last );
+        const std::size_t searched = reads;
+
+        std::cout << std::setw ( 22 ) << "qgram_horspool" << std::setw ( 26 ) << input
+                  << "  n = " << std::setw ( 6 ) << c.size () << "  m = " << std::setw ( 4 ) << p.size ()
+                  << "  reads " << std::setw ( 8 ) << searched << " (at most " << bound << ")" << std::endl;
+
+        BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( res - first ), expected );
+        BOOST_CHECK_MESSAGE ( searched <= bound,
+            "qgram_horspool on " << input << ": " << searched << " elements read (at most " << bound << ")" );
+        }
+
+    void check_all ( const char *input, const std::string &c, const std::string &p, const horspool_bounds &h ) {
+        const vec corpus  = make ( c );
+        const vec pattern = make ( p );
+        const std::size_t n = c.size ();
+        const std::size_t m = p.size ();
+        const bool found = c.find ( p ) != std::string::npos;
+
+        const bounds kmp = { "knuth_morris_pratt",   2 * m, 2 * n };
+        const bounds bm  = { "boyer_moore",          6 * m, 3 * n };
+        const bounds bmh = { "boyer_moore_horspool", 0, h.bmh };
+        const bounds tbm = { "tuned_boyer_moore",    0, h.tbm };
+        const bounds rk  = { "rabin_karp",           0, found ? m : 0 };
+
+        check_one<ba::knuth_morris_pratt<iter> >   ( kmp, input, corpus, pattern );
+        check_one<ba::boyer_moore<iter> >          ( bm,  input, corpus, pattern );
+        check_one<ba::boyer_moore_horspool<iter> > ( bmh, input, corpus, pattern );
+        check_one<ba::tuned_boyer_moore<iter> >    ( tbm, input, corpus, pattern );
+        check_one<ba::rabin_karp<iter> >           ( rk,  input, corpus, pattern );
+        check_qgram ( h.qgram, input, c, p );
+        }
+
+    void test_unary () {
+        const std::size_t n = 10000;
+        const std::string a_n = std::string ( n, 'a' );
+        for ( std::size_t m = 2; m <= 256; m *= 4 ) {
+            const std::string a_m1 ( m - 1, 'a' );
+            const std::size_t places = n - m + 1;   // where the pattern can start in a^n
+
+        //  The only match is at the very end. Every other place costs BMH one
+        //  comparison, and a shift of one; tuned_boyer_moore and qgram_horspool
+        //  only compare at the match.
+            {
+                const horspool_bounds h = { n + 1, m - 1, Q * ( places + 1 ) + m };
+                check_all ( "a^n b / a^(m-1) b", a_n + "b", a_m1 + "b", h );
+            }
+        //  Every place matches all but the first element: BMH's worst case.
+        //  tuned_boyer_moore compares that element first, and so fails at once;
+        //  it then shifts by one, or (for "ba") by two. For "ba", qgram_horspool
+        //  never compares at all.
+            {
+                const horspool_bounds h = { m * places,
+                                            m == 2 ? ( places + 1 ) / 2 : places,
+                                            m <= Q ? Q * places : ( Q + 1 ) * places };
+                check_all ( "a^n / b a^(m-1)", a_n, "b" + a_m1, h );
+            }
+        //  Every place matches all but the last element, which is never in the corpus
+            {
+                const horspool_bounds h = { places, 0, Q * places };
+                check_all ( "a^n / a^(m-1) b", a_n, a_m1 + "b", h );
+            }
+        //  A mismatch in the middle: BMH compares the m - m/2 elements from the end,
+        //  tuned_boyer_moore the m/2 + 1 from the start (unless the 'b' is last,
+        //  and it never stops), and qgram_horspool stops everywhere if the last
+        //  Q elements are all 'a'.
+            {
+                const std::size_t half = m / 2;
+                const std::size_t tail = m - half - 1;
+                const horspool_bounds h = { ( m - half ) * places,
+                                            tail == 0 ? 0 : ( half + 1 ) * places,
+                                            tail < Q ? Q * places : ( Q + half + 1 ) * places };
+                check_all ( "a^n / a^(m/2) b a^(m/2-1)", a_n, std::string ( half, 'a' ) + "b" + std::string ( tail, 'a' ), h );
+            }
+            }
+        }
+
+//  The stops in one period of 'period'^n, searching it for 'period'^k z, of
+//  a searcher that shifts on the last 'g' elements under the pattern (1 for
+//  BMH, Q for qgram_horspool). The end of the pattern starts on the first
+//  element of a period, and the g elements that end at 'offset' shift it to
+//  the last place in the period where they end, again.
+    std::size_t period_stops ( const std::string &period, std::size_t g ) {
+        const std::size_t q = period.size ();
+        const std::string twice = period + period;  // the g elements ending at j start at q + j + 1 - g
+        std::size_t retVal = 0;
+        for ( std::size_t offset = 0; offset < q; ++retVal ) {
+            std::size_t last = offset;
+            for ( std::size_t j = offset + 1; j < q; ++j )
+                if ( twice.compare ( q + j + 1 - g, g, twice, q + offset + 1 - g, g ) == 0 )
+                    last = j;
+            offset += q - last;
+            }
+        return retVal;
+        }
+
+    void test_periodic () {
+        const std::size_t n = 10000;
+        const char *periods [] = { "ab", "aab", "abcabd" };
+        for ( std::size_t i = 0; i < sizeof ( periods ) / sizeof ( periods [ 0 ] ); ++i ) {
+            const std::string period = periods [ i ];
+            const std::size_t q = period.size ();
+            const std::string text = repeat ( period, n / q );
+            for ( std::size_t k = 2; k <= 32; k *= 4 ) {
+                const std::size_t m = q * k;
+                const std::size_t places = text.size () - m + 1;
+            //  The places where the pattern starts on a period boundary
+                const std::size_t in_phase = ( text.size () - m ) / q + 1;
+
+            //  Many partial matches, broken at the last element, which the corpus
+            //  doesn't have. The element (and q-gram) under the end of the pattern
+            //  is always the end of a period, which is one period earlier in the
+            //  pattern, so every shift is a whole period; at each stop BMH makes
+            //  one comparison, and tuned_boyer_moore none.
+                std::string p = repeat ( period, k );
+                p [ p.size () - 1 ] = 'z';
+                {
+                    const horspool_bounds h = { in_phase, 0, Q * in_phase };
+                    check_all ( "periodic / broken at end", text, p, h );
+                }
+            //  ... at the first element. The last element of each period only
+            //  occurs once in it, so the shift from there is a whole period, and
+            //  the searchers stay on the period boundaries: BMH compares all m
+            //  elements there, tuned_boyer_moore just the first, and qgram_horspool
+            //  reads Q + 1. Unless the only earlier copy of the last q-gram was
+            //  the one that the 'z' replaced: then qgram_horspool shifts m - Q + 1
+            //  after a mismatch, and takes at most q - 1 more steps of Q reads
+            //  to get back to a boundary.
+                p = repeat ( period, k );
+                p [ 0 ] = 'z';
+                {
+                    const std::size_t qgram = m >= q + Q + 1 ? ( Q + 1 ) * in_phase
+                        : (( text.size () - m ) / ( m - Q + 1 ) + 1 ) * ( Q + 1 + Q * ( q - 1 ));
+                    const horspool_bounds h = { m * in_phase, in_phase, qgram };
+                    check_all ( "periodic / broken at start", text, p, h );
+                }
+            //  Found at the end of the corpus, the only place with a 'z'. Until
+            //  then, BMH makes one comparison at each stop, and qgram_horspool
+            //  reads Q elements.
+                {
+                    const std::size_t periods = ( places - 1 ) / q + 1;
+                    const horspool_bounds h = { period_stops ( period, 1 ) * periods + m, m,
+                                                Q * period_stops ( period, Q ) * periods + m + 1 };
+                    check_all ( "periodic + z / period^k z", text + "z", repeat ( period, k ) + "z", h );
+                }
+                }
+            }
+        }
+
+//  In a de Bruijn sequence B(k, order), each string of j <= order elements
+//  occurs k^(order - j) times, and longer ones at most once. So however a
+//  searcher moves, the places where it can match j elements (for each j)
+//  are limited; this is the sum of those limits for j = 1 ... m.
+    std::size_t de_bruijn_partial_matches ( std::size_t k, std::size_t order, std::size_t m ) {
+        std::size_t retVal = 0;
+        std::size_t count = 1;
+        for ( std::size_t j = order; j >= 1; --j, count *= k )
+            if ( j <= m )
+                retVal += count;
+        return retVal + ( m > order ? m - order : 0 );
+        }
+
+    std::size_t power ( std::size_t k, std::size_t e ) {
+        std::size_t retVal = 1;
+        while ( e-- > 0 )
+            retVal *= k;
+        return retVal;
+        }
+
+    void test_de_bruijn () {
+    //  Every window of 'order' elements is different, so skip tables see everything.
+    //  A searcher compares one element more than it matches wherever it compares,
+    //  and for BMH that is everywhere it stops; tuned_boyer_moore only compares
+    //  where the last element matches (k^(order-1) places), qgram_horspool where
+    //  the last Q do (k^(order-Q) places).
+        const std::size_t ks [] = { 2, 4, 26 };
+        const std::size_t orders [] = { 12, 6, 3 };
+        for ( std::size_t i = 0; i < 3; ++i ) {
+            const std::size_t k = ks [ i ];
+            const std::size_t order = orders [ i ];
+            const std::string text = de_bruijn ( k, order );
+            for ( std::size_t m = 4; m <= 64; m *= 4 ) {
+                const std::size_t places = text.size () - m + 1;
+                const std::size_t partial = de_bruijn_partial_matches ( k, order, m );
+                const horspool_bounds h = { places + partial,
+                                            power ( k, order - 1 ) + partial,
+                                            Q * places + power ( k, order - Q ) + partial };
+            //  Found, near the end
+                const std::string found = text.substr ( text.size () - m - 3, m );
+                check_all ( "de Bruijn / found", text, found, h );
+            //  Not found: each window of it occurs, but not all together
+                std::string missing = found;
+                missing [ m / 2 ] = missing [ m / 2 ] == 'a' ? 'b' : 'a';
+                if ( text.find ( missing ) == std::string::npos )
+                    check_all ( "de Bruijn / not found", text, missing, h );
+                }
+            }
+        }
+
+//  packed_dna_searcher reads 32 bases at a time. Short patterns (under 12
+//  bases) are tried at every place, with one word, and the rest of the pattern
+//  only if that matches. Longer ones skip on 8-mers: one word at every place
+//  it stops, and then the pattern a word at a time, until one differs.
+    void check_packed_dna ( std::size_t bound, const char *input, const std::string &c, const std::string &p ) {
+        const std::size_t expected = std::min ( c.find ( p ), c.size ());
+        const ba::packed_dna_sequence corpus ( c );
+        const ba::packed_dna_searcher s ( p.begin (), p.end ());
+        windows = 0;
+        const std::size_t res = s.find_in ( counting_sequence ( corpus ), 0, corpus.size ());
+        const std::size_t searched = windows;
+
+        std::cout << std::setw ( 22 ) << "packed_dna_searcher" << std::setw ( 26 ) << input
+                  << "  n = " << std::setw ( 6 ) << c.size () << "  m = " << std::setw ( 4 ) << p.size ()
+                  << "  words " << std::setw ( 8 ) << searched << " (at most " << bound << ")" << std::endl;
+
+        BOOST_CHECK_EQUAL ( res, expected );
+        BOOST_CHECK ( s ( corpus ) == corpus.begin () + expected );
+        BOOST_CHECK_MESSAGE ( searched <= bound,
+            "packed_dna_searcher on " << input << ": " << searched << " words read (at most " << bound << ")" );
+        }
+
+    void test_packed_dna () {
+        const std::size_t n = 10000;
+        const std::string a_n ( n, 'A' );
+        const std::size_t lengths [] = { 8, 16, 48, 128 };
+        for ( std::size_t i = 0; i < sizeof ( lengths ) / sizeof ( lengths [ 0 ] ); ++i ) {
+            const std::size_t m = lengths [ i ];
+            const std::size_t places = n - m + 1;
+            const bool skips = m >= 12;
+            const std::string a_m1 ( m - 1, 'A' );
+
+        //  Every place matches all but the first base. With the 8-mer skips, the
+        //  last 8-mer is everywhere, so every place is checked: one word for the
+        //  8-mer, and one for the first 32 bases of the pattern.
+            check_packed_dna ( skips ? 2 * places : places, "A^n / C A^(m-1)", a_n, "C" + a_m1 );
+        //  The last 8-mer is nowhere, and a^8 shifts by one
+            check_packed_dna ( places, "A^n / A^(m-1) C", a_n, a_m1 + "C" );
+        //  With eight or more 'A's after the 'C', every place is checked, up to
+        //  the word with the 'C' in it. With fewer, the last A^8 of the pattern
+        //  is the one before the 'C', and the shift is from there.
+            const std::size_t half = m / 2;
+            const std::size_t tail = m - half - 1;
+            check_packed_dna ( !skips ? places : tail >= 8 ? ( 2 + half / 32 ) * places : ( places - 1 ) / ( m - half ) + 1,
+                               "A^n / A^(m/2) C A^(m/2-1)", a_n, std::string ( half, 'A' ) + "C" + std::string ( tail, 'A' ));
+            }
+
+    //  A de Bruijn sequence over the four bases: every 6-mer once, so each 8-mer
+    //  of the pattern is in at most one place, and the last one is the only place
+    //  where the whole pattern is read. Elsewhere, long patterns shift by m - 7.
+        std::string dna = de_bruijn ( 4, 6 );
+        for ( std::size_t i = 0; i < dna.size (); ++i )
+            dna [ i ] = "ACGT" [ dna [ i ] - 'a' ];
+        for ( std::size_t m = 4; m <= 64; m *= 4 ) {
+            const std::size_t places = dna.size () - m + 1;
+            const std::size_t words = ( m + 31 ) / 32;
+            const std::string found = dna.substr ( dna.size () - m - 3, m );
+            const std::size_t stops = m < 12 ? places : ( m - 7 ) + dna.size () / ( m - 7 ) + 1;
+            check_packed_dna ( stops + words, "de Bruijn / found", dna, found );
+            }
+        }
+
+    void test_step () {
+    //  KMP's step () is the same automaton, one element at a time
+        const std::string c = repeat ( "aab", 1000 ) + "aaab";
+        const vec corpus  = make ( c );
+        const vec pattern = make ( "aaab" );
+        ba::knuth_morris_pratt<iter> s ( pattern.begin (), pattern.end ());
+        comparisons = 0;
+        std::ptrdiff_t matched = 0;
+        std::size_t i = 0;
+        for ( ; i < corpus.size () && matched != 4; ++i )
+            matched = s.step ( matched, corpus [ i ] );
+        BOOST_CHECK_EQUAL ( i, c.size ());
+        BOOST_CHECK_MESSAGE ( comparisons <= 2 * c.size (),
+            "knuth_morris_pratt::step: " << comparisons << " comparisons (at most " << 2 * c.size () << ")" );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_unary ();
+    test_periodic ();
+    test_de_bruijn ();
+    test_packed_dna ();
+    test_step ();
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/search_each.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::vector<std::size_t> expected_results ( const std::vector<std::string> &corpora, const std::string &pat ) {
+        std::vector<std::size_t> retVal;
+        for ( std::size_t i = 0; i < corpora.size (); ++i )
+            retVal.push_back ( std::search ( corpora [i].begin (), corpora [i].end (), pat.begin (), pat.end ())
+                                - corpora [i].begin ());
+        return retVal;
+        }
+
+    template <typename Searcher>
+    void check_one ( const std::vector<std::string> &corpora, const std::string &pat ) {
+        const Searcher s ( pat.begin (), pat.end ());
+        const std::vector<std::size_t> expected = expected_results ( corpora, pat );
+
+    //  Strings take the fast path
+        std::vector<std::size_t> results;
+        ba::search_each ( s, corpora, std::back_inserter ( results ));
+        BOOST_CHECK ( results == expected );
+
+    //  So do ranges of pointers
+        std::vector<boost::iterator_range<const char *> > ranges;
+        for ( std::size_t i = 0; i < corpora.size (); ++i )
+            ranges.push_back ( boost::iterator_range<const char *> (
+                        corpora [i].data (), corpora [i].data () + corpora [i].size ()));
+        std::vector<std::size_t> results2 ( corpora.size ());
+        ba::boyer_moore<const char *> bm ( pat.data (), pat.data () + pat.size ());
+        ba::search_each ( bm, ranges.begin (), ranges.end (), results2.begin ());
+        BOOST_CHECK ( results2 == expected );
+
+    //  A batch split into parts gives the same results
+        for ( std::size_t parts = 1; parts <= 5; ++parts ) {
+            std::vector<std::size_t> results3 ( corpora.size (), 12345 );
+            for ( std::size_t part = 0; part < parts; ++part )
+                ba::search_each_part ( s, corpora.begin (), corpora.end (), results3.begin (), part, parts );
+            BOOST_CHECK ( results3 == expected );
+            }
+        }
+
+    void check_all ( const std::vector<std::string> &corpora, const std::string &pat ) {
+        typedef std::string::const_iterator iter;
+        check_one<ba::boyer_moore<iter> >            ( corpora, pat );
+        check_one<ba::boyer_moore_horspool<iter> >   ( corpora, pat );
+        check_one<ba::knuth_morris_pratt<iter> >     ( corpora, pat );
+
+    //  Deques aren't contiguous, so they all go to the searcher
+        std::vector<std::deque<char> > deques;
+        for ( std::size_t i = 0; i < corpora.size (); ++i )
+            deques.push_back ( std::deque<char> ( corpora [i].begin (), corpora [i].end ()));
+        BOOST_CHECK (( !ba::detail::search_each_fast_path<ba::knuth_morris_pratt<iter>, std::deque<char>::const_iterator>::value ));
+        const ba::knuth_morris_pratt<iter> kmp ( pat.begin (), pat.end ());
+        std::vector<std::size_t> results;
+        ba::search_each ( kmp, deques, std::back_inserter ( results ));
+        BOOST_CHECK ( results == expected_results ( corpora, pat ));
+        }
+
+    void test_simple () {
+        BOOST_CHECK (( ba::detail::has_pattern_range<ba::boyer_moore<const char *> >::value ));
+        BOOST_CHECK (( !ba::detail::has_pattern_range<int>::value ));
+
+        std::vector<std::string> corpora;
+        corpora.push_back ( "" );
+        corpora.push_back ( "a" );
+        corpora.push_back ( "abc" );
+        corpora.push_back ( "xxabcxx" );
+        corpora.push_back ( "the quick brown fox jumps over the lazy dog" );
+        corpora.push_back ( std::string ( 300, 'a' ) + "abc" );     // longer than a short corpus
+        corpora.push_back ( std::string ( 40, 'a' ) + "ab" + std::string ( 40, 'c' ) + "abc" );
+
+        check_all ( corpora, "" );
+        check_all ( corpora, "a" );
+        check_all ( corpora, "ab" );
+        check_all ( corpora, "abc" );
+        check_all ( corpora, "lazy dog" );
+        check_all ( corpora, "not there" );
+        }
+
+    void test_random () {
+        std::srand ( 1 );
+        for ( int i = 0; i < 200; ++i ) {
+            std::vector<std::string> corpora;
+            const int count = std::rand () % 50;
+            for ( int j = 0; j < count; ++j ) {
+                std::string corpus;
+                const int len = std::rand () % ( j % 10 == 0 ? 400 : 60 );
+                for ( int k = 0; k < len; ++k )
+                    corpus += static_cast<char> ( 'a' + std::rand () % 3 );
+                corpora.push_back ( corpus );
+                }
+            std::string pat;
+            const int plen = 1 + std::rand () % 8;
+            for ( int j = 0; j < plen; ++j )
+                pat += static_cast<char> ( 'a' + std::rand () % 3 );
+            check_all ( corpora, pat );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_simple ();
+    test_random ();
+    return 0;
+}
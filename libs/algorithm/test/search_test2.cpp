@@ -10,6 +10,13 @@
 #include <boost/algorithm/searching/boyer_moore.hpp>
 #include <boost/algorithm/searching/boyer_moore_horspool.hpp>
 #include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/tuned_boyer_moore.hpp>
+#include <boost/algorithm/searching/rabin_karp.hpp>
+#include <boost/algorithm/searching/qgram_horspool.hpp>
+
+#include <boost/algorithm/perf_counters.hpp>
+#define BOOST_ALGORITHM_COUNT_ALLOCATIONS
+#include <boost/algorithm/allocation_counter.hpp>
 
 #include <boost/test/included/test_exec_monitor.hpp>
 
@@ -21,8 +28,8 @@ typedef std::vector<char> vec;
 #define NUM_TRIES   100
 
 #define runOne(call, refDiff)   { \
-    std::clock_t bTime, eTime;                              \
-    bTime = std::clock ();                                  \
+    allocs.reset ();                                        \
+    counters.start ();                                      \
     for ( i = 0; i < NUM_TRIES; ++i ) {                     \
         res = boost::algorithm::call                        \
             ( haystack.begin (), haystack.end (),           \
@@ -35,12 +42,11 @@ typedef std::vector<char> vec;
                 ( "Unexpected result from " #call );        \
             }                                               \
         }                                                   \
-    eTime = std::clock ();                                  \
-    printRes ( #call, eTime - bTime, refDiff ); }
+    printRes ( #call, counters.stop (), allocs.allocations (), refDiff ); }
 
 #define runObject(obj, refDiff) { \
-    std::clock_t bTime, eTime;                              \
-    bTime = std::clock ();                                  \
+    allocs.reset ();                                        \
+    counters.start ();                                      \
     boost::algorithm::obj <vec::const_iterator>             \
                 s_o ( needle.begin (), needle.end ());      \
     for ( i = 0; i < NUM_TRIES; ++i ) {                     \
@@ -53,8 +59,7 @@ typedef std::vector<char> vec;
             ( "Unexpected result from " #obj " object" );   \
             }                                               \
         }                                                   \
-    eTime = std::clock ();                                  \
-    printRes ( #obj " object", eTime - bTime, refDiff ); }
+    printRes ( #obj " object", counters.stop (), allocs.allocations (), refDiff ); }
     
 
 
@@ -70,7 +75,8 @@ namespace {
         return retVal;
         }
     
-    void printRes ( const char *prompt, unsigned long diff, unsigned long stdDiff ) {
+    void printRes ( const char *prompt, const boost::algorithm::perf_sample &sample, std::size_t allocations, unsigned long stdDiff ) {
+        const unsigned long diff = sample.ticks;
         std::cout 
             << std::setw(34) << prompt << " "
             << std::setw(6)  << (  1.0 * diff) / CLOCKS_PER_SEC << " seconds\t"
@@ -78,12 +84,15 @@ namespace {
             << std::setw(12) << diff;
         if ( diff > stdDiff ) 
             std::cout << " !!";
-        std::cout << std::endl;
+        std::cout << std::endl << std::setw(35) << "" << "allocations " << allocations << "  ";
+        boost::algorithm::print_perf_sample ( std::cout, sample ) << std::endl;
         }
     
     void check_one ( const vec &haystack, const vec &needle, int expected ) {
         std::size_t i;
-        std::clock_t sTime;
+        boost::algorithm::perf_counters counters;
+        boost::algorithm::allocation_scope allocs;
+        boost::algorithm::perf_sample stdSample;
         unsigned long stdDiff;
         
         vec::const_iterator res;
@@ -102,7 +111,8 @@ namespace {
         std::cout << "Corpus  is " << haystack.size () << " entries long" << std::endl;
 
     //  First, the std library search
-        sTime = std::clock ();
+        allocs.reset ();
+        counters.start ();
         for ( i = 0; i < NUM_TRIES; ++i ) {
             res = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
             if ( res != exp ) {
@@ -110,8 +120,9 @@ namespace {
                 throw std::runtime_error ( "Unexpected result from std::search" );
                 }
             }
-        stdDiff = std::clock () - sTime;
-        printRes ( "std::search", stdDiff, stdDiff );
+        stdSample = counters.stop ();
+        stdDiff = stdSample.ticks;
+        printRes ( "std::search", stdSample, allocs.allocations (), stdDiff );
 
         runOne    ( boyer_moore_search,          stdDiff );
         runObject ( boyer_moore,                 stdDiff );
@@ -119,6 +130,12 @@ namespace {
         runObject ( boyer_moore_horspool,        stdDiff );
         runOne    ( knuth_morris_pratt_search,   stdDiff );
         runObject ( knuth_morris_pratt,          stdDiff );
+        runOne    ( tuned_boyer_moore_search,    stdDiff );
+        runObject ( tuned_boyer_moore,           stdDiff );
+        runOne    ( rabin_karp_search,           stdDiff );
+        runObject ( rabin_karp,                  stdDiff );
+        runOne    ( qgram_horspool_search,       stdDiff );
+        runObject ( qgram_horspool,              stdDiff );
         }
     }
 
@@ -140,6 +157,16 @@ int test_main( int , char* [] )
     check_one ( c1, p1e, c1.size() - p1e.size ());  
     std::cout << "--- Not found ---" << std::endl;
     check_one ( c1, p1n, -1 );      //  Not found
+
+//  Mostly padding, and a record that ends in padding. At every position, BMH
+//  compares back through the padding before it finds the mismatch; tuned
+//  Boyer-Moore compares the first element of the pattern, and moves on.
+    vec padded ( c1.size () / 8, ' ' );     // BMH is slow enough here with an eighth
+    vec record ( p1e.begin (), p1e.begin () + 8 );
+    record.resize ( 64, ' ' );
+    std::copy ( record.begin (), record.end (), padded.end () - record.size ());
+    std::cout << "---- Padded -----" << std::endl;
+    check_one ( padded, record, padded.size () - record.size ());
     
     return 0;
     }
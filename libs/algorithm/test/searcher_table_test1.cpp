@@ -0,0 +1,160 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/searcher_table.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::string::const_iterator str_iter;
+
+//  The skip tables are saved for all 256 byte values; draw from both halves,
+//  so that a table indexed by a signed char would be caught
+    std::string random_bytes ( std::size_t len, int alphabet ) {
+        static const char bytes [] = { 'a', '\xff', 'b', '\x80' };
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += bytes [ std::rand () % alphabet ];
+        return retVal;
+        }
+
+//  Copy the saved bytes into 8-byte aligned memory, as a mapped file would be
+    std::vector<boost::uint64_t> load ( const std::string &bytes ) {
+        std::vector<boost::uint64_t> retVal ( bytes.size () / 8 + 1 );
+        std::memcpy ( &retVal [ 0 ], bytes.data (), bytes.size ());
+        return retVal;
+        }
+
+    std::string save ( const ba::searcher_table_builder &b ) {
+        std::ostringstream out;
+        b.write ( out );
+        return out.str ();
+        }
+
+    void test_search () {
+        std::srand ( 1 );
+        std::vector<std::string> patterns;
+        patterns.push_back ( "" );
+        patterns.push_back ( "a" );
+        patterns.push_back ( "\xff\x80\x01" );      // bytes with the high bit set
+        for ( int i = 0; i < 200; ++i )
+            patterns.push_back ( random_bytes ( 1 + std::rand () % 20, 1 + std::rand () % 4 ));
+
+        ba::searcher_table_builder builder;
+        for ( std::size_t i = 0; i < patterns.size (); ++i ) {
+            const std::string &p = patterns [ i ];
+            switch ( i % 3 ) {
+                case 0: BOOST_CHECK_EQUAL ( builder.add ( ba::boyer_moore<str_iter> ( p.begin (), p.end ())), i ); break;
+                case 1: BOOST_CHECK_EQUAL ( builder.add ( ba::boyer_moore_horspool<str_iter> ( p.begin (), p.end ())), i ); break;
+                case 2: BOOST_CHECK_EQUAL ( builder.add ( ba::knuth_morris_pratt<str_iter> ( p.begin (), p.end ())), i ); break;
+                }
+            }
+
+        const std::string bytes = save ( builder );
+        const std::vector<boost::uint64_t> mem = load ( bytes );
+        ba::searcher_table table ( &mem [ 0 ], bytes.size ());
+        BOOST_CHECK_EQUAL ( table.size (), patterns.size ());
+
+        for ( int c = 0; c < 50; ++c ) {
+            std::string corpus = random_bytes ( std::rand () % 300, 1 + std::rand () % 4 );
+            if ( c == 0 ) corpus += "xx\xff\x80\x01";
+            for ( std::size_t i = 0; i < patterns.size (); ++i ) {
+                const std::string &p = patterns [ i ];
+                const ba::compiled_searcher s = table [ i ];
+                BOOST_CHECK_EQUAL ( s.kind (), ( i % 3 ) + 1 );
+                BOOST_CHECK ( std::string ( s.pattern_begin (), s.pattern_end ()) == p );
+                const std::ptrdiff_t expected = std::search ( corpus.begin (), corpus.end (), p.begin (), p.end ()) - corpus.begin ();
+                BOOST_CHECK_EQUAL ( s ( corpus.begin (), corpus.end ()) - corpus.begin (), expected );
+                BOOST_CHECK_EQUAL ( s ( corpus ) - corpus.begin (), expected );
+                }
+            }
+        }
+
+    void test_format () {
+        const std::string pat ( "needle" );
+        ba::searcher_table_builder builder;
+        builder.add ( ba::boyer_moore<str_iter> ( pat.begin (), pat.end ()));
+        builder.add ( ba::knuth_morris_pratt<str_iter> ( pat.begin (), pat.end ()));
+        const std::string bytes = save ( builder );
+        BOOST_CHECK_EQUAL ( bytes.size () % 8, 0U );
+
+    //  Empty tables are fine
+        const std::string empty_bytes = save ( ba::searcher_table_builder ());
+        std::vector<boost::uint64_t> mem = load ( empty_bytes );
+        BOOST_CHECK_EQUAL ( ba::searcher_table ( &mem [ 0 ], empty_bytes.size ()).size (), 0U );
+
+    //  Too short
+        mem = load ( bytes );
+        BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], bytes.size () - 1 ), ba::index_format_error );
+        BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], 10 ), ba::index_format_error );
+
+    //  Not aligned
+        std::vector<boost::uint64_t> big ( bytes.size () / 8 + 2 );
+        char *odd = reinterpret_cast<char *> ( &big [ 0 ] ) + 4;
+        std::memcpy ( odd, bytes.data (), bytes.size ());
+        BOOST_CHECK_THROW ( ba::searcher_table ( odd, bytes.size ()), ba::index_format_error );
+
+    //  Damaged tables fail the checksum, unless it isn't checked
+        std::string damaged ( bytes );
+        damaged [ damaged.size () - 3 ] ^= 1;
+        mem = load ( damaged );
+        BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], damaged.size ()), ba::index_format_error );
+        BOOST_CHECK_EQUAL ( ba::searcher_table ( &mem [ 0 ], damaged.size (), false ).size (), 2U );
+
+    //  A different version, or a different byte order
+        std::string other ( bytes );
+        other [ 8 ] = 2;
+        mem = load ( other );
+        BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], other.size ()), ba::index_format_error );
+        other = bytes;
+        std::swap ( other [ 12 ], other [ 15 ] );
+        mem = load ( other );
+        BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], other.size ()), ba::index_format_error );
+
+    //  A searcher that runs off the end of the table
+        other = bytes;
+        other [ 40 + 16 + 4 ] = 100;    // the second searcher's pattern length
+        mem = load ( other );
+        BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], other.size (), false ), ba::index_format_error );
+
+    //  A header whose size doesn't even cover the header, or the directory
+        for ( boost::uint64_t sz = 0; sz < 40 + 2 * 16; sz += 8 ) {
+            other = bytes;
+            std::memcpy ( &other [ 24 ], &sz, sizeof ( sz ));
+            mem = load ( other );
+            BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], other.size (), false ), ba::index_format_error );
+            }
+
+    //  A searcher whose offset points into the header or the directory
+        for ( boost::uint64_t off = 0; off < 40 + 2 * 16; off += 8 ) {
+            other = bytes;
+            std::memcpy ( &other [ 40 + 16 + 8 ], &off, sizeof ( off ));
+            mem = load ( other );
+            BOOST_CHECK_THROW ( ba::searcher_table ( &mem [ 0 ], other.size (), false ), ba::index_format_error );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_search ();
+    test_format ();
+    return 0;
+}
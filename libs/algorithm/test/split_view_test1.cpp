@@ -0,0 +1,103 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/split_view.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/finder.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <typename Searcher>
+    void check_one ( const std::string &corpus, const std::string &delim ) {
+        typedef std::string::const_iterator iter;
+        const Searcher s ( delim.begin (), delim.end ());
+
+    //  What Boost.StringAlgo makes, by copying
+        std::vector<std::string> expected;
+        if ( delim.empty ())
+            expected.push_back ( corpus );
+        else
+            ba::iter_split ( expected, corpus, ba::first_finder ( delim ));
+
+        std::vector<std::string> fields;
+        const ba::split_view<iter, Searcher> sv ( corpus.begin (), corpus.end (), s );
+        for ( typename ba::split_view<iter, Searcher>::iterator it = sv.begin (); it != sv.end (); ++it ) {
+        //  The fields point into the corpus
+            BOOST_CHECK ( it->begin () >= corpus.begin () && it->end () <= corpus.end ());
+            fields.push_back ( std::string ( it->begin (), it->end ()));
+            }
+        BOOST_CHECK ( fields == expected );
+
+    //  Iterators can be copied, and walked again
+        typename ba::split_view<iter, Searcher>::iterator a = sv.begin (), b = a;
+        BOOST_CHECK ( a == b );
+        if ( a != sv.end ()) ++a;
+        BOOST_CHECK_EQUAL ( std::distance ( b, sv.end ()), (std::ptrdiff_t) expected.size ());
+        BOOST_CHECK_EQUAL ( std::distance ( a, sv.end ()), (std::ptrdiff_t) expected.size () - 1 );
+
+    //  The view can be a temporary; its iterators don't refer to it
+        std::size_t count = 0;
+        for ( typename ba::split_view<iter, Searcher>::iterator it = ba::make_split_view ( corpus, s ).begin ();
+                    it != sv.end (); ++it )
+            ++count;
+        BOOST_CHECK_EQUAL ( count, expected.size ());
+        }
+
+    void check_all ( const std::string &corpus, const std::string &delim ) {
+        typedef std::string::const_iterator iter;
+        check_one<ba::boyer_moore_horspool<iter> > ( corpus, delim );
+        check_one<ba::knuth_morris_pratt<iter> >   ( corpus, delim );
+        }
+
+    void test_simple () {
+        check_all ( "", "," );
+        check_all ( ",", "," );
+        check_all ( "a,b,c", "," );
+        check_all ( "a,,b,", "," );
+        check_all ( "line one\r\nline two\r\n\r\nline four", "\r\n" );
+        check_all ( "a||b|c||||d", "||" );
+        check_all ( "no delimiters", "<sep>" );
+        check_all ( "abc", "" );
+        check_all ( "aaaa", "aa" );
+        }
+
+    void test_random () {
+        std::srand ( 1 );
+        for ( int i = 0; i < 500; ++i ) {
+            std::string corpus, delim;
+            const int len = std::rand () % 100;
+            for ( int j = 0; j < len; ++j )
+                corpus += static_cast<char> ( 'a' + std::rand () % 3 );
+            const int dlen = 1 + std::rand () % 3;
+            for ( int j = 0; j < dlen; ++j )
+                delim += static_cast<char> ( 'a' + std::rand () % 3 );
+            check_all ( corpus, delim );
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_simple ();
+    test_random ();
+    return 0;
+}
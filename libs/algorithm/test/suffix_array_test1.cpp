@@ -0,0 +1,222 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/suffix_array.hpp>
+#include <boost/algorithm/searching/fm_index.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef ba::suffix_array<std::string::const_iterator> sa_type;
+    typedef ba::fm_index<> fm_type;
+
+//  DNA; with a larger 'alphabet', a zero byte (which the FM-index uses for
+//  its sentinel) and a byte with the high bit set are mixed in
+    std::string random_dna ( std::size_t len, int alphabet ) {
+        std::string retVal;
+        for ( std::size_t i = 0; i < len; ++i )
+            retVal += static_cast<char> ( "ACGT\0\xff" [ std::rand () % alphabet ] );
+        return retVal;
+        }
+
+//  All the positions of 'needle' in 'haystack', in order
+    std::vector<std::size_t> all_matches ( const std::string &haystack, const std::string &needle ) {
+        std::vector<std::size_t> retVal;
+        std::string::const_iterator it = haystack.begin ();
+        while (( it = std::search ( it, haystack.end (), needle.begin (), needle.end ())) != haystack.end ()) {
+            retVal.push_back ( it - haystack.begin ());
+            ++it;
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const sa_type &sa, const fm_type &fm,
+                                                    const std::string &needle ) {
+        const std::vector<std::size_t> expected = all_matches ( haystack, needle );
+        const std::size_t first = expected.empty () ? haystack.size () : expected [ 0 ];
+
+        std::vector<std::size_t> found;
+        sa.locate ( needle.begin (), needle.end (), std::back_inserter ( found ));
+        std::sort ( found.begin (), found.end ());
+        BOOST_CHECK ( found == expected );
+        BOOST_CHECK_EQUAL ( sa.count ( needle.begin (), needle.end ()), expected.size ());
+        BOOST_CHECK_EQUAL ((std::size_t) ( sa ( needle ) - haystack.begin ()), first );
+
+        found.clear ();
+        fm.locate ( needle.begin (), needle.end (), std::back_inserter ( found ));
+        std::sort ( found.begin (), found.end ());
+        BOOST_CHECK ( found == expected );
+        BOOST_CHECK_EQUAL ( fm.count ( needle.begin (), needle.end ()), expected.size ());
+        BOOST_CHECK_EQUAL ( fm ( needle ), first );
+        }
+
+    void test_array () {
+        const std::string corpus ( "abracadabra" );
+        sa_type sa ( corpus.begin (), corpus.end ());
+        const int expected [] = { 10, 7, 0, 3, 5, 8, 1, 4, 6, 9, 2 };
+        BOOST_CHECK ( sa.size () == corpus.size ());
+        BOOST_CHECK ( std::equal ( sa.array ().begin (), sa.array ().end (), expected ));
+
+        fm_type fm ( corpus.begin (), corpus.end (), 4, 4 );
+        check_one ( corpus, sa, fm, "abra" );
+        check_one ( corpus, sa, fm, "a" );
+        check_one ( corpus, sa, fm, "bra" );
+        check_one ( corpus, sa, fm, "cad" );
+        check_one ( corpus, sa, fm, "abracadabra" );
+        check_one ( corpus, sa, fm, "abracadabrax" );
+        check_one ( corpus, sa, fm, "z" );
+        check_one ( corpus, sa, fm, "ra" );
+        BOOST_CHECK ( sa ( std::string ()) == corpus.begin ());
+        BOOST_CHECK_EQUAL ( fm ( std::string ()), 0U );
+
+    //  An empty corpus
+        const std::string empty;
+        sa_type esa ( empty.begin (), empty.end ());
+        fm_type efm ( empty.begin (), empty.end ());
+        check_one ( empty, esa, efm, "a" );
+        BOOST_CHECK ( esa.size () == 0 && efm.size () == 0 );
+        }
+
+    void test_random () {
+        std::srand ( 1 );
+        for ( int i = 0; i < 300; ++i ) {
+            const int alphabet = 1 + std::rand () % 6;
+            const std::string corpus = random_dna ( std::rand () % 500, alphabet );
+            sa_type sa ( corpus.begin (), corpus.end ());
+            fm_type fm ( corpus.begin (), corpus.end (), 1 + std::rand () % 16, 1 + std::rand () % 70 );
+            for ( int j = 0; j < 20; ++j ) {
+                std::string needle;
+                if ( j % 2 == 0 && !corpus.empty ()) {
+                    const std::size_t pos = std::rand () % corpus.size ();
+                    needle = corpus.substr ( pos, 1 + std::rand () % 12 );
+                    }
+                else
+                    needle = random_dna ( 1 + std::rand () % 6, alphabet );
+                check_one ( corpus, sa, fm, needle );
+                }
+            }
+        }
+
+    void test_serialization () {
+        std::string corpus;
+        for ( int i = 0; i < 200; ++i )
+            corpus += "GATTACA TAGACAT ";
+        const std::string needle ( "ACAT" );
+
+        sa_type sa ( corpus.begin (), corpus.end ());
+        std::stringstream sa_stream;
+        sa.save ( sa_stream );
+        sa_type sa2 ( corpus.begin (), corpus.end (), sa_stream );
+        BOOST_CHECK ( sa.array () == sa2.array ());
+
+    //  The saved array can't be used with a different corpus
+        std::string other ( corpus );
+        other [ 5 ] = 'X';
+        std::stringstream sa_stream2;
+        sa.save ( sa_stream2 );
+        BOOST_CHECK_THROW ( sa_type ( other.begin (), other.end (), sa_stream2 ), ba::index_format_error );
+
+    //  The FM-index doesn't need the corpus once it's built
+        fm_type fm ( sa );
+        std::stringstream fm_stream;
+        fm.save ( fm_stream );
+        fm_type fm2 ( fm_stream );
+        BOOST_CHECK_EQUAL ( fm2.size (), corpus.size ());
+        BOOST_CHECK_EQUAL ( fm2.count ( needle.begin (), needle.end ()), 200U );
+        check_one ( corpus, sa2, fm2, needle );
+        check_one ( corpus, sa2, fm2, "TTACA T" );
+
+    //  Damaged or mismatched input
+        std::string bytes = fm_stream.str ();
+        std::istringstream truncated ( bytes.substr ( 0, bytes.size () / 2 ));
+        BOOST_CHECK_THROW ( fm_type fm3 ( truncated ), ba::index_format_error );
+        std::istringstream wrong_kind ( bytes );
+        BOOST_CHECK_THROW ( sa_type ( corpus.begin (), corpus.end (), wrong_kind ), ba::index_format_error );
+        std::istringstream wrong_index ( bytes );
+        BOOST_CHECK_THROW ( ba::fm_index<int> fm4 ( wrong_index ), ba::index_format_error );
+        }
+
+//  Load 'bytes' as an FM-index, and use it; it must either work, or throw index_format_error
+    bool try_load ( const std::string &bytes ) {
+        std::istringstream in ( bytes );
+        try {
+            fm_type fm ( in );
+            const std::string needles [] = { "A", "ACAT", "TTACA T", "GATTACA TAGACAT G" };
+            std::vector<std::size_t> pos;
+            for ( std::size_t i = 0; i < sizeof ( needles ) / sizeof ( needles [ 0 ] ); ++i ) {
+                fm.count ( needles [ i ].begin (), needles [ i ].end ());
+                fm.locate ( needles [ i ].begin (), needles [ i ].end (), std::back_inserter ( pos ));
+                }
+            return true;
+            }
+        catch ( const ba::index_format_error & ) {}
+        return false;
+        }
+
+    void test_damaged () {
+        std::string corpus;
+        for ( int i = 0; i < 8; ++i )
+            corpus += "GATTACA TAGACAT ";
+        const fm_type fm ( corpus.begin (), corpus.end (), 4, 8 );
+        std::ostringstream out;
+        fm.save ( out );
+        const std::string bytes = out.str ();
+        BOOST_CHECK ( try_load ( bytes ));
+
+    //  Every byte, changed: a table that doesn't fit the BWT is rejected
+        std::size_t rejected = 0;
+        for ( std::size_t i = 0; i < bytes.size (); ++i ) {
+            std::string damaged ( bytes );
+            damaged [ i ] ^= 0x41;
+            if ( !try_load ( damaged ))
+                ++rejected;
+            }
+        BOOST_CHECK ( rejected > bytes.size () / 2 );
+
+    //  A huge count in front of an array is a format error, not an allocation failure.
+    //  The header is 12 bytes, then five 64-bit values, then the count for code_.
+        std::string huge ( bytes );
+        const boost::uint64_t counts [] = { boost::uint64_t ( 1 ) << 40, boost::uint64_t ( -1 ), boost::uint64_t ( -1 ) / 2 };
+        for ( std::size_t i = 0; i < sizeof ( counts ) / sizeof ( counts [ 0 ] ); ++i ) {
+            std::memcpy ( &huge [ 12 + 5 * 8 ], &counts [ i ], sizeof ( counts [ i ] ));
+            BOOST_CHECK ( !try_load ( huge ));
+            }
+
+    //  A saved suffix array with a position outside the corpus
+        sa_type sa ( corpus.begin (), corpus.end ());
+        std::ostringstream sa_out;
+        sa.save ( sa_out );
+        std::string sa_bytes = sa_out.str ();
+        const std::ptrdiff_t past_end = static_cast<std::ptrdiff_t> ( corpus.size ());
+        std::memcpy ( &sa_bytes [ sa_bytes.size () - sizeof ( past_end ) ], &past_end, sizeof ( past_end ));
+        std::istringstream sa_in ( sa_bytes );
+        BOOST_CHECK_THROW ( sa_type ( corpus.begin (), corpus.end (), sa_in ), ba::index_format_error );
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_array ();
+    test_random ();
+    test_serialization ();
+    test_damaged ();
+    return 0;
+}
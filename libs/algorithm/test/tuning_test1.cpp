@@ -0,0 +1,146 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/calibrate.hpp>
+#include <boost/algorithm/searching/search_each.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/tuning.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <algorithm>
+#include <cstdio>       // for std::remove
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    void test_read_write () {
+        const ba::search_tuning defaults;
+        BOOST_CHECK_EQUAL ( defaults.short_corpus, ba::search_each_short_corpus );
+        BOOST_CHECK_EQUAL ( defaults.horspool_max_pattern, 64U );
+        BOOST_CHECK_EQUAL ( defaults.parallel_min_grain, ba::execution::parallel_min_grain );
+
+        ba::search_tuning t;
+        t.short_corpus = 512;
+        t.horspool_max_pattern = 16;
+        t.parallel_min_grain = 4096;
+        std::stringstream ss;
+        ba::write_search_tuning ( ss, t );
+        BOOST_CHECK ( ba::read_search_tuning ( ss ) == t );
+
+    //  Comments, blank lines and unknown keys are skipped; missing keys keep their defaults
+        std::istringstream in ( "# a comment\n\n  horspool_max_pattern 8\nfrobnicate 3\nparallel_min_grain 99\n" );
+        const ba::search_tuning r = ba::read_search_tuning ( in );
+        BOOST_CHECK_EQUAL ( r.horspool_max_pattern, 8U );
+        BOOST_CHECK_EQUAL ( r.parallel_min_grain, 99U );
+        BOOST_CHECK_EQUAL ( r.short_corpus, defaults.short_corpus );
+
+        std::istringstream empty ( "" );
+        BOOST_CHECK ( ba::read_search_tuning ( empty ) == defaults );
+
+        const char *bad [] = { "short_corpus\n", "short_corpus many\n", "short_corpus 12 13\n" };
+        for ( std::size_t i = 0; i < sizeof ( bad ) / sizeof ( bad [ 0 ] ); ++i ) {
+            std::istringstream b ( bad [ i ] );
+            BOOST_CHECK_THROW ( ba::read_search_tuning ( b ), ba::tuning_format_error );
+            }
+        }
+
+    void test_files () {
+        BOOST_CHECK_THROW ( ba::load_search_tuning ( "no/such/directory/tuning.txt" ), ba::tuning_format_error );
+
+        const std::string path = "tuning_test1.txt";
+        ba::search_tuning t;
+        t.short_corpus = 1024;
+        t.horspool_max_pattern = 128;
+        ba::save_search_tuning ( path, t );
+        BOOST_CHECK ( ba::load_search_tuning ( path ) == t );
+        std::remove ( path.c_str ());
+        }
+
+    std::vector<std::size_t> naive_each ( const std::vector<std::string> &corpora, const std::string &pat ) {
+        std::vector<std::size_t> retVal;
+        for ( std::size_t i = 0; i < corpora.size (); ++i )
+            retVal.push_back ( std::search ( corpora [ i ].begin (), corpora [ i ].end (), pat.begin (), pat.end ()) - corpora [ i ].begin ());
+        return retVal;
+        }
+
+    //  search_each must give the same answers whichever way short_corpus is set
+    void test_search_each () {
+        const ba::search_tuning saved = ba::current_search_tuning ();
+        std::vector<std::string> corpora;
+        for ( std::size_t len = 0; len < 600; len += 37 )
+            corpora.push_back ( ba::detail::calibration_text ( len, static_cast<boost::uint32_t> ( len )) + "needle" );
+        corpora.push_back ( "no match here" );
+        const std::string pat ( "needle" );
+        const std::vector<std::size_t> expected = naive_each ( corpora, pat );
+
+        const std::size_t settings [] = { 0, 64, 256, 100000 };
+        for ( std::size_t i = 0; i < sizeof ( settings ) / sizeof ( settings [ 0 ] ); ++i ) {
+            ba::current_search_tuning ().short_corpus = settings [ i ];
+            ba::boyer_moore_horspool<std::string::const_iterator> s ( pat.begin (), pat.end ());
+            std::vector<std::size_t> found ( corpora.size ());
+            ba::search_each ( s, corpora.begin (), corpora.end (), found.begin ());
+            BOOST_CHECK ( found == expected );
+            }
+        ba::current_search_tuning () = saved;
+        }
+
+    void test_calibrated_search () {
+        const ba::search_tuning saved = ba::current_search_tuning ();
+        const std::string text = ba::detail::calibration_text ( 10000, 7 );
+        for ( std::size_t len = 1; len < 200; len += 13 ) {
+            const std::string pat = text.substr ( 5000, len );
+            const std::string::const_iterator expected = std::search ( text.begin (), text.end (), pat.begin (), pat.end ());
+            ba::current_search_tuning ().horspool_max_pattern = 0;      // always boyer_moore
+            BOOST_CHECK ( ba::calibrated_search ( text.begin (), text.end (), pat.begin (), pat.end ()) == expected );
+            ba::current_search_tuning ().horspool_max_pattern = 1000;   // always boyer_moore_horspool
+            BOOST_CHECK ( ba::calibrated_search ( text.begin (), text.end (), pat.begin (), pat.end ()) == expected );
+            }
+        ba::current_search_tuning () = saved;
+        }
+
+    void test_threshold () {
+        std::vector<std::size_t> sizes;
+        std::vector<double> small, large;
+        for ( std::size_t n = 16; n <= 256; n *= 2 )
+            sizes.push_back ( n );
+        const double s1 [] = { 1, 1, 1, 3, 3 }, l1 [] = { 2, 2, 2, 2, 2 };   // one crossover, at 64
+        small.assign ( s1, s1 + 5 ); large.assign ( l1, l1 + 5 );
+        BOOST_CHECK_EQUAL ( ba::detail::calibration_threshold ( sizes, small, large ), 64U );
+        const double s2 [] = { 3, 3, 1, 1, 1 };                             // small is only better for big sizes
+        small.assign ( s2, s2 + 5 );
+        BOOST_CHECK_EQUAL ( ba::detail::calibration_threshold ( sizes, small, large ), 256U );
+        const double s3 [] = { 3, 3, 3, 3, 3 };                             // never better
+        small.assign ( s3, s3 + 5 );
+        BOOST_CHECK_EQUAL ( ba::detail::calibration_threshold ( sizes, small, large ), 0U );
+        }
+
+    void test_calibrate () {
+        const ba::search_tuning before = ba::current_search_tuning ();
+        const ba::search_tuning t = ba::calibrate_search_tuning ( 0.0005 );
+        BOOST_CHECK ( t.horspool_max_pattern <= 256 );
+        BOOST_CHECK ( t.short_corpus <= 4096 );
+        BOOST_CHECK ( ba::current_search_tuning () == before );
+        }
+    }
+
+int test_main( int , char* [] )
+{
+    test_read_write ();
+    test_files ();
+    test_search_each ();
+    test_calibrated_search ();
+    test_threshold ();
+    test_calibrate ();
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/typed_searcher.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The slow way: try every aligned offset
+    std::size_t reference ( const std::vector<unsigned char> &corpus, const std::vector<unsigned char> &pat, std::size_t alignment ) {
+        for ( std::size_t o = 0; o + pat.size () <= corpus.size (); o += alignment )
+            if ( std::equal ( pat.begin (), pat.end (), corpus.begin () + o ))
+                return o;
+        return corpus.size ();
+        }
+
+    template <typename T>
+    void check_one ( const std::vector<unsigned char> &corpus, const ba::typed_searcher<T> &ts ) {
+        const std::size_t expected = reference ( corpus, ts.pattern_bytes (), ts.alignment ());
+        BOOST_CHECK ( static_cast<std::size_t> ( ts ( corpus.begin (), corpus.end ()) - corpus.begin ()) == expected );
+        const std::deque<unsigned char> dq ( corpus.begin (), corpus.end ());
+        BOOST_CHECK ( static_cast<std::size_t> ( ts ( dq.begin (), dq.end ()) - dq.begin ()) == expected );
+        }
+
+    void test_byte_order () {
+        const boost::uint32_t magic = 0xA1B2C3D4;
+        const unsigned char le [] = { 0xD4, 0xC3, 0xB2, 0xA1 };
+        const unsigned char be [] = { 0xA1, 0xB2, 0xC3, 0xD4 };
+
+        ba::typed_searcher<boost::uint32_t> tle ( magic, ba::little_endian_byte_order );
+        ba::typed_searcher<boost::uint32_t> tbe ( magic, ba::big_endian_byte_order );
+        ba::typed_searcher<boost::uint32_t> tn  ( magic );
+        BOOST_CHECK ( std::equal ( le, le + 4, tle.pattern_bytes ().begin ()));
+        BOOST_CHECK ( std::equal ( be, be + 4, tbe.pattern_bytes ().begin ()));
+        BOOST_CHECK ( std::memcmp ( &tn.pattern_bytes () [ 0 ], &magic, 4 ) == 0 );
+        BOOST_CHECK ( tle.pattern_length () == 4 && tle.alignment () == 4 );
+
+        std::vector<unsigned char> corpus ( 40, 0 );
+        std::copy ( be, be + 4, corpus.begin () + 6 );     // not aligned
+        std::copy ( le, le + 4, corpus.begin () + 20 );
+        std::copy ( be, be + 4, corpus.begin () + 32 );
+        BOOST_CHECK ( tle ( corpus ) - corpus.begin () == 20 );
+        BOOST_CHECK ( tbe ( corpus ) - corpus.begin () == 32 );
+        BOOST_CHECK ( ba::typed_search ( corpus.begin (), corpus.end (), magic, ba::big_endian_byte_order, 1 ) - corpus.begin () == 6 );
+        BOOST_CHECK ( ba::typed_search ( corpus.begin (), corpus.end (), magic, ba::big_endian_byte_order, 2 ) - corpus.begin () == 6 );
+
+    //  Sequences of values
+        const boost::uint16_t ids [] = { 0x0102, 0x0304 };
+        const std::vector<boost::uint16_t> idv ( ids, ids + 2 );
+        const unsigned char idbytes [] = { 0, 1, 2, 3, 4, 0, 1, 2, 3, 4 };
+        const std::vector<unsigned char> c2 ( idbytes, idbytes + sizeof ( idbytes ));
+        BOOST_CHECK ( ba::make_typed_searcher ( idv, ba::big_endian_byte_order ) ( c2 ) - c2.begin () == 6 );
+        BOOST_CHECK ( ba::make_typed_searcher ( idv, ba::big_endian_byte_order, 1 ) ( c2 ) - c2.begin () == 1 );
+        BOOST_CHECK ( ba::make_typed_searcher ( idv, ba::little_endian_byte_order, 1 ) ( c2 ) == c2.end ());
+
+    //  Floating point values, and the empty cases
+        const double pi = 3.14159;
+        std::vector<unsigned char> c3 ( 64, 0 );
+        std::memcpy ( &c3 [ 24 ], &pi, sizeof ( pi ));
+        BOOST_CHECK ( ba::typed_search ( c3.begin (), c3.end (), pi ) - c3.begin () == 24 );
+        BOOST_CHECK ( ba::typed_search ( c3.begin (), c3.begin (), pi ) == c3.begin ());
+        const std::vector<int> none;
+        BOOST_CHECK ( ba::make_typed_searcher ( none ) ( c3 ) == c3.begin ());
+
+        BOOST_CHECK_THROW ( ba::typed_searcher<int> ( 1, ba::native_byte_order, 0 ), std::invalid_argument );
+        }
+
+    template <typename T>
+    void test_random ( std::size_t alignment ) {
+        for ( int i = 0; i < 200; ++i ) {
+            std::vector<unsigned char> corpus ( std::rand () % 300 );
+            for ( std::size_t j = 0; j < corpus.size (); ++j )
+                corpus [ j ] = static_cast<unsigned char> ( std::rand () % 3 );
+            std::vector<T> values ( 1 + std::rand () % 2 );
+            for ( std::size_t j = 0; j < values.size (); ++j ) {
+                unsigned char bytes [ sizeof ( T ) ];
+                for ( std::size_t k = 0; k < sizeof ( T ); ++k )
+                    bytes [ k ] = static_cast<unsigned char> ( std::rand () % 3 );
+                std::memcpy ( &values [ j ], bytes, sizeof ( T ));
+                }
+            check_one ( corpus, ba::typed_searcher<T> ( values.begin (), values.end (), ba::little_endian_byte_order, alignment ));
+            check_one ( corpus, ba::typed_searcher<T> ( values.begin (), values.end (), ba::big_endian_byte_order, alignment ));
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_byte_order ();
+    std::srand ( 17 );
+    const std::size_t alignments [] = { 1, 2, 3, 4, 6, 8, 16, 32 };
+    for ( std::size_t i = 0; i < sizeof ( alignments ) / sizeof ( alignments [ 0 ] ); ++i ) {
+        test_random<unsigned char>  ( alignments [ i ] );
+        test_random<boost::uint16_t> ( alignments [ i ] );
+        test_random<boost::uint32_t> ( alignments [ i ] );
+        test_random<boost::uint64_t> ( alignments [ i ] );
+        }
+    return 0;
+}
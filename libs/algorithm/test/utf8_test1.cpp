@@ -0,0 +1,151 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/utf8.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+
+#include <boost/test/included/test_exec_monitor.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::size_t find ( const std::string &corpus, const std::string &pat ) {
+        ba::utf8_searcher<std::string::const_iterator> us ( pat.begin (), pat.end ());
+        const std::size_t retVal = us ( corpus.begin (), corpus.end ()) - corpus.begin ();
+        BOOST_CHECK ( retVal == static_cast<std::size_t> (
+                    ba::utf8_search ( corpus.begin (), corpus.end (), pat.begin (), pat.end ()) - corpus.begin ()));
+        return retVal;
+        }
+
+    std::size_t ifind ( const std::string &corpus, const std::string &pat ) {
+        ba::utf8_icase_searcher<std::string::const_iterator> us ( pat.begin (), pat.end ());
+        const std::size_t retVal = us ( corpus.begin (), corpus.end ()) - corpus.begin ();
+        BOOST_CHECK ( retVal == static_cast<std::size_t> (
+                    ba::utf8_icase_search ( corpus.begin (), corpus.end (), pat.begin (), pat.end ()) - corpus.begin ()));
+        BOOST_CHECK ( us.pattern_length () == pat.size ());
+        return retVal;
+        }
+
+    void test_boundaries () {
+        const std::string cafe ( "caf\xC3\xA9" );
+    //  Well-formed patterns match wherever the bytes do
+        BOOST_CHECK ( find ( "caf\xC3\xA9 caf\xC3\xA9", "\xC3\xA9" ) == 3 );
+        BOOST_CHECK ( find ( "caf\xC3\xA9", "" ) == 0 );
+        BOOST_CHECK ( find ( "", "abc" ) == 0 );
+        BOOST_CHECK ( find ( "abc", "abcd" ) == 3 );
+
+    //  A pattern that starts with a continuation byte never starts on a boundary
+        BOOST_CHECK ( find ( cafe, "\xA9" ) == cafe.size ());
+
+    //  A pattern that ends part way through a character only matches at the end of the corpus,
+    //  or before another lead byte
+        const std::string euro ( "\xE2\x82\xAC" );
+        BOOST_CHECK ( find ( euro + " " + euro, "\xE2\x82" ) == 7 );
+        BOOST_CHECK ( find ( euro + " \xE2\x82", "\xE2\x82" ) == 4 );
+        BOOST_CHECK ( find ( euro + " \xE2\x82" "a", "\xE2\x82" ) == 4 );
+        BOOST_CHECK ( find ( "a\xC3\xA9 a\xC3", "a\xC3" ) == 4 );
+
+    //  Other searchers can be used underneath
+        const std::string pat ( "\xE2\x82" );
+        ba::utf8_searcher<std::string::const_iterator, ba::boyer_moore<std::string::const_iterator> >
+                us ( pat.begin (), pat.end ());
+        const std::string corpus ( euro + euro + "x\xE2\x82" );
+        BOOST_CHECK ( us ( corpus ) - corpus.begin () == 7 );
+        BOOST_CHECK ( ba::make_utf8_searcher ( pat ) ( corpus ) - corpus.begin () == 7 );
+        }
+
+    void test_folding () {
+        BOOST_CHECK ( ifind ( "Hello World", "WORLD" ) == 6 );
+        BOOST_CHECK ( ifind ( "Hello World", "world!" ) == 11 );
+        BOOST_CHECK ( ifind ( "tel 555-1234", "555-1234" ) == 4 );                        // nothing to fold
+        BOOST_CHECK ( ifind ( "une \xC3\xA9" "cole", "\xC3\x89" "COLE" ) == 4 );          // Latin-1
+        BOOST_CHECK ( ifind ( "\xC3\x98resund", "\xC3\xB8" "RESUND" ) == 0 );
+        BOOST_CHECK ( ifind ( "\xC3\x97", "\xC3\xB7" ) == 2 );                            // x and / don't fold
+        BOOST_CHECK ( ifind ( "\xC5\xBB\xC3\xB3\xC5\x82w", "\xC5\xBC\xC3\x93\xC5\x81W" ) == 0 );  // Latin Extended-A
+        BOOST_CHECK ( ifind ( "\xC3\xBF", "\xC5\xB8" ) == 0 );                            // y with diaeresis
+        BOOST_CHECK ( ifind ( "\xCE\xA3\xCE\x9F\xCE\xA6\xCE\x8A\xCE\x91",                 // Greek, including sigmas
+                              "\xCF\x83\xCE\xBF\xCF\x86\xCE\xAF\xCE\xB1" ) == 0 );
+        BOOST_CHECK ( ifind ( "\xCF\x82", "\xCE\xA3" ) == 0 );
+        BOOST_CHECK ( ifind ( "\xC2\xB5", "\xCE\x9C" ) == 0 );                            // MICRO SIGN
+        BOOST_CHECK ( ifind ( "\xD0\x9C\xD0\x9E\xD0\xA1\xD0\x9A\xD0\x92\xD0\x90",         // Cyrillic
+                              "\xD0\xBC\xD0\xBE\xD1\x81\xD0\xBA\xD0\xB2\xD0\xB0" ) == 0 );
+        BOOST_CHECK ( ifind ( "\xD0\x81", "\xD1\x91" ) == 0 );
+        BOOST_CHECK ( ifind ( "\xD4\xB1", "\xD5\xA1" ) == 0 );                            // Armenian
+        BOOST_CHECK ( ifind ( "\xE1\xBA\xA0", "\xE1\xBA\xA1" ) == 0 );                    // Latin Extended Additional
+        BOOST_CHECK ( ifind ( "\xEF\xBC\xA1", "\xEF\xBD\x81" ) == 0 );                    // Fullwidth
+
+    //  Folds that change the encoded length aren't matched
+        BOOST_CHECK ( ifind ( "\xE2\x84\xAA", "k" ) == 3 );                               // KELVIN SIGN
+        BOOST_CHECK ( ifind ( "\xC5\xBF", "S" ) == 2 );                                   // LONG S
+
+    //  Bytes that aren't UTF-8 are matched as they are
+        BOOST_CHECK ( ifind ( "ab\xFF" "Cd", "B\xFF" "c" ) == 1 );
+        BOOST_CHECK ( ifind ( "ab\xFE" "Cd", "B\xFF" "c" ) == 5 );
+
+        const std::string pat ( "\xC3\x89t\xC3\xA9" );
+        const std::string corpus ( "en \xC3\xA9T\xC3\x89" );
+        BOOST_CHECK ( ba::make_utf8_icase_searcher ( pat ) ( corpus ) - corpus.begin () == 3 );
+        }
+
+//  A slow reference: compare character by character, folded
+    std::size_t reference ( const std::string &corpus, const std::string &pat ) {
+        const unsigned char *c = reinterpret_cast<const unsigned char *> ( corpus.data ());
+        const unsigned char *p = reinterpret_cast<const unsigned char *> ( pat.data ());
+        for ( std::size_t pos = 0; pos + pat.size () <= corpus.size (); ++pos ) {
+            std::size_t i = 0;
+            while ( i < pat.size ()) {
+                boost::uint32_t pc = 0, cc = 0;
+                const std::size_t n = ba::detail::utf8_decode ( p + i, pat.size () - i, pc );
+                if ( n == 0 ) {     // not UTF-8: matched as it is, a byte at a time
+                    if ( c [ pos + i ] != p [ i ] )
+                        break;
+                    ++i;
+                    continue;
+                    }
+                if ( ba::detail::utf8_decode ( c + pos + i, n, cc ) != n || ba::detail::utf8_fold ( pc ) != ba::detail::utf8_fold ( cc ))
+                    break;
+                i += n;
+                }
+            if ( i == pat.size ())
+                return pos;
+            }
+        return corpus.size ();
+        }
+
+    void test_random () {
+        static const char *alphabet [] = {
+            "a", "A", "b", "\xC3\xA9", "\xC3\x89", "\xCF\x83", "\xCE\xA3", "\xCF\x82", "\xD0\xB6", "\xD0\x96", "\xE1\xBA\xA1" };
+        const int k = sizeof ( alphabet ) / sizeof ( alphabet [ 0 ] );
+        std::srand ( 42 );
+        for ( int i = 0; i < 500; ++i ) {
+            std::string corpus, pat;
+            const int clen = std::rand () % 40;
+            for ( int j = 0; j < clen; ++j )
+                corpus += alphabet [ std::rand () % k ];
+            const int plen = 1 + std::rand () % 4;
+            for ( int j = 0; j < plen; ++j )
+                pat += alphabet [ std::rand () % k ];
+            BOOST_CHECK ( ifind ( corpus, pat ) == reference ( corpus, pat ));
+            }
+        }
+    }
+
+
+int test_main( int , char* [] )
+{
+    test_boundaries ();
+    test_folding ();
+    test_random ();
+    return 0;
+}